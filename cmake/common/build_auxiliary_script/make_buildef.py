@@ -4,25 +4,65 @@
 # Copyright (c) 2009-2023 Huawei Technologies Co., Ltd. All rights reserved.
 
 import os
+import re
 import sys
 import logging
+import tempfile
 from Kconfig2macro import do_cmd
 
 
 logging.basicConfig(stream=sys.stdout, level=logging.NOTSET) 
 
+# 将环境变量CONFIG_FRAGMENT指定的配置片段合并到defconfig的临时副本中，片段中的配置项覆盖defconfig，
+# defconfig本身不修改。没有配置片段时直接返回defconfig。
+def merge_fragment(kconfig_dir):
+    fragment_file = os.environ.get("CONFIG_FRAGMENT", "")
+    if not fragment_file:
+        return kconfig_dir
+
+    fragment = {}
+    with open(fragment_file) as fd_in:
+        for line in fd_in:
+            match_s = re.match(r'^(?:# )?(CONFIG_\w+)[= ]', line)
+            if match_s is not None:
+                fragment[match_s.group(1)] = line.rstrip("\n")
+
+    lines = []
+    with open(kconfig_dir) as fd_in:
+        for line in fd_in:
+            match_s = re.match(r'^(?:# )?(CONFIG_\w+)[= ]', line)
+            if match_s is not None and match_s.group(1) in fragment:
+                line = fragment.pop(match_s.group(1)) + "\n"
+            lines.append(line)
+    lines.extend(["%s\n" % line for line in fragment.values()])
+
+    with tempfile.NamedTemporaryFile("w", suffix=".config", delete=False) as fd_out:
+        fd_out.writelines(lines)
+    logging.info("merge config fragment %s.", fragment_file)
+    return fd_out.name
+
+def remove_merged_config(config_file, kconfig_dir):
+    if config_file != kconfig_dir:
+        os.remove(config_file)
+
 def make_buildef(home_path, kconf_dir, choice):
     kconfig_dir = "{}/build/uniproton_config/config_{}/defconfig".format(home_path,kconf_dir)
     buildef_file = "{}/build/uniproton_config/config_{}/prt_buildef.h".format(home_path,kconf_dir)
     if choice == "CREATE":
-        paras = ["-f", kconfig_dir, "-o", buildef_file]
-        if do_cmd(paras, False) != 0:
+        config_file = merge_fragment(kconfig_dir)
+        paras = ["-f", config_file, "-o", buildef_file]
+        ret = do_cmd(paras, False)
+        remove_merged_config(config_file, kconfig_dir)
+        if ret != 0:
             logging.info("build prt_buildef.h failed.")
             return False
         logging.info("build prt_buildef.h succeed.")
     elif choice == "EXPORT":
-        paras = ["-e", "-f", kconfig_dir, "-o", buildef_file]
-        if do_cmd(paras, False) != 0:
+        config_file = merge_fragment(kconfig_dir)
+        paras = ["-e", "-f", config_file, "-o", buildef_file]
+        ret = do_cmd(paras, False)
+        remove_merged_config(config_file, kconfig_dir)
+        if ret != 0:
             logging.info("export prt_buildef.h failed.")
             return False
         logging.info("export prt_buildef.h succeed.")
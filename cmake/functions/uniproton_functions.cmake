@@ -9,6 +9,11 @@
 function(import_kconfig config_file)##.config文件转换为cmake命名空间的变量
     #### 读取Config文件
     file(STRINGS ${config_file} config_list REGEX "^CONFIG_" ENCODING "UTF-8")#### 读取Config文件
+    ##追加环境变量CONFIG_FRAGMENT指定的配置片段，同名配置项以后读入的为准
+    if(DEFINED ENV{CONFIG_FRAGMENT})##追加配置片段
+      file(STRINGS $ENV{CONFIG_FRAGMENT} fragment_list REGEX "^CONFIG_" ENCODING "UTF-8")
+      list(APPEND config_list ${fragment_list})
+    endif()##追加配置片段结束
 
     ##处理各个匹配行
     foreach (config ${config_list})##处理各个匹配行
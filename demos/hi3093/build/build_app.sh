@@ -15,6 +15,13 @@ fi
 
 export TMP_DIR=$APP
 
+# 用例需要的额外配置放在配置片段中，构建时与defconfig合并，不修改defconfig
+FRAGMENT=../../../testsuites/kern-test/config/${APP}.config
+if [ -f "$FRAGMENT" ]
+then
+    export CONFIG_FRAGMENT=$(realpath "$FRAGMENT")
+fi
+
 sh ./build_fetch.sh
 sh ./build_static.sh hi3093
 sh ./build_openamp.sh $TOOLCHAIN_PATH
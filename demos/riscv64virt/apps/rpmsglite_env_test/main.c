@@ -84,6 +84,25 @@ U32 PRT_AppInit(void)
         uart_putstr_sync("err in rpmsg_master/remote resume");
         goto failed;
     }
+#elif defined(CONFIG_RPMSGLITE_BENCH)
+    para.taskPrio = 24;
+    para.taskEntry = rpmsg_bench_master;
+    if(PRT_TaskCreate(&master_pid,&para) != OS_OK) {
+        uart_putstr_sync("err in rpmsg_bench_master create");
+        goto failed;
+    }
+    para.taskPrio = 25;
+    para.taskEntry = rpmsg_bench_remote;
+    if(PRT_TaskCreate(&remote_pid,&para) != OS_OK) {
+        uart_putstr_sync("err in rpmsg_bench_remote create");
+        goto failed;
+    }
+
+    if(PRT_TaskResume(master_pid) != OS_OK
+       || PRT_TaskResume(remote_pid) != OS_OK) {
+        uart_putstr_sync("err in rpmsg_bench resume");
+        goto failed;
+    }
 #else 
     para.taskPrio = 24;
     para.taskEntry = rpmsg_master;
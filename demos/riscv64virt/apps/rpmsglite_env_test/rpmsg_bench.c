@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-08-05
+ * Description: rpmsglite 本地共享内存回环吞吐测试，对比逐条发送与批量发送。
+ */
+
+#include "rpmsg_common.h"
+#include "platform.h"
+#include "prt_config.h"
+
+/* 远端端点数超过RL_EPT_HASH_SIZE，同时覆盖哈希桶内链表查找 */
+#define BENCH_EPT_COUNT 64
+#define BENCH_MSG_COUNT 4096
+#define BENCH_BATCH 16
+#define BENCH_MSG_SIZE 64
+#define BENCH_MASTER_ADDR 0
+#define BENCH_REMOTE_ADDR 1024
+#define BENCH_US_PER_SEC 1000000ULL
+
+static rpmsg_lite_instance_t *bench_master_rpmsg = NULL;
+static rpmsg_lite_instance_t *bench_remote_rpmsg = NULL;
+static rpmsg_lite_endpoint_t *bench_master_ept = NULL;
+static rpmsg_lite_endpoint_t *bench_repts[BENCH_EPT_COUNT] = {0};
+static volatile uint32_t bench_recv_count = 0;
+static volatile uint32_t bench_bad_count = 0;
+static volatile uint32_t bench_remote_ready = 0;
+static uint32_t bench_payload[BENCH_BATCH][BENCH_MSG_SIZE / sizeof(uint32_t)];
+
+static inline uint64_t bench_now(void)
+{
+    return *(volatile uint64_t *)CLINT_TIME;
+}
+
+/* 回调运行在中断上下文，只做目的地址与负载校验和计数 */
+static int32_t bench_rept_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    uintptr_t addr = (uintptr_t)priv;
+
+    if ((payload_len != BENCH_MSG_SIZE) || (src != BENCH_MASTER_ADDR) ||
+        (*(uint32_t *)payload != (uint32_t)addr)) {
+        bench_bad_count++;
+    }
+    bench_recv_count++;
+    return RL_RELEASE;
+}
+
+static int32_t bench_wait_recv(uint32_t expect)
+{
+    uint32_t idle = 0;
+
+    while (bench_recv_count < expect) {
+        env_sleep_msec(1);
+        if (++idle > 10000) {
+            RPMSGLITE_LOG(RM_LOG_PREFIX, "bench timeout, recv %u/%u", bench_recv_count, expect);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void bench_fill(struct rpmsg_lite_batch_msg *msg, uint32_t seq, void *data)
+{
+    uint32_t dst = BENCH_REMOTE_ADDR + (seq % BENCH_EPT_COUNT);
+
+    msg->dst = dst;
+    msg->data = data;
+    msg->size = BENCH_MSG_SIZE;
+    *(uint32_t *)data = dst;
+}
+
+static void bench_report(const char *name, uint64_t cycles)
+{
+    uint64_t us = cycles * BENCH_US_PER_SEC / OS_SYS_CLOCK;
+
+    if (us == 0) {
+        us = 1;
+    }
+    RPMSGLITE_LOG(RM_LOG_PREFIX, "%s: %u msgs in %lu us, %lu msgs/s", name, BENCH_MSG_COUNT,
+                  (unsigned long)us, (unsigned long)(BENCH_MSG_COUNT * BENCH_US_PER_SEC / us));
+}
+
+/* 每条消息一次rpmsg_lite_send，即每条消息一次通知 */
+static int32_t bench_single(void)
+{
+    struct rpmsg_lite_batch_msg msg;
+    uint64_t start;
+    uint32_t i;
+
+    bench_recv_count = 0;
+    start = bench_now();
+    for (i = 0; i < BENCH_MSG_COUNT; i++) {
+        bench_fill(&msg, i, bench_payload[0]);
+        TEST_ASSERT_MESSAGE(rpmsg_lite_send(bench_master_rpmsg, bench_master_ept, msg.dst, (char *)msg.data,
+                                            msg.size, RL_BLOCK) == RL_SUCCESS, "bench single send failed");
+    }
+    TEST_ASSERT_MESSAGE(bench_wait_recv(BENCH_MSG_COUNT) == 0, "bench single recv failed");
+    bench_report("single send", bench_now() - start);
+    return 0;
+}
+
+/* 每BENCH_BATCH条消息一次rpmsg_lite_send_batch，即每批一次通知 */
+static int32_t bench_batch(void)
+{
+    struct rpmsg_lite_batch_msg msgs[BENCH_BATCH];
+    uint64_t start;
+    uint32_t sent;
+    uint32_t i;
+    uint32_t j;
+
+    bench_recv_count = 0;
+    start = bench_now();
+    for (i = 0; i < BENCH_MSG_COUNT; i += BENCH_BATCH) {
+        for (j = 0; j < BENCH_BATCH; j++) {
+            bench_fill(&msgs[j], i + j, bench_payload[j]);
+        }
+        TEST_ASSERT_MESSAGE(rpmsg_lite_send_batch(bench_master_rpmsg, bench_master_ept, msgs, BENCH_BATCH, &sent,
+                                                  RL_BLOCK) == RL_SUCCESS, "bench batch send failed");
+        TEST_ASSERT_MESSAGE(sent == BENCH_BATCH, "bench batch sent count mismatch");
+    }
+    TEST_ASSERT_MESSAGE(bench_wait_recv(BENCH_MSG_COUNT) == 0, "bench batch recv failed");
+    bench_report("batch send", bench_now() - start);
+    return 0;
+}
+
+/* 零拷贝批量发送，申请缓冲区后直接填写负载 */
+static int32_t bench_nocopy_batch(void)
+{
+    struct rpmsg_lite_batch_msg msgs[BENCH_BATCH];
+    uint64_t start;
+    uint32_t size;
+    uint32_t i;
+    uint32_t j;
+    void *buf;
+
+    bench_recv_count = 0;
+    start = bench_now();
+    for (i = 0; i < BENCH_MSG_COUNT; i += BENCH_BATCH) {
+        for (j = 0; j < BENCH_BATCH; j++) {
+            buf = rpmsg_lite_alloc_tx_buffer(bench_master_rpmsg, &size, RL_BLOCK);
+            TEST_ASSERT_MESSAGE((buf != NULL) && (size >= BENCH_MSG_SIZE), "bench alloc tx buffer failed");
+            bench_fill(&msgs[j], i + j, buf);
+        }
+        TEST_ASSERT_MESSAGE(rpmsg_lite_send_nocopy_batch(bench_master_rpmsg, bench_master_ept, msgs,
+                                                         BENCH_BATCH) == RL_SUCCESS, "bench nocopy batch failed");
+    }
+    TEST_ASSERT_MESSAGE(bench_wait_recv(BENCH_MSG_COUNT) == 0, "bench nocopy batch recv failed");
+    bench_report("nocopy batch send", bench_now() - start);
+    return 0;
+}
+
+void rpmsg_bench_remote(
+    uintptr_t param1,
+    uintptr_t param2,
+    uintptr_t param3,
+    uintptr_t param4)
+{
+    uintptr_t shm_len = (uintptr_t)rpmsg_lite_end - (uintptr_t)rpmsg_lite_base;
+    uint32_t i;
+
+    if (rpmsg_init(&bench_remote_rpmsg, UNI2UNI_RPMSGLITE_TEST_LINKID, rpmsg_lite_base, RL_NO_FLAGS,
+                   shm_len, REMOTE) != RL_SUCCESS) {
+        goto failed;
+    }
+
+    for (i = 0; i < BENCH_EPT_COUNT; i++) {
+        bench_repts[i] = rpmsg_lite_create_ept(bench_remote_rpmsg, BENCH_REMOTE_ADDR + i, bench_rept_cb,
+                                               (void *)(uintptr_t)(BENCH_REMOTE_ADDR + i));
+        if (bench_repts[i] == NULL) {
+            goto failed;
+        }
+    }
+
+    rpmsg_lite_wait_for_link_up(bench_remote_rpmsg, (uint32_t)RL_BLOCK);
+    bench_remote_ready = 1;
+    RPMSGLITE_LOG(RR_LOG_PREFIX, "BENCH REMOTE READY, %u endpoints", BENCH_EPT_COUNT);
+    return;
+failed:
+    RPMSGLITE_LOG(RR_LOG_PREFIX, "BENCH REMOTE INIT FAILED");
+}
+
+void rpmsg_bench_master(
+    uintptr_t param1,
+    uintptr_t param2,
+    uintptr_t param3,
+    uintptr_t param4)
+{
+    uintptr_t shm_len = (uintptr_t)rpmsg_lite_end - (uintptr_t)rpmsg_lite_base;
+    uint32_t i;
+
+    if (rpmsg_init(&bench_master_rpmsg, UNI2UNI_RPMSGLITE_TEST_LINKID, rpmsg_lite_base, RL_NO_FLAGS,
+                   shm_len, MASTER) != RL_SUCCESS) {
+        goto failed;
+    }
+
+    bench_master_ept = rpmsg_lite_create_ept(bench_master_rpmsg, BENCH_MASTER_ADDR, bench_rept_cb, NULL);
+    if (bench_master_ept == NULL) {
+        goto failed;
+    }
+
+    while (bench_remote_ready == 0) {
+        env_sleep_msec(10);
+    }
+
+    if ((bench_single() != 0) || (bench_batch() != 0) || (bench_nocopy_batch() != 0)) {
+        goto failed;
+    }
+
+    if (bench_bad_count != 0) {
+        RPMSGLITE_LOG(RM_LOG_PREFIX, "BENCH FAILED, %u messages dispatched to a wrong endpoint", bench_bad_count);
+        return;
+    }
+    RPMSGLITE_LOG(RM_LOG_PREFIX, "BENCH SUCCESS!");
+
+    for (i = 0; i < BENCH_EPT_COUNT; i++) {
+        (void)rpmsg_lite_destroy_ept(bench_remote_rpmsg, bench_repts[i]);
+    }
+    (void)rpmsg_lite_destroy_ept(bench_master_rpmsg, bench_master_ept);
+    return;
+failed:
+    RPMSGLITE_LOG(RM_LOG_PREFIX, "BENCH FAILED");
+}
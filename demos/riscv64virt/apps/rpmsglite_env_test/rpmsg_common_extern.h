@@ -33,4 +33,14 @@ void rpmsg_master_rpc_on_que(
     uintptr_t param2, 
     uintptr_t param3, 
     uintptr_t param4);
+void rpmsg_bench_master(
+    uintptr_t param1, 
+    uintptr_t param2, 
+    uintptr_t param3, 
+    uintptr_t param4);
+void rpmsg_bench_remote(
+    uintptr_t param1, 
+    uintptr_t param2, 
+    uintptr_t param3, 
+    uintptr_t param4);
 #endif
\ No newline at end of file
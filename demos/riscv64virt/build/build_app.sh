@@ -42,6 +42,8 @@ for one_arg in $*; do
 	export APP=rpmsglite_test_master
     elif [[ $one_arg == "rpmsglite_test_slave" ]]; then
 	export APP=rpmsglite_test_slave
+    elif [[ $one_arg == "rpmsglite_bench" ]]; then
+	export APP=rpmsglite_bench
     else
         echo "[Error] Not support args - $one_arg"
         exit 1
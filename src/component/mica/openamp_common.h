@@ -29,6 +29,24 @@
 
 #define VRING_COUNT		2
 
+/*
+ * 与Linux之间的virtqueue对数，每对在资源表中对应一个独立的vdev，由单板cpu_config.h配置。
+ * 通道i由核i上的任务收包，核c发送tty数据使用通道c % OPENAMP_CHANNEL_NUM。
+ */
+#ifndef OPENAMP_CHANNEL_NUM
+#define OPENAMP_CHANNEL_NUM	1
+#endif
+
+#define OPENAMP_CHANNEL_MAX	4
+
+#if (OPENAMP_CHANNEL_NUM < 1) || (OPENAMP_CHANNEL_NUM > OPENAMP_CHANNEL_MAX)
+#error "OPENAMP_CHANNEL_NUM must be in [1, OPENAMP_CHANNEL_MAX]"
+#endif
+
+#if (OPENAMP_CHANNEL_NUM > 1) && (!defined(OS_OPTION_SMP) || (OPENAMP_CHANNEL_NUM > OS_MAX_CORE_NUM))
+#error "multiple openamp channels need OS_OPTION_SMP and one core per channel"
+#endif
+
 #define VRING_RX_ADDRESS        -1  /* allocated by Master processor */
 #define VRING_TX_ADDRESS        -1  /* allocated by Master processor */
 #define VRING_BUFF_ADDRESS      -1  /* allocated by Master processor */
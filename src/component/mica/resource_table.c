@@ -18,6 +18,15 @@
 #define OS_SEC_RSC_TABLE __attribute__((section(".resource_table")))
 #endif
 
+#define RSC_TABLE_CHAN_ENTRY(n) {                                                    \
+    .vdev = {RSC_VDEV, VIRTIO_ID_RPMSG, RSC_CHAN_NOTIFY_ID(n, 2), RPMSG_IPU_C0_FEATURES, \
+             0, 0, 0, VRING_COUNT, {0, 0}},                                          \
+    .vring0 = {VRING_TX_ADDRESS, VRING_ALIGNMENT, NUM_RPMSG_BUFF,                    \
+               RSC_CHAN_NOTIFY_ID(n, VRING0_ID), 0},                                 \
+    .vring1 = {VRING_RX_ADDRESS, VRING_ALIGNMENT, NUM_RPMSG_BUFF,                    \
+               RSC_CHAN_NOTIFY_ID(n, VRING1_ID), 0},                                 \
+}
+
 OS_SEC_RSC_TABLE static struct fw_resource_table resource_table = {
     .ver = 1,
     .num = RSC_TABLE_NUM_ENTRY,
@@ -27,6 +36,15 @@ OS_SEC_RSC_TABLE static struct fw_resource_table resource_table = {
         offsetof(struct fw_resource_table, rbufs),
 #endif
         offsetof(struct fw_resource_table, vdev),
+#if (OPENAMP_CHANNEL_NUM > 1)
+        offsetof(struct fw_resource_table, chans[0]),
+#endif
+#if (OPENAMP_CHANNEL_NUM > 2)
+        offsetof(struct fw_resource_table, chans[1]),
+#endif
+#if (OPENAMP_CHANNEL_NUM > 3)
+        offsetof(struct fw_resource_table, chans[2]),
+#endif
     },
 
     .ept_table = {
@@ -47,6 +65,19 @@ OS_SEC_RSC_TABLE static struct fw_resource_table resource_table = {
                    NUM_RPMSG_BUFF, VRING0_ID, 0},
     .vring1 = {VRING_RX_ADDRESS, VRING_ALIGNMENT,
            NUM_RPMSG_BUFF, VRING1_ID, 0},
+
+#if (OPENAMP_CHANNEL_NUM > 1)
+    /* 其余通道的virtio设备，mica为每个vdev创建一条独立的rpmsg总线 */
+    .chans = {
+        RSC_TABLE_CHAN_ENTRY(1),
+#if (OPENAMP_CHANNEL_NUM > 2)
+        RSC_TABLE_CHAN_ENTRY(2),
+#endif
+#if (OPENAMP_CHANNEL_NUM > 3)
+        RSC_TABLE_CHAN_ENTRY(3),
+#endif
+    },
+#endif
 };
 
 void rsc_table_get(void **table_ptr, int *length)
@@ -40,7 +40,8 @@ enum rsc_table_entries {
     RSC_TABLE_RBUF_ENTRY,
 #endif
     RSC_TABLE_VDEV_ENTRY,
-    RSC_TABLE_NUM_ENTRY
+    /* 通道1及以后的vdev紧跟通道0的vdev */
+    RSC_TABLE_NUM_ENTRY = RSC_TABLE_VDEV_ENTRY + OPENAMP_CHANNEL_NUM
 };
 
 METAL_PACKED_BEGIN
@@ -86,6 +87,17 @@ extern uint8_t get_rbuf_state(void);
 
 #endif
 
+/* 通道1及以后的virtio设备，布局与通道0的vdev、vring0、vring1相同 */
+METAL_PACKED_BEGIN
+struct fw_rsc_vdev_chan {
+    struct fw_rsc_vdev vdev;
+    struct fw_rsc_vdev_vring vring0;
+    struct fw_rsc_vdev_vring vring1;
+} METAL_PACKED_END;
+
+/* 通道n的vring0、vring1、vdev通知号依次为3n、3n+1、3n+2，通道0与单通道时一致 */
+#define RSC_CHAN_NOTIFY_ID(n, id)  (3 * (n) + (id))
+
 METAL_PACKED_BEGIN
 struct fw_resource_table {
     unsigned int ver;
@@ -100,6 +112,9 @@ struct fw_resource_table {
     struct fw_rsc_vdev vdev;
     struct fw_rsc_vdev_vring vring0;
     struct fw_rsc_vdev_vring vring1;
+#if (OPENAMP_CHANNEL_NUM > 1)
+    struct fw_rsc_vdev_chan chans[OPENAMP_CHANNEL_NUM - 1];
+#endif
 
 } METAL_PACKED_END;
 
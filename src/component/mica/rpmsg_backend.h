@@ -31,20 +31,27 @@ extern int rpmsg_service_init(void);
 extern void (*g_rpmsg_ipi_handler)(void);
 
 /**
- * rpmsg_backend_init - register rpmsg-virtio-device.
+ * rpmsg_backend_init - register rpmsg-virtio-device of every channel.
  *
- * Return: pointer of rpmsg_device(rpdev) on success, NULL on failure.
+ * Return: pointer of channel 0 rpmsg_device(rpdev) on success, NULL on failure.
  */
 extern struct rpmsg_device *rpmsg_backend_init(void);
 
+/**
+ * rpmsg_backend_get_device - get the rpmsg_device of a channel
+ *
+ * Return: pointer of rpmsg_device(rpdev), NULL if chan is out of range.
+ */
+extern struct rpmsg_device *rpmsg_backend_get_device(unsigned int chan);
+
 /**
  * rpmsg_backend_remove - remove the backend
  */
 extern void rpmsg_backend_remove(void);
 /**
- * receive_message - Call it to receive messages from host(linux)
+ * receive_message - Call it to receive messages of a channel from host(linux)
  */
-extern void receive_message(void);
+extern void receive_message(unsigned int chan);
 
 /* 下线时，设置rsc_table的reserved[1]为CPU_OFF_FUNCID，告诉mica侧更新状态 */
 extern void rsc_table_set_offline_flag(void);
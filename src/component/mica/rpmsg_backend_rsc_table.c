@@ -33,9 +33,15 @@
 #define CPU_OFF_FUNCID   0x84000002
 #define SYSTEM_RESET     0x84000009
 
-static SemHandle msg_sem;
-static struct virtio_device *vdev;
-static struct rpmsg_virtio_device rvdev;
+/* 每个通道独占一个virtio设备，virtqueue和rpmsg设备锁都不跨通道共享 */
+struct rpmsg_backend_chan {
+    SemHandle msg_sem;
+    uint32_t rx_notifyid;
+    struct virtio_device *vdev;
+    struct rpmsg_virtio_device rvdev;
+};
+
+static struct rpmsg_backend_chan g_chans[OPENAMP_CHANNEL_NUM];
 
 static metal_phys_addr_t shm_physmap[] = { VDEV_START_ADDR };
 static struct metal_device shm_device = {
@@ -58,18 +64,33 @@ static struct metal_device shm_device = {
     .irq_info = NULL
 };
 
-static inline struct fw_rsc_vdev *rsc_table_to_vdev(void *rsc_table)
+static inline struct fw_rsc_vdev *rsc_table_to_vdev(void *rsc_table, unsigned int chan)
 {
+#if (OPENAMP_CHANNEL_NUM > 1)
+    if (chan != 0) {
+        return &((struct fw_resource_table *)rsc_table)->chans[chan - 1].vdev;
+    }
+#endif
     return &((struct fw_resource_table *)rsc_table)->vdev;
 }
 
-static inline struct fw_rsc_vdev_vring *rsc_table_get_vring0(void *rsc_table)
+static inline struct fw_rsc_vdev_vring *rsc_table_get_vring0(void *rsc_table, unsigned int chan)
 {
+#if (OPENAMP_CHANNEL_NUM > 1)
+    if (chan != 0) {
+        return &((struct fw_resource_table *)rsc_table)->chans[chan - 1].vring0;
+    }
+#endif
     return &((struct fw_resource_table *)rsc_table)->vring0;
 }
 
-static inline struct fw_rsc_vdev_vring *rsc_table_get_vring1(void *rsc_table)
+static inline struct fw_rsc_vdev_vring *rsc_table_get_vring1(void *rsc_table, unsigned int chan)
 {
+#if (OPENAMP_CHANNEL_NUM > 1)
+    if (chan != 0) {
+        return &((struct fw_resource_table *)rsc_table)->chans[chan - 1].vring1;
+    }
+#endif
     return &((struct fw_resource_table *)rsc_table)->vring1;
 }
 
@@ -94,9 +115,9 @@ static int virtio_notify(void *priv, uint32_t id)
     return 0;
 }
 
-static void reset_vq(void)
+static void reset_vq(struct rpmsg_virtio_device *rvdev)
 {
-    if (rvdev.svq != NULL) {
+    if (rvdev->svq != NULL) {
         /*
          * For svq:
          * vq_free_cnt: Set to vq_nentries, all descriptors in the svq are available.
@@ -107,27 +128,27 @@ static void reset_vq(void)
          * vq_used_cons_idx: No descriptors have been added to the used ring.
          * vq_ring.avail->idx and vq_ring.used->idx will be set at host.
          */
-        rvdev.svq->vq_free_cnt = rvdev.svq->vq_nentries;
-        rvdev.svq->vq_queued_cnt = 0;
-        rvdev.svq->vq_desc_head_idx = 0;
-        rvdev.svq->vq_available_idx = 0;
-        rvdev.svq->vq_used_cons_idx = 0;
+        rvdev->svq->vq_free_cnt = rvdev->svq->vq_nentries;
+        rvdev->svq->vq_queued_cnt = 0;
+        rvdev->svq->vq_desc_head_idx = 0;
+        rvdev->svq->vq_available_idx = 0;
+        rvdev->svq->vq_used_cons_idx = 0;
     }
 
-    if (rvdev.rvq != NULL) {
+    if (rvdev->rvq != NULL) {
         /*
          * For rvq:
          * Because host resets its tx vq, on the remote side,
          * it also needs to reset the rx rq.
          */
-        rvdev.rvq->vq_available_idx = 0;
-        rvdev.rvq->vq_used_cons_idx = 0;
-        rvdev.rvq->vq_ring.used->idx = 0;
-        rvdev.rvq->vq_ring.avail->idx = 0;
-        metal_cache_flush(&(rvdev.rvq->vq_ring.used->idx),
-                          sizeof(rvdev.rvq->vq_ring.used->idx));
-        metal_cache_flush(&(rvdev.rvq->vq_ring.avail->idx),
-                          sizeof(rvdev.rvq->vq_ring.avail->idx));
+        rvdev->rvq->vq_available_idx = 0;
+        rvdev->rvq->vq_used_cons_idx = 0;
+        rvdev->rvq->vq_ring.used->idx = 0;
+        rvdev->rvq->vq_ring.avail->idx = 0;
+        metal_cache_flush(&(rvdev->rvq->vq_ring.used->idx),
+                          sizeof(rvdev->rvq->vq_ring.used->idx));
+        metal_cache_flush(&(rvdev->rvq->vq_ring.avail->idx),
+                          sizeof(rvdev->rvq->vq_ring.avail->idx));
     }
 }
 
@@ -136,6 +157,7 @@ static void rpmsg_ipi_handler(void)
     void *rsc;
     int rsc_size;
     uint32_t status;
+    unsigned int chan;
     struct fw_resource_table *rsc_table;
 
     rsc_table_get(&rsc, &rsc_size);
@@ -153,11 +175,15 @@ static void rpmsg_ipi_handler(void)
     }
 #endif
     if (status == CPU_ON_FUNCID || status == 0) {
-        /* normal work */
-        PRT_SemPost(msg_sem);
+        /* normal work: 通知不携带vring号，唤醒各通道的收包任务检查自己的vring */
+        for (chan = 0; chan < OPENAMP_CHANNEL_NUM; chan++) {
+            PRT_SemPost(g_chans[chan].msg_sem);
+        }
     } else if (status == SYSTEM_RESET) {
         /* attach work: reset virtqueue */
-        reset_vq();
+        for (chan = 0; chan < OPENAMP_CHANNEL_NUM; chan++) {
+            reset_vq(&g_chans[chan].rvdev);
+        }
         /* clear reserved[0] as the reset work is done */
         rsc_table->reserved[0] = 0;
         os_asm_invalidate_dcache_all();
@@ -187,12 +213,12 @@ void rsc_table_set_offline_flag(void)
     os_asm_invalidate_dcache_all();
 }
 
-void receive_message(void)
+void receive_message(unsigned int chan)
 {
-    U32 ret = PRT_SemPend(msg_sem, OS_WAIT_FOREVER);
+    U32 ret = PRT_SemPend(g_chans[chan].msg_sem, OS_WAIT_FOREVER);
 
     if (ret == OS_OK)
-        rproc_virtio_notified(vdev, VRING1_ID);
+        rproc_virtio_notified(g_chans[chan].vdev, g_chans[chan].rx_notifyid);
 }
 
 static void rpmsg_ipi_init(void)
@@ -206,14 +232,14 @@ NULL);
 }
 
 struct virtio_device *
-platform_create_vdev(void *rsc_table, struct metal_io_region *rsc_io)
+platform_create_vdev(void *rsc_table, struct metal_io_region *rsc_io, unsigned int chan)
 {
     struct fw_rsc_vdev_vring *vring_rsc;
     struct virtio_device *vdev;
     int ret;
 
     vdev = rproc_virtio_create_vdev(VIRTIO_DEV_DEVICE, VDEV_ID,
-                    rsc_table_to_vdev(rsc_table),
+                    rsc_table_to_vdev(rsc_table, chan),
                     rsc_io, NULL, virtio_notify, NULL);
     if (!vdev)
         return NULL;
@@ -221,8 +247,8 @@ platform_create_vdev(void *rsc_table, struct metal_io_region *rsc_io)
     /* wait master rpmsg init completion */
     rproc_virtio_wait_remote_ready(vdev);
 
-    vring_rsc = rsc_table_get_vring0(rsc_table);
-    PRT_Printf("[openamp]: get vring0: da %lx\n", vring_rsc->da);
+    vring_rsc = rsc_table_get_vring0(rsc_table, chan);
+    PRT_Printf("[openamp]: chan %u get vring0: da %lx\n", chan, vring_rsc->da);
 
     ret = rproc_virtio_init_vring(vdev, 0, vring_rsc->notifyid,
                       (void *)(uintptr_t)vring_rsc->da, rsc_io,
@@ -230,8 +256,8 @@ platform_create_vdev(void *rsc_table, struct metal_io_region *rsc_io)
     if (ret)
         goto failed;
 
-    vring_rsc = rsc_table_get_vring1(rsc_table);
-    PRT_Printf("[openamp]: get vring1: da %lx\n", vring_rsc->da);
+    vring_rsc = rsc_table_get_vring1(rsc_table, chan);
+    PRT_Printf("[openamp]: chan %u get vring1: da %lx\n", chan, vring_rsc->da);
 
     ret = rproc_virtio_init_vring(vdev, 1, vring_rsc->notifyid,
                       (void *)(uintptr_t)vring_rsc->da, rsc_io,
@@ -239,6 +265,7 @@ platform_create_vdev(void *rsc_table, struct metal_io_region *rsc_io)
     if (ret)
         goto failed;
 
+    g_chans[chan].rx_notifyid = vring_rsc->notifyid;
     return vdev;
 
 failed:
@@ -262,19 +289,23 @@ struct rpmsg_device *rpmsg_backend_init(void)
     int32_t err;
     struct metal_init_params metal_params = METAL_INIT_DEFAULTS;
     struct metal_device *device;
-
-    rpmsg_ipi_init();
-    err = PRT_SemCreate(0, &msg_sem);
-    if (err) {
-        PRT_Printf("[openamp] SemCreate failed %d\n", err);
-        goto cleanup_ipi;
+    unsigned int chan;
+    unsigned int ready = 0;
+
+    for (chan = 0; chan < OPENAMP_CHANNEL_NUM; chan++) {
+        err = PRT_SemCreate(0, &g_chans[chan].msg_sem);
+        if (err) {
+            PRT_Printf("[openamp] SemCreate failed %d\n", err);
+            goto cleanup_sem;
+        }
     }
+    rpmsg_ipi_init();
 
     /* Libmetal setup */
     err = metal_init(&metal_params);
     if (err) {
         PRT_Printf("[openamp] metal_init failed %d\n", err);
-        goto cleanup_ipi;
+        goto cleanup_sem;
     }
 
     err = metal_register_generic_device(&shm_device);
@@ -310,36 +341,61 @@ struct rpmsg_device *rpmsg_backend_init(void)
         goto cleanup_metal;
     }
 
-    /* virtio device setup */
-    vdev = platform_create_vdev(rsc_table, rsc_io);
-    if (!vdev) {
-        PRT_Printf("[openamp] create virtio device failed %d\n", err);
-        goto cleanup_metal;
+    for (; ready < OPENAMP_CHANNEL_NUM; ready++) {
+        /* virtio device setup */
+        g_chans[ready].vdev = platform_create_vdev(rsc_table, rsc_io, ready);
+        if (!g_chans[ready].vdev) {
+            PRT_Printf("[openamp] create virtio device %u failed\n", ready);
+            goto cleanup_vdev;
+        }
+
+        /* setup rvdev */
+        err = rpmsg_init_vdev_with_config(&g_chans[ready].rvdev, g_chans[ready].vdev, NULL, shm_io, NULL,
+                                          RPMSG_VIRTIO_CONSOLE_CONFIG);
+        if (err) {
+            PRT_Printf("[openamp] rpmsg_init_vdev_with_config failed %d\n", err);
+            rproc_virtio_remove_vdev(g_chans[ready].vdev);
+            goto cleanup_vdev;
+        }
     }
 
-    /* setup rvdev */
-    err = rpmsg_init_vdev_with_config(&rvdev, vdev, NULL, shm_io, NULL, RPMSG_VIRTIO_CONSOLE_CONFIG);
-    if (err) {
-        PRT_Printf("[openamp] rpmsg_init_vdev_with_config failed %d\n", err);
-        goto cleanup_vdev;
-    }
-
-    return rpmsg_virtio_get_rpmsg_device(&rvdev);
+    return rpmsg_virtio_get_rpmsg_device(&g_chans[0].rvdev);
 
 cleanup_vdev:
-    rproc_virtio_remove_vdev(vdev);
+    while (ready > 0) {
+        ready--;
+        rpmsg_deinit_vdev(&g_chans[ready].rvdev);
+        rproc_virtio_remove_vdev(g_chans[ready].vdev);
+    }
 cleanup_metal:
     metal_finish();
-cleanup_ipi:
-    PRT_SemDelete(msg_sem);
+cleanup_sem:
+    while (chan > 0) {
+        chan--;
+        PRT_SemDelete(g_chans[chan].msg_sem);
+    }
     return NULL;
 }
 
+struct rpmsg_device *rpmsg_backend_get_device(unsigned int chan)
+{
+    if (chan >= OPENAMP_CHANNEL_NUM) {
+        return NULL;
+    }
+    return rpmsg_virtio_get_rpmsg_device(&g_chans[chan].rvdev);
+}
+
 void rpmsg_backend_remove(void)
 {
-    rpmsg_deinit_vdev(&rvdev);
-    rproc_virtio_remove_vdev(vdev);
+    unsigned int chan;
+
+    for (chan = 0; chan < OPENAMP_CHANNEL_NUM; chan++) {
+        rpmsg_deinit_vdev(&g_chans[chan].rvdev);
+        rproc_virtio_remove_vdev(g_chans[chan].vdev);
+    }
     metal_finish();
-    PRT_SemDelete(msg_sem);
+    for (chan = 0; chan < OPENAMP_CHANNEL_NUM; chan++) {
+        PRT_SemDelete(g_chans[chan].msg_sem);
+    }
     /* TODO: disable openamp ipi */
 }
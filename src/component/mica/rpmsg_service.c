@@ -14,6 +14,7 @@
 
 #include "rpmsg_backend.h"
 #include "prt_sem.h"
+#include "prt_task.h"
 #include "prt_proxy_ext.h"
 #include "pthread.h"
 #include "stdio.h"
@@ -44,11 +45,17 @@ extern int rpmsg_client_cb(struct rpmsg_endpoint *ept,
                uint32_t src, void *priv);
 extern void rpmsg_set_default_ept(struct rpmsg_endpoint *ept);
 
-/* RPMsg tty */
+/* RPMsg tty，每个通道各有一个tty端点，Linux侧对应各自的ttyRPMSG设备 */
 #define RPMSG_TTY_EPT_NAME "rpmsg-tty"
-static SemHandle tty_sem;
-static struct rpmsg_endpoint tty_ept;
-static struct rpmsg_rcv_msg tty_msg;
+struct rpmsg_tty_chan {
+    unsigned int id;
+    SemHandle sem;
+    struct rpmsg_device *rpdev;
+    struct rpmsg_endpoint ept;
+    struct rpmsg_rcv_msg msg;
+    struct PrtSpinLock lock;
+};
+static struct rpmsg_tty_chan g_tty_chans[OPENAMP_CHANNEL_NUM];
 
 /* RPMsg umt */
 #define RPMSG_UMT_EPT_NAME "rpmsg-umt"
@@ -61,32 +68,58 @@ static U64 g_umt_send_data_addr;
 char *g_s1 = "Hello, UniProton! \r\n";
 extern char *g_printf_buffer;
 
-static struct PrtSpinLock g_ttyLock;
-
 static void rpmsg_service_unbind(struct rpmsg_endpoint *ep)
 {
     rpmsg_destroy_ept(ep);
 }
 
+/* 各核使用自己的通道发送，通道的tty尚未就绪时退回通道0 */
+static struct rpmsg_tty_chan *rpmsg_tty_chan_get(void)
+{
+#if (OPENAMP_CHANNEL_NUM > 1)
+    struct rpmsg_tty_chan *chan = &g_tty_chans[PRT_GetCoreID() % OPENAMP_CHANNEL_NUM];
+
+    if (is_rpmsg_ept_ready(&chan->ept)) {
+        return chan;
+    }
+#endif
+    return &g_tty_chans[0];
+}
+
+/* 通道的收包及tty任务绑定到通道号对应的核 */
+static void rpmsg_chan_bind_core(unsigned int chan)
+{
+#if (OPENAMP_CHANNEL_NUM > 1)
+    TskHandle self;
+
+    if (PRT_TaskSelf(&self) == OS_OK) {
+        (void)PRT_TaskCoreBind(self, 1U << chan);
+    }
+#else
+    (void)chan;
+#endif
+}
+
 unsigned int is_tty_ready(void)
 {
-    return is_rpmsg_ept_ready(&tty_ept);
+    return is_rpmsg_ept_ready(&rpmsg_tty_chan_get()->ept);
 }
 
 int send_message(unsigned char *message, int len)
 {
     int ret;
     uintptr_t intSave;
+    struct rpmsg_tty_chan *chan = rpmsg_tty_chan_get();
 
-    if (!is_rpmsg_ept_ready(&tty_ept)) {
+    if (!is_rpmsg_ept_ready(&chan->ept)) {
         return 0;
     }
 #if defined(OS_OPTION_SMP)
-    intSave = PRT_SplIrqLock(&g_ttyLock);
+    intSave = PRT_SplIrqLock(&chan->lock);
 #endif
-    ret = rpmsg_send(&tty_ept, message, len);
+    ret = rpmsg_send(&chan->ept, message, len);
 #if defined(OS_OPTION_SMP)
-    PRT_SplIrqUnlock(&g_ttyLock, intSave);
+    PRT_SplIrqUnlock(&chan->lock, intSave);
 #endif
     return ret;
 }
@@ -110,12 +143,12 @@ err:
 static int rpmsg_rx_tty_callback(struct rpmsg_endpoint *ept, void *data,
                    size_t len, uint32_t src, void *priv)
 {
-    struct rpmsg_rcv_msg *tty_msg = priv;
+    struct rpmsg_tty_chan *chan = priv;
 
     rpmsg_hold_rx_buffer(ept, data);
-    tty_msg->data = data;
-    tty_msg->len = len;
-    PRT_SemPost(tty_sem);
+    chan->msg.data = data;
+    chan->msg.len = len;
+    PRT_SemPost(chan->sem);
 
     return 0;
 }
@@ -127,17 +160,21 @@ static void *rpmsg_tty_task(void *arg)
     char tx_buff[512];
 #endif
     char *tty_data;
+    struct rpmsg_tty_chan *chan = arg;
+    struct rpmsg_endpoint *tty_ept = &chan->ept;
+    struct rpmsg_rcv_msg *tty_msg = &chan->msg;
 
-    ret = PRT_SemCreate(0, &tty_sem);
+    rpmsg_chan_bind_core(chan->id);
+    ret = PRT_SemCreate(0, &chan->sem);
     if (ret != OS_OK) {
         PRT_Printf("[openamp] failed to create tty sem\n");
         goto err;
     }
 
-    PRT_Printf("[openamp] tty task started\n");
+    PRT_Printf("[openamp] tty task %u started\n", chan->id);
 
-    tty_ept.priv = &tty_msg;
-    ret = rpmsg_create_ept(&tty_ept, rpdev, RPMSG_TTY_EPT_NAME,
+    tty_ept->priv = chan;
+    ret = rpmsg_create_ept(tty_ept, chan->rpdev, RPMSG_TTY_EPT_NAME,
                    RPMSG_ADDR_ANY, RPMSG_ADDR_ANY,
                    rpmsg_rx_tty_callback, NULL);
     if (ret != 0) {
@@ -145,34 +182,34 @@ static void *rpmsg_tty_task(void *arg)
         goto err;
     }
 
-    while (tty_ept.addr !=  RPMSG_ADDR_ANY) {
-        PRT_SemPend(tty_sem, OS_WAIT_FOREVER);
-        if (tty_msg.len) {
-            tty_data = (char *)tty_msg.data;
-            tty_data[tty_msg.len] = '\0';
+    while (tty_ept->addr !=  RPMSG_ADDR_ANY) {
+        PRT_SemPend(chan->sem, OS_WAIT_FOREVER);
+        if (tty_msg->len) {
+            tty_data = (char *)tty_msg->data;
+            tty_data[tty_msg->len] = '\0';
             #ifdef LOSCFG_SHELL_MICA_INPUT
                 ShellCB *shellCb = OsGetShellCB();
                 if (shellCb == NULL) {
                     send_message((void *)g_s1, strlen(g_s1) * sizeof(char));
                 } else {
-                    for(int i = 0; i < tty_msg.len; i++){
+                    for(int i = 0; i < tty_msg->len; i++){
                         char c = tty_data[i];
                         ShellCmdLineParse(c, (pf_OUTPUT)printf, shellCb);
                     }
                 }
             #else
                 ret = snprintf(tx_buff, 512, "Hello, UniProton! Recv: %s\r\n", tty_data);
-                rpmsg_send(&tty_ept, tx_buff, ret);
+                rpmsg_send(tty_ept, tx_buff, ret);
             #endif
-                rpmsg_release_rx_buffer(&tty_ept, tty_msg.data);
+                rpmsg_release_rx_buffer(tty_ept, tty_msg->data);
 
         }
-        tty_msg.len = 0;
-        tty_msg.data = NULL;
+        tty_msg->len = 0;
+        tty_msg->data = NULL;
 
         /* TODO: add lifecycle */
     }
-    rpmsg_destroy_ept(&tty_ept);
+    rpmsg_destroy_ept(tty_ept);
 err:
     pthread_exit(NULL);
 }
@@ -219,9 +256,12 @@ err:
 
 static void *rpmsg_listen_task(void *arg)
 {
+    unsigned int chan = (unsigned int)(uintptr_t)arg;
+
+    rpmsg_chan_bind_core(chan);
     /* Waiting for messages from host */
     while (1) {
-        receive_message();
+        receive_message(chan);
         /* TODO: add lifecycle */
     }
     return NULL;
@@ -290,6 +330,7 @@ int send_data_to_nrtos(void *send_data, int data_len)
 int rpmsg_service_init(void)
 {
     int ret0, ret1, ret2, ret3;
+    unsigned int chan;
     pthread_attr_t attr;
     pthread_t rpc_thread, tty_thread, listen_thread, umt_thread;
 
@@ -311,24 +352,34 @@ int rpmsg_service_init(void)
         goto err;
     }
 
-    /* create rpmsg task */
+    for (chan = 0; chan < OPENAMP_CHANNEL_NUM; chan++) {
+        g_tty_chans[chan].id = chan;
+        g_tty_chans[chan].rpdev = rpmsg_backend_get_device(chan);
+        /* 端点创建前视为未就绪，其他核的输出退回通道0 */
+        g_tty_chans[chan].ept.addr = RPMSG_ADDR_ANY;
+        g_tty_chans[chan].ept.dest_addr = RPMSG_ADDR_ANY;
+#if defined(OS_OPTION_SMP)
+        if (PRT_SplLockInit(&g_tty_chans[chan].lock)) {
+            pthread_attr_destroy(&attr);
+            PRT_Printf("[openamp] spin lock init fail\n");
+            return OS_ERROR;
+        }
+#endif
+    }
+
+    /* create rpmsg task, rpc和umt只在通道0上，tty及收包任务每个通道一个 */
     ret0 = pthread_create(&rpc_thread, &attr, rpmsg_rpc_task, NULL);
-    ret1 = pthread_create(&tty_thread, &attr, rpmsg_tty_task, NULL);
-    ret2 = pthread_create(&listen_thread, &attr, rpmsg_listen_task, NULL);
     ret3 = pthread_create(&umt_thread, &attr, rpmsg_umt_task, NULL);
+    for (chan = 0, ret1 = 0, ret2 = 0; chan < OPENAMP_CHANNEL_NUM && ret1 == 0 && ret2 == 0; chan++) {
+        ret1 = pthread_create(&tty_thread, &attr, rpmsg_tty_task, &g_tty_chans[chan]);
+        ret2 = pthread_create(&listen_thread, &attr, rpmsg_listen_task, (void *)(uintptr_t)chan);
+    }
     pthread_attr_destroy(&attr);
     if (ret0 != 0 || ret1 != 0 || ret2 != 0 || ret3 != 0) {
         /* If no rpmsg tasks, release the backend. */
         PRT_Printf("[openamp] create task fail, %d/%d/%d/%d\n", ret0, ret1, ret2, ret3);
         goto err;
     }
-#if defined(OS_OPTION_SMP)
-    ret0 = PRT_SplLockInit(&g_ttyLock);
-    if (ret0) {
-        PRT_Printf("[openamp] spin lock init fail\n");
-        return OS_ERROR;
-    }
-#endif
 
     while (!is_rpmsg_ept_ready(&rpc_ept)) {
         PRT_TaskDelay(100);
@@ -343,6 +394,13 @@ int rpmsg_service_init(void)
     rpmsg_set_default_ept(&rpc_ept);
     g_printf_buffer = (char *)malloc(PRINTF_BUFFER_LEN);
 
+#if defined(MMU_OPENAMP_BULK_ADDR) && defined(OPENAMP_BULK_SHM_SIZE)
+    /* 代理大块读写的共享内存由单板配置，协商失败不影响代理的内联拷贝 */
+    if (PRT_ProxyBulkInit((void *)MMU_OPENAMP_BULK_ADDR, MMU_OPENAMP_BULK_ADDR, OPENAMP_BULK_SHM_SIZE) != 0) {
+        PRT_Printf("[openamp] proxy bulk shm disabled\n");
+    }
+#endif
+
     return OS_OK;
 
 err:
@@ -8,6 +8,12 @@
 #define MAX_NODE_SIZE 2048
 #define MAX_NODE_NUM 10
 #define WORKERS 2
+/* 多个worker共用请求队列时每次只取一个请求，避免慢请求阻塞同批的其它请求而另一个worker空闲 */
+#if WORKERS > 1
+#define WORKER_BATCH_NUM 1
+#else
+#define WORKER_BATCH_NUM 4
+#endif
 #define CMD_CLIENT_PRIORITY 9
 
 extern U32 g_cmd_req_queue;
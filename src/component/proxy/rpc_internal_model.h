@@ -80,6 +80,7 @@
 #define MKDIR_ID          55UL
 #define RMDIR_ID          56UL
 #define FSCANFX_ID        57UL
+#define BULKSHM_ID        58UL
 
 #define FREEADDRINFO_ID    100UL
 #define GETADDRINFO_ID     101UL
@@ -281,6 +282,19 @@ typedef rpc_write_resp_t rpc_ncpywrite_resp_t;
 
 typedef rpc_write_outp_t rpc_ncpywrite_outp_t;
 
+/* bulk shared memory, ncpyread/ncpywrite的baddr_offset相对该区域起始地址 */
+typedef struct rpc_bulkshm_req {
+    unsigned long func_id;
+    uint32_t trace_id;
+    uint32_t block_size;
+    unsigned long long phys_addr;
+    unsigned long long size;
+} rpc_bulkshm_req_t;
+
+typedef rpc_common_resp_t rpc_bulkshm_resp_t;
+
+typedef rpc_common_outp_t rpc_bulkshm_outp_t;
+
 /* close */
 typedef struct rpc_close_req {
     unsigned long func_id;
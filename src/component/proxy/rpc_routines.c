@@ -25,6 +25,7 @@
 #include <openamp/rpmsg_rpc_client_server.h>
 
 #include "prt_hwi.h"
+#include "prt_sem.h"
 #include "securec.h"
 #include "rpc_internal_common.h"
 #include "rpc_internal_model.h"
@@ -99,6 +100,9 @@
 #define MAX_RECORDS 128
 #define MAX_FDS 20
 
+#define PROXY_BULK_BLOCK_SIZE 0x10000U
+#define PROXY_BULK_MAX_BLOCKS 64U
+
 #define WEAK_ALIAS(old, new) \
     extern __typeof(old) new __attribute__((__weak__, __alias__(#old)))
 
@@ -117,8 +121,28 @@ typedef struct rpc_record {
     bool in_use;
     void *outp;
     resp2outp_fn cb;
+    /* 同步调用阻塞在槽位信号量上，首次使用槽位时创建，创建失败时退化为让出CPU轮询 */
+    bool has_sem;
+    SemHandle sem;
+    /* 异步调用的完成回调，输出参数保存在槽位内，调用者无需保留栈上的outp */
+    PRT_ProxyAsyncCb async_cb;
+    void *async_arg;
+    union {
+        rpc_read_outp_t read;
+        rpc_recv_outp_t recv;
+        rpc_csret_outp_t csret;
+    } async_outp;
 } rpc_record_t;
 
+/* 大块读写使用的共享内存区，按固定大小分块，空闲位图无锁分配 */
+typedef struct rpc_bulk_ctl {
+    uint8_t *base;
+    uint32_t block_size;
+    uint32_t block_num;
+    uint64_t free_map;
+    bool ready;
+} rpc_bulk_ctl_t;
+
 typedef struct rpc_records_ctl {
     rpc_record_t *const records;
     int *const status;
@@ -141,6 +165,7 @@ static rpc_records_ctl_t g_default_ctl = {
     .lock = PTHREAD_MUTEX_INITIALIZER
 };
 static rpc_records_ctl_t *g_records_ctl = &g_default_ctl;
+static rpc_bulk_ctl_t g_bulk;
 static char *g_s1 = "Hello, UniProton! \r\n";
 
 static int alloc_slot()
@@ -161,6 +186,10 @@ static int alloc_slot()
             record->trace_id = counter;
             record->outp = NULL;
             record->cb = NULL;
+            record->async_cb = NULL;
+            if (!record->has_sem) {
+                record->has_sem = (PRT_SemCreate(0, &record->sem) == OS_OK);
+            }
             g_records_ctl->trace_counter = counter + 1;
             break;
         }
@@ -181,6 +210,22 @@ static int new_slot(void *outp)
     return idx;
 }
 
+static int new_async_slot(PRT_ProxyAsyncCb cb, void *arg)
+{
+    int idx = alloc_slot();
+
+    if (idx < 0) {
+        return -RPC_ENO_SLOT;
+    }
+    (void)memset_s(&RECORD_AT(idx).async_outp, sizeof(RECORD_AT(idx).async_outp), 0,
+        sizeof(RECORD_AT(idx).async_outp));
+    RECORD_AT(idx).outp = &RECORD_AT(idx).async_outp;
+    RECORD_AT(idx).async_cb = cb;
+    RECORD_AT(idx).async_arg = arg;
+
+    return idx;
+}
+
 static inline int tid2si(int trace_id)
 {
     return trace_id & (g_records_ctl->len - 1);
@@ -198,14 +243,15 @@ static int free_slot(int idx)
     return 0;
 }
 
+/* 状态由接收任务写、请求任务读，release/acquire保证看到READY时outp已经填好 */
 static void set_status(int idx, int status)
 {
-    g_record_status[idx] = status;
+    __atomic_store_n(&g_record_status[idx], status, __ATOMIC_RELEASE);
 }
 
 static bool not_ready(int idx)
 {
-    return g_record_status[idx] != STATUS_READY;
+    return __atomic_load_n(&g_record_status[idx], __ATOMIC_ACQUIRE) != STATUS_READY;
 }
 
 static void common_cb(int status, void *data, size_t len)
@@ -221,6 +267,11 @@ static void common_cb(int status, void *data, size_t len)
     int trace_id = base->trace_id;
     idx = tid2si(trace_id);
     dprintf("tid:%d", trace_id);
+    /* 槽位已释放或被新请求复用时丢弃过期应答 */
+    if (!RECORD_AT(idx).in_use || RECORD_AT(idx).trace_id != (uint32_t)trace_id ||
+        !not_ready(idx)) {
+        return;
+    }
     obase = RECORD_AT(idx).outp;
     cb = RECORD_AT(idx).cb;
     if (obase != NULL && base->errnum != 0) {
@@ -229,8 +280,25 @@ static void common_cb(int status, void *data, size_t len)
     if (cb != NULL) {
         cb(data, obase);
     }
+
+    if (RECORD_AT(idx).async_cb != NULL) {
+        /* 先取出回调和结果再释放槽位，回调内可以立即提交下一个请求 */
+        PRT_ProxyAsyncCb async_cb = RECORD_AT(idx).async_cb;
+        void *async_arg = RECORD_AT(idx).async_arg;
+        ssize_t ret = RECORD_AT(idx).async_outp.csret.ret;
+        int errnum = obase->errnum;
+
+        set_status(idx, STATUS_READY);
+        free_slot(idx);
+        async_cb(ret, errnum, async_arg);
+        return;
+    }
+
     /* to clear the flag set in the caller function */
     set_status(idx, STATUS_READY);
+    if (RECORD_AT(idx).has_sem) {
+        (void)PRT_SemPost(RECORD_AT(idx).sem);
+    }
 }
 
 static fileHandle file2handle(FILE *f)
@@ -614,10 +682,26 @@ int rpmsg_client_cb(struct rpmsg_endpoint *ept,
 #ifdef OS_SUPPORT_IGH_ETHERCAT
     if (is_valid_cmd_func_id(msg->id)) {
         cmd_base_req_t *cmd_req = (cmd_base_req_t *)&(msg->params[0]);
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+        /* rpmsg接收缓冲区需要归还，请求只拷贝一次到借出的缓冲区，入队只传递指针 */
+        void *buf = NULL;
+        U32 size = len - MAX_FUNC_ID_LEN;
+        U32 ret = PRT_QueueLoan(g_cmd_req_queue, size, &buf);
+        if (ret != OS_OK) {
+            return RPMSG_ERR_NO_MEM;
+        }
+        (void)memcpy_s(buf, size, cmd_req, size);
+        ret = PRT_QueueCommit(g_cmd_req_queue, buf, size, 0, OS_QUEUE_NORMAL);
+        if (ret != OS_OK) {
+            (void)PRT_QueueRelease(g_cmd_req_queue, buf);
+            return RPMSG_ERR_NO_MEM;
+        }
+#else
         U32 ret = PRT_QueueWrite(g_cmd_req_queue, cmd_req, len - MAX_FUNC_ID_LEN, 0, OS_QUEUE_NORMAL);
         if (ret != OS_OK) {
             return RPMSG_ERR_NO_MEM;
         }
+#endif
         return RPMSG_SUCCESS;
     }
 #endif
@@ -631,7 +715,7 @@ int rpmsg_client_cb(struct rpmsg_endpoint *ept,
     return RPMSG_SUCCESS;
 }
 
-static int wait4resp(int slot_idx, void *data, size_t size)
+static int send_req(int slot_idx, void *data, size_t size)
 {
     int ret = 0;
 
@@ -649,13 +733,34 @@ static int wait4resp(int slot_idx, void *data, size_t size)
         dprintf("sendfail:%d\n", ret);
         return ret;
     }
-    /* waiting to get response from endpoint callback */
+    return 0;
+}
+
+static int wait4resp(int slot_idx, void *data, size_t size)
+{
+    int ret = send_req(slot_idx, data, size);
+
+    CHECK_RET(ret)
+    /* 每个请求的应答只post一次且在置READY之后，应答先到时信号量已有计数，pend立即返回 */
+    if (RECORD_AT(slot_idx).has_sem) {
+        (void)PRT_SemPend(RECORD_AT(slot_idx).sem, OS_WAIT_FOREVER);
+    }
+    /* waiting to get response from endpoint callback, pend失败时退化为让出CPU轮询 */
     while (not_ready(slot_idx)) {
         sched_yield();
     }
     return 0;
 }
 
+/*
+ * 异步请求发送后立即返回，应答由rpmsg接收任务调用common_cb处理，
+ * 槽位在调用完成回调前释放，因此同时在途的请求数受MAX_RECORDS限制。
+ */
+static int submit_async(int slot_idx, void *data, size_t size)
+{
+    return send_req(slot_idx, data, size);
+}
+
 static int __open(const char *filename, int flags, unsigned mode)
 {
     DEFINE_COMMON_RPC_VAR(open)
@@ -699,15 +804,170 @@ int PRT_ProxyOpen(const char *filename, int flags, ...)
     return __open(filename, flags, mode);
 }
 
+static bool bulk_ready(void)
+{
+    return __atomic_load_n(&g_bulk.ready, __ATOMIC_ACQUIRE);
+}
+
+/* 超过内联长度且有空闲块时返回块号，否则返回-1走rpmsg内联拷贝 */
+static int bulk_alloc(size_t count)
+{
+    uint64_t map;
+    int idx;
+
+    if (count <= MAX_STRING_LEN || !bulk_ready()) {
+        return -1;
+    }
+
+    map = __atomic_load_n(&g_bulk.free_map, __ATOMIC_RELAXED);
+    do {
+        if (map == 0) {
+            return -1;
+        }
+        idx = __builtin_ctzll(map);
+    } while (!__atomic_compare_exchange_n(&g_bulk.free_map, &map, map & ~(1ULL << idx), true,
+        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    return idx;
+}
+
+static void bulk_free(int idx)
+{
+    __atomic_fetch_or(&g_bulk.free_map, 1ULL << idx, __ATOMIC_RELEASE);
+}
+
+static inline unsigned long bulk_offset(int idx)
+{
+    return (unsigned long)idx * g_bulk.block_size;
+}
+
+static ssize_t bulk_read(int fd, void *buf, size_t count, int blk)
+{
+    DEFINE_COMMON_RPC_VAR(ncpyread)
+    ssize_t sret = 0;
+
+    slot_idx = new_slot(&outp);
+    if (slot_idx < 0) {
+        bulk_free(blk);
+        return slot_idx;
+    }
+    outp.ret = 0;
+
+    /* Linux侧直接读到共享内存块中，应答只携带长度 */
+    req.func_id = NCPYREAD_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.fd = fd;
+    req.baddr_offset = bulk_offset(blk);
+    req.count = MIN(count, g_bulk.block_size);
+
+    RECORD_AT(slot_idx).cb = CONVERT(csret);
+    ret = wait4resp(slot_idx, &req, payload_size);
+    if (ret < 0) {
+        bulk_free(blk);
+        return ret;
+    }
+
+    sret = MIN(outp.ret, (ssize_t)req.count);
+    errno = outp.super.errnum;
+    free_slot(slot_idx);
+    if (sret > 0) {
+        (void)memcpy_s(buf, count, g_bulk.base + req.baddr_offset, sret);
+    }
+    bulk_free(blk);
+    return sret;
+}
+
+static ssize_t bulk_write(int fd, const void *buf, size_t count, int blk)
+{
+    DEFINE_COMMON_RPC_VAR(ncpywrite)
+    ssize_t sret = 0;
+
+    slot_idx = new_slot(&outp);
+    if (slot_idx < 0) {
+        bulk_free(blk);
+        return slot_idx;
+    }
+    outp.ret = 0;
+
+    req.func_id = NCPYWRITE_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.fd = fd;
+    req.baddr_offset = bulk_offset(blk);
+    req.count = MIN(count, g_bulk.block_size);
+    (void)memcpy_s(g_bulk.base + req.baddr_offset, g_bulk.block_size, buf, req.count);
+
+    RECORD_AT(slot_idx).cb = CONVERT(csret);
+    ret = wait4resp(slot_idx, &req, payload_size);
+    if (ret < 0) {
+        bulk_free(blk);
+        return ret;
+    }
+
+    sret = outp.ret;
+    errno = outp.super.errnum;
+    free_slot(slot_idx);
+    bulk_free(blk);
+    return sret;
+}
+
+int PRT_ProxyBulkInit(void *base, unsigned long long phys_addr, size_t size)
+{
+    DEFINE_COMMON_RPC_VAR(bulkshm)
+    uint32_t block_size = PROXY_BULK_BLOCK_SIZE;
+    uint32_t block_num;
+
+    CHECK_INIT()
+    CHECK_ARG(base == NULL, EFAULT)
+    CHECK_ARG(bulk_ready(), EBUSY)
+    if (size < block_size) {
+        block_size = (uint32_t)size;
+    }
+    CHECK_ARG(block_size <= MAX_STRING_LEN, EINVAL)
+    block_num = MIN(size / block_size, PROXY_BULK_MAX_BLOCKS);
+
+    slot_idx = new_slot(&outp);
+    CHECK_RET(slot_idx)
+
+    /* 通知Linux侧映射该区域，拒绝时保持内联拷贝 */
+    req.func_id = BULKSHM_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.block_size = block_size;
+    req.phys_addr = phys_addr;
+    req.size = (unsigned long long)block_size * block_num;
+
+    RECORD_AT(slot_idx).cb = CONVERT(common);
+    ret = wait4resp(slot_idx, &req, payload_size);
+    CHECK_RET(ret)
+
+    ret = outp.ret;
+    errno = outp.super.errnum;
+    free_slot(slot_idx);
+    if (ret < 0) {
+        return ret;
+    }
+
+    g_bulk.base = (uint8_t *)base;
+    g_bulk.block_size = block_size;
+    g_bulk.block_num = block_num;
+    __atomic_store_n(&g_bulk.free_map, (block_num == PROXY_BULK_MAX_BLOCKS) ? ~0ULL : ((1ULL << block_num) - 1),
+        __ATOMIC_RELAXED);
+    __atomic_store_n(&g_bulk.ready, true, __ATOMIC_RELEASE);
+    return 0;
+}
+
 ssize_t PRT_ProxyRead(int fd, void *buf, size_t count)
 {
     DEFINE_COMMON_RPC_VAR(read)
     size_t cnt = MIN(count, MAX_STRING_LEN);
     ssize_t sret = 0;
+    int blk;
 
     CHECK_INIT()
     CHECK_ARG(fd < 0, EBADF)
     CHECK_ARG(buf == NULL, EFAULT)
+    blk = bulk_alloc(count);
+    if (blk >= 0) {
+        return bulk_read(fd, buf, count, blk);
+    }
     slot_idx = new_slot(&outp);
     CHECK_RET(slot_idx)
 
@@ -739,7 +999,7 @@ ssize_t PRT_ProxyReadLoop(int fd, void *buf, size_t count) {
 
     if (count <= MAX_STRING_LEN) {
         return PRT_ProxyRead(fd, buf, count);
-    } else {
+    } else if (!bulk_ready()) {
         printf("WARN: read buf too large, using loop read\n");
     }
 
@@ -770,11 +1030,16 @@ ssize_t PRT_ProxyWrite(int fd, const void *buf, size_t count)
 {
     DEFINE_COMMON_RPC_VAR(write)
     ssize_t sret = 0;
-    count = MIN(count, sizeof(req.buf));
+    int blk;
 
     CHECK_INIT()
     CHECK_ARG(fd < 0, EBADF)
     CHECK_ARG(buf == NULL, EFAULT)
+    blk = bulk_alloc(count);
+    if (blk >= 0) {
+        return bulk_write(fd, buf, count, blk);
+    }
+    count = MIN(count, sizeof(req.buf));
     slot_idx = new_slot(&outp);
     CHECK_RET(slot_idx)
 
@@ -795,6 +1060,53 @@ ssize_t PRT_ProxyWrite(int fd, const void *buf, size_t count)
     return sret;
 }
 
+int PRT_ProxyReadAsync(int fd, void *buf, size_t count, PRT_ProxyAsyncCb cb, void *arg)
+{
+    rpc_read_req_t req;
+    int slot_idx;
+
+    CHECK_INIT()
+    CHECK_ARG(fd < 0, EBADF)
+    CHECK_ARG(buf == NULL || cb == NULL, EFAULT)
+    slot_idx = new_async_slot(cb, arg);
+    CHECK_RET(slot_idx)
+
+    RECORD_AT(slot_idx).async_outp.read.buf = buf;
+
+    req.func_id = READ_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.fd = fd;
+    req.count = MIN(count, MAX_STRING_LEN);
+
+    RECORD_AT(slot_idx).cb = CONVERT(read);
+    return submit_async(slot_idx, &req, sizeof(req));
+}
+
+int PRT_ProxyWriteAsync(int fd, const void *buf, size_t count, PRT_ProxyAsyncCb cb, void *arg)
+{
+    rpc_write_req_t req;
+    unsigned int payload_size = sizeof(req);
+    int slot_idx;
+
+    CHECK_INIT()
+    CHECK_ARG(fd < 0, EBADF)
+    CHECK_ARG(buf == NULL || cb == NULL, EFAULT)
+    slot_idx = new_async_slot(cb, arg);
+    CHECK_RET(slot_idx)
+
+    /* 数据在提交时拷贝进请求，返回后调用者即可复用buf */
+    count = MIN(count, sizeof(req.buf));
+    req.func_id = WRITE_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.fd = fd;
+    memcpy_s(req.buf, count, buf, count);
+    req.count = count;
+    payload_size = payload_size - sizeof(req.buf) + count;
+
+    RECORD_AT(slot_idx).cb = CONVERT(csret);
+    return submit_async(slot_idx, &req, payload_size);
+}
+
 int PRT_ProxyClose(int fd)
 {
     DEFINE_COMMON_RPC_VAR(close)
@@ -1554,6 +1866,53 @@ ssize_t PRT_ProxySendTo(int sockfd, const void *buf, size_t len, int flags,
     return __PRT_ProxySendTo(sockfd, buf, len, flags, dest_addr, addrlen);
 }
 
+int PRT_ProxyRecvAsync(int sockfd, void *buf, size_t len, int flags, PRT_ProxyAsyncCb cb, void *arg)
+{
+    rpc_recv_req_t req;
+    int slot_idx;
+
+    CHECK_INIT()
+    CHECK_ARG(sockfd < 0, EBADF)
+    CHECK_ARG(buf == NULL || cb == NULL, EFAULT)
+    slot_idx = new_async_slot(cb, arg);
+    CHECK_RET(slot_idx)
+
+    RECORD_AT(slot_idx).async_outp.recv.buf = buf;
+
+    req.func_id = RECV_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.fd = sockfd;
+    req.len = MIN(MAX_SBUF_LEN, len);
+    req.flags = flags;
+
+    RECORD_AT(slot_idx).cb = CONVERT(recv);
+    return submit_async(slot_idx, &req, sizeof(req));
+}
+
+int PRT_ProxySendAsync(int sockfd, const void *buf, size_t len, int flags, PRT_ProxyAsyncCb cb, void *arg)
+{
+    rpc_send_req_t req;
+    unsigned int payload_size = sizeof(req);
+    int slot_idx;
+
+    CHECK_INIT()
+    CHECK_ARG(sockfd < 0, EBADF)
+    CHECK_ARG(buf == NULL || cb == NULL, EFAULT)
+    slot_idx = new_async_slot(cb, arg);
+    CHECK_RET(slot_idx)
+
+    req.func_id = SEND_ID;
+    req.trace_id = RECORD_AT(slot_idx).trace_id;
+    req.fd = sockfd;
+    req.len = MIN(len, sizeof(req.buf));
+    req.flags = flags;
+    memcpy_s(req.buf, req.len, buf, req.len);
+    payload_size = payload_size - sizeof(req.buf) + req.len;
+
+    RECORD_AT(slot_idx).cb = CONVERT(csret);
+    return submit_async(slot_idx, &req, payload_size);
+}
+
 int PRT_ProxySetSockOpt(int sockfd, int level, int optname, const void *optval, 
                    socklen_t optlen)
 {
@@ -8,6 +8,7 @@
 #include "rpc_internal_model.h"
 #include "rpc_client_internal.h"
 #include "prt_queue.h"
+#include "prt_mem.h"
 #include "prt_task.h"
 #include "prt_config.h"
 
@@ -130,34 +131,71 @@ static int process_cmd_request(struct rpmsg_endpoint *ept, cmd_base_req_t *req)
     return ret;
 }
 
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+/* 零拷贝队列直接取出rpmsg回调借出的请求缓冲区，处理完后归还 */
 static void worker_thread(uintptr_t param1, uintptr_t param2, uintptr_t param3, uintptr_t param4)
 {
-    cmd_base_req_t *cmd_req = (cmd_base_req_t *)malloc(MAX_NODE_SIZE);
-    U32 len = 2048;
+    cmd_base_req_t *cmd_req = NULL;
+    U32 len = 0;
     struct rpmsg_endpoint *ept = (struct rpmsg_endpoint *)param1;
-    if (!cmd_req || !ept) {
+    if (!ept) {
         printf("[ERROR] woker thread null param!\n");
         return;
     }
 
     while (1) {
-        if (PRT_QueueRead(g_cmd_req_queue, cmd_req, &len, OS_QUEUE_WAIT_FOREVER) != OS_OK) {
+        if (PRT_QueueAcquire(g_cmd_req_queue, (void **)&cmd_req, &len, OS_QUEUE_WAIT_FOREVER) != OS_OK) {
             printf("[ERROR] read data fail\n");
-        } else {
+            continue;
+        }
+        int ret = process_cmd_request(ept, cmd_req);
+        processed_num++;
+        if (ret < 0) {
+            printf("[ERROR] process req fail\n");
+        }
+        (void)PRT_QueueRelease(g_cmd_req_queue, cmd_req);
+    }
+}
+#else
+/* 单个worker时批量取出队列中积压的请求，减少读队列的加锁和调度次数 */
+static void worker_thread(uintptr_t param1, uintptr_t param2, uintptr_t param3, uintptr_t param4)
+{
+    char *reqs = (char *)malloc(MAX_NODE_SIZE * WORKER_BATCH_NUM);
+    U32 lens[WORKER_BATCH_NUM] = {0};
+    U32 num = 0;
+    struct rpmsg_endpoint *ept = (struct rpmsg_endpoint *)param1;
+    if (!reqs || !ept) {
+        printf("[ERROR] woker thread null param!\n");
+        return;
+    }
+    memset(reqs, 0, MAX_NODE_SIZE * WORKER_BATCH_NUM);
+
+    while (1) {
+        if (PRT_QueueReadBatch(g_cmd_req_queue, reqs, MAX_NODE_SIZE, lens, WORKER_BATCH_NUM, &num,
+            OS_QUEUE_WAIT_FOREVER) != OS_OK) {
+            printf("[ERROR] read data fail\n");
+            continue;
+        }
+        for (U32 i = 0; i < num; i++) {
+            cmd_base_req_t *cmd_req = (cmd_base_req_t *)(reqs + i * MAX_NODE_SIZE);
             int ret = process_cmd_request(ept, cmd_req);
             processed_num++;
             if (ret < 0) {
                 printf("[ERROR] process req fail\n");
             }
+            memset(cmd_req, 0, lens[i]);
         }
-        memset(cmd_req, 0, len);
-        len = 2048;
     }
 }
+#endif
 
 int workers_init(struct rpmsg_endpoint *ept)
 {
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+    U32 ret = PRT_QueueCreateZeroCopy(MAX_NODE_NUM, OS_MEM_DEFAULT_FSC_PT, &g_cmd_req_queue);
+#else
     U32 ret = PRT_QueueCreate(MAX_NODE_NUM, MAX_NODE_SIZE, &g_cmd_req_queue);
+#endif
     if (ret != OS_OK) {
         printf("[ERROR] create Q fail, ret:%u\n", ret);
         return ret;
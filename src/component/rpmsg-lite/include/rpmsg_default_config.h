@@ -169,6 +169,44 @@
 #define RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION (0)
 #endif
 
+//! @def RL_EPT_HASH_SIZE
+//!
+//! Number of buckets of the endpoint table, it must be power of two (1, 2, 4, ...).
+//! Received messages are dispatched by hashing the destination address into
+//! this table, so lookup cost stays constant as long as the number of
+//! endpoints does not largely exceed the bucket count.
+//! The default value is 32U.
+#ifndef RL_EPT_HASH_SIZE
+#define RL_EPT_HASH_SIZE (32U)
+#endif
+
+//! @def RL_USE_TX_EVENT
+//!
+//! When enabled, a sender waiting for a free tx buffer blocks on an event
+//! signalled from the tx virtqueue callback instead of sleeping in
+//! RL_MS_PER_INTERVAL steps. Requires env_create_event() and friends in the
+//! environment layer.
+//! The default value is 1 (enabled).
+#ifndef RL_USE_TX_EVENT
+#define RL_USE_TX_EVENT (1)
+#endif
+
+//! @def RL_TX_EVENT_MAX_WAIT
+//!
+//! Upper bound in ms of one wait for the tx buffer event, 0 for no bound.
+//! The other side only signals returned buffers when it is built with
+//! RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION (Linux always does), otherwise the
+//! sender has to re-check the virtqueue periodically.
+//! The default value is 0 when RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION is set,
+//! RL_MS_PER_INTERVAL otherwise.
+#ifndef RL_TX_EVENT_MAX_WAIT
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+#define RL_TX_EVENT_MAX_WAIT (0)
+#else
+#define RL_TX_EVENT_MAX_WAIT (RL_MS_PER_INTERVAL)
+#endif
+#endif
+
 //! @def RL_HANG
 //!
 //! Default implementation of hang assert function
@@ -640,4 +640,53 @@ uint32_t env_wait_for_link_up(volatile uint32_t *link_state, uint32_t link_id, u
  */
 void env_tx_callback(uint32_t link_id);
 
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+/*!
+ * env_create_event
+ *
+ * Creates an event used to wake a task from interrupt context.
+ * Signals are counted, a signal set before the wait is not lost.
+ *
+ * @param event   - pointer to created event
+ * @param context - context for event
+ *
+ * @return - status of function execution
+ */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+int32_t env_create_event(void **event, void *context);
+#else
+int32_t env_create_event(void **event);
+#endif
+
+/*!
+ * env_delete_event
+ *
+ * Deletes the given event.
+ *
+ * @param event - event to delete
+ */
+void env_delete_event(void *event);
+
+/*!
+ * env_set_event
+ *
+ * Signals the event, callable from interrupt context.
+ *
+ * @param event - event to signal
+ */
+void env_set_event(void *event);
+
+/*!
+ * env_wait_event
+ *
+ * Waits until the event is signalled or the timeout expires.
+ *
+ * @param event      - event to wait for
+ * @param timeout_ms - timeout in ms, RL_BLOCK to wait forever
+ *
+ * @return RL_TRUE when signalled, RL_FALSE on timeout.
+ */
+uint32_t env_wait_event(void *event, uintptr_t timeout_ms);
+#endif /* RL_USE_TX_EVENT */
+
 #endif /* RPMSG_ENV_H_ */
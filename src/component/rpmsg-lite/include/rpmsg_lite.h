@@ -144,6 +144,17 @@ struct rpmsg_lite_endpoint
     /* 16 bytes aligned on 32bit architecture */
 };
 
+/*!
+ * Descriptor of one message sent by rpmsg_lite_send_batch()
+ * or rpmsg_lite_send_nocopy_batch()
+ */
+struct rpmsg_lite_batch_msg
+{
+    uint32_t dst;  /*!< remote endpoint address */
+    void *data;    /*!< payload buffer */
+    uint32_t size; /*!< size of payload, in bytes */
+};
+
 /*!
  * RPMsg Lite Endpoint static context
  */
@@ -163,10 +174,17 @@ struct rpmsg_lite_instance
 {
     struct virtqueue *rvq;                /*!< receive virtqueue */
     struct virtqueue *tvq;                /*!< transmit virtqueue */
-    struct llist *rl_endpoints;           /*!< linked list of endpoints */
+    struct llist *rl_endpoints[RL_EPT_HASH_SIZE]; /*!< endpoint lists hashed by address */
     LOCK *lock;                           /*!< local RPMsg Lite mutex lock */
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
     LOCK_STATIC_CONTEXT lock_static_ctxt; /*!< Static context for lock object creation */
+#endif
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+    void *tx_event;                       /*!< signalled when the other side returns tx buffers */
+    volatile uint32_t tx_waiters;         /*!< number of senders blocked on tx_event */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT tx_event_static_ctxt; /*!< Static context for tx event creation */
+#endif
 #endif
     uint32_t link_state;                  /*!< state of the link, up/down*/
     char *sh_mem_base;                    /*!< base address of the shared memory */
@@ -322,6 +340,34 @@ int32_t rpmsg_lite_send(struct rpmsg_lite_instance *rpmsg_lite_dev,
                         uint32_t size,
                         uintptr_t timeout);
 
+/*!
+ *
+ * @brief Sends several messages from one endpoint and notifies
+ * the other side only once.
+ *
+ * Each payload is copied into its own tx buffer and enqueued on the
+ * virtqueue, the other side is kicked after the last one instead of
+ * once per message. When the tx buffers run out in the middle of the
+ * batch, the messages enqueued so far are published before waiting so
+ * the other side can consume them.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Sender endpoint
+ * @param msgs              Array of message descriptors
+ * @param count             Number of messages in msgs
+ * @param sent              Number of messages actually sent, may be RL_NULL
+ * @param timeout           Timeout in ms for each tx buffer, 0 if nonblocking
+ *
+ * @return Status of function execution, RL_SUCCESS when all messages were sent.
+ *
+ */
+int32_t rpmsg_lite_send_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              struct rpmsg_lite_endpoint *ept,
+                              const struct rpmsg_lite_batch_msg *msgs,
+                              uint32_t count,
+                              uint32_t *sent,
+                              uintptr_t timeout);
+
 /*!
  * @brief Function to get the link state
  *
@@ -406,6 +452,28 @@ int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
                                uint32_t dst,
                                void *data,
                                uint32_t size);
+
+/*!
+ * @brief Sends several tx buffers allocated by rpmsg_lite_alloc_tx_buffer()
+ * with a single notification of the other side.
+ *
+ * Same ownership rules as rpmsg_lite_send_nocopy() apply to every buffer
+ * of the batch. The batch is checked before anything is enqueued, so on
+ * failure none of the buffers has been sent.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param[in] ept           Sender endpoint pointer
+ * @param[in] msgs          Array of message descriptors, data points to the tx buffers
+ * @param[in] count         Number of messages in msgs
+ *
+ * @return 0 on success and an appropriate error value on failure.
+ *
+ * @see rpmsg_lite_alloc_tx_buffer
+ */
+int32_t rpmsg_lite_send_nocopy_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     const struct rpmsg_lite_batch_msg *msgs,
+                                     uint32_t count);
 #endif /* RL_API_HAS_ZEROCOPY */
 
 //! @}
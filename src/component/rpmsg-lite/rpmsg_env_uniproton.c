@@ -54,6 +54,7 @@
 
 #include "prt_sem.h"
 #include "prt_queue.h"
+#include "prt_sys_external.h"
 
 static int32_t env_init_counter = 0;
 
@@ -368,6 +369,104 @@ void env_unlock_mutex(void *lock)
     }
 }
 
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+/*!
+ * env_create_event
+ *
+ * Creates an event backed by a counting semaphore with zero initial count.
+ *
+ */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+int32_t env_create_event(void **event, void *context)
+#else
+int32_t env_create_event(void **event)
+#endif
+{
+    if (event == NULL) {
+        return 1;
+    }
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    *event = context;
+#else
+    if ((*event = env_allocate_memory(sizeof(SemHandle))) == NULL) {
+        return 1;
+    }
+#endif
+
+    if (PRT_SemCreate(0, *((SemHandle **)event)) != OS_OK) {
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        CHECK_FREE(*event);
+#endif
+        return 1;
+    }
+
+    return RL_SUCCESS;
+}
+
+/*!
+ * env_delete_event
+ *
+ * Deletes the given event
+ *
+ */
+void env_delete_event(void *event)
+{
+    if (event == NULL) {
+        return;
+    }
+    (void)PRT_SemDelete(*((SemHandle *)event));
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+    env_free_memory(event);
+#endif
+}
+
+/*!
+ * env_set_event
+ *
+ * Posts the event semaphore, PRT_SemPost is allowed in interrupt context.
+ *
+ */
+void env_set_event(void *event)
+{
+    if (event != NULL)
+    {
+        (void)PRT_SemPost(*((SemHandle *)event));
+    }
+}
+
+/*!
+ * env_wait_event
+ *
+ * Pends on the event semaphore, timeout is converted from ms to ticks
+ * and rounded up so that a short wait never becomes a no-wait.
+ *
+ */
+uint32_t env_wait_event(void *event, uintptr_t timeout_ms)
+{
+    U64 ticks;
+
+    if (event == NULL)
+    {
+        return RL_FALSE;
+    }
+
+    if (timeout_ms == RL_BLOCK)
+    {
+        ticks = OS_WAIT_FOREVER;
+    }
+    else
+    {
+        ticks = ((U64)timeout_ms * OsSysGetTickPerSecond() + OS_SYS_MS_PER_SECOND - 1) / OS_SYS_MS_PER_SECOND;
+        if (ticks >= OS_WAIT_FOREVER)
+        {
+            ticks = OS_WAIT_FOREVER - 1;
+        }
+    }
+
+    return (PRT_SemPend(*((SemHandle *)event), (U32)ticks) == OS_OK) ? RL_TRUE : RL_FALSE;
+}
+#endif /* RL_USE_TX_EVENT */
+
 /*!
  * env_sleep_msec
  *
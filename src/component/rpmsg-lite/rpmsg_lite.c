@@ -65,9 +65,16 @@ struct virtqueue_ops
 #endif
 #endif /* !(defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)) */
 
+#if (!RL_EPT_HASH_SIZE) || (RL_EPT_HASH_SIZE & (RL_EPT_HASH_SIZE - 1))
+#error "RL_EPT_HASH_SIZE must be power of two (1, 2, 4, ...)"
+#endif
+
+/* Bucket of the endpoint table holding the given address */
+#define RL_EPT_HASH(addr) ((addr) & (RL_EPT_HASH_SIZE - 1U))
+
 /*!
  * @brief
- * Traverse the linked list of endpoints to get the one with defined address.
+ * Look up the endpoint with defined address in its bucket of the endpoint table.
  *
  * @param rpmsg_lite_dev    RPMsg Lite instance
  * @param addr              Local endpoint address
@@ -79,7 +86,7 @@ static struct llist *rpmsg_lite_get_endpoint_from_addr(struct rpmsg_lite_instanc
 {
     struct llist *rl_ept_lut_head;
 
-    rl_ept_lut_head = rpmsg_lite_dev->rl_endpoints;
+    rl_ept_lut_head = rpmsg_lite_dev->rl_endpoints[RL_EPT_HASH(addr)];
     while (rl_ept_lut_head != RL_NULL)
     {
         struct rpmsg_lite_endpoint *rl_ept = (struct rpmsg_lite_endpoint *)rl_ept_lut_head->data;
@@ -183,6 +190,13 @@ static void rpmsg_lite_tx_callback(struct virtqueue *vq)
 
     RL_ASSERT(rpmsg_lite_dev != RL_NULL);
     rpmsg_lite_dev->link_state = 1U;
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+    /* The other side returned buffers, wake up a blocked sender */
+    if (rpmsg_lite_dev->tx_waiters != 0U)
+    {
+        env_set_event(rpmsg_lite_dev->tx_event);
+    }
+#endif
     env_tx_callback(rpmsg_lite_dev->link_id);
 }
 
@@ -482,7 +496,7 @@ struct rpmsg_lite_endpoint *rpmsg_lite_create_ept(struct rpmsg_lite_instance *rp
 
         node->data = rl_ept;
 
-        add_to_list((struct llist **)&rpmsg_lite_dev->rl_endpoints, node);
+        add_to_list((struct llist **)&rpmsg_lite_dev->rl_endpoints[RL_EPT_HASH(addr)], node);
     }
     env_unlock_mutex(rpmsg_lite_dev->lock);
 
@@ -516,7 +530,7 @@ int32_t rpmsg_lite_destroy_ept(struct rpmsg_lite_instance *rpmsg_lite_dev, struc
     node = rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, rl_ept->addr);
     if (node != RL_NULL)
     {
-        remove_from_list((struct llist **)&rpmsg_lite_dev->rl_endpoints, node);
+        remove_from_list((struct llist **)&rpmsg_lite_dev->rl_endpoints[RL_EPT_HASH(rl_ept->addr)], node);
         env_unlock_mutex(rpmsg_lite_dev->lock);
 #if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
         env_free_memory(node);
@@ -561,6 +575,96 @@ uint32_t rpmsg_lite_wait_for_link_up(struct rpmsg_lite_instance *rpmsg_lite_dev,
     return env_wait_for_link_up(&rpmsg_lite_dev->link_state, rpmsg_lite_dev->link_id, timeout);
 }
 
+/*!
+ * @brief
+ * Internal function to get a free tx buffer, waiting for
+ * the other side to return one if none is available.
+ *
+ * With RL_USE_TX_EVENT the sender registers itself in tx_waiters
+ * before looking at the virtqueue, so a buffer returned after a failed
+ * allocation always signals tx_event and the wait ends early.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param len               Pointer to store the buffer length
+ * @param idx               Pointer to store the buffer index
+ * @param timeout           Timeout in ms, 0 if nonblocking
+ *
+ * @return  Buffer pointer, RL_NULL on timeout
+ *
+ */
+static void *rpmsg_lite_get_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      uint32_t *len,
+                                      uint16_t *idx,
+                                      uintptr_t timeout)
+{
+    void *buffer;
+    uint32_t tick_count = 0U;
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+    uintptr_t wait_ms;
+    uint32_t signalled;
+#endif
+
+    /* Lock the device to enable exclusive access to virtqueues */
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    /* Get rpmsg buffer for sending message. */
+    buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, len, idx);
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+
+    if (timeout == RL_DONT_BLOCK)
+    {
+        return buffer;
+    }
+
+    while (buffer == RL_NULL)
+    {
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+        env_lock_mutex(rpmsg_lite_dev->lock);
+        rpmsg_lite_dev->tx_waiters++;
+        env_mb();
+        buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, len, idx);
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+
+        signalled = RL_FALSE;
+        wait_ms   = 0U;
+        if (buffer == RL_NULL)
+        {
+            wait_ms = (timeout == RL_BLOCK) ? RL_BLOCK : (timeout - tick_count);
+#if (RL_TX_EVENT_MAX_WAIT != 0)
+            if (wait_ms > (uintptr_t)RL_TX_EVENT_MAX_WAIT)
+            {
+                wait_ms = (uintptr_t)RL_TX_EVENT_MAX_WAIT;
+            }
+#endif
+            signalled = env_wait_event(rpmsg_lite_dev->tx_event, wait_ms);
+
+            env_lock_mutex(rpmsg_lite_dev->lock);
+            buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, len, idx);
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+        }
+
+        env_lock_mutex(rpmsg_lite_dev->lock);
+        rpmsg_lite_dev->tx_waiters--;
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+
+        /* A signal that did not yield a buffer (taken by another sender)
+           is charged like one polling interval */
+        tick_count += (signalled == RL_TRUE) ? (uint32_t)RL_MS_PER_INTERVAL : (uint32_t)wait_ms;
+#else
+        env_sleep_msec(RL_MS_PER_INTERVAL);
+        env_lock_mutex(rpmsg_lite_dev->lock);
+        buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, len, idx);
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+        tick_count += (uint32_t)RL_MS_PER_INTERVAL;
+#endif
+        if ((buffer == RL_NULL) && (timeout != RL_BLOCK) && (tick_count >= timeout))
+        {
+            return RL_NULL;
+        }
+    }
+
+    return buffer;
+}
+
 /*!
  * @brief
  * Internal function to format a RPMsg compatible
@@ -588,7 +692,6 @@ static int32_t rpmsg_lite_format_message(struct rpmsg_lite_instance *rpmsg_lite_
     struct rpmsg_std_msg *rpmsg_msg;
     void *buffer;
     uint16_t idx;
-    uint32_t tick_count = 0U;
     uint32_t buff_len;
 
     if (rpmsg_lite_dev == RL_NULL)
@@ -606,30 +709,12 @@ static int32_t rpmsg_lite_format_message(struct rpmsg_lite_instance *rpmsg_lite_
         return RL_NOT_READY;
     }
 
-    /* Lock the device to enable exclusive access to virtqueues */
-    env_lock_mutex(rpmsg_lite_dev->lock);
-    /* Get rpmsg buffer for sending message. */
-    buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, &buff_len, &idx);
-    env_unlock_mutex(rpmsg_lite_dev->lock);
-
-    if ((buffer == RL_NULL) && (timeout == RL_FALSE))
+    buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, &buff_len, &idx, timeout);
+    if (buffer == RL_NULL)
     {
         return RL_ERR_NO_MEM;
     }
 
-    while (buffer == RL_NULL)
-    {
-        env_sleep_msec(RL_MS_PER_INTERVAL);
-        env_lock_mutex(rpmsg_lite_dev->lock);
-        buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, &buff_len, &idx);
-        env_unlock_mutex(rpmsg_lite_dev->lock);
-        tick_count += (uint32_t)RL_MS_PER_INTERVAL;
-        if ((tick_count >= timeout) && (buffer == RL_NULL))
-        {
-            return RL_ERR_NO_MEM;
-        }
-    }
-
     rpmsg_msg = (struct rpmsg_std_msg *)buffer;
 
     /* Initialize RPMSG header. */
@@ -676,6 +761,110 @@ int32_t rpmsg_lite_send(struct rpmsg_lite_instance *rpmsg_lite_dev,
     return rpmsg_lite_format_message(rpmsg_lite_dev, ept->addr, dst, data, size, RL_NO_FLAGS, timeout);
 }
 
+int32_t rpmsg_lite_send_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              struct rpmsg_lite_endpoint *ept,
+                              const struct rpmsg_lite_batch_msg *msgs,
+                              uint32_t count,
+                              uint32_t *sent,
+                              uintptr_t timeout)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    void *buffer;
+    uint16_t idx;
+    uint32_t buff_len;
+    uint32_t i;
+    uint32_t queued = 0U;
+    int32_t status  = RL_SUCCESS;
+
+    if (sent != RL_NULL)
+    {
+        *sent = 0U;
+    }
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (msgs == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        if (msgs[i].data == RL_NULL)
+        {
+            return RL_ERR_PARAM;
+        }
+
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+        if (msgs[i].size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE(rpmsg_lite_dev->link_id))
+#else
+        if (msgs[i].size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE)
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+        {
+            return RL_ERR_BUFF_SIZE;
+        }
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, &buff_len, &idx, RL_DONT_BLOCK);
+        if ((buffer == RL_NULL) && (queued != 0U))
+        {
+            /* Out of buffers, publish the enqueued ones so the other side can return some. */
+            env_lock_mutex(rpmsg_lite_dev->lock);
+            virtqueue_kick(rpmsg_lite_dev->tvq);
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+            queued = 0U;
+        }
+
+        if ((buffer == RL_NULL) && (timeout != RL_DONT_BLOCK))
+        {
+            buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, &buff_len, &idx, timeout);
+        }
+
+        if (buffer == RL_NULL)
+        {
+            status = RL_ERR_NO_MEM;
+            break;
+        }
+
+        rpmsg_msg = (struct rpmsg_std_msg *)buffer;
+
+        /* Initialize RPMSG header. */
+        rpmsg_msg->hdr.dst   = msgs[i].dst;
+        rpmsg_msg->hdr.src   = ept->addr;
+        rpmsg_msg->hdr.len   = (uint16_t)msgs[i].size;
+        rpmsg_msg->hdr.flags = (uint16_t)(RL_NO_FLAGS & 0xFFFFU);
+
+        /* Copy data to rpmsg buffer. */
+        env_memcpy(rpmsg_msg->data, msgs[i].data, msgs[i].size);
+
+        env_lock_mutex(rpmsg_lite_dev->lock);
+        /* Enqueue buffer on virtqueue, the kick is deferred to the end of the batch. */
+        rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvq, buffer, buff_len, idx);
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+        queued++;
+    }
+
+    if (queued != 0U)
+    {
+        env_lock_mutex(rpmsg_lite_dev->lock);
+        /* Let the other side know that there are jobs to process. */
+        virtqueue_kick(rpmsg_lite_dev->tvq);
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+    }
+
+    if (sent != RL_NULL)
+    {
+        *sent = i;
+    }
+
+    return status;
+}
+
 #if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
 
 void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t *size, uintptr_t timeout)
@@ -683,7 +872,6 @@ void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uin
     struct rpmsg_std_msg *rpmsg_msg;
     void *buffer;
     uint16_t idx;
-    uint32_t tick_count = 0U;
 
     if (size == RL_NULL)
     {
@@ -696,32 +884,13 @@ void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uin
         return RL_NULL;
     }
 
-    /* Lock the device to enable exclusive access to virtqueues */
-    env_lock_mutex(rpmsg_lite_dev->lock);
-    /* Get rpmsg buffer for sending message. */
-    buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, size, &idx);
-    env_unlock_mutex(rpmsg_lite_dev->lock);
-
-    if ((buffer == RL_NULL) && (timeout == RL_FALSE))
+    buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, size, &idx, timeout);
+    if (buffer == RL_NULL)
     {
         *size = 0;
         return RL_NULL;
     }
 
-    while (buffer == RL_NULL)
-    {
-        env_sleep_msec(RL_MS_PER_INTERVAL);
-        env_lock_mutex(rpmsg_lite_dev->lock);
-        buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, size, &idx);
-        env_unlock_mutex(rpmsg_lite_dev->lock);
-        tick_count += (uint32_t)RL_MS_PER_INTERVAL;
-        if ((tick_count >= timeout) && (buffer == RL_NULL))
-        {
-            *size = 0;
-            return RL_NULL;
-        }
-    }
-
     rpmsg_msg = (struct rpmsg_std_msg *)buffer;
 
     /* keep idx and totlen information for nocopy tx function */
@@ -794,6 +963,74 @@ int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
     return RL_SUCCESS;
 }
 
+int32_t rpmsg_lite_send_nocopy_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     const struct rpmsg_lite_batch_msg *msgs,
+                                     uint32_t count)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    uint32_t i;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (msgs == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        if (msgs[i].data == RL_NULL)
+        {
+            return RL_ERR_PARAM;
+        }
+
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+        if (msgs[i].size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE(rpmsg_lite_dev->link_id))
+#else
+        if (msgs[i].size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE)
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+        {
+            return RL_ERR_BUFF_SIZE;
+        }
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    if (count == 0U)
+    {
+        return RL_SUCCESS;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(msgs[i].data);
+
+        /* Initialize RPMSG header. */
+        rpmsg_msg->hdr.dst   = msgs[i].dst;
+        rpmsg_msg->hdr.src   = ept->addr;
+        rpmsg_msg->hdr.len   = (uint16_t)msgs[i].size;
+        rpmsg_msg->hdr.flags = (uint16_t)(RL_NO_FLAGS & 0xFFFFU);
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    for (i = 0U; i < count; i++)
+    {
+        rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(msgs[i].data);
+        /* Enqueue buffer on virtqueue. */
+        rpmsg_lite_dev->vq_ops->vq_tx(
+            rpmsg_lite_dev->tvq, (void *)rpmsg_msg,
+            (uint32_t)virtqueue_get_buffer_length(rpmsg_lite_dev->tvq, rpmsg_msg->hdr.reserved.idx),
+            rpmsg_msg->hdr.reserved.idx);
+    }
+    /* One notification for the whole batch. */
+    virtqueue_kick(rpmsg_lite_dev->tvq);
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+
+    return RL_SUCCESS;
+}
+
 /******************************************
 
  mmmmm  m    m          mm   mmmmm  mmmmm
@@ -1059,6 +1296,27 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         return RL_NULL;
     }
 
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_event(&rpmsg_lite_dev->tx_event, &rpmsg_lite_dev->tx_event_static_ctxt);
+#else
+    status = env_create_event(&rpmsg_lite_dev->tx_event);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t c = 0U; c < 2U; c++)
+        {
+            virtqueue_free(vqs[c]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif /* RL_USE_TX_EVENT */
+
     // FIXME - a better way to handle this , tx for master is rx for remote and vice versa.
     rpmsg_lite_dev->tvq = vqs[1];
     rpmsg_lite_dev->rvq = vqs[0];
@@ -1316,6 +1574,27 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
         return RL_NULL;
     }
 
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_event(&rpmsg_lite_dev->tx_event, &rpmsg_lite_dev->tx_event_static_ctxt);
+#else
+    status = env_create_event(&rpmsg_lite_dev->tx_event);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t c = 0U; c < 2U; c++)
+        {
+            virtqueue_free(vqs[c]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif /* RL_USE_TX_EVENT */
+
     // FIXME - a better way to handle this , tx for master is rx for remote and vice versa.
     rpmsg_lite_dev->tvq = vqs[0];
     rpmsg_lite_dev->rvq = vqs[1];
@@ -1386,6 +1665,9 @@ int32_t rpmsg_lite_deinit(struct rpmsg_lite_instance *rpmsg_lite_dev)
     rpmsg_lite_dev->tvq = RL_NULL;
 
     env_delete_mutex(rpmsg_lite_dev->lock);
+#if defined(RL_USE_TX_EVENT) && (RL_USE_TX_EVENT == 1)
+    env_delete_event(rpmsg_lite_dev->tx_event);
+#endif
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     (void)env_deinit(rpmsg_lite_dev->env);
 #else
@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <stdarg.h>
 #include "prt_dynmodule_internal.h"
 #include "prt_module.h"
@@ -36,6 +37,8 @@ struct DynModuleUnitInfo *g_dynModuleInfoPool[OS_MAX_MODULE_NUM] = {0};
 
 char *g_dynModuleErrorStr = NULL;
 
+static DynModuleProtectHook g_dynModuleProtectHook = NULL;
+
 /**
  * @brief 设置动态模块的错误信息。
  * 
@@ -69,45 +72,40 @@ static void OsDynModuleSetError(const char *fmt, ...)
 }
 
 /**
- * 从指定的模块文件中获取文件内容
- * 
- * @param moduleFile 指向要读取的模块文件名的字符指针。
- * @return 返回一个指向包含文件内容的字符数组的指针；如果失败，则返回NULL。
+ * 从模块文件的指定偏移读取数据，文件可能经代理访问，单次read可能只返回部分数据
+ *
+ * @param fd 模块文件描述符。
+ * @param offset 文件偏移。
+ * @param buf 保存数据的缓冲区。
+ * @param size 读取长度。
+ * @return 成功返回0，失败返回OS_MODULE_ERRNO_FILE_READ。
  */
-static U32 OsDynModuleGetFileContent(const char *moduleFile, char **buf)
+static U32 OsDynModuleFileRead(int fd, off_t offset, void *buf, size_t size)
 {
-    int fd = -1;
-    unsigned long length;
-    char *moduleStr = NULL;
-    fd = open(moduleFile, O_RDONLY);
-    if (fd < 0) {
-        return OS_MODULE_ERRNO_FILE_OPEN;
-    }
-    length = lseek(fd, 0, SEEK_END); 
-    lseek(fd, 0, SEEK_SET);
-    moduleStr = (char *)PRT_MemAlloc(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT, length + 1);
-    if (moduleStr == NULL) {
-        close(fd);
-        return OS_MODULE_ERRNO_MEMORY_ALLOC;
-    }
-    (void)memset_s(moduleStr, length + 1, 0, length + 1);
-    if(read(fd, moduleStr, length) != length) {
-        (void)PRT_MemFree(OS_MID_DYNAMIC, moduleStr);
-        close(fd);
+    ssize_t len;
+    uint8_t *pos = (uint8_t *)buf;
+
+    if (lseek(fd, offset, SEEK_SET) != offset) {
         return OS_MODULE_ERRNO_FILE_READ;
     }
-    close(fd);
-    *buf = moduleStr;
+    while (size > 0) {
+        len = read(fd, pos, size);
+        if (len <= 0) {
+            return OS_MODULE_ERRNO_FILE_READ;
+        }
+        pos += len;
+        size -= (size_t)len;
+    }
     return OS_MODULE_OK;
 }
 
 /**
  * 动态模块加载时，检查ELF文件格式是否正确。
  * 
- * @param lfInfo 指向ELF头信息的指针。
+ * @param elfInfo 指向ELF头信息的指针。
  * @return 成功返回0，失败返回错误码
  */
-static U32 OsDynModuleCheckElf(Elf_Ehdr *elfInfo)
+static U32 OsDynModuleCheckElf(const Elf_Ehdr *elfInfo)
 {
     /* 魔术字校验 */
     if ((elfInfo->e_ident[EI_MAG0] != ELFMAG0) || (elfInfo->e_ident[EI_MAG1] != ELFMAG1) ||
@@ -126,6 +124,10 @@ static U32 OsDynModuleCheckElf(Elf_Ehdr *elfInfo)
     if (elfInfo->e_shentsize != sizeof(Elf_Shdr)) {
         return OS_MODULE_ERRNO_ELF_HEAD_SHENT_SIZE;
     }
+    /* 程序头表项大小校验 */
+    if ((elfInfo->e_phnum == 0) || (elfInfo->e_phentsize != sizeof(Elf_Phdr))) {
+        return OS_MODULE_ERRNO_ELF_HEAD_LEN;
+    }
     /* 检查节区个数 */
     if (elfInfo->e_shnum == 0) {
         return OS_MODULE_ERRNO_ELF_HEAD_SHNUM;
@@ -141,6 +143,68 @@ static U32 OsDynModuleCheckElf(Elf_Ehdr *elfInfo)
     return OS_MODULE_OK;
 }
 
+static void OsDynModuleLoadInfoFree(struct DynModuleLoadInfo *loadInfo)
+{
+    if (loadInfo->phdr != NULL) {
+        (void)PRT_MemFree(OS_MID_DYNAMIC, loadInfo->phdr);
+        loadInfo->phdr = NULL;
+    }
+    if (loadInfo->shdr != NULL) {
+        (void)PRT_MemFree(OS_MID_DYNAMIC, loadInfo->shdr);
+        loadInfo->shdr = NULL;
+    }
+    if (loadInfo->fd >= 0) {
+        close(loadInfo->fd);
+        loadInfo->fd = -1;
+    }
+}
+
+/**
+ * 读取并校验模块文件的ELF头、程序头表和节区头表
+ *
+ * 只读取头部信息，加载段的内容在分配好模块内存后直接读到最终位置，不再把整个文件读入内存。
+ *
+ * @param moduleFile 模块文件路径。
+ * @param loadInfo 保存读取结果，失败时由调用者使用OsDynModuleLoadInfoFree释放。
+ * @return 成功返回0，失败返回错误码。
+ */
+static U32 OsDynModuleReadHeaders(const char *moduleFile, struct DynModuleLoadInfo *loadInfo)
+{
+    U32 ret;
+    size_t size;
+    Elf_Ehdr *elfInfo = &loadInfo->ehdr;
+
+    loadInfo->fd = open(moduleFile, O_RDONLY);
+    if (loadInfo->fd < 0) {
+        return OS_MODULE_ERRNO_FILE_OPEN;
+    }
+    ret = OsDynModuleFileRead(loadInfo->fd, 0, elfInfo, sizeof(Elf_Ehdr));
+    if (ret != OS_MODULE_OK) {
+        return ret;
+    }
+    ret = OsDynModuleCheckElf(elfInfo);
+    if (ret != OS_MODULE_OK) {
+        return ret;
+    }
+
+    size = elfInfo->e_phnum * sizeof(Elf_Phdr);
+    loadInfo->phdr = (Elf_Phdr *)PRT_MemAlloc(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT, size);
+    if (loadInfo->phdr == NULL) {
+        return OS_MODULE_ERRNO_MEMORY_ALLOC;
+    }
+    ret = OsDynModuleFileRead(loadInfo->fd, (off_t)elfInfo->e_phoff, loadInfo->phdr, size);
+    if (ret != OS_MODULE_OK) {
+        return ret;
+    }
+
+    size = elfInfo->e_shnum * sizeof(Elf_Shdr);
+    loadInfo->shdr = (Elf_Shdr *)PRT_MemAlloc(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT, size);
+    if (loadInfo->shdr == NULL) {
+        return OS_MODULE_ERRNO_MEMORY_ALLOC;
+    }
+    return OsDynModuleFileRead(loadInfo->fd, (off_t)elfInfo->e_shoff, loadInfo->shdr, size);
+}
+
 /**
  * 动态模块单元分配函数
  * 本函数用于从动态模块单元信息池中分配一个未使用的单元。如果找到可用单元，则将其状态设置为初始化，并返回其信息指针。
@@ -182,71 +246,141 @@ static U32 OsDynModuleUnitAlloc(struct DynModuleUnitInfo **dynModuleUnitInfo)
     return OS_MODULE_OK;
 }
 
+OS_SEC_ALW_INLINE INLINE uintptr_t OsDynModuleImageSize(const struct DynModuleUnitInfo *unitInfo)
+{
+    return ALIGN(unitInfo->loadSegEndAddr - unitInfo->loadSegStartAddr, OS_MODULE_ALIGN_LEN);
+}
+
+OS_SEC_ALW_INLINE INLINE U32 OsDynModuleSegProt(Elf_Word flags)
+{
+    U32 prot = 0;
+
+    if ((flags & PF_R) != 0) {
+        prot |= OS_MODULE_PROT_READ;
+    }
+    if ((flags & PF_W) != 0) {
+        prot |= OS_MODULE_PROT_WRITE;
+    }
+    if ((flags & PF_X) != 0) {
+        prot |= OS_MODULE_PROT_EXEC;
+    }
+    return prot;
+}
+
+/**
+ * 记录PT_LOAD段对应的按页对齐区域，与上一个区域落在同一页时合并，权限取并集。
+ *
+ * @param unitInfo 指向包含模块信息的结构体的指针。
+ * @param phdr 指向PT_LOAD段程序头的指针。
+ * @return 成功返回0，区域个数超出OS_MODULE_REGION_MAX时返回错误码。
+ */
+static U32 OsDynModuleAddRegion(struct DynModuleUnitInfo *unitInfo, const Elf_Phdr *phdr)
+{
+    uintptr_t regStart = TRUNCATE((uintptr_t)phdr->p_vaddr, OS_MODULE_ALIGN_LEN) - unitInfo->loadSegStartAddr;
+    uintptr_t regEnd = ALIGN(phdr->p_vaddr + phdr->p_memsz, OS_MODULE_ALIGN_LEN) - unitInfo->loadSegStartAddr;
+    struct DynModuleRegion *region = NULL;
+
+    if (unitInfo->regionNum != 0) {
+        region = &unitInfo->regions[unitInfo->regionNum - 1];
+        if (regStart < region->offset + region->size) {
+            region->size = regEnd - region->offset;
+            region->prot |= OsDynModuleSegProt(phdr->p_flags);
+            return OS_MODULE_OK;
+        }
+    }
+    if (unitInfo->regionNum == OS_MODULE_REGION_MAX) {
+        return OS_MODULE_ERRNO_PTLOAD_NUM;
+    }
+    region = &unitInfo->regions[unitInfo->regionNum++];
+    region->offset = regStart;
+    region->size = regEnd - regStart;
+    region->prot = OsDynModuleSegProt(phdr->p_flags);
+    return OS_MODULE_OK;
+}
+
 /**
  * 为动态模块分配内存以加载段。
  * 
  * 该函数遍历ELF文件中的程序头（Program Headers），找到所有类型为PT_LOAD的段（segment），
  * 并为这些段分配足够的内存。它记录段的起始地址和结束地址，并实际分配内存以供后续加载模块使用。
+ * 位置无关代码中代码段与数据段的相对距离在链接时已经确定，所以各段放在同一块按页对齐的内存中，
+ * 起始地址向下取整到页，保证各段在内存中与ELF虚拟地址的页内偏移一致，代码段和数据段各自占用独立的页。
  * 
- * @param unitInfo 指向包含模块信息的结构体的指针。该结构体应包含模块的字符串表示（即ELF文件的起始地址）。
- * @return 成功返回0，失败返回特定错误码，指示无法分配内存或PT_LOAD段的大小为0。
+ * @param unitInfo 指向包含模块信息的结构体的指针。
+ * @param loadInfo 指向已读取的ELF头信息的指针。
+ * @return 成功返回0，失败返回特定错误码，指示无法分配内存或PT_LOAD段的大小不正确。
  */
-static U32 OsDynModuleAllocMemForLoadSeg(struct DynModuleUnitInfo *unitInfo)
+static U32 OsDynModuleAllocMemForLoadSeg(struct DynModuleUnitInfo *unitInfo, const struct DynModuleLoadInfo *loadInfo)
 {
-    U32 i;
-    Elf_Ehdr *elfInfo = (Elf_Ehdr *)(unitInfo->moduleStr);
-    Elf_Phdr *phdr = (Elf_Phdr *)(unitInfo->moduleStr + elfInfo->e_phoff);
+    U32 i, ret;
+    uintptr_t size;
+    const Elf_Phdr *phdr = loadInfo->phdr;
     bool flag = false;
-    for (i = 0; i < elfInfo->e_phnum; i++) {
+    for (i = 0; i < loadInfo->ehdr.e_phnum; i++) {
         if (phdr[i].p_type != PT_LOAD) {
             continue;
         }
-        if (phdr[i].p_filesz > phdr[i].p_memsz) {
+        if ((phdr[i].p_filesz > phdr[i].p_memsz) || (phdr[i].p_vaddr + phdr[i].p_memsz < phdr[i].p_vaddr)) {
             return OS_MODULE_ERRNO_PTLOAD_SIZE;
         }
         if (!flag) {
-            unitInfo->loadSegStartAddr = phdr[i].p_vaddr;
+            unitInfo->loadSegStartAddr = TRUNCATE((uintptr_t)phdr[i].p_vaddr, OS_MODULE_ALIGN_LEN);
             flag = true;
+        } else if (phdr[i].p_vaddr < unitInfo->loadSegEndAddr) {
+            /* ELF规范要求PT_LOAD段按虚拟地址升序排列且不重叠 */
+            return OS_MODULE_ERRNO_PTLOAD_NUM;
         }
         unitInfo->loadSegEndAddr = phdr[i].p_vaddr + phdr[i].p_memsz;
+        ret = OsDynModuleAddRegion(unitInfo, &phdr[i]);
+        if (ret != OS_MODULE_OK) {
+            return ret;
+        }
     }
-    U32 size = unitInfo->loadSegEndAddr - unitInfo->loadSegStartAddr;
-    if (size == 0) {
+    if (unitInfo->loadSegEndAddr == unitInfo->loadSegStartAddr) {
         return OS_MODULE_ERRNO_PTLOAD_SIZE;
     }
-    size = ALIGN(size, OS_MODULE_ALIGN_LEN);
+    size = OsDynModuleImageSize(unitInfo);
     unitInfo->loadSegMem = (uint8_t *)PRT_MemAllocAlign(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT, size, MEM_ADDR_ALIGN_4K);
     if (unitInfo->loadSegMem == NULL) {
         return OS_MODULE_ERRNO_MEMORY_ALLOC;
     }
-    (void)memset_s(unitInfo->loadSegMem, size, 0, size);
     return OS_MODULE_OK;
 }
 
 /**
- * 从动态模块中获取加载段数据
+ * 从模块文件中读取加载段数据
  * 
- * 本函数用于从动态模块的内存表示中提取出所有需要加载到内存的段数据，并将这些数据复制到
- * 指定的内存区域。该操作是基于ELF格式的动态模块。
+ * 本函数把所有需要加载的段从文件直接读到模块内存的最终位置，段之间的空隙、
+ * 每个段memsz超出filesz的部分（即bss）以及末尾的页对齐填充清0，其余内存不重复清0。
  *
- * @param unitInfo 指向动态模块单元信息的指针。单元信息包含了模块的字符串起始地址、加载段的内存起始地址等。
- * @return 函数成功执行时返回0，若复制过程中发生错误则返回OS_MODULE_ERRNO_MEMCOPY。
+ * @param unitInfo 指向动态模块单元信息的指针。单元信息包含了加载段的内存起始地址等。
+ * @param loadInfo 指向已读取的ELF头信息的指针。
+ * @return 函数成功执行时返回0，失败返回错误码。
  */
-static U32 OsDynModuleGetLoadSegData(struct DynModuleUnitInfo *unitInfo)
+static U32 OsDynModuleGetLoadSegData(struct DynModuleUnitInfo *unitInfo, const struct DynModuleLoadInfo *loadInfo)
 {
     U32 i, ret;
-    Elf_Ehdr *elfInfo = (Elf_Ehdr *)(unitInfo->moduleStr);
-    Elf_Phdr *phdr = (Elf_Phdr *)(unitInfo->moduleStr + elfInfo->e_phoff);
-    for (i = 0; i < elfInfo->e_phnum; i++) {
+    uintptr_t segOff;
+    uintptr_t prevEnd = 0;
+    uintptr_t size = OsDynModuleImageSize(unitInfo);
+    const Elf_Phdr *phdr = loadInfo->phdr;
+    for (i = 0; i < loadInfo->ehdr.e_phnum; i++) {
         if (phdr[i].p_type != PT_LOAD) {
             continue;
         }
-        /* 前面申请内存的时候已经初始化0了，这里拷贝的大小使用p_filesz而不是用p_memsz的原因就是memsz-filesz这一块是bss，需要清0 */
-        ret = memcpy_s(unitInfo->loadSegMem + phdr[i].p_vaddr - unitInfo->loadSegStartAddr,
-            phdr[i].p_filesz, unitInfo->moduleStr + phdr[i].p_offset, phdr[i].p_filesz);
-        if (ret != EOK) {
-            return OS_MODULE_ERRNO_MEMCOPY;
+        segOff = phdr[i].p_vaddr - unitInfo->loadSegStartAddr;
+        if (segOff > prevEnd) {
+            (void)memset_s(unitInfo->loadSegMem + prevEnd, segOff - prevEnd, 0, segOff - prevEnd);
+        }
+        ret = OsDynModuleFileRead(loadInfo->fd, (off_t)phdr[i].p_offset, unitInfo->loadSegMem + segOff,
+            phdr[i].p_filesz);
+        if (ret != OS_MODULE_OK) {
+            return ret;
         }
+        prevEnd = segOff + phdr[i].p_filesz;
+    }
+    if (size > prevEnd) {
+        (void)memset_s(unitInfo->loadSegMem + prevEnd, size - prevEnd, 0, size - prevEnd);
     }
 #ifndef OS_ARCH_X86_64
     os_asm_invalidate_dcache_all();
@@ -254,6 +388,22 @@ static U32 OsDynModuleGetLoadSegData(struct DynModuleUnitInfo *unitInfo)
     return OS_MODULE_OK;
 }
 
+/**
+ * 获取已加载到模块内存中的节区地址，.dynsym、.dynstr和重定位表都在加载段内，无需再从文件读取。
+ *
+ * @param unitInfo 指向动态模块单元信息的指针。
+ * @param shdr 指向节区头的指针。
+ * @return 返回节区在模块内存中的地址，节区不在加载段内时返回NULL。
+ */
+static uint8_t *OsDynModuleSectionAddr(const struct DynModuleUnitInfo *unitInfo, const Elf_Shdr *shdr)
+{
+    if (((shdr->sh_flags & SHF_ALLOC) == 0) || (shdr->sh_addr < unitInfo->loadSegStartAddr) ||
+        (shdr->sh_addr > unitInfo->loadSegEndAddr) || (shdr->sh_size > unitInfo->loadSegEndAddr - shdr->sh_addr)) {
+        return NULL;
+    }
+    return unitInfo->loadSegMem + shdr->sh_addr - unitInfo->loadSegStartAddr;
+}
+
 static U32 OsDynModuleRelocatePrepare(struct DynModuleUnitInfo *unitInfo, uintptr_t reloc,
     Elf_Sym *symTab, uint8_t *strTab, Elf_Shdr *shdr)
 {
@@ -293,22 +443,31 @@ static U32 OsDynModuleRelocatePrepare(struct DynModuleUnitInfo *unitInfo, uintpt
     return OS_MODULE_OK;
 }
 
-static U32 OsDynModuleProcessRelocationSection(struct DynModuleUnitInfo *unitInfo)
+static U32 OsDynModuleProcessRelocationSection(struct DynModuleUnitInfo *unitInfo,
+    const struct DynModuleLoadInfo *loadInfo)
 {
     U32 i, j, ret;
-    Elf_Ehdr *elfInfo = (Elf_Ehdr *)(unitInfo->moduleStr);
-    Elf_Shdr *shdr = (Elf_Shdr *)(unitInfo->moduleStr + elfInfo->e_shoff);
+    U32 shnum = loadInfo->ehdr.e_shnum;
+    Elf_Shdr *shdr = loadInfo->shdr;
     uintptr_t reloc;
-    for (i = 0; i < elfInfo->e_shnum; i++) {
+    Elf_Sym *symTab = NULL;
+    uint8_t *strTab = NULL;
+    for (i = 0; i < shnum; i++) {
         if ((shdr[i].sh_type != SHT_RELA) && (shdr[i].sh_type != SHT_REL)) {
             continue;
         }
+        if ((shdr[i].sh_entsize == 0) || (shdr[i].sh_link >= shnum) || (shdr[shdr[i].sh_link].sh_link >= shnum)) {
+            return OS_MODULE_ERRNO_SECTION_RANGE;
+        }
         /* 获取要处理的节区表.rela.dyn或.rela.plt */
-        reloc = (uintptr_t)(unitInfo->moduleStr + shdr[i].sh_offset);
+        reloc = (uintptr_t)OsDynModuleSectionAddr(unitInfo, &shdr[i]);
         /* 通过sh_link获取到符号表节区.dynsym */
-        Elf_Sym *symTab = (Elf_Sym *)(unitInfo->moduleStr + shdr[shdr[i].sh_link].sh_offset);
+        symTab = (Elf_Sym *)OsDynModuleSectionAddr(unitInfo, &shdr[shdr[i].sh_link]);
         /* 通过节区.dynsym的sh_link获取到符号名字字符串表节区.dynstr */
-        uint8_t *strTab = (uint8_t *)(unitInfo->moduleStr + shdr[shdr[shdr[i].sh_link].sh_link].sh_offset);
+        strTab = OsDynModuleSectionAddr(unitInfo, &shdr[shdr[shdr[i].sh_link].sh_link]);
+        if ((reloc == 0) || (symTab == NULL) || (strTab == NULL)) {
+            return OS_MODULE_ERRNO_SECTION_RANGE;
+        }
         for (j = 0; j < shdr[i].sh_size / shdr[i].sh_entsize; j++, reloc += shdr[i].sh_entsize) {
             /* 从重定向表里获取每一个重定向表项reloc */
             ret = OsDynModuleRelocatePrepare(unitInfo, reloc, symTab, strTab, &shdr[i]);
@@ -327,127 +486,149 @@ static U32 OsDynModuleProcessRelocationSection(struct DynModuleUnitInfo *unitInf
 /**
  * 保存动态模块的符号表信息，供外部调用
  * 
- * 该函数负责解析动态模块的ELF文件格式，找到符号表（.dynsym），
+ * 该函数负责解析动态模块的ELF文件格式，按节区类型SHT_DYNSYM找到符号表（.dynsym），
  * 并从中提取出所有的全局函数符号，保存到模块的符号表结构体中。
+ * 符号表和符号名一次申请，符号名依次存放在符号表之后，最后为符号表创建哈希索引。
  * 
- * @param unitInfo 指向动态模块单元信息的指针，包含了模块的字符串起始地址等信息。
+ * @param unitInfo 指向动态模块单元信息的指针，包含了加载段的内存起始地址等信息。
+ * @param loadInfo 指向已读取的ELF头信息的指针。
  * @return 成功返回OS_MODULE_OK，否则返回相应的错误码。
  */
-static U32 OsDynModuleSaveSymTab(struct DynModuleUnitInfo *unitInfo)
+static U32 OsDynModuleSaveSymTab(struct DynModuleUnitInfo *unitInfo, const struct DynModuleLoadInfo *loadInfo)
 {
-    U32 ret;
     U16 index, i, j = 0;
-    Elf_Ehdr *elfInfo = (Elf_Ehdr *)(unitInfo->moduleStr);
-    Elf_Shdr *shdr = (Elf_Shdr *)(unitInfo->moduleStr + elfInfo->e_shoff);
-    uint8_t *shstrndx = (uint8_t *)(unitInfo->moduleStr + shdr[elfInfo->e_shstrndx].sh_offset);
-    for (index = 0; index < elfInfo->e_shnum; index++) {
-        if (strcmp((const char *)(shstrndx + shdr[index].sh_name), ".dynsym") == 0) {
+    U32 strSize = 0;
+    U32 tabSize;
+    size_t symNameLen;
+    char *symName = NULL;
+    U16 shnum = loadInfo->ehdr.e_shnum;
+    Elf_Shdr *shdr = loadInfo->shdr;
+    for (index = 0; index < shnum; index++) {
+        if (shdr[index].sh_type == SHT_DYNSYM) {
             break;
         }
     }
-    if (index == elfInfo->e_shnum) {
+    if ((index == shnum) || (shdr[index].sh_entsize == 0) || (shdr[index].sh_link >= shnum)) {
         return OS_MODULE_ERRNO_DYNSYM_SECTION_NOT_FOUND;
     }
     /* 获取节区.dynsym的信息，符号表节区，其结构为Elf_Sym */
-    Elf_Sym *symTab = (Elf_Sym *)(unitInfo->moduleStr + shdr[index].sh_offset);
+    Elf_Sym *symTab = (Elf_Sym *)OsDynModuleSectionAddr(unitInfo, &shdr[index]);
     /* 获取节区.dynstr的信息，符号名字字符串表节区，其结构为uint8_t */
-    uint8_t *strTab = (uint8_t *)(unitInfo->moduleStr + shdr[shdr[index].sh_link].sh_offset);
-    /* 计算节区有多少个全局函数 */
+    uint8_t *strTab = OsDynModuleSectionAddr(unitInfo, &shdr[shdr[index].sh_link]);
+    if ((symTab == NULL) || (strTab == NULL)) {
+        return OS_MODULE_ERRNO_SECTION_RANGE;
+    }
+    /* 计算节区有多少个全局函数及符号名总长度 */
     for (i = 0; i < shdr[index].sh_size / shdr[index].sh_entsize; i++) {
         if ((ELF_ST_TYPE(symTab[i].st_info) == STT_FUNC) && (ELF_ST_BIND(symTab[i].st_info) == STB_GLOBAL)) {
             unitInfo->symNum++;
+            strSize += strlen((const char *)(strTab + symTab[i].st_name)) + 1;
         }
     }
     if (unitInfo->symNum == 0) {
         return OS_MODULE_ERRNO_NO_GLOBAL_FUNC;
     }
+    tabSize = unitInfo->symNum * sizeof(struct DynModuleSymTab);
     unitInfo->symTab = (struct DynModuleSymTab *)PRT_MemAlloc(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT,
-        unitInfo->symNum * sizeof(struct DynModuleSymTab));
+        tabSize + strSize);
     if (unitInfo->symTab == NULL) {
         return OS_MODULE_ERRNO_MEMORY_ALLOC;
     }
-    (void)memset_s(unitInfo->symTab, unitInfo->symNum * sizeof(struct DynModuleSymTab), 0,
-        unitInfo->symNum * sizeof(struct DynModuleSymTab));
     /* 获取符号信息 */
+    symName = (char *)unitInfo->symTab + tabSize;
     for (i = 0; i < shdr[index].sh_size / shdr[index].sh_entsize; i++) {
         if ((ELF_ST_TYPE(symTab[i].st_info) != STT_FUNC) || (ELF_ST_BIND(symTab[i].st_info) != STB_GLOBAL)) {
             continue;
         }
         /* 获取符号地址 */
         unitInfo->symTab[j].addr = (void *)(unitInfo->loadSegMem + symTab[i].st_value - unitInfo->loadSegStartAddr);
-        size_t symNameLen = strlen(strTab + symTab[i].st_name) + 1;
-        unitInfo->symTab[j].name = (char *)PRT_MemAlloc(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT, symNameLen);
-        if (unitInfo->symTab[j].name == NULL) {
-            ret =  OS_MODULE_ERRNO_MEMORY_ALLOC;
-            goto FAIL_RET;
-        }
-        (void)memset_s(unitInfo->symTab[j].name, symNameLen, 0, symNameLen);
-        errno_t err = strcpy_s(unitInfo->symTab[j].name, symNameLen, (const char *)(strTab + symTab[i].st_name));
-        if (err != OS_MODULE_OK) {
-            ret = OS_MODULE_ERRNO_MEMCOPY;
-            goto FAIL_RET;
+        symNameLen = strlen((const char *)(strTab + symTab[i].st_name)) + 1;
+        if (memcpy_s(symName, strSize, strTab + symTab[i].st_name, symNameLen) != EOK) {
+            (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->symTab);
+            unitInfo->symTab = NULL;
+            return OS_MODULE_ERRNO_MEMCOPY;
         }
+        unitInfo->symTab[j].name = symName;
+        symName += symNameLen;
+        strSize -= symNameLen;
         j++;
     }
-    return OS_MODULE_OK;
-FAIL_RET:
-    for (i = 0; i < j; i++) {
-        if (unitInfo->symTab[i].name != NULL) {
-            (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->symTab[i].name);
-            unitInfo->symTab[i].name = NULL;
-        }
-    }
-    if (unitInfo->symTab != NULL) {
+    unitInfo->symHash = OsDynModuleSymHashCreate(unitInfo->symTab, unitInfo->symNum);
+    if (unitInfo->symHash == NULL) {
         (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->symTab);
         unitInfo->symTab = NULL;
+        return OS_MODULE_ERRNO_MEMORY_ALLOC;
+    }
+    return OS_MODULE_OK;
+}
+
+/**
+ * 重定位完成后按区域设置加载段权限，未注册权限设置钩子时直接返回。
+ *
+ * @param unitInfo 指向动态模块单元信息的指针。
+ * @return 成功返回0，钩子返回失败时返回OS_MODULE_ERRNO_PROTECT。
+ */
+static U32 OsDynModuleProtect(struct DynModuleUnitInfo *unitInfo)
+{
+    U32 i;
+    DynModuleProtectHook hook = g_dynModuleProtectHook;
+
+    if (hook == NULL) {
+        return OS_MODULE_OK;
+    }
+    /* 部分区域设置成功后失败也需要在释放时恢复 */
+    unitInfo->protect = true;
+    for (i = 0; i < unitInfo->regionNum; i++) {
+        if (hook((uintptr_t)unitInfo->loadSegMem + unitInfo->regions[i].offset, unitInfo->regions[i].size,
+            unitInfo->regions[i].prot) != 0) {
+            return OS_MODULE_ERRNO_PROTECT;
+        }
     }
-    return ret;
+    return OS_MODULE_OK;
 }
 
-static U32 OsDynModuleUnitLoad(struct DynModuleUnitInfo *unitInfo, S32 mode)
+static U32 OsDynModuleUnitLoad(struct DynModuleUnitInfo *unitInfo, const struct DynModuleLoadInfo *loadInfo, S32 mode)
 {
     (void)mode;
     U32 ret;
-    ret = OsDynModuleAllocMemForLoadSeg(unitInfo);
+    ret = OsDynModuleAllocMemForLoadSeg(unitInfo, loadInfo);
     if (ret != 0) {
         return ret;
     }
-    ret = OsDynModuleGetLoadSegData(unitInfo);
+    ret = OsDynModuleGetLoadSegData(unitInfo, loadInfo);
     if (ret != 0) {
         return ret;
     }
-    ret = OsDynModuleProcessRelocationSection(unitInfo);
+    ret = OsDynModuleProcessRelocationSection(unitInfo, loadInfo);
     if (ret != 0) {
         return ret;
     }
-    ret = OsDynModuleSaveSymTab(unitInfo);
+    ret = OsDynModuleSaveSymTab(unitInfo, loadInfo);
     if (ret != 0) {
         return ret;
     }
-    return ret;
+    return OsDynModuleProtect(unitInfo);
 }
 
 static void OsDynModuleUnitFree(struct DynModuleUnitInfo *unitInfo)
 {
-    U32 i;
     if (unitInfo == NULL) {
         return;
     }
-    if (unitInfo->moduleStr != NULL) {
-        (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->moduleStr);
-        unitInfo->moduleStr = NULL;
+    if (unitInfo->symHash != NULL) {
+        (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->symHash);
+        unitInfo->symHash = NULL;
     }
     if (unitInfo->symTab != NULL) {
-        for (i = 0; i < unitInfo->symNum; i++) {
-            if (unitInfo->symTab[i].name != NULL) {
-                (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->symTab[i].name);
-                unitInfo->symTab[i].name = NULL;
-            }
-        }
         (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->symTab);
         unitInfo->symTab = NULL;
     }
     if (unitInfo->loadSegMem != NULL) {
+        /* 内存归还前恢复为可读写 */
+        if (unitInfo->protect && (g_dynModuleProtectHook != NULL)) {
+            (void)g_dynModuleProtectHook((uintptr_t)unitInfo->loadSegMem, OsDynModuleImageSize(unitInfo),
+                OS_MODULE_PROT_READ | OS_MODULE_PROT_WRITE);
+        }
         (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->loadSegMem);
         unitInfo->loadSegMem = NULL;
     }
@@ -480,8 +661,7 @@ static U32 OsDynModuleFileCheck(const char *moduleFile, struct stat *moduleFileS
 void* OsDynModuleLoad(const char *moduleFile, S32 mode)
 {
     U32 ret;
-    char *moduleStr = NULL;
-    Elf_Ehdr *elfInfo = NULL;
+    struct DynModuleLoadInfo loadInfo = { .fd = -1 };
     struct stat moduleFileSata;
     struct DynModuleUnitInfo *unitInfo = NULL;
     if (moduleFile == NULL) {
@@ -503,40 +683,32 @@ void* OsDynModuleLoad(const char *moduleFile, S32 mode)
         return unitInfo;
     }
 
-    ret = OsDynModuleGetFileContent(moduleFile, &moduleStr);
-    if ((ret != OS_MODULE_OK) || (moduleStr == NULL)) {
-        OsDynModuleSetError("Get file content failed, ret:%u.", ret);
-        return NULL;
-    }
-
-    elfInfo = (Elf_Ehdr *)moduleStr;
-    ret = OsDynModuleCheckElf(elfInfo);
-    if (ret != 0) {
-        OsDynModuleSetError("ELF check failed, ret:%u.", ret);
-        (void)PRT_MemFree(OS_MID_DYNAMIC, moduleStr);
+    ret = OsDynModuleReadHeaders(moduleFile, &loadInfo);
+    if (ret != OS_MODULE_OK) {
+        OsDynModuleSetError("Read ELF headers failed, ret:%u.", ret);
+        OsDynModuleLoadInfoFree(&loadInfo);
         return NULL;
     }
 
     ret = OsDynModuleUnitAlloc(&unitInfo);
     if (ret != 0) {
         OsDynModuleSetError("Alloc memory failed for the dynamic module unit, ret:%u.", ret);
-        (void)PRT_MemFree(OS_MID_DYNAMIC, moduleStr);
+        OsDynModuleLoadInfoFree(&loadInfo);
         return NULL;
     }
-    unitInfo->moduleStr = moduleStr;
     unitInfo->stDev = moduleFileSata.st_dev;
     unitInfo->stIno = moduleFileSata.st_ino;
+    (void)strncpy_s(unitInfo->name, OS_MODULE_NAME_LEN, moduleFile, OS_MODULE_NAME_LEN - 1);
     unitInfo->state = MODULE_UNIT_INIT;
 
-    ret = OsDynModuleUnitLoad(unitInfo, mode);
+    ret = OsDynModuleUnitLoad(unitInfo, &loadInfo, mode);
+    OsDynModuleLoadInfoFree(&loadInfo);
     if (ret != 0) {
         OsDynModuleSetError("Load the dynamic module unit failed, ret:%u.", ret);
         OsDynModuleUnitFree(unitInfo);
         return NULL;
     }
 
-    (void)PRT_MemFree(OS_MID_DYNAMIC, unitInfo->moduleStr);
-    unitInfo->moduleStr = NULL;
     unitInfo->state = MODULE_UNIT_ACTIVE;
     return (void *)unitInfo;
 }
@@ -544,16 +716,10 @@ void* OsDynModuleLoad(const char *moduleFile, S32 mode)
 void* OsDynModuleFind(void *handle, const char *symbol)
 {
     struct DynModuleUnitInfo *unitInfo = (struct DynModuleUnitInfo *)handle;
-    if (unitInfo == NULL) {
+    if ((unitInfo == NULL) || (unitInfo->symHash == NULL) || (symbol == NULL)) {
         return NULL;
     }
-    U16 i;
-    for (i = 0; i < unitInfo->symNum; i++) {
-        if (strcmp(unitInfo->symTab[i].name, symbol) == 0) {
-            return unitInfo->symTab[i].addr;
-        }
-    }
-    return NULL;
+    return OsDynModuleSymHashFind(unitInfo->symHash, unitInfo->symTab, symbol);
 }
 
 void OsDynModuleUnload(void *handle)
@@ -565,7 +731,41 @@ void OsDynModuleUnload(void *handle)
     OsDynModuleUnitFree(unitInfo);
 }
 
+void OsDynModuleSetProtectHook(DynModuleProtectHook hook)
+{
+    g_dynModuleProtectHook = hook;
+}
+
 const char *OsDynModuleGetError(void)
 {
     return (const char *)g_dynModuleErrorStr;
 }
+
+U32 OsDynModuleGetMaps(struct DynModuleMapInfo *maps, U32 maxNum)
+{
+    U32 i;
+    U32 num = 0;
+    uintptr_t intSave;
+    struct DynModuleUnitInfo *unitInfo = NULL;
+
+    if (maps == NULL) {
+        return 0;
+    }
+
+    intSave = OsModuleIntLock();
+    for (i = 0; (i < OS_MAX_MODULE_NUM) && (num < maxNum); i++) {
+        unitInfo = g_dynModuleInfoPool[i];
+        if ((unitInfo == NULL) || (unitInfo->state != MODULE_UNIT_ACTIVE)) {
+            continue;
+        }
+        maps[num].start = (uintptr_t)unitInfo->loadSegMem;
+        maps[num].end = (uintptr_t)unitInfo->loadSegMem + (uintptr_t)(unitInfo->loadSegEndAddr -
+            unitInfo->loadSegStartAddr);
+        maps[num].vaddr = (uintptr_t)unitInfo->loadSegStartAddr;
+        (void)memcpy_s(maps[num].name, OS_MODULE_NAME_LEN, unitInfo->name, OS_MODULE_NAME_LEN);
+        num++;
+    }
+    OsModuleIntUnlock(intSave);
+
+    return num;
+}
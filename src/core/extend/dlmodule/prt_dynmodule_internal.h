@@ -19,9 +19,12 @@
 #include <sys/stat.h>
 #include "prt_typedef.h"
 #include "prt_cpu_external.h"
+#include "prt_dynamic_module.h"
 
 #define OS_MODULE_ERROR_STR_LEN           512
 #define OS_MODULE_ALIGN_LEN               4096
+#define OS_MODULE_SYM_HASH_EMPTY          0xFFFFFFFFU
+#define OS_MODULE_REGION_MAX              8        // 最多支持的PT_LOAD段个数
 
 #define OS_ELF32_R_SYM(info)              ((info) >> 8)            /* r_info的高24位表示重定位入口的符号在符号表中的下标 */
 #define OS_ELF64_R_SYM(info)              ((info) >> 32)           /* r_info的高32位表示重定位入口的符号在符号表中的下标 */
@@ -56,8 +59,6 @@ typedef Elf32_Addr                        Elf_Addr;
 #define ELF_R_TYPE                        OS_ELF32_R_TYPE
 #endif
 
-#define OS_MAX_MODULE_NUM                  5      // 最大可以加载5个模块
-
 enum OS_MODULE_ERRNO_E {
     OS_MODULE_OK = 0,                             // 成功
     OS_MODULE_ERRNO_ELF_HEAD_LEN,                 // ELF头长度不正确
@@ -80,6 +81,35 @@ enum OS_MODULE_ERRNO_E {
     OS_MODULE_ERRNO_FILE_CHECK_FAILED,            // 模块文件校验失败
     OS_MODULE_ERRNO_FILE_OPEN,                    // 模块文件打开失败
     OS_MODULE_ERRNO_FILE_READ,                    // 模块文件读取失败
+    OS_MODULE_ERRNO_PTLOAD_NUM,                   // PT_LOAD段个数超出OS_MODULE_REGION_MAX或顺序不正确
+    OS_MODULE_ERRNO_SECTION_RANGE,                // 节区不在加载段内
+    OS_MODULE_ERRNO_PROTECT,                      // 加载段权限设置失败
+};
+
+/*
+ * GNU hash风格的符号索引：同一个桶的符号在chain中连续存放，chain保存符号名哈希值，
+ * 最低位为1表示桶内最后一个符号，index保存chain位置对应的符号表下标
+ */
+struct DynModuleSymHash {
+    U32 mask;                                    // 桶数量减1，桶数量为2的幂
+    U32 *buckets;                                // 桶内第一个符号在chain中的位置
+    U32 *chain;                                  // 符号名哈希值
+    U32 *index;                                  // 符号表下标
+};
+
+/* 加载段在模块内存中的区域，起止按页对齐，同一页内的相邻段合并且权限取并集 */
+struct DynModuleRegion {
+    uintptr_t offset;                            // 相对模块内存起始地址的偏移
+    uintptr_t size;                              // 区域大小
+    U32 prot;                                    // OS_MODULE_PROT_*
+};
+
+/* 流式加载过程中从文件读取的ELF头信息，加载完成后释放 */
+struct DynModuleLoadInfo {
+    int fd;                                      // 模块文件描述符
+    Elf_Ehdr ehdr;                               // ELF头
+    Elf_Phdr *phdr;                              // 程序头表
+    Elf_Shdr *shdr;                              // 节区头表
 };
 
 enum ModuleUnitSate {
@@ -97,10 +127,14 @@ struct DynModuleUnitInfo
     U64 loadSegEndAddr;                          // 要加载的段结束地址
 	dev_t stDev;                                 // 模块所在设备
 	ino_t stIno;                                 // 模块所在inode
-    struct DynModuleSymTab *symTab;              // 符号表
+    struct DynModuleSymTab *symTab;              // 符号表，符号名保存在同一块内存的末尾
+    struct DynModuleSymHash *symHash;            // 符号表哈希索引
     uint8_t *loadSegMem;                         // 加载段内存
-    char *moduleStr;                             // 模块字符串
+    U8 regionNum;                                // 加载段区域个数
+    bool protect;                                // 是否已设置区域权限
+    struct DynModuleRegion regions[OS_MODULE_REGION_MAX]; // 加载段区域
     char *error;                                 // 错误信息
+    char name[OS_MODULE_NAME_LEN];               // 模块文件路径
 };
 
 struct OsDynModuleRelocInfo {
@@ -147,4 +181,7 @@ OS_SEC_ALW_INLINE INLINE void OsModuleIntUnlock(uintptr_t intSave)
 
 U32 OsDynModuleRelocate(Elf_Addr relocAddr, struct OsDynModuleRelocInfo relocInfo);
 U64 OsDynModuleFindSymFromOs(const char *symName);
+struct DynModuleSymHash *OsDynModuleSymHashCreate(const struct DynModuleSymTab *symTab, U32 symNum);
+void *OsDynModuleSymHashFind(const struct DynModuleSymHash *symHash, const struct DynModuleSymTab *symTab,
+    const char *symName);
 #endif
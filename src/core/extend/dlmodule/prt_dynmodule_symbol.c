@@ -15,28 +15,182 @@
 #include "prt_dynmodule_internal.h"
 #include "prt_dynamic_module.h"
 #include "prt_mem.h"
+#include "securec.h"
 
-U64 OsDynModuleFindSymFromOs(const char *symName)
+extern int os_symtab_start;
+extern int os_symtab_end;
+
+/* OS符号表的哈希索引在第一次解析符号时创建，之后只读 */
+static struct DynModuleSymHash *g_osSymHash = NULL;
+
+/* 与GNU hash(dl_new_hash)相同的符号名哈希 */
+static U32 OsDynModuleSymNameHash(const char *symName)
 {
-    extern int os_symtab_start;
-    extern int os_symtab_end;
-    struct DynModuleSymTab *symTabStart = (struct DynModuleSymTab *)&os_symtab_start;
-    struct DynModuleSymTab *symTabEnd = (struct DynModuleSymTab *)&os_symtab_end;
-    struct DynModuleSymTab *symTabIndex = NULL;
-    if (symName == NULL) {
-        return 0;
+    U32 hash = 5381;
+
+    for (; *symName != '\0'; symName++) {
+        hash = (hash << 5) + hash + (U8)*symName;
+    }
+    return hash;
+}
+
+/**
+ * 为符号表创建GNU hash风格的索引，符号表本身不移动。
+ *
+ * 先统计每个桶的符号数得到各桶的结束位置，再倒序把符号放入所在的桶，
+ * 这样桶内符号保持符号表中的先后顺序，最后为每个非空桶的最后一个符号打上结束标记。
+ *
+ * @param symTab 符号表。
+ * @param symNum 符号数量。
+ * @return 成功返回索引，内存不足返回NULL，使用完后用PRT_MemFree释放。
+ */
+struct DynModuleSymHash *OsDynModuleSymHashCreate(const struct DynModuleSymTab *symTab, U32 symNum)
+{
+    U32 i;
+    U32 end;
+    U32 slot;
+    U32 hashNum = 0;
+    U32 bucketNum = 1;
+    U32 size;
+    struct DynModuleSymHash *symHash = NULL;
+
+    /* 平均每个桶约两个符号 */
+    while (bucketNum < (symNum >> 1)) {
+        bucketNum <<= 1;
     }
+    size = sizeof(struct DynModuleSymHash) + (bucketNum + symNum * 2) * sizeof(U32);
+    symHash = (struct DynModuleSymHash *)PRT_MemAlloc(OS_MID_DYNAMIC, OS_MEM_DEFAULT_FSC_PT, size);
+    if (symHash == NULL) {
+        return NULL;
+    }
+    symHash->mask = bucketNum - 1;
+    symHash->buckets = (U32 *)(symHash + 1);
+    symHash->chain = symHash->buckets + bucketNum;
+    symHash->index = symHash->chain + symNum;
+    (void)memset_s(symHash->buckets, bucketNum * sizeof(U32), 0, bucketNum * sizeof(U32));
 
-    for (symTabIndex = symTabStart; symTabIndex < symTabEnd; symTabIndex++) {
-        if (symTabIndex->name == NULL) {
+    for (i = 0; i < symNum; i++) {
+        if (symTab[i].name != NULL) {
+            symHash->buckets[OsDynModuleSymNameHash(symTab[i].name) & symHash->mask]++;
+            hashNum++;
+        }
+    }
+    for (i = 1; i < bucketNum; i++) {
+        symHash->buckets[i] += symHash->buckets[i - 1];
+    }
+    for (i = symNum; i > 0; i--) {
+        if (symTab[i - 1].name == NULL) {
             continue;
         }
-        if (strcmp(symName, symTabIndex->name) == 0) {
-            return (U64)(symTabIndex->addr);
+        U32 hash = OsDynModuleSymNameHash(symTab[i - 1].name);
+        slot = --symHash->buckets[hash & symHash->mask];
+        symHash->chain[slot] = hash & ~1U;
+        symHash->index[slot] = i - 1;
+    }
+    for (i = 0; i < bucketNum; i++) {
+        end = (i + 1 < bucketNum) ? symHash->buckets[i + 1] : hashNum;
+        if (end == symHash->buckets[i]) {
+            symHash->buckets[i] = OS_MODULE_SYM_HASH_EMPTY;
+        } else {
+            symHash->chain[end - 1] |= 1U;
+        }
+    }
+    return symHash;
+}
+
+/**
+ * 通过哈希索引查找符号，只有哈希值相同的符号才比较名字。
+ *
+ * @return 找到返回符号地址，否则返回NULL。
+ */
+void *OsDynModuleSymHashFind(const struct DynModuleSymHash *symHash, const struct DynModuleSymTab *symTab,
+    const char *symName)
+{
+    U32 hash = OsDynModuleSymNameHash(symName);
+    U32 slot = symHash->buckets[hash & symHash->mask];
+    U32 chain;
+
+    if (slot == OS_MODULE_SYM_HASH_EMPTY) {
+        return NULL;
+    }
+    do {
+        chain = symHash->chain[slot];
+        if ((((chain ^ hash) & ~1U) == 0) && (strcmp(symName, symTab[symHash->index[slot]].name) == 0)) {
+            return symTab[symHash->index[slot]].addr;
+        }
+        slot++;
+    } while ((chain & 1U) == 0);
+    return NULL;
+}
+
+static struct DynModuleSymHash *OsDynModuleOsSymHashGet(const struct DynModuleSymTab *symTab, U32 symNum)
+{
+    struct DynModuleSymHash *expect = NULL;
+    struct DynModuleSymHash *symHash = __atomic_load_n(&g_osSymHash, __ATOMIC_ACQUIRE);
+
+    if (symHash != NULL) {
+        return symHash;
+    }
+    symHash = OsDynModuleSymHashCreate(symTab, symNum);
+    if (symHash == NULL) {
+        return NULL;
+    }
+    /* 多个加载者同时创建时只保留第一个 */
+    if (!__atomic_compare_exchange_n(&g_osSymHash, &expect, symHash, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        (void)PRT_MemFree(OS_MID_DYNAMIC, symHash);
+        return expect;
+    }
+    return symHash;
+}
+
+/* 没有内存创建索引时使用，链接脚本已按名字排序，二分查找失败再顺序查找 */
+static U64 OsDynModuleOsSymSearch(const struct DynModuleSymTab *symTab, U32 symNum, const char *symName)
+{
+    U32 low = 0;
+    U32 high = symNum;
+    U32 mid;
+    S32 cmp;
+
+    while (low < high) {
+        mid = low + ((high - low) >> 1);
+        if (symTab[mid].name == NULL) {
+            break;
+        }
+        cmp = strcmp(symName, symTab[mid].name);
+        if (cmp == 0) {
+            return (U64)(uintptr_t)symTab[mid].addr;
+        }
+        if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    for (mid = 0; mid < symNum; mid++) {
+        if ((symTab[mid].name != NULL) && (strcmp(symName, symTab[mid].name) == 0)) {
+            return (U64)(uintptr_t)symTab[mid].addr;
         }
     }
     return OS_MODULE_OK;
 }
 
+U64 OsDynModuleFindSymFromOs(const char *symName)
+{
+    const struct DynModuleSymTab *symTab = (const struct DynModuleSymTab *)&os_symtab_start;
+    U32 symNum = (U32)((const struct DynModuleSymTab *)&os_symtab_end - symTab);
+    struct DynModuleSymHash *symHash = NULL;
+
+    if (symName == NULL) {
+        return 0;
+    }
+
+    symHash = OsDynModuleOsSymHashGet(symTab, symNum);
+    if (symHash == NULL) {
+        return OsDynModuleOsSymSearch(symTab, symNum, symName);
+    }
+    return (U64)(uintptr_t)OsDynModuleSymHashFind(symHash, symTab, symName);
+}
+
 /* 在这里使用OS_SYMBOL_EXPORT来导出动态加载需要的OS的符号表，否则找不到符号表，加载失败 */
 OS_SYMBOL_EXPORT(PRT_MemAlloc);
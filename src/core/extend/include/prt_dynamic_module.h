@@ -17,16 +17,42 @@
 
 #include "prt_typedef.h"
 
+#define OS_MAX_MODULE_NUM                 5       // 最大可以加载5个模块
+#define OS_MODULE_NAME_LEN                64      // 模块文件路径最大长度，超出部分截断
+
 struct DynModuleSymTab
 {
     void *addr;                             // 符号地址
     char *name;                             // 符号名称
 };
 
+/* 已加载模块的地址映射信息，供perf等维测工具把运行地址还原到模块文件 */
+struct DynModuleMapInfo
+{
+    uintptr_t start;                        // 加载段运行起始地址
+    uintptr_t end;                          // 加载段运行结束地址
+    uintptr_t vaddr;                        // 运行起始地址对应的ELF虚拟地址
+    char name[OS_MODULE_NAME_LEN];          // 模块文件路径
+};
+
+/* 模块加载段的访问权限，与ELF程序头p_flags的PF_R/PF_W/PF_X对应 */
+#define OS_MODULE_PROT_READ               0x1U
+#define OS_MODULE_PROT_WRITE              0x2U
+#define OS_MODULE_PROT_EXEC               0x4U
+
+/*
+ * 模块加载段权限设置钩子，由具备MMU/MPU的单板实现，addr和size按页对齐。
+ * 加载完成后按段调用，代码段为READ|EXEC，只有PF_X的段为EXEC(执行不可读)，数据段为READ|WRITE；
+ * 卸载时以READ|WRITE调用恢复整块内存后再释放。返回非0表示设置失败。
+ */
+typedef U32 (*DynModuleProtectHook)(uintptr_t addr, uintptr_t size, U32 prot);
+
 #define OS_SECTION(info) __attribute__((section(info)))
+/* 每个符号放在独立的.OsSymTab.<symbol>段，链接脚本用SORT_BY_NAME排序后OS符号表按名字有序 */
 #define OS_SYMBOL_EXPORT(symbol) \
 const char __dynModule_##symbol##_name[] OS_SECTION(".test") = { #symbol }; \
-const struct DynModuleSymTab __dynModule_##symbol OS_SECTION(".OsSymTab") = { (void *)&symbol, __dynModule_##symbol##_name };
+const struct DynModuleSymTab __dynModule_##symbol OS_SECTION(".OsSymTab." #symbol) = \
+    { (void *)&symbol, (char *)__dynModule_##symbol##_name };
 
 /**
  * 动态加载模块函数
@@ -62,4 +88,22 @@ void OsDynModuleUnload(void *handle);
  */
 const char *OsDynModuleGetError(void);
 
+/**
+ * 注册模块加载段权限设置钩子，未注册时加载段保持可读写可执行。
+ *
+ * @param hook 权限设置函数，传NULL取消注册。
+ */
+void OsDynModuleSetProtectHook(DynModuleProtectHook hook);
+
+/**
+ * 获取已加载模块的地址映射信息
+ *
+ * 只返回加载完成的模块，信息为调用时刻的快照。
+ *
+ * @param maps 保存映射信息的数组。
+ * @param maxNum 数组元素个数。
+ * @return 返回写入的映射信息个数。
+ */
+U32 OsDynModuleGetMaps(struct DynModuleMapInfo *maps, U32 maxNum);
+
 #endif
@@ -19,6 +19,9 @@
 #include "prt_list_external.h"
 #include "prt_cpu_external.h"
 #include "prt_raw_spinlock_external.h"
+#if defined(OS_OPTION_QUEUE_SPSC)
+#include "prt_sem.h"
+#endif
 
 /* 模块间宏定义 */
 #define OS_QUEUE_NODE_HEAD_LEN (sizeof(struct QueNode) - 2)
@@ -34,6 +37,15 @@
 
 #define OS_QUEUE_INNER_ID(queueId)  ((queueId) - 1)
 #define OS_QUEUE_ID(innerId)  ((innerId) + 1)
+
+/* 队列模式，零拷贝队列的节点只保存消息缓冲区指针 */
+#define OS_QUEUE_MODE_COPY         0
+#define OS_QUEUE_MODE_ZERO_COPY    1
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+#define OS_QUEUE_MODE_GET(queueCb) ((queueCb)->queueMode)
+#else
+#define OS_QUEUE_MODE_GET(queueCb) OS_QUEUE_MODE_COPY
+#endif
 extern volatile uintptr_t g_mcInitGuard;
 #if defined(OS_OPTION_SMP)
 #define QUEUE_CB_LOCK(queue)    OS_MCMUTEX_LOCK(0, &(queue)->queueLock)
@@ -81,6 +93,12 @@ struct TagQueCb {
     U16 writableCnt;
     /* 队列读资源计数器 */
     U16 readableCnt;
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+    /* 队列模式 OS_QUEUE_MODE_COPY/OS_QUEUE_MODE_ZERO_COPY */
+    U16 queueMode;
+    /* 零拷贝队列借出缓冲区使用的内存分区号 */
+    U16 ptNo;
+#endif
     /* 写队列超时LIST */
     struct TagListObject writeList;
     /* 读队列超时LIST */
@@ -97,8 +115,58 @@ struct QueNode {
     U8 buf[2];
 };
 
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+/* 零拷贝队列借出缓冲区的头部，位于返回给用户的缓冲区之前 */
+struct QueLoanHead {
+    /* 借出缓冲区的队列ID，释放后清零 */
+    U32 queueId;
+    /* 借出的缓冲区大小，提交后为消息实际大小 */
+    U32 size;
+    /* 缓冲区已提交到队列中，被读取后清除 */
+    U32 committed;
+    /* 保留，头部保持16字节，不改变用户缓冲区的对齐 */
+    U32 reserved;
+};
+
+#define OS_QUEUE_LOAN_HEAD(buf) ((struct QueLoanHead *)(uintptr_t)(buf) - 1)
+#endif
+
+#if defined(OS_OPTION_QUEUE_SPSC)
+#define OS_QUEUE_SPSC_MAGIC         0x53505343U
+#define OS_QUEUE_SPSC_CACHE_LINE    64
+
+/*
+ * 单生产者单消费者队列控制块，tail只由生产者修改，head和waiting由消费者设置，
+ * 生产者和消费者各自修改的字段放在不同cache line，避免伪共享
+ */
+struct TagSpscQue {
+    U32 magic;
+    /* 节点个数减1 */
+    U32 mask;
+    /* 节点大小 */
+    U32 entrySize;
+    /* 消费者阻塞等待使用的计数信号量 */
+    SemHandle sem;
+    /* 环形缓冲区 */
+    U8 *ring;
+    /* 生产者写位置，自由增长，取模后为节点下标 */
+    volatile U32 tail __attribute__((aligned(OS_QUEUE_SPSC_CACHE_LINE)));
+    /* 消费者读位置 */
+    volatile U32 head __attribute__((aligned(OS_QUEUE_SPSC_CACHE_LINE)));
+    /* 消费者已阻塞或即将阻塞，生产者写入后需要唤醒 */
+    volatile U32 waiting;
+};
+#endif
+
 /* 队列最大个数 */
 extern U16 g_maxQueue;
 extern struct TagQueCb *g_allQueue;
 
+extern U32 OsQueueCreate(U16 nodeNum, U16 maxNodeSize, U32 *queueId);
+extern U32 OsQueueRead(U32 queueId, void *bufferAddr, U32 *len, U32 timeOut, U16 mode);
+extern U32 OsQueueWrite(U32 queueId, void *bufferAddr, U32 bufferSize, U32 timeOut, U32 prio, U16 mode);
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+extern void OsQueueZeroCopyDrain(struct TagQueCb *queueCb);
+#endif
+
 #endif /* PRT_QUEUE_EXTERNAL_H */
@@ -44,7 +44,6 @@
 #define GET_MUTEX_TYPE(semType) (U32)(((semType) >> SEM_TYPE_BIT_WIDTH) & ((1U << SEM_TYPE_BIT_WIDTH) - 1))
 #define GET_SEM_PROTOCOL(semType) (U32)((semType) >> SEM_PROTOCOL_BIT_WIDTH)
 #if defined(OS_OPTION_SMP)
-extern volatile uintptr_t g_semPrioLock;
 #define SEM_CB_LOCK(sem) OS_MCMUTEX_LOCK(0, &(sem)->semLock)
 #define SEM_CB_UNLOCK(sem) OS_MCMUTEX_UNLOCK(0, &(sem)->semLock)
 #define RW_CB_LOCK(rwSpin) OS_MCMUTEX_LOCK(0, rwSpin)
@@ -123,54 +122,86 @@ extern U16 g_maxSem;
 /* 指向核内信号量控制块 */
 extern struct TagSemCb *g_allSem;
 
+/*
+ * 优先级继承的锁顺序：semCb锁 -> 持有者任务的semBLock -> 任务rq锁。
+ * 持有互斥信号量的任务的semBList，以及该任务所持有互斥信号量的semList，均在持有者semBLock内修改，
+ * 同一时刻最多持有一个semCb锁和一个semBLock，多级继承逐级换锁，不同继承链之间互不竞争。
+ */
 #if defined(OS_OPTION_SMP)
-// 需要保证锁顺序避免死锁，在semCb锁内，在task rq锁外
-OS_SEC_ALW_INLINE INLINE void OsSemPrioLock(void)
+OS_SEC_ALW_INLINE INLINE void OsSemOwnerLock(struct TagTskCb *taskCb)
 {
-    OS_MCMUTEX_LOCK(0, &g_semPrioLock);
+    OS_MCMUTEX_LOCK(0, &taskCb->semBLock);
 }
 
-OS_SEC_ALW_INLINE INLINE void OsSemPrioUnLock(void)
+OS_SEC_ALW_INLINE INLINE void OsSemOwnerUnLock(struct TagTskCb *taskCb)
 {
-    OS_MCMUTEX_UNLOCK(0, &g_semPrioLock);
+    OS_MCMUTEX_UNLOCK(0, &taskCb->semBLock);
 }
-
-// 需要保证锁顺序避免死锁，在semCb锁内，在task rq锁外
-OS_SEC_ALW_INLINE INLINE void OsSemIfPrioLock(struct TagSemCb *sem)
+#else
+OS_SEC_ALW_INLINE INLINE void OsSemOwnerLock(struct TagTskCb *taskCb)
 {
-   if (sem->semMode == SEM_MODE_PRIOR) {
-        OsSemPrioLock();
-   }
+    (void)taskCb;
 }
 
-OS_SEC_ALW_INLINE INLINE void OsSemIfPrioUnLock(struct TagSemCb *sem)
+OS_SEC_ALW_INLINE INLINE void OsSemOwnerUnLock(struct TagTskCb *taskCb)
 {
-   if (sem->semMode == SEM_MODE_PRIOR) {
-        OsSemPrioUnLock();
-   }
+    (void)taskCb;
 }
-#else
-OS_SEC_ALW_INLINE INLINE void OsSemPrioLock(void)
+#endif
+
+/*
+ * 描述：互斥信号量已被持有时锁住持有者，返回持有者任务，否则返回NULL，需要在semCb锁内调用
+ */
+OS_SEC_ALW_INLINE INLINE struct TagTskCb *OsSemIfOwnerLock(struct TagSemCb *sem)
 {
+    struct TagTskCb *owner;
+
+    if (GET_SEM_TYPE(sem->semType) != SEM_TYPE_BIN || sem->semOwner == OS_INVALID_OWNER_ID) {
+        return NULL;
+    }
 
+    owner = GET_TCB_HANDLE(sem->semOwner);
+    OsSemOwnerLock(owner);
+    return owner;
 }
-OS_SEC_ALW_INLINE INLINE void OsSemPrioUnLock(void)
+
+OS_SEC_ALW_INLINE INLINE void OsSemIfOwnerUnLock(struct TagTskCb *owner)
 {
-    
+    if (owner != NULL) {
+        OsSemOwnerUnLock(owner);
+    }
 }
 
-OS_SEC_ALW_INLINE INLINE void OsSemIfPrioLock(struct TagSemCb *sem)
+extern U32 OsSemCreate(U32 count, U32 semType, enum SemMode semMode, SemHandle *semHandle, U32 cookie);
+extern bool OsSemBusy(SemHandle semHandle);
+
+#if defined(OS_OPTION_POSIX)
+/*
+ * pthread互斥锁的用户态持有者字：0表示空闲，低31位为持有任务PID + 1，
+ * OS_MUTEX_WAITERS表示有任务阻塞在内核信号量上，此时信号量由持有任务持有，解锁必须进入内核。
+ * 未置位OS_MUTEX_WAITERS时内核信号量保持空闲，加解锁只做一次CAS。
+ */
+#define OS_MUTEX_WAITERS           0x80000000U
+#define OS_MUTEX_OWNER_ID(pid)     ((U32)(pid) + 1U)
+#define OS_MUTEX_OWNER_PID(val)    (((val) & ~OS_MUTEX_WAITERS) - 1U)
+
+OS_SEC_ALW_INLINE INLINE U32 OsMutexOwnerGet(volatile U32 *owner)
 {
-   (void)sem;
+    return __atomic_load_n(owner, __ATOMIC_ACQUIRE);
 }
 
-OS_SEC_ALW_INLINE INLINE void OsSemIfPrioUnLock(struct TagSemCb *sem)
+OS_SEC_ALW_INLINE INLINE void OsMutexOwnerSet(volatile U32 *owner, U32 val)
 {
-   (void)sem;
+    __atomic_store_n(owner, val, __ATOMIC_RELEASE);
 }
-#endif
 
-extern U32 OsSemCreate(U32 count, U32 semType, enum SemMode semMode, SemHandle *semHandle, U32 cookie);
-extern bool OsSemBusy(SemHandle semHandle);
+OS_SEC_ALW_INLINE INLINE bool OsMutexOwnerCas(volatile U32 *owner, U32 oldVal, U32 newVal)
+{
+    return __atomic_compare_exchange_n(owner, &oldVal, newVal, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+extern U32 OsSemMutexPend(SemHandle semHandle, volatile U32 *owner, U32 timeout);
+extern U32 OsSemMutexPost(SemHandle semHandle, volatile U32 *owner);
+#endif
 
 #endif /* PRT_SEM_EXTERNAL_H */
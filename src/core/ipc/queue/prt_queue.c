@@ -16,6 +16,7 @@
 #include "prt_task_external.h"
 #include "prt_asm_cpu_external.h"
 #include "prt_task_sched_external.h"
+#include "prt_lib_external.h"
 
 OS_SEC_ALW_INLINE INLINE U32 OsGetSrcPid(void)
 {
@@ -143,9 +144,25 @@ OS_SEC_ALW_INLINE INLINE bool OsQueuePendNeedProc(struct TagListObject *objectLi
 }
 
 /*
- * 描述：读指定队列
+ * 描述：批量读写释放出num个资源，依次交给阻塞的任务，剩余的计入资源计数，返回是否唤醒了任务
  */
-OS_SEC_L4_TEXT U32 PRT_QueueRead(U32 queueId, void *bufferAddr, U32 *len, U32 timeOut)
+OS_SEC_ALW_INLINE INLINE bool OsQueuePendBatchProc(struct TagListObject *objectList, U16 *count, U32 num)
+{
+    bool resumed = FALSE;
+
+    while ((num > 0) && OsQueuePendNeedProc(objectList)) {
+        resumed = TRUE;
+        num--;
+    }
+
+    *count += (U16)num;
+    return resumed;
+}
+
+/*
+ * 描述：读指定队列，零拷贝队列的节点数据为消息缓冲区指针
+ */
+OS_SEC_L4_TEXT U32 OsQueueRead(U32 queueId, void *bufferAddr, U32 *len, U32 timeOut, U16 mode)
 {
     uintptr_t intSave;
     U32 ret;
@@ -176,6 +193,11 @@ OS_SEC_L4_TEXT U32 PRT_QueueRead(U32 queueId, void *bufferAddr, U32 *len, U32 ti
         goto QUEUE_END;
     }
 
+    if (OS_QUEUE_MODE_GET(queueCb) != mode) {
+        ret = OS_ERRNO_QUEUE_MODE_INVALID;
+        goto QUEUE_END;
+    }
+
     /* 读队列PEND */
     ret = OsInnerPend(&queueCb->readableCnt, &queueCb->readList, timeOut, queueCb);
     if (ret != OS_OK) {
@@ -217,6 +239,104 @@ QUEUE_END:
     return ret;
 }
 
+/*
+ * 描述：读指定队列
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueRead(U32 queueId, void *bufferAddr, U32 *len, U32 timeOut)
+{
+    return OsQueueRead(queueId, bufferAddr, len, timeOut, OS_QUEUE_MODE_COPY);
+}
+
+/*
+ * 描述：批量读指定队列，一次持锁读取多个消息，读完后统一唤醒写等待任务
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueReadBatch(U32 queueId, void *bufferAddr, U32 msgSize, U32 *lens, U32 maxNum, U32 *num,
+                                      U32 timeOut)
+{
+    uintptr_t intSave;
+    U32 ret;
+    U32 cnt;
+    U32 len;
+    U32 loop;
+    U32 innerId = OS_QUEUE_INNER_ID(queueId);
+    struct TagQueCb *queueCb = NULL;
+    struct QueNode *queueNode = NULL;
+
+    if (innerId >= g_maxQueue) {
+        return OS_ERRNO_QUEUE_INVALID;
+    }
+
+    if ((bufferAddr == NULL) || (num == NULL)) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    if (msgSize == 0) {
+        return OS_ERRNO_QUEUE_SIZE_ZERO;
+    }
+
+    if (maxNum == 0) {
+        return OS_ERRNO_QUEUE_BATCH_NUM_ZERO;
+    }
+
+    if (msgSize > (OS_MAX_U32 / maxNum)) {
+        return OS_ERRNO_QUEUE_SIZE_TOO_BIG;
+    }
+
+    queueCb = (struct TagQueCb *)GET_QUEUE_HANDLE(innerId);
+
+    QUEUE_CB_IRQ_LOCK(queueCb, intSave);
+    if (queueCb->queueState == OS_QUEUE_UNUSED) {
+        ret = OS_ERRNO_QUEUE_NOT_CREATE;
+        goto QUEUE_END;
+    }
+
+    if (OS_QUEUE_MODE_GET(queueCb) != OS_QUEUE_MODE_COPY) {
+        ret = OS_ERRNO_QUEUE_MODE_INVALID;
+        goto QUEUE_END;
+    }
+
+    /* 读队列PEND，返回成功时已占有一个可读节点 */
+    ret = OsInnerPend(&queueCb->readableCnt, &queueCb->readList, timeOut, queueCb);
+    if (ret != OS_OK) {
+        goto QUEUE_END;
+    }
+
+    /* 再取走其余可读节点 */
+    cnt = (queueCb->readableCnt < (maxNum - 1)) ? queueCb->readableCnt : (maxNum - 1);
+    queueCb->readableCnt -= (U16)cnt;
+    cnt++;
+
+    for (loop = 0; loop < cnt; loop++) {
+        queueNode = (struct QueNode *)(uintptr_t)&queueCb->queue[(queueCb->queueHead) * (queueCb->nodeSize)];
+        len = (msgSize > queueNode->size) ? queueNode->size : msgSize;
+        if (memcpy_s((U8 *)bufferAddr + loop * msgSize, msgSize, (void *)queueNode->buf, len) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+
+        if (lens != NULL) {
+            lens[loop] = len;
+        }
+
+        queueNode->srcPid = OS_QUEUE_PID_INVALID;
+        queueCb->queueHead++;
+        if (queueCb->queueHead == queueCb->nodeNum) {
+            queueCb->queueHead = 0;
+        }
+    }
+
+    *num = cnt;
+    if (OsQueuePendBatchProc(&queueCb->writeList, &queueCb->writableCnt, cnt)) {
+        QUEUE_CB_UNLOCK(queueCb);
+        OsTskSchedule();
+        OsIntRestore(intSave);
+        return OS_OK;
+    }
+
+QUEUE_END:
+    QUEUE_CB_IRQ_UNLOCK(queueCb, intSave);
+    return ret;
+}
+
 OS_SEC_L4_TEXT U32 OsQueueWriteParaCheck(U32 innerId, uintptr_t bufferAddr, U32 bufferSize, U32 prio)
 {
     if (innerId >= g_maxQueue) {
@@ -278,9 +398,9 @@ OS_SEC_ALW_INLINE INLINE void OsQueueCpData2Node(U32 prio, uintptr_t bufferAddr,
 }
 
 /*
- * 描述：写指定队列
+ * 描述：写指定队列，零拷贝队列的节点数据为消息缓冲区指针
  */
-OS_SEC_L4_TEXT U32 PRT_QueueWrite(U32 queueId, void *bufferAddr, U32 bufferSize, U32 timeOut, U32 prio)
+OS_SEC_L4_TEXT U32 OsQueueWrite(U32 queueId, void *bufferAddr, U32 bufferSize, U32 timeOut, U32 prio, U16 mode)
 {
     U32 ret;
     uintptr_t intSave;
@@ -300,6 +420,11 @@ OS_SEC_L4_TEXT U32 PRT_QueueWrite(U32 queueId, void *bufferAddr, U32 bufferSize,
         goto QUEUE_END;
     }
 
+    if (OS_QUEUE_MODE_GET(queueCb) != mode) {
+        ret = OS_ERRNO_QUEUE_MODE_INVALID;
+        goto QUEUE_END;
+    }
+
     if (bufferSize > (queueCb->nodeSize - OS_QUEUE_NODE_HEAD_LEN)) {
         ret = OS_ERRNO_QUEUE_SIZE_TOO_BIG;
         goto QUEUE_END;
@@ -327,3 +452,85 @@ QUEUE_END:
     QUEUE_CB_IRQ_UNLOCK(queueCb, intSave);
     return ret;
 }
+
+/*
+ * 描述：写指定队列
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueWrite(U32 queueId, void *bufferAddr, U32 bufferSize, U32 timeOut, U32 prio)
+{
+    return OsQueueWrite(queueId, bufferAddr, bufferSize, timeOut, prio, OS_QUEUE_MODE_COPY);
+}
+
+/*
+ * 描述：批量写指定队列，一次持锁写入多个消息，写完后统一唤醒读等待任务
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueWriteBatch(U32 queueId, void *bufferAddr, U32 msgSize, U32 msgNum, U32 *num, U32 timeOut,
+                                       U32 prio)
+{
+    U32 ret;
+    U32 cnt;
+    U32 loop;
+    U32 idx;
+    uintptr_t intSave;
+    U32 innerId = OS_QUEUE_INNER_ID(queueId);
+    struct TagQueCb *queueCb = NULL;
+
+    ret = OsQueueWriteParaCheck(innerId, (uintptr_t)bufferAddr, msgSize, prio);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    if (num == NULL) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    if (msgNum == 0) {
+        return OS_ERRNO_QUEUE_BATCH_NUM_ZERO;
+    }
+
+    queueCb = (struct TagQueCb *)GET_QUEUE_HANDLE(innerId);
+    QUEUE_CB_IRQ_LOCK(queueCb, intSave);
+    if (queueCb->queueState == OS_QUEUE_UNUSED) {
+        ret = OS_ERRNO_QUEUE_NOT_CREATE;
+        goto QUEUE_END;
+    }
+
+    if (OS_QUEUE_MODE_GET(queueCb) != OS_QUEUE_MODE_COPY) {
+        ret = OS_ERRNO_QUEUE_MODE_INVALID;
+        goto QUEUE_END;
+    }
+
+    if (msgSize > (queueCb->nodeSize - OS_QUEUE_NODE_HEAD_LEN)) {
+        ret = OS_ERRNO_QUEUE_SIZE_TOO_BIG;
+        goto QUEUE_END;
+    }
+
+    /* 写队列PEND，返回成功时已占有一个空闲节点 */
+    ret = OsInnerPend(&queueCb->writableCnt, &queueCb->writeList, timeOut, queueCb);
+    if (ret != OS_OK) {
+        goto QUEUE_END;
+    }
+
+    /* 再占用其余空闲节点，空闲节点不足时只写入部分消息 */
+    cnt = (queueCb->writableCnt < (msgNum - 1)) ? queueCb->writableCnt : (msgNum - 1);
+    queueCb->writableCnt -= (U16)cnt;
+    cnt++;
+
+    for (loop = 0; loop < cnt; loop++) {
+        /* 紧急消息逐个插到队列头上，倒序写入以保持批内顺序 */
+        idx = (prio == (U32)OS_QUEUE_NORMAL) ? loop : (cnt - 1 - loop);
+        OsQueueCpData2Node(prio, (uintptr_t)bufferAddr + idx * msgSize, msgSize, queueCb);
+    }
+
+    *num = cnt;
+    if (OsQueuePendBatchProc(&queueCb->readList, &queueCb->readableCnt, cnt)) {
+        QUEUE_CB_UNLOCK(queueCb);
+        OsTskSchedule();
+        OsIntRestore(intSave);
+        return OS_OK;
+    }
+
+QUEUE_END:
+    QUEUE_CB_IRQ_UNLOCK(queueCb, intSave);
+    return ret;
+}
@@ -47,6 +47,13 @@ OS_SEC_L4_TEXT U32 PRT_QueueDelete(U32 queueId)
         goto QUEUE_END;
     }
 
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+    /* 零拷贝队列中未被读取的消息缓冲区随队列一并释放 */
+    if (queueCb->queueMode == OS_QUEUE_MODE_ZERO_COPY) {
+        OsQueueZeroCopyDrain(queueCb);
+    }
+#endif
+
     ret = PRT_MemFree((U32)OS_MID_QUEUE, (void *)(queueCb->queue));
     if (ret != OS_OK) {
         goto QUEUE_END;
@@ -115,6 +115,9 @@ OS_SEC_L4_TEXT U32 OsQueueCreate(U16 nodeNum, U16 maxNodeSize, U32 *queueId)
     queueCb->queueTail = 0;
     queueCb->nodePeak = 0;
     queueCb->readableCnt = 0;
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+    queueCb->queueMode = OS_QUEUE_MODE_COPY;
+#endif
 
     *queueId = qId;
 
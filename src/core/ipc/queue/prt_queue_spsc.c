@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-22
+ * Description: 单生产者单消费者无锁队列，用于中断向任务传递数据
+ */
+#include "securec.h"
+#include "prt_queue_external.h"
+#include "prt_mem_external.h"
+#include "prt_lib_external.h"
+#include "prt_task_external.h"
+
+/*
+ * 唤醒协议：消费者先置waiting再复查tail，生产者先写tail再查waiting，两侧均为顺序一致的原子操作，
+ * 因此至少有一方能看到对方的写入，不会出现消费者阻塞而数据已写入却没有唤醒的情况。
+ * 生产者交换waiting为0后才post信号量，多余的post只会让消费者多醒一次后重新检查。
+ */
+
+OS_SEC_ALW_INLINE INLINE struct TagSpscQue *OsQueueSpscGet(SpscQueHandle handle)
+{
+    struct TagSpscQue *que = (struct TagSpscQue *)handle;
+
+    if ((que == NULL) || (que->magic != OS_QUEUE_SPSC_MAGIC)) {
+        return NULL;
+    }
+    return que;
+}
+
+/*
+ * 描述：消费者批量取出最多maxNum个节点，只读写head，环绕时分两段拷贝
+ */
+OS_SEC_ALW_INLINE INLINE U32 OsQueueSpscDrain(struct TagSpscQue *que, U8 *buf, U32 maxNum)
+{
+    U32 head = que->head;
+    U32 cnt = __atomic_load_n(&que->tail, __ATOMIC_ACQUIRE) - head;
+    U32 idx = head & que->mask;
+    U32 first;
+
+    if (cnt == 0) {
+        return 0;
+    }
+
+    if (cnt > maxNum) {
+        cnt = maxNum;
+    }
+
+    first = que->mask + 1 - idx;
+    if (first > cnt) {
+        first = cnt;
+    }
+
+    if (memcpy_s(buf, first * que->entrySize, &que->ring[idx * que->entrySize], first * que->entrySize) != EOK) {
+        OS_GOTO_SYS_ERROR1();
+    }
+
+    if (cnt > first) {
+        if (memcpy_s(&buf[first * que->entrySize], (cnt - first) * que->entrySize, que->ring,
+            (cnt - first) * que->entrySize) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+    }
+
+    __atomic_store_n(&que->head, head + cnt, __ATOMIC_RELEASE);
+    return cnt;
+}
+
+/*
+ * 描述：创建单生产者单消费者队列，控制块和环形缓冲区一次申请
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueSpscCreate(U32 entryNum, U32 entrySize, SpscQueHandle *handle)
+{
+    U32 ret;
+    U32 size;
+    struct TagSpscQue *que = NULL;
+
+    if (handle == NULL) {
+        return OS_ERRNO_QUEUE_CREAT_PTR_NULL;
+    }
+
+    if ((entryNum == 0) || (entrySize == 0)) {
+        return OS_ERRNO_QUEUE_PARA_ZERO;
+    }
+
+    if ((entryNum & (entryNum - 1)) != 0) {
+        return OS_ERRNO_QUEUE_SPSC_NUM_INVALID;
+    }
+
+    if (entrySize > ((OS_MAX_U32 - sizeof(struct TagSpscQue)) / entryNum)) {
+        return OS_ERRNO_QUEUE_NSIZE_INVALID;
+    }
+
+    size = sizeof(struct TagSpscQue) + entryNum * entrySize;
+    que = (struct TagSpscQue *)PRT_MemAllocAlign(OS_MID_QUEUE, OS_MEM_DEFAULT_FSC_PT, size, MEM_ADDR_ALIGN_064);
+    if (que == NULL) {
+        return OS_ERRNO_QUEUE_CREATE_NO_MEMORY;
+    }
+
+    if (memset_s(que, sizeof(struct TagSpscQue), 0, sizeof(struct TagSpscQue)) != EOK) {
+        OS_GOTO_SYS_ERROR1();
+    }
+
+    ret = PRT_SemCreate(0, &que->sem);
+    if (ret != OS_OK) {
+        (void)PRT_MemFree((U32)OS_MID_QUEUE, (void *)que);
+        return ret;
+    }
+
+    que->mask = entryNum - 1;
+    que->entrySize = entrySize;
+    que->ring = (U8 *)(que + 1);
+    que->magic = OS_QUEUE_SPSC_MAGIC;
+
+    *handle = (SpscQueHandle)que;
+    return OS_OK;
+}
+
+/*
+ * 描述：删除单生产者单消费者队列
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueSpscDelete(SpscQueHandle handle)
+{
+    U32 ret;
+    struct TagSpscQue *que = OsQueueSpscGet(handle);
+
+    if (que == NULL) {
+        return OS_ERRNO_QUEUE_INVALID;
+    }
+
+    /* 消费者仍阻塞在信号量上时删除失败 */
+    ret = PRT_SemDelete(que->sem);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    que->magic = 0;
+    return PRT_MemFree((U32)OS_MID_QUEUE, (void *)que);
+}
+
+/*
+ * 描述：生产者写入一个节点，无锁无等待，只有消费者在等待时才post信号量
+ */
+OS_SEC_L0_TEXT U32 PRT_QueueSpscPut(SpscQueHandle handle, const void *entry)
+{
+    U32 tail;
+    struct TagSpscQue *que = OsQueueSpscGet(handle);
+
+    if (que == NULL) {
+        return OS_ERRNO_QUEUE_INVALID;
+    }
+
+    if (entry == NULL) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    tail = que->tail;
+    if ((tail - __atomic_load_n(&que->head, __ATOMIC_ACQUIRE)) > que->mask) {
+        return OS_ERRNO_QUEUE_NO_SOURCE;
+    }
+
+    if (memcpy_s(&que->ring[(tail & que->mask) * que->entrySize], que->entrySize, entry, que->entrySize) != EOK) {
+        OS_GOTO_SYS_ERROR1();
+    }
+
+    __atomic_store_n(&que->tail, tail + 1, __ATOMIC_SEQ_CST);
+
+    if ((__atomic_load_n(&que->waiting, __ATOMIC_SEQ_CST) != 0) &&
+        (__atomic_exchange_n(&que->waiting, 0, __ATOMIC_ACQ_REL) != 0)) {
+        return PRT_SemPost(que->sem);
+    }
+    return OS_OK;
+}
+
+/*
+ * 描述：消费者批量读取节点，队列非空时不加锁，为空时阻塞在信号量上
+ */
+OS_SEC_L0_TEXT U32 PRT_QueueSpscGet(SpscQueHandle handle, void *buf, U32 maxNum, U32 *num, U32 timeOut)
+{
+    U32 ret;
+    U32 cnt;
+    U32 waitTicks = timeOut;
+    U64 elapsed;
+    U64 start = 0;
+    bool timing = FALSE;
+    struct TagSpscQue *que = OsQueueSpscGet(handle);
+
+    if (que == NULL) {
+        return OS_ERRNO_QUEUE_INVALID;
+    }
+
+    if ((buf == NULL) || (num == NULL)) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    if (maxNum == 0) {
+        return OS_ERRNO_QUEUE_SIZE_ZERO;
+    }
+
+    while (TRUE) {
+        cnt = OsQueueSpscDrain(que, (U8 *)buf, maxNum);
+        if (cnt != 0) {
+            *num = cnt;
+            return OS_OK;
+        }
+
+        if (timeOut == OS_QUEUE_NO_WAIT) {
+            return OS_ERRNO_QUEUE_NO_SOURCE;
+        }
+
+        if (OS_INT_ACTIVE) {
+            return OS_ERRNO_QUEUE_IN_INTERRUPT;
+        }
+
+        /* 多余的post会让消费者空醒一次，重新等待时只等剩余的tick数，总等待时间不超过timeOut */
+        if (timeOut != OS_QUEUE_WAIT_FOREVER) {
+            if (!timing) {
+                start = PRT_TickGetCount();
+                timing = TRUE;
+            } else {
+                elapsed = PRT_TickGetCount() - start;
+                if (elapsed >= timeOut) {
+                    return OS_ERRNO_QUEUE_TIMEOUT;
+                }
+                waitTicks = timeOut - (U32)elapsed;
+            }
+        }
+
+        /* 声明等待后复查，生产者在此之前写入的数据在这里可见 */
+        __atomic_store_n(&que->waiting, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&que->tail, __ATOMIC_SEQ_CST) != que->head) {
+            __atomic_store_n(&que->waiting, 0, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        ret = PRT_SemPend(que->sem, waitTicks);
+        if (ret != OS_OK) {
+            __atomic_store_n(&que->waiting, 0, __ATOMIC_RELAXED);
+            /* 超时与写入同时发生时以数据为准 */
+            cnt = OsQueueSpscDrain(que, (U8 *)buf, maxNum);
+            if (cnt != 0) {
+                *num = cnt;
+                return OS_OK;
+            }
+            return (ret == OS_ERRNO_SEM_TIMEOUT) ? OS_ERRNO_QUEUE_TIMEOUT : ret;
+        }
+    }
+}
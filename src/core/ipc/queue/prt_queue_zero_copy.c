@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-15
+ * Description: 零拷贝队列实现，队列节点只传递消息缓冲区指针
+ */
+#include "securec.h"
+#include "prt_queue_external.h"
+#include "prt_mem_external.h"
+#include "prt_lib_external.h"
+
+OS_SEC_ALW_INLINE INLINE U32 OsQueueZeroCopyGet(U32 queueId, struct TagQueCb **queueCb)
+{
+    U32 innerId = OS_QUEUE_INNER_ID(queueId);
+
+    if (innerId >= g_maxQueue) {
+        return OS_ERRNO_QUEUE_INVALID;
+    }
+
+    *queueCb = (struct TagQueCb *)GET_QUEUE_HANDLE(innerId);
+    if ((*queueCb)->queueState == OS_QUEUE_UNUSED) {
+        return OS_ERRNO_QUEUE_NOT_CREATE;
+    }
+
+    if ((*queueCb)->queueMode != OS_QUEUE_MODE_ZERO_COPY) {
+        return OS_ERRNO_QUEUE_MODE_INVALID;
+    }
+    return OS_OK;
+}
+
+/*
+ * 描述：创建零拷贝队列，队列节点只保存消息缓冲区指针
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueCreateZeroCopy(U16 nodeNum, U8 ptNo, U32 *queueId)
+{
+    uintptr_t intSave;
+    U32 ret;
+    U32 qId = 0;
+    struct TagQueCb *queueCb = NULL;
+
+    if (queueId == NULL) {
+        return OS_ERRNO_QUEUE_CREAT_PTR_NULL;
+    }
+
+    if (nodeNum == 0) {
+        return OS_ERRNO_QUEUE_PARA_ZERO;
+    }
+
+    QUEUE_INIT_IRQ_LOCK(intSave);
+    ret = OsQueueCreate(nodeNum, (U16)sizeof(void *), &qId);
+    if (ret != OS_OK) {
+        QUEUE_INIT_IRQ_UNLOCK(intSave);
+        return ret;
+    }
+
+    queueCb = (struct TagQueCb *)GET_QUEUE_HANDLE(OS_QUEUE_INNER_ID(qId));
+    queueCb->queueMode = OS_QUEUE_MODE_ZERO_COPY;
+    queueCb->ptNo = ptNo;
+
+    *queueId = qId;
+    QUEUE_INIT_IRQ_UNLOCK(intSave);
+    return OS_OK;
+}
+
+/*
+ * 描述：按消息大小从队列的内存分区借出缓冲区，不持有队列锁
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueLoan(U32 queueId, U32 size, void **bufferAddr)
+{
+    U32 ret;
+    struct TagQueCb *queueCb = NULL;
+    struct QueLoanHead *head = NULL;
+
+    if (bufferAddr == NULL) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    if (size == 0) {
+        return OS_ERRNO_QUEUE_SIZE_ZERO;
+    }
+
+    if (size > (OS_MAX_U32 - sizeof(struct QueLoanHead))) {
+        return OS_ERRNO_QUEUE_SIZE_TOO_BIG;
+    }
+
+    ret = OsQueueZeroCopyGet(queueId, &queueCb);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    head = (struct QueLoanHead *)PRT_MemAlloc(OS_MID_QUEUE, (U8)queueCb->ptNo, size + sizeof(struct QueLoanHead));
+    if (head == NULL) {
+        return OS_ERRNO_QUEUE_LOAN_NO_MEMORY;
+    }
+
+    head->queueId = queueId;
+    head->size = size;
+    head->committed = FALSE;
+    *bufferAddr = (void *)(head + 1);
+    return OS_OK;
+}
+
+/*
+ * 描述：提交借出的缓冲区，队列锁内只写入缓冲区指针
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueCommit(U32 queueId, void *bufferAddr, U32 size, U32 timeOut, U32 prio)
+{
+    U32 ret;
+    struct QueLoanHead *head = NULL;
+
+    if (bufferAddr == NULL) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    if (size == 0) {
+        return OS_ERRNO_QUEUE_SIZE_ZERO;
+    }
+
+    head = OS_QUEUE_LOAN_HEAD(bufferAddr);
+    if ((head->queueId != queueId) || (size > head->size)) {
+        return OS_ERRNO_QUEUE_LOAN_INVALID;
+    }
+
+    if (head->committed) {
+        return OS_ERRNO_QUEUE_LOAN_COMMITTED;
+    }
+
+    /* 写入后读取者可能立即取走缓冲区，提交标记需在写入前设置，写入失败时缓冲区仍归调用者 */
+    head->committed = TRUE;
+    head->size = size;
+    ret = OsQueueWrite(queueId, (void *)&bufferAddr, sizeof(void *), timeOut, prio, OS_QUEUE_MODE_ZERO_COPY);
+    if (ret != OS_OK) {
+        head->committed = FALSE;
+    }
+    return ret;
+}
+
+/*
+ * 描述：读取零拷贝队列中最早的消息，缓冲区所有权转移给调用者
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueAcquire(U32 queueId, void **bufferAddr, U32 *len, U32 timeOut)
+{
+    U32 ret;
+    void *buf = NULL;
+    U32 ptrLen = sizeof(void *);
+
+    if ((bufferAddr == NULL) || (len == NULL)) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    ret = OsQueueRead(queueId, (void *)&buf, &ptrLen, timeOut, OS_QUEUE_MODE_ZERO_COPY);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    OS_QUEUE_LOAN_HEAD(buf)->committed = FALSE;
+    *bufferAddr = buf;
+    *len = OS_QUEUE_LOAN_HEAD(buf)->size;
+    return OS_OK;
+}
+
+/*
+ * 描述：归还零拷贝队列的消息缓冲区
+ */
+OS_SEC_L4_TEXT U32 PRT_QueueRelease(U32 queueId, void *bufferAddr)
+{
+    struct QueLoanHead *head = NULL;
+
+    if (bufferAddr == NULL) {
+        return OS_ERRNO_QUEUE_PTR_NULL;
+    }
+
+    head = OS_QUEUE_LOAN_HEAD(bufferAddr);
+    if (head->queueId != queueId) {
+        return OS_ERRNO_QUEUE_LOAN_INVALID;
+    }
+
+    /* 缓冲区仍在队列中，释放后队列节点会指向已释放的内存 */
+    if (head->committed) {
+        return OS_ERRNO_QUEUE_LOAN_COMMITTED;
+    }
+
+    head->queueId = 0;
+    return PRT_MemFree((U32)OS_MID_QUEUE, (void *)head);
+}
+
+/*
+ * 描述：删除零拷贝队列时释放队列中尚未被读取的缓冲区，调用者持有队列锁
+ */
+OS_SEC_L4_TEXT void OsQueueZeroCopyDrain(struct TagQueCb *queueCb)
+{
+    U32 loop;
+    U32 index = queueCb->queueHead;
+    void *buf = NULL;
+    struct QueNode *queueNode = NULL;
+
+    for (loop = 0; loop < queueCb->readableCnt; loop++) {
+        queueNode = (struct QueNode *)(uintptr_t)&queueCb->queue[index * (queueCb->nodeSize)];
+        /* 节点数据区只保证2字节对齐，按字节拷出指针 */
+        if (memcpy_s((void *)&buf, sizeof(buf), (void *)queueNode->buf, sizeof(buf)) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+
+        OS_QUEUE_LOAN_HEAD(buf)->queueId = 0;
+        (void)PRT_MemFree((U32)OS_MID_QUEUE, (void *)OS_QUEUE_LOAN_HEAD(buf));
+        queueNode->srcPid = OS_QUEUE_PID_INVALID;
+
+        index++;
+        if (index == queueCb->nodeNum) {
+            index = 0;
+        }
+    }
+}
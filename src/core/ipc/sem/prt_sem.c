@@ -65,7 +65,7 @@ OS_SEC_ALW_INLINE INLINE U32 OsSemPostErrorCheck(struct TagSemCb *semPosted, Sem
 #endif
 
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
-/* 遍历任务持有的互斥信号量，获取阻塞中任务的最高优先级，需要semPrio锁保护 */
+/* 遍历任务持有的互斥信号量，获取阻塞中任务的最高优先级，需要持有该任务的semBLock */
 OS_SEC_ALW_INLINE INLINE void OsGetPendTskMaxPriority(struct TagTskCb *taskCb, TskPrior *maxPriority)
 {
     TskPrior curMaxPrior = *maxPriority;
@@ -112,7 +112,7 @@ OS_SEC_L4_TEXT U32 OsCheckPrioritySet(struct TagTskCb *taskCb, TskPrior taskPrio
         return OS_OK;
     }
 
-    /* 遍历持有的互斥信号量，获取pend任务的最高优先级，此处需要semIfPrior锁保护 */
+    /* 遍历持有的互斥信号量，获取pend任务的最高优先级，调用者已持有该任务的semBLock */
     OsGetPendTskMaxPriority(taskCb, &maxPriority);
 
     if (taskPrio > maxPriority) {
@@ -127,7 +127,7 @@ OS_SEC_L4_TEXT U32 OsCheckPrioritySet(struct TagTskCb *taskCb, TskPrior taskPrio
  */
 OS_SEC_ALW_INLINE INLINE void OsResortSemList(struct TagTskCb *taskCb)
 {  
-    /* 调整信号量优先级队列，外部需要锁OsSemIfPrioLock，taskrq */
+    /* 调整信号量优先级队列，外部需要锁semCb，信号量持有者的semBLock，taskrq */
     struct TagTskCb *curTskCb = NULL;
     struct TagSemCb *semPended = (struct TagSemCb *)taskCb->taskPend;
 
@@ -148,22 +148,41 @@ OS_SEC_ALW_INLINE INLINE void OsResortSemList(struct TagTskCb *taskCb)
 }
 
 /*
- * 描述：当前任务因为互斥信号量阻塞，需要升高持有互斥信号量的任务的优先级，外部受到semPrio锁保护
+ * 描述：当前任务因为互斥信号量阻塞，需要升高持有互斥信号量的任务的优先级
+ * 备注：在semCb锁外调用，沿阻塞链逐级加锁，每一级只持有当前信号量的semCb锁和其持有者的semBLock，
+ *       换到下一级信号量后重新校验阻塞关系；链在中途解除时由释放、超时路径恢复优先级
  */
 OS_SEC_L0_TEXT void OsPriorityInherit(struct TagSemCb *semPended, struct TagTskCb *runTsk)
 {
+    struct TagTskCb *pendTask = runTsk;
     struct TagTskCb *semOwnerTask;
     struct TagSemCb *recurSem;
     TskPrior newPriority = runTsk->priority;
-    
+
     if (GET_SEM_TYPE(semPended->semType) != SEM_TYPE_BIN) {
         return;
     }
 
-    semOwnerTask = GET_TCB_HANDLE(semPended->semOwner);
+    SEM_CB_LOCK(semPended);
+    while (TSK_STATUS_TST(pendTask, OS_TSK_PEND) && (pendTask->taskPend == (void *)semPended)) {
+        semOwnerTask = OsSemIfOwnerLock(semPended);
+        /* 被提升的中间任务按新优先级重排所阻塞信号量的阻塞队列，当前任务入队时已按优先级插入 */
+        if ((pendTask != runTsk) && (semPended->semMode == SEM_MODE_PRIOR)) {
+            OsSpinLockTaskRq(pendTask);
+            OsResortSemList(pendTask);
+            OsSpinUnlockTaskRq(pendTask);
+        }
+        /* 所阻塞的信号量不为互斥型，直接退出 */
+        if (semOwnerTask == NULL) {
+            break;
+        }
 
-    OsSpinLockTaskRq(semOwnerTask);
-    while (semOwnerTask->priority > newPriority) {
+        OsSpinLockTaskRq(semOwnerTask);
+        if (semOwnerTask->priority <= newPriority) {
+            OsSpinUnlockTaskRq(semOwnerTask);
+            OsSemOwnerUnLock(semOwnerTask);
+            break;
+        }
         /* 信号量持有任务处于就绪状态，调整就绪队列后退出 */
         if (TSK_STATUS_TST(semOwnerTask, OS_TSK_READY)) {
             OsTskReadyDel(semOwnerTask);
@@ -171,34 +190,31 @@ OS_SEC_L0_TEXT void OsPriorityInherit(struct TagSemCb *semPended, struct TagTskC
             /* 添加到就绪链表同优先级尾部 */
             OsTskReadyAdd(semOwnerTask);
             OsSpinUnlockTaskRq(semOwnerTask);
-            return;
+            OsSemOwnerUnLock(semOwnerTask);
+            break;
         }
         semOwnerTask->priority = newPriority;
         /* 信号量持有任务不处于信号量阻塞状态与就绪状态，直接退出 */
         if (!TSK_STATUS_TST(semOwnerTask, OS_TSK_PEND)) {
             OsSpinUnlockTaskRq(semOwnerTask);
-            return;
+            OsSemOwnerUnLock(semOwnerTask);
+            break;
         }
-        /* 信号量持有任务也处于阻塞状态，获取所阻塞的信号量 */
+        /* 信号量持有任务也处于阻塞状态，换锁到所阻塞的信号量，多级优先级继承 */
         recurSem = (struct TagSemCb *)semOwnerTask->taskPend;
-        /* 如果是优先级唤醒模式先重排信号量的阻塞优先级队列 */
-        if (recurSem->semMode == SEM_MODE_PRIOR) {
-            OsResortSemList(semOwnerTask);
-        }
         OsSpinUnlockTaskRq(semOwnerTask);
-        /* 所阻塞的信号量不为互斥型，直接退出 */
-        if (GET_SEM_TYPE(recurSem->semType) != SEM_TYPE_BIN) {
-            return;
-        }
-        /* 所阻塞的信号量类型为互斥型，多级优先级继承，提升拥有该互斥信号量的任务优先级 */
-        semOwnerTask = GET_TCB_HANDLE(recurSem->semOwner);
-        OsSpinLockTaskRq(semOwnerTask);
+        OsSemOwnerUnLock(semOwnerTask);
+        SEM_CB_UNLOCK(semPended);
+
+        semPended = recurSem;
+        pendTask = semOwnerTask;
+        SEM_CB_LOCK(semPended);
     }
-    OsSpinUnlockTaskRq(semOwnerTask);
+    SEM_CB_UNLOCK(semPended);
 }
 
 /*
- * 描述：任务释放互斥信号量时尝试恢复原本优先级，需要semPrio锁保护
+ * 描述：任务释放互斥信号量时尝试恢复原本优先级，需要持有当前任务的semBLock
  */
 OS_SEC_L0_TEXT bool OsPriorityRestore(void)
 {
@@ -235,7 +251,7 @@ OS_SEC_L0_TEXT bool OsPriorityRestore(void)
 #endif
 
 /*
- * 描述：把当前运行任务挂接到信号量链表上，外部受semPrio锁保护
+ * 描述：把当前运行任务挂接到信号量链表上，外部受semCb锁保护，优先级继承由调用者释放semCb锁后进行
  */
 OS_SEC_L0_TEXT void OsSemPendListPut(struct TagSemCb *semPended, U32 timeOut)
 {
@@ -243,6 +259,8 @@ OS_SEC_L0_TEXT void OsSemPendListPut(struct TagSemCb *semPended, U32 timeOut)
     struct TagTskCb *runTsk = RUNNING_TASK;
     struct TagListObject *pendObj = &runTsk->pendList;
     struct TagOsRunQue *runQue;
+    /* 互斥信号量的阻塞链表在持有者semBLock内修改，持有者遍历semBList时可见一致的首个等待任务 */
+    struct TagTskCb *semOwnerTask = OsSemIfOwnerLock(semPended);
 
     runQue = OsSpinLockRunTaskRq();
     OsTskReadyDel((struct TagTskCb *)runTsk);
@@ -274,11 +292,7 @@ TIMER_ADD:
     }
 
     OsSpinUnLockRunTaskRq(runQue);
-
-#if defined(OS_OPTION_SEM_PRIO_INHERIT)
-    /* 优先级继承，仅二进制信号量支持 */
-    OsPriorityInherit(semPended, runTsk);
-#endif
+    OsSemIfOwnerUnLock(semOwnerTask);
 }
 
 /*
@@ -288,6 +302,7 @@ OS_SEC_L0_TEXT void OsSemPendListGet(struct TagSemCb *semPended)
 {
     /* 任务阻塞链表上的第一个任务/优先级最高的任务 */
     struct TagTskCb *taskCb = GET_TCB_PEND(OS_LIST_FIRST(&(semPended->semList)));
+    struct TagTskCb *prevOwner = OsSemIfOwnerLock(semPended);
 
     ListDelete(OS_LIST_FIRST(&(semPended->semList)));
 
@@ -310,18 +325,23 @@ OS_SEC_L0_TEXT void OsSemPendListGet(struct TagSemCb *semPended)
     semPended->semOwner = taskCb->taskPid;
 #if defined(OS_OPTION_BIN_SEM)
     /*
-     * 如果释放的是互斥信号量，就从释放此互斥信号量任务的持有链表上摘除它，
-     * 再把它挂接到新的持有它的任务的持有链表上；然后尝试降低任务的优先级
+     * 如果释放的是互斥信号量，在释放者的semBLock内从其持有链表上摘除它并尝试降低优先级，
+     * 再换锁把它挂接到新的持有它的任务的持有链表上，两个持有者锁不嵌套
      */
-    if (GET_SEM_TYPE(semPended->semType) == SEM_TYPE_BIN) {
-        // 此处需要受到 semIfPrio 锁保护
+    if (prevOwner != NULL) {
         ListDelete(&semPended->semBList);
-        ListTailAdd(&semPended->semBList, &taskCb->semBList);  
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
         (void)OsPriorityRestore();
 #endif
+        OsSemOwnerUnLock(prevOwner);
+
+        OsSemOwnerLock(taskCb);
+        ListTailAdd(&semPended->semBList, &taskCb->semBList);
+        OsSemOwnerUnLock(taskCb);
+        return;
     }
 #endif
+    OsSemIfOwnerUnLock(prevOwner);
 }
 
 OS_SEC_L0_TEXT U32 OsSemPendParaCheck(U32 timeout)
@@ -350,9 +370,11 @@ OS_SEC_L0_TEXT bool OsSemPendNotNeedSche(struct TagSemCb *semPended, struct TagT
         semPended->semCount--;
         semPended->semOwner = runTsk->taskPid;
 #if defined(OS_OPTION_BIN_SEM)
-        /* 如果是互斥信号量，把持有的互斥信号量挂接起来，此处需要受semPrio锁保护 */
+        /* 如果是互斥信号量，把持有的互斥信号量挂接起来，此处需要受持有者semBLock保护 */
         if (GET_SEM_TYPE(semPended->semType) == SEM_TYPE_BIN) {
+            OsSemOwnerLock(runTsk);
             ListTailAdd(&semPended->semBList, &runTsk->semBList);
+            OsSemOwnerUnLock(runTsk);
         }
 #endif
         return TRUE;
@@ -360,6 +382,48 @@ OS_SEC_L0_TEXT bool OsSemPendNotNeedSche(struct TagSemCb *semPended, struct TagT
     return FALSE;
 }
 
+/*
+ * 描述：信号量不可用时阻塞当前任务，调用者持有semCb锁，返回前释放
+ */
+OS_SEC_ALW_INLINE INLINE U32 OsSemPendBlock(struct TagSemCb *semPended, struct TagTskCb *runTsk, U32 timeout,
+    uintptr_t intSave)
+{
+    U32 ret;
+    struct TagOsRunQue *runQue = NULL;
+
+    ret = OsSemPendParaCheck(timeout);
+    if (ret != OS_OK) {
+        SEM_CB_IRQ_UNLOCK(semPended, intSave);
+        return ret;
+    }
+    /* 把当前任务挂接在信号量链表上 */
+    OsSemPendListPut(semPended, timeout);
+
+    SEM_CB_UNLOCK(semPended);
+#if defined(OS_OPTION_SEM_PRIO_INHERIT)
+    /* 优先级继承，仅二进制信号量支持，沿阻塞链逐级加锁，不再持有当前信号量的semCb锁 */
+    OsPriorityInherit(semPended, runTsk);
+#endif
+    if (timeout != OS_WAIT_FOREVER) {
+        /* 触发任务调度 */
+        OsTskSchedule();
+
+        runQue = OsSpinLockRunTaskRq();
+        /* 判断是否是等待信号量超时 */
+        if (TSK_STATUS_TST(runTsk, OS_TSK_TIMEOUT)) {
+            TSK_STATUS_CLEAR(runTsk, OS_TSK_TIMEOUT);
+            OsSpinUnLockRunTaskRq(runQue);
+            OsIntRestore(intSave);
+            return OS_ERRNO_SEM_TIMEOUT;
+        }
+        OsSpinUnLockRunTaskRq(runQue);
+    } 
+    /* 恢复ps的快速切换 */
+    OsTskScheduleFastPs(intSave);
+    OsIntRestore(intSave);
+    return OS_OK;
+}
+
 /*
  * 描述：指定信号量的P操作
  */
@@ -369,10 +433,8 @@ OS_SEC_L0_TEXT U32 PRT_SemPend(SemHandle semHandle, U32 timeout)
     PRT_PERF(SEM_PEND);
 #endif
     uintptr_t intSave;
-    U32 ret;
     struct TagTskCb *runTsk = NULL;
     struct TagSemCb *semPended = NULL;
-    struct TagOsRunQue *runQue = NULL;
 
     if (semHandle >= (SemHandle)g_maxSem) {
         return OS_ERRNO_SEM_INVALID;
@@ -393,42 +455,12 @@ OS_SEC_L0_TEXT U32 PRT_SemPend(SemHandle semHandle, U32 timeout)
     }
 
     runTsk = (struct TagTskCb *)RUNNING_TASK;
-    OsSemIfPrioLock(semPended);
     if (OsSemPendNotNeedSche(semPended, runTsk) == TRUE) {
-        OsSemIfPrioUnLock(semPended);
         SEM_CB_IRQ_UNLOCK(semPended, intSave);
         return OS_OK;
     }
 
-    ret = OsSemPendParaCheck(timeout);
-    if (ret != OS_OK) {
-        OsSemIfPrioUnLock(semPended);
-        SEM_CB_IRQ_UNLOCK(semPended, intSave);
-        return ret;
-    }
-    /* 把当前任务挂接在信号量链表上 */
-    OsSemPendListPut(semPended, timeout);
-
-    OsSemIfPrioUnLock(semPended);
-    SEM_CB_UNLOCK(semPended);
-    if (timeout != OS_WAIT_FOREVER) {
-        /* 触发任务调度 */
-        OsTskSchedule();
-
-        runQue = OsSpinLockRunTaskRq();
-        /* 判断是否是等待信号量超时 */
-        if (TSK_STATUS_TST(runTsk, OS_TSK_TIMEOUT)) {
-            TSK_STATUS_CLEAR(runTsk, OS_TSK_TIMEOUT);
-            OsSpinUnLockRunTaskRq(runQue);
-            OsIntRestore(intSave);
-            return OS_ERRNO_SEM_TIMEOUT;
-        }
-        OsSpinUnLockRunTaskRq(runQue);
-    } 
-    /* 恢复ps的快速切换 */
-    OsTskScheduleFastPs(intSave);
-    OsIntRestore(intSave);
-    return OS_OK;
+    return OsSemPendBlock(semPended, runTsk, timeout, intSave);
 }
 
 /*
@@ -479,12 +511,10 @@ OS_SEC_L0_TEXT U32 PRT_SemPost(SemHandle semHandle)
         SEM_CB_IRQ_UNLOCK(semPosted, intSave);
         return OS_OK;
     }
-    OsSemIfPrioLock(semPosted);
 
     /* 如果有任务阻塞在信号量上，就激活信号量阻塞队列上的首个任务 */
     if (!ListEmpty(&semPosted->semList)) {
         OsSemPendListGet(semPosted);
-        OsSemIfPrioUnLock(semPosted);
         SEM_CB_UNLOCK(semPosted);
         /* 相当于快速切换+中断恢复 */
         OsTskScheduleFastPs(intSave);
@@ -495,24 +525,166 @@ OS_SEC_L0_TEXT U32 PRT_SemPost(SemHandle semHandle)
 #if defined(OS_OPTION_BIN_SEM)
         /* 如果释放的是互斥信号量，就从释放此互斥信号量任务的持有链表上摘除它 */
         if (GET_SEM_TYPE(semPosted->semType) == SEM_TYPE_BIN) {
+            OsSemOwnerLock(RUNNING_TASK);
             ListDelete(&semPosted->semBList);
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
             /* 尝试降低当前任务优先级 */
             if (OsPriorityRestore()) {
                 /* 优先级发生变化，触发任务调度 */
-                OsSemIfPrioUnLock(semPosted);
+                OsSemOwnerUnLock(RUNNING_TASK);
                 SEM_CB_UNLOCK(semPosted);
                 OsTskSchedule();
                 OsIntRestore(intSave);
                 return OS_OK;
             }
 #endif
+            OsSemOwnerUnLock(RUNNING_TASK);
         }
 #endif
-        OsSemIfPrioUnLock(semPosted);
         SEM_CB_UNLOCK(semPosted);
     }
 
     OsIntRestore(intSave);
     return OS_OK;
 }
+
+#if defined(OS_OPTION_POSIX)
+/*
+ * 描述：pthread互斥锁竞争时的加锁慢速路径
+ * 备注：首个竞争者在semCb锁内置位OS_MUTEX_WAITERS，并把信号量记为被用户态持有者持有，
+ *       之后按普通互斥信号量阻塞，优先级继承与PRT_SemPend相同
+ */
+OS_SEC_L0_TEXT U32 OsSemMutexPend(SemHandle semHandle, volatile U32 *owner, U32 timeout)
+{
+    U32 val;
+    U32 self;
+    uintptr_t intSave;
+    struct TagTskCb *runTsk = NULL;
+    struct TagTskCb *ownerTsk = NULL;
+    struct TagSemCb *semPended = NULL;
+
+    if (semHandle >= (SemHandle)g_maxSem) {
+        return OS_ERRNO_SEM_INVALID;
+    }
+
+    semPended = GET_SEM(semHandle);
+
+    SEM_CB_IRQ_LOCK(semPended, intSave);
+
+    if (semPended->semStat == OS_SEM_UNUSED) {
+        SEM_CB_IRQ_UNLOCK(semPended, intSave);
+        return OS_ERRNO_SEM_INVALID;
+    }
+
+    if (OS_INT_ACTIVE) {
+        SEM_CB_IRQ_UNLOCK(semPended, intSave);
+        return OS_ERRNO_SEM_PEND_INTERR;
+    }
+
+    runTsk = (struct TagTskCb *)RUNNING_TASK;
+    self = OS_MUTEX_OWNER_ID(runTsk->taskPid);
+    while (TRUE) {
+        val = OsMutexOwnerGet(owner);
+        /* 持有者已在用户态释放 */
+        if (val == 0) {
+            if (OsMutexOwnerCas(owner, 0, self)) {
+                SEM_CB_IRQ_UNLOCK(semPended, intSave);
+                return OS_OK;
+            }
+            continue;
+        }
+
+        /* 信号量已由内核管理，直接阻塞 */
+        if ((val & OS_MUTEX_WAITERS) != 0) {
+            break;
+        }
+
+        if (OsMutexOwnerCas(owner, val, val | OS_MUTEX_WAITERS)) {
+            ownerTsk = GET_TCB_HANDLE(OS_MUTEX_OWNER_PID(val));
+            semPended->semCount = 0;
+            semPended->semOwner = ownerTsk->taskPid;
+            OsSemOwnerLock(ownerTsk);
+            ListTailAdd(&semPended->semBList, &ownerTsk->semBList);
+            OsSemOwnerUnLock(ownerTsk);
+            break;
+        }
+    }
+
+    return OsSemPendBlock(semPended, runTsk, timeout, intSave);
+}
+
+/*
+ * 描述：pthread互斥锁有等待者时的解锁慢速路径，把锁交给信号量上的首个等待任务
+ * 备注：没有剩余等待者时信号量恢复空闲，持有关系交还给用户态持有者字
+ */
+OS_SEC_L0_TEXT U32 OsSemMutexPost(SemHandle semHandle, volatile U32 *owner)
+{
+    U32 val;
+    uintptr_t intSave;
+    struct TagTskCb *newOwner = NULL;
+    struct TagSemCb *semPosted = NULL;
+
+    if (semHandle >= (SemHandle)g_maxSem) {
+        return OS_ERRNO_SEM_INVALID;
+    }
+
+    semPosted = GET_SEM(semHandle);
+    SEM_CB_IRQ_LOCK(semPosted, intSave);
+
+    if (semPosted->semStat == OS_SEM_UNUSED) {
+        SEM_CB_IRQ_UNLOCK(semPosted, intSave);
+        return OS_ERRNO_SEM_INVALID;
+    }
+
+    val = OsMutexOwnerGet(owner);
+    if ((val & ~OS_MUTEX_WAITERS) != OS_MUTEX_OWNER_ID(RUNNING_TASK->taskPid)) {
+        SEM_CB_IRQ_UNLOCK(semPosted, intSave);
+        return OS_ERRNO_SEM_MUTEX_NOT_OWNER_POST;
+    }
+
+    /* 竞争者尚未置位等待标志，直接在用户态释放 */
+    if (((val & OS_MUTEX_WAITERS) == 0) && OsMutexOwnerCas(owner, val, 0)) {
+        SEM_CB_IRQ_UNLOCK(semPosted, intSave);
+        return OS_OK;
+    }
+
+    if (!ListEmpty(&semPosted->semList)) {
+        newOwner = GET_TCB_PEND(OS_LIST_FIRST(&semPosted->semList));
+        OsSemPendListGet(semPosted);
+        if (ListEmpty(&semPosted->semList)) {
+            OsSemOwnerLock(newOwner);
+            ListDelete(&semPosted->semBList);
+            OsSemOwnerUnLock(newOwner);
+            semPosted->semCount = OS_SEM_FULL;
+            semPosted->semOwner = OS_INVALID_OWNER_ID;
+            OsMutexOwnerSet(owner, OS_MUTEX_OWNER_ID(newOwner->taskPid));
+        } else {
+            OsMutexOwnerSet(owner, OS_MUTEX_OWNER_ID(newOwner->taskPid) | OS_MUTEX_WAITERS);
+        }
+        SEM_CB_UNLOCK(semPosted);
+        /* 相当于快速切换+中断恢复 */
+        OsTskScheduleFastPs(intSave);
+        OsIntRestore(intSave);
+        return OS_OK;
+    }
+
+    /* 等待者均已超时退出 */
+    OsSemOwnerLock(RUNNING_TASK);
+    ListDelete(&semPosted->semBList);
+    semPosted->semCount = OS_SEM_FULL;
+    semPosted->semOwner = OS_INVALID_OWNER_ID;
+    OsMutexOwnerSet(owner, 0);
+#if defined(OS_OPTION_SEM_PRIO_INHERIT)
+    if (OsPriorityRestore()) {
+        OsSemOwnerUnLock(RUNNING_TASK);
+        SEM_CB_UNLOCK(semPosted);
+        OsTskSchedule();
+        OsIntRestore(intSave);
+        return OS_OK;
+    }
+#endif
+    OsSemOwnerUnLock(RUNNING_TASK);
+    SEM_CB_IRQ_UNLOCK(semPosted, intSave);
+    return OS_OK;
+}
+#endif
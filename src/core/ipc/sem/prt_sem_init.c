@@ -16,9 +16,6 @@
 
 OS_SEC_BSS struct TagListObject g_unusedSemList;
 OS_SEC_BSS struct TagSemCb *g_allSem;
-#if defined(OS_OPTION_SMP)
-OS_SEC_BSS volatile uintptr_t g_semPrioLock;
-#endif
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
 extern U32 OsCheckPrioritySet(struct TagTskCb *taskCb, TskPrior taskPrio);
 #endif
@@ -85,10 +82,6 @@ OS_SEC_L4_TEXT U32 OsSemInit(void)
 {
     U32 ret = OsSemInitCb();
 
-#if defined(OS_OPTION_SMP)
-    OsSpinLockInitInner(&g_semPrioLock);
-#endif
-
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
     g_checkPrioritySet = OsCheckPrioritySet;
 #endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-01
+ * Description: 截止期(EDF/CBS)调度公共头文件
+ */
+#ifndef PRT_DL_EXTERNAL_H
+#define PRT_DL_EXTERNAL_H
+
+#include "prt_list_external.h"
+
+#if defined(OS_OPTION_SCHED_EDF)
+/*
+ * 模块间宏定义
+ */
+/* 带宽定点数的小数位数，带宽 = runtime / period */
+#define OS_DL_BW_SHIFT 20U
+#define OS_DL_BW_UNIT (1U << OS_DL_BW_SHIFT)
+/* 每个核截止期任务带宽总和上限95%，为固定优先级任务和中断保留余量 */
+#define OS_DL_BW_MAX ((OS_DL_BW_UNIT / 100U) * 95U)
+
+/* 周期上限10秒，保证带宽乘法不溢出 */
+#define OS_DL_PERIOD_MAX_US 10000000U
+
+/* 是否为截止期任务，调用者持有任务所在rq的锁 */
+#define OS_TSK_IS_DEADLINE(tsk) ((tsk)->dlRuntime != 0)
+
+/*
+ * 模块间结构体定义
+ */
+/*
+ * 截止期运行队列，任务pendList复用作为链表节点
+ */
+struct DlRq {
+    /* 有剩余预算的就绪任务，按绝对截止期从早到晚排序 */
+    struct TagListObject readyList;
+    /* 预算耗尽的任务，按预算补充时间从早到晚排序 */
+    struct TagListObject throttledList;
+    /* readyList上的任务个数 */
+    U32 nrReady;
+    /* 已接纳任务的带宽总和 */
+    U32 bwUsed;
+    /* 当前截止期任务本次开始计费的时间点(cycle) */
+    U64 execStart;
+};
+
+struct TagOsRunQue;
+struct TagTskCb;
+
+/*
+ * 模块间函数声明
+ */
+extern struct TagScheduleClass *OsGetEdfSchedClass(void);
+extern void OsDlTick(struct TagOsRunQue *runQue);
+extern void OsDlTaskRelease(struct TagTskCb *task);
+#else
+#define OS_TSK_IS_DEADLINE(tsk) FALSE
+#endif
+
+#endif /* PRT_DL_EXTERNAL_H */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-15
+ * Description: 高精度定时器私有头文件
+ */
+#ifndef PRT_HRTIMER_EXTERNAL_H
+#define PRT_HRTIMER_EXTERNAL_H
+
+#include "prt_timer.h"
+#include "prt_list_external.h"
+
+#if defined(OS_OPTION_HRTIMER)
+/*
+ * 模块间宏定义
+ */
+/* 定时器状态，全0的控制块为空闲状态 */
+#define OS_HRTIMER_IDLE    0U
+#define OS_HRTIMER_PENDING 1U
+#define OS_HRTIMER_FIRING  2U
+
+/*
+ * 模块间结构体定义
+ */
+struct TagHrtimer;
+typedef void (*OsHrtimerFunc)(struct TagHrtimer *timer, uintptr_t arg);
+
+/*
+ * 高精度定时器节点，挂在所在核按超时cycle升序排列的链表上
+ */
+struct TagHrtimer {
+    struct TagListObject node;
+    /* 超时时刻，cycle */
+    U64 expire;
+    OsHrtimerFunc func;
+    uintptr_t arg;
+    /* 定时器所在核，非PENDING状态时无意义 */
+    U32 coreID;
+    volatile U32 state;
+};
+
+/*
+ * 每核高精度定时器链表
+ */
+struct TagHrtimerBase {
+    volatile uintptr_t spinLock;
+    struct TagListObject list;
+    /* 当前已设置到硬件的超时cycle */
+    U64 nextEvent;
+    /* 本核正在执行回调的定时器，base锁保护 */
+    struct TagHrtimer *running;
+};
+
+/*
+ * 模块间函数声明
+ */
+extern void OsHrtimerStart(struct TagHrtimer *timer, U64 expire);
+extern bool OsHrtimerCancel(struct TagHrtimer *timer);
+extern U64 OsHrtimerNs2Cycle(U64 ns);
+extern U64 OsHrtimerCycle2Ns(U64 cycle);
+#endif
+
+#endif /* PRT_HRTIMER_EXTERNAL_H */
@@ -60,5 +60,6 @@ extern void OsEnqueueTaskRtSingle(struct TagOsRunQue *runQue, struct TagTskCb *t
 extern void OsDequeueTaskRtSingle(struct TagOsRunQue *runQue, struct TagTskCb *task, U32 flags);
 extern void OsPutPrevTaskRtSingle(struct TagOsRunQue *runQue, struct TagTskCb *prevTskCB);
 extern struct TagTskCb *OsPickNextTaskRtSingle(struct TagOsRunQue* runQue);
+extern struct TagTskCb *OsPickNextTaskRtSingleLocked(struct TagOsRunQue *runQue);
 extern struct TagTskCb *OsNextReadyRtTaskSingle(struct TagOsRunQue *runQue);
 #endif
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "prt_sys_external.h"
 #include "prt_cpu_external.h"
 #include "prt_rt_external.h"
+#include "prt_dl_external.h"
 #include "prt_atomic.h"
 #include "prt_typedef.h"
 
@@ -51,10 +52,15 @@ extern "C" {
 #define RT_SINGLE_CLASS()      (&g_osRtSingleSchedClass)
 
 enum OsScheduleType{
-    OS_SCHEDULE_RT_SINGLE //单硬线程调度
+    OS_SCHEDULE_RT_SINGLE, //单硬线程调度
+    OS_SCHEDULE_EDF        //截止期调度，与单硬线程调度共存
 };
 
+#if defined(OS_OPTION_SCHED_EDF)
+#define OS_DEFAULT_SCHED_TYPE OS_SCHEDULE_EDF
+#else
 #define OS_DEFAULT_SCHED_TYPE OS_SCHEDULE_RT_SINGLE
+#endif
 
 /*
  * 模块间结构体定义
@@ -82,6 +88,9 @@ struct TagOsRunQue {
     bool online;                        // 队列是否还在线
     U32 currntPrio;                     // RQ中最高优先级任务的优先级
     struct RtRq rtRq;                   // 实时优先级运行队列
+#if defined(OS_OPTION_SCHED_EDF)
+    struct DlRq dlRq;                   // 截止期运行队列
+#endif
     struct TagScheduleClass *schedClass; //调度方法
 };
 /*
@@ -97,6 +106,9 @@ extern struct TagOsRunQue g_runQueue[OS_MAX_CORE_NUM];
 extern void OsReschedTask(struct TagTskCb *task);
 extern void OsReschedTaskNoWakeIpc(struct TagTskCb *task);
 extern void OsSmpSendReschedule(U32 coreID);
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+extern void OsRtSelectTaskRq(struct TagTskCb *task);
+#endif
 
 extern U32 g_tskMaxNum;
 
@@ -174,14 +186,22 @@ OS_SEC_ALW_INLINE INLINE void OsDecNrRunning(struct TagOsRunQue *runQue)
 
 OS_SEC_ALW_INLINE INLINE bool OsSchedIsDomainTypeValid(enum OsScheduleType type)
 {
+#if defined(OS_OPTION_SCHED_EDF)
+    return ((type == OS_SCHEDULE_RT_SINGLE) || (type == OS_SCHEDULE_EDF));
+#else
     return (type == OS_SCHEDULE_RT_SINGLE);
+#endif
 }
 
 extern struct TagScheduleClass *OsGetRtSingleSchedClass(void);
 
 OS_SEC_ALW_INLINE INLINE struct TagScheduleClass *OsSchedGetSchedClass()
 {
+#if defined(OS_OPTION_SCHED_EDF)
+    return OsGetEdfSchedClass();
+#else
     return OsGetRtSingleSchedClass();
+#endif
 }
 
 #endif
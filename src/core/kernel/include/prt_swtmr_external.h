@@ -17,6 +17,7 @@
 
 #include "prt_timer_external.h"
 #include "prt_list_external.h"
+#include "prt_tmr_wheel_external.h"
 
 /* 最大支持软件定时器个数 */
 extern U32 g_swTmrMaxNum;
@@ -87,10 +88,12 @@ struct TagSwTmrSortLinkAttr {
     /* 自旋锁 */
     volatile uintptr_t spinLock;
     U32 reserved;
-    /* 软件定时器头节点 */
+    /* 已到期定时器头节点，扫描时从时间轮取出 */
     struct TagListObject sortLink;
     /* 最近超时的tick刻度 */
     U64 nearestTicks;
+    /* 计时中的定时器，挂在时间轮上 */
+    struct TagTmrWheel wheel;
 };
 #else
 struct TagSwTmrSortLinkAttr {
@@ -26,6 +26,8 @@
 #include "prt_mem_external.h"
 #include "prt_atomic.h"
 #include "prt_plist_external.h"
+#include "prt_tmr_wheel_external.h"
+#include "prt_hrtimer_external.h"
 #include "prt_sched_external.h"
 
 #if defined(OS_OPTION_NUTTX_VFS)
@@ -82,10 +84,12 @@ struct TagOsTskSortedDelayList {
     volatile uintptr_t spinLock;
 
     U32 reserved;
-    /* 延时任务链表 */
+    /* 已到期、待唤醒的任务链表 */
     struct TagListObject tskList;
     /* 延时链上最近超时的tick刻度 */
     U64 nearestTicks;
+    /* 未到期的延时任务，挂在时间轮上 */
+    struct TagTmrWheel wheel;
 };
 struct TagTskCb;
 struct TagOsRunQue;
@@ -162,6 +166,10 @@ struct TagTskCb {
     struct TagListObject timerList;
     /* 持有互斥信号量链表 */
     struct TagListObject semBList;
+#if defined(OS_OPTION_SMP)
+    /* 持有者锁，保护semBList及所持有互斥信号量的阻塞链表，用于优先级继承 */
+    volatile uintptr_t semBLock;
+#endif
     /* 记录条件变量的等待线程 */
     struct TagListObject condNode;
 #if defined(OS_OPTION_LINUX)
@@ -191,9 +199,27 @@ struct TagTskCb {
     bool isOnRq;
     /* 该任务使用的调度类 */
     struct TagScheduleClass *scheClass;
+#if defined(OS_OPTION_SCHED_EDF)
+    /* 截止期调度参数(cycle)，dlRuntime为0表示固定优先级任务 */
+    U64 dlRuntime;
+    U64 dlDeadline;
+    U64 dlPeriod;
+    /* 当前作业的绝对截止期(cycle) */
+    U64 dlAbsDeadline;
+    /* 当前周期剩余预算(cycle)，超支时为负 */
+    S64 dlRemain;
+    /* 任务带宽，定点数 */
+    U32 dlBw;
+    /* 预算耗尽，等待补充 */
+    bool dlThrottled;
+#endif
 #endif
     /* 任务恢复的时间点(单位Tick) */
     U64 expirationTick;
+#if defined(OS_OPTION_HRTIMER)
+    /* 高精度睡眠使用的定时器 */
+    struct TagHrtimer sleepTimer;
+#endif
 #if defined(OS_OPTION_POSIX)
     /* 当前任务状态 */
     U8 state;
@@ -285,7 +311,7 @@ extern struct TagListObject g_tskPercpuRecycleList[OS_MAX_CORE_NUM];
     do {                                                                                    \
         struct TagOsTskSortedDelayList *tmpDlyBase = &g_tskSortedDelay[(task)->timeCoreID];\
         OS_MCMUTEX_LOCK(0, &tmpDlyBase->spinLock);                                          \
-        ListDelete(&(task)->timerList);                                                     \
+        OsTmrWheelDel(&tmpDlyBase->wheel, &(task)->timerList);                              \
         OS_MCMUTEX_UNLOCK(0, &tmpDlyBase->spinLock);                                        \
     } while (0)
 #else
@@ -471,7 +497,7 @@ OS_SEC_ALW_INLINE INLINE bool IsIdleTask(TskHandle task)
 OS_SEC_ALW_INLINE INLINE void OsTskSetCoreAllowed(U32 coreAllowed, struct TagTskCb *tsk)
 {
     tsk->coreAllowedMask = coreAllowed;
-    tsk->nrCoresAllowed = 1;
+    tsk->nrCoresAllowed = (U32)__builtin_popcount(coreAllowed);
 }
 OS_SEC_ALW_INLINE INLINE void OsSetTaskCoreId(U32 newCoreId, struct TagTskCb *tskCB)
 {
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-08
+ * Description: 分层时间轮私有头文件，供SMP任务超时和软件定时器使用
+ */
+#ifndef PRT_TMR_WHEEL_EXTERNAL_H
+#define PRT_TMR_WHEEL_EXTERNAL_H
+
+#include "prt_list_external.h"
+#include "prt_tick_external.h"
+
+#if defined(OS_OPTION_SMP)
+/*
+ * 模块间宏定义
+ */
+/* 每层32个槽，与32bit占用位图对应 */
+#define OS_TMR_WHEEL_SLOT_BITS 5U
+#define OS_TMR_WHEEL_SLOT_NUM (1U << OS_TMR_WHEEL_SLOT_BITS)
+#define OS_TMR_WHEEL_SLOT_MASK (OS_TMR_WHEEL_SLOT_NUM - 1U)
+/* 5层可直接表示约2^25个tick，更远的节点挂在最高层最远的槽上，级联时重新插入 */
+#define OS_TMR_WHEEL_LEVEL_NUM 5U
+#define OS_TMR_WHEEL_SHIFT(level) ((level) * OS_TMR_WHEEL_SLOT_BITS)
+
+/* 通过链表节点获取节点所在结构体中的超时tick */
+#define OS_TMR_WHEEL_KEY(wheel, node) (*(U64 *)((uintptr_t)(node) + (wheel)->keyOffset))
+
+/*
+ * 模块间结构体定义
+ */
+/*
+ * 分层时间轮，第0层每个槽对应1个tick，第n层每个槽对应32^n个tick。
+ * 节点挂在双向链表上，删除仍为O(1)；插入按超时tick直接定位槽，不再遍历有序链表。
+ * 调用者负责加锁。
+ */
+struct TagTmrWheel {
+    /* 下一个待处理的tick */
+    U64 curTick;
+    /* 超时tick字段相对链表节点的偏移 */
+    uintptr_t keyOffset;
+    /* 每层非空槽位图 */
+    U32 bitmap[OS_TMR_WHEEL_LEVEL_NUM];
+    struct TagListObject slot[OS_TMR_WHEEL_LEVEL_NUM][OS_TMR_WHEEL_SLOT_NUM];
+};
+
+/*
+ * 模块间函数声明
+ */
+extern void OsTmrWheelInit(struct TagTmrWheel *wheel, uintptr_t keyOffset, U64 curTick);
+extern void OsTmrWheelAdd(struct TagTmrWheel *wheel, struct TagListObject *node);
+extern void OsTmrWheelAdvance(struct TagTmrWheel *wheel, U64 now, struct TagListObject *expired);
+extern U64 OsTmrWheelNearest(struct TagTmrWheel *wheel);
+
+/*
+ * 模块间内联函数定义
+ */
+/*
+ * 描述：从时间轮删除节点，节点所在槽变空时清除位图
+ * 备注：节点也可能已被移到到期链表上，此时只做链表删除
+ */
+OS_SEC_ALW_INLINE INLINE void OsTmrWheelDel(struct TagTmrWheel *wheel, struct TagListObject *node)
+{
+    struct TagListObject *prev = node->prev;
+    uintptr_t idx;
+
+    ListDelete(node);
+    if ((prev < &wheel->slot[0][0]) || (prev > &wheel->slot[OS_TMR_WHEEL_LEVEL_NUM - 1][OS_TMR_WHEEL_SLOT_MASK])) {
+        return;
+    }
+
+    if (ListEmpty(prev)) {
+        idx = (uintptr_t)(prev - &wheel->slot[0][0]);
+        wheel->bitmap[idx >> OS_TMR_WHEEL_SLOT_BITS] &= ~(1U << (idx & OS_TMR_WHEEL_SLOT_MASK));
+    }
+}
+#endif
+
+#endif /* PRT_TMR_WHEEL_EXTERNAL_H */
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-01
+ * Description: 截止期(EDF/CBS)调度实现，与RT_SINGLE固定优先级调度共存
+ */
+#include "prt_task_external.h"
+#include "prt_rt_internal.h"
+
+static void OsEnqueueTaskEdf(struct TagOsRunQue *runQue, struct TagTskCb *task, U32 flags);
+static void OsDequeueTaskEdf(struct TagOsRunQue *runQue, struct TagTskCb *task, U32 flags);
+static struct TagTskCb *OsPickNextTaskEdf(struct TagOsRunQue *runQue);
+static struct TagTskCb *OsNextReadyTaskEdf(struct TagOsRunQue *runQue);
+
+/*
+ * 截止期调度类作为核的调度类，截止期任务按EDF调度，固定优先级任务交给RT_SINGLE处理。
+ * 本核有就绪的截止期任务时总是先于固定优先级任务运行。
+ */
+OS_SEC_DATA struct TagScheduleClass g_osEdfSchedClass = {
+    .osEnqueueTask = OsEnqueueTaskEdf,
+    .osDequeueTask = OsDequeueTaskEdf,
+    .osPutPrevTask = OsPutPrevTaskRtSingle,
+    .osPickNextTask = OsPickNextTaskEdf,
+    .osNextReadyTask = OsNextReadyTaskEdf,
+};
+
+INIT_SEC_L4_TEXT struct TagScheduleClass *OsGetEdfSchedClass(void)
+{
+    return &g_osEdfSchedClass;
+}
+
+/* 预算补充时间点为当前周期结束，即下一周期开始 */
+OS_SEC_ALW_INLINE INLINE U64 OsDlReplenishTime(struct TagTskCb *task)
+{
+    return task->dlAbsDeadline - task->dlDeadline + task->dlPeriod;
+}
+
+/* 任务是否为有剩余预算、可以继续运行的截止期任务 */
+OS_SEC_ALW_INLINE INLINE bool OsDlTaskRunnable(struct TagTskCb *task)
+{
+    return OS_TSK_IS_DEADLINE(task) && task->isOnRq && !task->dlThrottled;
+}
+
+/*
+ * 描述：按绝对截止期从早到晚插入就绪链表，截止期相同时按FIFO顺序
+ * 备注：插入需遍历链表，链表上只有本核的截止期任务，长度有限
+ */
+OS_SEC_ALW_INLINE INLINE void OsDlReadyAdd(struct DlRq *dlRq, struct TagTskCb *task)
+{
+    struct TagListObject *head = &dlRq->readyList;
+    struct TagListObject *pos = OS_LIST_FIRST(head);
+
+    while ((pos != head) && (GET_TCB_READY(pos)->dlAbsDeadline <= task->dlAbsDeadline)) {
+        pos = OS_LIST_FIRST(pos);
+    }
+    /* 插入到pos之前 */
+    ListTailAdd(&task->pendList, pos);
+    dlRq->nrReady++;
+}
+
+/*
+ * 描述：按预算补充时间从早到晚插入限流链表
+ * 备注：NA
+ */
+OS_SEC_ALW_INLINE INLINE void OsDlThrottledAdd(struct DlRq *dlRq, struct TagTskCb *task)
+{
+    U64 replenish = OsDlReplenishTime(task);
+    struct TagListObject *head = &dlRq->throttledList;
+    struct TagListObject *pos = OS_LIST_FIRST(head);
+
+    while ((pos != head) && (OsDlReplenishTime(GET_TCB_READY(pos)) <= replenish)) {
+        pos = OS_LIST_FIRST(pos);
+    }
+    ListTailAdd(&task->pendList, pos);
+    task->dlThrottled = TRUE;
+}
+
+OS_SEC_ALW_INLINE INLINE void OsDlListDel(struct DlRq *dlRq, struct TagTskCb *task)
+{
+    ListDelete(&task->pendList);
+    if (task->dlThrottled) {
+        task->dlThrottled = FALSE;
+    } else {
+        dlRq->nrReady--;
+    }
+}
+
+/*
+ * 描述：CBS唤醒规则，剩余预算按剩余时间计算的带宽超过任务带宽时，重新开始一个周期
+ * 备注：剩余预算不足时保留原截止期，任务进入限流链表等待补充
+ */
+OS_SEC_ALW_INLINE INLINE void OsDlWakeupUpdate(struct TagTskCb *task, U64 now)
+{
+    bool renew = (now >= task->dlAbsDeadline);
+
+    if (!renew && (task->dlRemain > 0)) {
+        renew = ((U64)task->dlRemain > (((task->dlAbsDeadline - now) * task->dlBw) >> OS_DL_BW_SHIFT));
+    }
+
+    if (renew) {
+        task->dlAbsDeadline = now + task->dlDeadline;
+        task->dlRemain = (S64)task->dlRuntime;
+    }
+}
+
+/* 补充预算，超支部分从后续周期中扣除 */
+OS_SEC_ALW_INLINE INLINE void OsDlReplenish(struct TagTskCb *task)
+{
+    while (task->dlRemain <= 0) {
+        task->dlAbsDeadline += task->dlPeriod;
+        task->dlRemain += (S64)task->dlRuntime;
+    }
+}
+
+/* 新就绪的截止期任务能否抢占当前任务 */
+OS_SEC_ALW_INLINE INLINE void OsDlCheckPreempt(struct TagOsRunQue *runQue, struct TagTskCb *task)
+{
+    struct TagTskCb *curr = runQue->tskCurr;
+
+    if (!OsDlTaskRunnable(curr) || (task->dlAbsDeadline < curr->dlAbsDeadline)) {
+        runQue->needReschedule = TRUE;
+    }
+}
+
+/*
+ * 描述：对当前运行的截止期任务计费，预算耗尽时移到限流链表并触发调度，调用者持有rq锁
+ * 备注：NA
+ */
+static OS_SEC_L0_TEXT void OsDlUpdateCurr(struct TagOsRunQue *runQue, U64 now)
+{
+    struct TagTskCb *curr = runQue->tskCurr;
+    struct DlRq *dlRq = &runQue->dlRq;
+
+    if (!OS_TSK_IS_DEADLINE(curr) || !curr->isOnRq) {
+        return;
+    }
+
+    curr->dlRemain -= (S64)(now - dlRq->execStart);
+    dlRq->execStart = now;
+    if ((curr->dlRemain > 0) || curr->dlThrottled) {
+        return;
+    }
+
+    OsDlListDel(dlRq, curr);
+    OsDlThrottledAdd(dlRq, curr);
+    runQue->needReschedule = TRUE;
+}
+
+static OS_SEC_L0_TEXT void OsEnqueueTaskEdf(struct TagOsRunQue *runQue, struct TagTskCb *task, U32 flags)
+{
+    struct DlRq *dlRq = &runQue->dlRq;
+
+    if (!OS_TSK_IS_DEADLINE(task)) {
+        OsEnqueueTaskRtSingle(runQue, task, flags);
+        return;
+    }
+
+    OsDlWakeupUpdate(task, OsCurCycleGet64());
+    if (task->dlRemain <= 0) {
+        OsDlThrottledAdd(dlRq, task);
+        return;
+    }
+
+    OsDlReadyAdd(dlRq, task);
+    OsDlCheckPreempt(runQue, task);
+}
+
+static OS_SEC_L0_TEXT void OsDequeueTaskEdf(struct TagOsRunQue *runQue, struct TagTskCb *task, U32 flags)
+{
+    if (!OS_TSK_IS_DEADLINE(task)) {
+        OsDequeueTaskRtSingle(runQue, task, flags);
+        return;
+    }
+
+    if (task == runQue->tskCurr) {
+        OsDlUpdateCurr(runQue, OsCurCycleGet64());
+        runQue->needReschedule = TRUE;
+    }
+    OsDlListDel(&runQue->dlRq, task);
+}
+
+static OS_SEC_L0_TEXT struct TagTskCb *OsNextReadyTaskEdf(struct TagOsRunQue *runQue)
+{
+    if (runQue->dlRq.nrReady != 0) {
+        return GET_TCB_READY(OS_LIST_FIRST(&runQue->dlRq.readyList));
+    }
+
+    return OsNextReadyRtTaskSingle(runQue);
+}
+
+/*
+ * 描述：截止期调度主pick函数，有就绪截止期任务时选择绝对截止期最早的任务，否则按固定优先级选择
+ * 备注：NA
+ */
+static OS_SEC_L0_TEXT struct TagTskCb *OsPickNextTaskEdf(struct TagOsRunQue *runQue)
+{
+    U64 now;
+    struct TagTskCb *task = NULL;
+    struct TagTskCb *prev = NULL;
+    struct DlRq *dlRq = &runQue->dlRq;
+
+    OsSplLock(&runQue->spinLock);
+    now = OsCurCycleGet64();
+    OsDlUpdateCurr(runQue, now);
+
+    if (dlRq->nrReady == 0) {
+        task = OsPickNextTaskRtSingleLocked(runQue);
+        // 固定优先级pick期间可能短暂释放rq锁，期间有截止期任务入队时重新调度
+        if (dlRq->nrReady != 0) {
+            runQue->needReschedule = TRUE;
+        }
+        OsSplUnlock(&runQue->spinLock);
+        return task;
+    }
+
+    prev = runQue->tskCurr;
+    runQue->needReschedule = FALSE;
+    if (runQue->rqCoreId == prev->coreID) {
+        TSK_STATUS_CLEAR(prev, OS_TSK_RUNNING);
+    }
+
+    task = GET_TCB_READY(OS_LIST_FIRST(&dlRq->readyList));
+    runQue->tskCurr = task;
+    TSK_STATUS_SET(task, OS_TSK_RUNNING);
+    dlRq->execStart = now;
+
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    // 被截止期任务抢占的固定优先级任务可以迁移到其他核运行
+    if ((task != prev) && prev->isOnRq && (prev->coreID == runQue->rqCoreId) &&
+        !OS_TSK_IS_DEADLINE(prev) && OsRtTaskPushable(runQue, prev)) {
+        OsRtPushableEnqueue(&runQue->rtRq, prev);
+    }
+    OsRtPush(runQue);
+#endif
+
+    OsSplUnlock(&runQue->spinLock);
+
+    return task;
+}
+
+/*
+ * 描述：tick处理，对当前截止期任务计费，并补充到达下一周期的限流任务，关中断外部保证
+ * 备注：NA
+ */
+OS_SEC_L0_TEXT void OsDlTick(struct TagOsRunQue *runQue)
+{
+    U64 now;
+    struct TagTskCb *task = NULL;
+    struct DlRq *dlRq = &runQue->dlRq;
+
+    OsSplLock(&runQue->spinLock);
+    now = OsCurCycleGet64();
+    OsDlUpdateCurr(runQue, now);
+
+    while (!ListEmpty(&dlRq->throttledList)) {
+        task = GET_TCB_READY(OS_LIST_FIRST(&dlRq->throttledList));
+        if (OsDlReplenishTime(task) > now) {
+            break;
+        }
+
+        OsDlListDel(dlRq, task);
+        OsDlReplenish(task);
+        OsDlReadyAdd(dlRq, task);
+        OsDlCheckPreempt(runQue, task);
+    }
+    OsSplUnlock(&runQue->spinLock);
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-06-26
+ * Description: 实时任务核间push/pull负载均衡实现
+ */
+#include "prt_task_external.h"
+#include "prt_rt_internal.h"
+
+/*
+ * 描述：任务当前能否参与迁移，调用者持有任务所在rq的锁
+ * 备注：只迁移未在运行的就绪任务，正在进行绑核、挂起、删除等操作的任务不迁移
+ */
+OS_SEC_ALW_INLINE INLINE bool OsRtTaskMovable(struct TagTskCb *task)
+{
+    if ((task->nrCoresAllowed <= 1) || (task->taskOperating != OS_TSK_OP_FREE) || (task->opBusy != 0)) {
+        return FALSE;
+    }
+
+    return !TSK_STATUS_TST(task, OS_TSK_RUNNING) && (task != GET_RUNQ(task->coreID)->tskCurr);
+}
+
+OS_SEC_ALW_INLINE INLINE bool OsRtTaskCanMigrate(struct TagTskCb *task, U32 destCore)
+{
+    return CPUMASK_HAS_BIT(task->coreAllowedMask, destCore) && OsRtTaskMovable(task);
+}
+
+/*
+ * 描述：将就绪任务从srcRq迁移到destRq，调用者持有两个rq的锁
+ * 备注：NA
+ */
+OS_SEC_ALW_INLINE INLINE void OsRtMigrateTask(struct TagOsRunQue *srcRq, struct TagOsRunQue *destRq,
+    struct TagTskCb *task)
+{
+    OsDeactiveTask(srcRq, task, 0);
+    task->scheClass = OS_SCHED_CLASS(destRq->rqCoreId);
+    TSK_CORE_SET(task, destRq->rqCoreId);
+    OsActiveTask(destRq, task, 0);
+}
+
+/*
+ * 描述：在任务允许的核中查找最高就绪优先级最低、且低于任务优先级的核，找不到返回OS_MAX_CORE_NUM
+ * 备注：无锁读取其他核的currntPrio，仅作预判，迁移时由调用者重新确认
+ */
+static OS_SEC_L0_TEXT U32 OsRtFindLowestCore(struct TagTskCb *task)
+{
+    U32 loop;
+    U32 core;
+    U32 prio;
+    U32 lowestPrio = task->priority;
+    U32 destCore = OS_MAX_CORE_NUM;
+    struct TagOsRunQue *runQue = NULL;
+
+    // 从任务所在核的下一个核开始查找，优先级相同时把任务分散到不同核
+    for (loop = 1; loop < g_maxNumOfCores; loop++) {
+        core = (task->coreID + loop) % g_maxNumOfCores;
+        if (!CPUMASK_HAS_BIT(task->coreAllowedMask, core)) {
+            continue;
+        }
+
+        runQue = GET_RUNQ(core);
+#if defined(OS_OPTION_SCHED_EDF)
+        // 有就绪截止期任务的核上固定优先级任务需要等待，不作为迁移目标
+        if (*(volatile U32 *)&runQue->dlRq.nrReady != 0) {
+            continue;
+        }
+#endif
+        prio = *(volatile U32 *)&runQue->currntPrio;
+        if (runQue->online && (prio > lowestPrio)) {
+            lowestPrio = prio;
+            destCore = core;
+        }
+    }
+
+    return destCore;
+}
+
+/*
+ * 描述：任务唤醒入队前为其选择运行队列，调用者持有任务所在rq的锁
+ * 备注：所在核有不低于任务优先级的任务时，把任务放到优先级更低的核上，避免等待本核任务让出。
+ *       迁移后释放原rq锁并持有目的rq锁，调用者通过OsSpinUnlockTaskRq按任务当前所在核解锁
+ */
+OS_SEC_L0_TEXT void OsRtSelectTaskRq(struct TagTskCb *task)
+{
+    U32 destCore;
+    struct TagOsRunQue *srcRq = GET_RUNQ(task->coreID);
+
+    if (srcRq->currntPrio > task->priority) {
+        return;
+    }
+
+    if (!OsRtTaskMovable(task)) {
+        return;
+    }
+
+    destCore = OsRtFindLowestCore(task);
+    if (destCore == OS_MAX_CORE_NUM) {
+        return;
+    }
+
+    // 任务不在任何rq上，修改核号后其他核按新核号加锁，与OsSpinLockTaskRq的重试配合
+    task->scheClass = OS_SCHED_CLASS(destCore);
+    TSK_CORE_SET(task, destCore);
+    OsSplUnlock(&srcRq->spinLock);
+    OsSplLock(&GET_RUNQ(destCore)->spinLock);
+}
+
+/*
+ * 描述：查找可push链表最高优先级高于本核的其他核，找不到返回NULL
+ * 备注：无锁预判，拉取时由调用者重新确认
+ */
+static OS_SEC_L0_TEXT struct TagOsRunQue *OsRtFindBusiestRq(struct TagOsRunQue *thisRq)
+{
+    U32 core;
+    U32 prio;
+    U32 highestPrio = thisRq->currntPrio;
+    struct TagOsRunQue *srcRq = NULL;
+    struct TagOsRunQue *runQue = NULL;
+
+    for (core = 0; core < g_maxNumOfCores; core++) {
+        runQue = GET_RUNQ(core);
+        if (runQue == thisRq) {
+            continue;
+        }
+
+        prio = *(volatile U32 *)&runQue->rtRq.nextPrio;
+        if (prio < highestPrio) {
+            highestPrio = prio;
+            srcRq = runQue;
+        }
+    }
+
+    return srcRq;
+}
+
+/*
+ * 描述：在srcRq的可push链表中查找可以拉到本核运行的任务，调用者持有两个rq的锁
+ * 备注：优先级高于源核当前任务的任务即将在源核抢占运行，不拉取
+ */
+static OS_SEC_L0_TEXT struct TagTskCb *OsRtPickPullTask(struct TagOsRunQue *thisRq, struct TagOsRunQue *srcRq)
+{
+    struct PushablTskList *node = NULL;
+    struct TagTskCb *task = NULL;
+
+    LIST_FOR_EACH(node, &srcRq->rtRq.pushAblList.nodeList, struct PushablTskList, nodeList) {
+        if (node->prio >= thisRq->currntPrio) {
+            break;
+        }
+
+        task = LIST_COMPONENT(node, struct TagTskCb, pushAbleList);
+        if (task->priority < srcRq->tskCurr->priority) {
+            continue;
+        }
+
+        if (OsRtTaskCanMigrate(task, thisRq->rqCoreId)) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * 描述：本核调度时从其他核拉取优先级高于本核的等待任务，调用者持有本核rq的锁
+ * 备注：double lock期间会短暂释放本核rq锁
+ */
+OS_SEC_L0_TEXT void OsRtPull(struct TagOsRunQue *thisRq)
+{
+    U32 tries;
+    struct TagOsRunQue *srcRq = NULL;
+    struct TagTskCb *task = NULL;
+
+    for (tries = 0; tries < OS_RT_MAX_TRYS; tries++) {
+        srcRq = OsRtFindBusiestRq(thisRq);
+        if (srcRq == NULL) {
+            return;
+        }
+
+        OsDoubleLockBalance(thisRq, srcRq);
+        task = OsRtPickPullTask(thisRq, srcRq);
+        if (task != NULL) {
+            OsRtMigrateTask(srcRq, thisRq, task);
+        }
+        OsDoubleUnlockDest(thisRq, srcRq);
+
+        if (task != NULL) {
+            return;
+        }
+    }
+}
+
+/*
+ * 描述：将本核等待运行的可迁移任务推到优先级更低的核，调用者持有本核rq的锁
+ * 备注：double lock期间会短暂释放本核rq锁，加锁后需重新确认任务和目的核状态
+ */
+OS_SEC_L0_TEXT void OsRtPush(struct TagOsRunQue *thisRq)
+{
+    U32 tries;
+    U32 destCore;
+    bool pushed;
+    struct TagOsRunQue *destRq = NULL;
+    struct TagTskCb *task = NULL;
+
+    for (tries = 0; tries < OS_RT_MAX_TRYS; tries++) {
+        if (!thisRq->rtRq.isOverload) {
+            return;
+        }
+
+        task = GET_TCB_PUSHABLE(OS_LIST_FIRST(&thisRq->rtRq.pushAblList.nodeList));
+        destCore = OsRtFindLowestCore(task);
+        if (destCore == OS_MAX_CORE_NUM) {
+            return;
+        }
+
+        destRq = GET_RUNQ(destCore);
+        OsDoubleLockBalance(thisRq, destRq);
+        pushed = FALSE;
+        if ((task->coreID == thisRq->rqCoreId) && task->isOnRq &&
+            !ListEmpty(&task->pushAbleList.nodeList) && (destRq->currntPrio > task->priority) &&
+            OsRtTaskCanMigrate(task, destCore)) {
+            OsRtMigrateTask(thisRq, destRq, task);
+            pushed = TRUE;
+        }
+        OsDoubleUnlockDest(thisRq, destRq);
+
+        if (pushed) {
+            OsSmpSendReschedule(destCore);
+        }
+    }
+}
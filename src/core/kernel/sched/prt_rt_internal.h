@@ -54,5 +54,72 @@ OS_SEC_ALW_INLINE INLINE void OsDequeueReadyListOnly(struct TagOsRunQue *runQue,
     }
     return;
 }
+
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+#define GET_TCB_PUSHABLE(ptr) LIST_COMPONENT(ptr, struct TagTskCb, pushAbleList.nodeList)
+
+/*
+ * 描述: 任务能否参与核间迁移：允许运行在多个核上，且不是所在队列的当前运行任务
+ * 备注: NA
+ */
+OS_SEC_ALW_INLINE INLINE bool OsRtTaskPushable(struct TagOsRunQue *runQue, struct TagTskCb *task)
+{
+    return (task->nrCoresAllowed > 1) && (task != runQue->tskCurr);
+}
+
+/*
+ * 描述: 刷新可push链表中最高的优先级，供其他核无锁预判是否需要拉取
+ * 备注: NA
+ */
+OS_SEC_ALW_INLINE INLINE void OsRtPushableRefresh(struct RtRq *rtRq)
+{
+    struct TagListObject *head = &rtRq->pushAblList.nodeList;
+
+    if (ListEmpty(head)) {
+        rtRq->nextPrio = OS_TSK_NUM_OF_PRIORITIES;
+        rtRq->isOverload = FALSE;
+        return;
+    }
+
+    rtRq->nextPrio = GET_TCB_PUSHABLE(OS_LIST_FIRST(head))->pushAbleList.prio;
+    rtRq->isOverload = TRUE;
+}
+
+/*
+ * 描述: 按优先级从高到低插入可push链表，同优先级按FIFO顺序
+ * 备注: 插入需遍历链表，链表上只有本核等待运行的可迁移任务，长度有限
+ */
+OS_SEC_ALW_INLINE INLINE void OsRtPushableEnqueue(struct RtRq *rtRq, struct TagTskCb *task)
+{
+    struct TagListObject *head = &rtRq->pushAblList.nodeList;
+    struct TagListObject *pos = OS_LIST_FIRST(head);
+
+    if (!ListEmpty(&task->pushAbleList.nodeList)) {
+        return;
+    }
+
+    task->pushAbleList.prio = task->priority;
+    while ((pos != head) && (GET_TCB_PUSHABLE(pos)->pushAbleList.prio <= task->priority)) {
+        pos = OS_LIST_FIRST(pos);
+    }
+    /* 插入到pos之前 */
+    ListTailAdd(&task->pushAbleList.nodeList, pos);
+
+    OsRtPushableRefresh(rtRq);
+}
+
+OS_SEC_ALW_INLINE INLINE void OsRtPushableDequeue(struct RtRq *rtRq, struct TagTskCb *task)
+{
+    if (ListEmpty(&task->pushAbleList.nodeList)) {
+        return;
+    }
+
+    ListDelete(&task->pushAbleList.nodeList);
+    OsRtPushableRefresh(rtRq);
+}
+
+extern void OsRtPull(struct TagOsRunQue *thisRq);
+extern void OsRtPush(struct TagOsRunQue *thisRq);
+#endif
 #endif
 #endif
\ No newline at end of file
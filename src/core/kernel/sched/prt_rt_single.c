@@ -58,6 +58,11 @@ OS_SEC_L0_TEXT void OsEnqueueTaskRtSingle(struct TagOsRunQue *runQue, struct Tag
     bool head = ((flags & OS_ENQUEUE_HEAD) != 0);
     // 入就绪优先级队列
     OsEnqueueReadyListOnly(task, head, task->priority, &runQue->rtRq);
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    if (OsRtTaskPushable(runQue, task)) {
+        OsRtPushableEnqueue(&runQue->rtRq, task);
+    }
+#endif
     if (runQue->currntPrio > task->priority) {
         runQue->currntPrio = task->priority;
         runQue->needReschedule = TRUE;
@@ -75,6 +80,9 @@ OS_SEC_L0_TEXT void OsDequeueTaskRtSingle(struct TagOsRunQue *runQue, struct Tag
     (void)flags;
 
     OsDequeueReadyListOnly(runQue,task); // CRG 暂无入队列头的场景
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    OsRtPushableDequeue(rtRq, task);
+#endif
     // 出队的任务优先级不低于新的优先级，需要出发调度
     if(runQue->currntPrio >= task->priority) {
         runQue->currntPrio = OsFindHighestPri(&rtRq->activeTsk.readyPrioBit[0],
@@ -96,15 +104,21 @@ OS_SEC_L0_TEXT void OsPutPrevTaskRtSingle(struct TagOsRunQue *runQue, struct Tag
 }
 
 /*
- * 描述：RT_SINGLE主调度pick函数
- * 备注：NA
+ * 描述：RT_SINGLE pick函数主体，调用者持有rq锁
+ * 备注：中间可能的doublelock会短暂释放rq锁
  */
-OS_SEC_L0_TEXT struct TagTskCb *OsPickNextTaskRtSingle(struct TagOsRunQue *runQue)
+OS_SEC_L0_TEXT struct TagTskCb *OsPickNextTaskRtSingleLocked(struct TagOsRunQue *runQue)
 {
     struct TagTskCb *task = NULL;
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    struct TagTskCb *prev = NULL;
+#endif
 
-    // 上锁 直到中间可能的doublelock时解锁，或者schedule结束时解锁
-    OsSplLock(&runQue->spinLock);
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    // 其他核有优先级高于本核的等待任务时拉取过来，覆盖本核优先级下降或即将进入idle的场景
+    OsRtPull(runQue);
+    prev = runQue->tskCurr;
+#endif
     runQue->needReschedule = FALSE;
     if (runQue->rqCoreId == runQue->tskCurr->coreID) {
         TSK_STATUS_CLEAR(runQue->tskCurr, OS_TSK_RUNNING);
@@ -114,6 +128,32 @@ OS_SEC_L0_TEXT struct TagTskCb *OsPickNextTaskRtSingle(struct TagOsRunQue *runQu
     runQue->tskCurr = task;
     TSK_STATUS_SET(task, OS_TSK_RUNNING);
 
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    if (task != prev) {
+        OsRtPushableDequeue(&runQue->rtRq, task);
+        // 被切出但仍然就绪的任务重新成为可迁移任务
+        if (prev->isOnRq && (prev->coreID == runQue->rqCoreId) && OsRtTaskPushable(runQue, prev)) {
+            OsRtPushableEnqueue(&runQue->rtRq, prev);
+        }
+    }
+    // 本核仍有等待运行的可迁移任务，尝试推给优先级更低的核
+    OsRtPush(runQue);
+#endif
+
+    return task;
+}
+
+/*
+ * 描述：RT_SINGLE主调度pick函数
+ * 备注：NA
+ */
+OS_SEC_L0_TEXT struct TagTskCb *OsPickNextTaskRtSingle(struct TagOsRunQue *runQue)
+{
+    struct TagTskCb *task = NULL;
+
+    // 上锁 直到中间可能的doublelock时解锁，或者schedule结束时解锁
+    OsSplLock(&runQue->spinLock);
+    task = OsPickNextTaskRtSingleLocked(runQue);
     OsSplUnlock(&runQue->spinLock);
 
     return task;
@@ -37,6 +37,10 @@ INIT_SEC_L4_TEXT void OsSchedRunQueInit(void)
         for(prioIdx = 0; prioIdx < OS_TSK_NUM_OF_PRIORITIES; prioIdx++) {
             OS_LIST_INIT(&rtRq->activeTsk.readyList[prioIdx]);
         }
+#if defined(OS_OPTION_SCHED_EDF)
+        OS_LIST_INIT(&g_runQueue[i].dlRq.readyList);
+        OS_LIST_INIT(&g_runQueue[i].dlRq.throttledList);
+#endif
         g_runQueue[i].schedClass = OsSchedGetSchedClass();
     }
     return;
@@ -25,6 +25,9 @@ OS_SEC_L4_TEXT void OsTaskDeleteResInit(struct TagTskCb *taskCb)
 
     if (((OS_TSK_DELAY | OS_TSK_TIMEOUT) & taskCb->taskStatus) != 0) {
         ListDelete(&taskCb->timerList);
+#if defined(OS_OPTION_HRTIMER)
+        (void)OsHrtimerCancel(&taskCb->sleepTimer);
+#endif
     }
 
     if ((OS_TSK_READY & taskCb->taskStatus) != 0) {
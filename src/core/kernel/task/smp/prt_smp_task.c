@@ -35,7 +35,7 @@ OS_SEC_L0_TEXT void OsTskReadyAddBgd(struct TagTskCb *task)
  */
 OS_SEC_L0_TEXT void OsTskDlyNearestTicksRefresh(struct TagOsTskSortedDelayList *tskDlyBase)
 {
-    U64 ticks = OS_TICKLESS_FOREVER;
+    U64 ticks;
 
     struct TagListObject *tskList = &tskDlyBase->tskList;
 
@@ -43,6 +43,8 @@ OS_SEC_L0_TEXT void OsTskDlyNearestTicksRefresh(struct TagOsTskSortedDelayList *
         struct TagTskCb *taskCB = LIST_COMPONENT(OS_LIST_FIRST(tskList), struct TagTskCb, timerList);
 
         ticks = taskCB->expirationTick;
+    } else {
+        ticks = OsTmrWheelNearest(&tskDlyBase->wheel);
     }
     tskDlyBase->nearestTicks = ticks;
 }
@@ -218,6 +220,10 @@ OS_SEC_L2_TEXT U32 OsTaskSetAffinityCheck(TskHandle taskPID, U32 coreMask, struc
         return OS_ERRNO_TSK_NOT_CREATED;
     }
 
+    if (OS_TSK_IS_DEADLINE(tempTaskCB)) {
+        return OS_ERRNO_TSK_DEADLINE_BIND;
+    }
+
     if (coreMask == 0) {
         return OS_ERRNO_TSK_BIND_CORE_INVALID;
     }
@@ -405,9 +411,14 @@ OS_SEC_TEXT bool OsTskDlyScanNoPendLock(struct TagTskCb *taskCB, struct TagOsTsk
 OS_SEC_TEXT bool OsTskDlyScanHasPendLock(struct TagTskCb *taskCB, volatile uintptr_t *pendedLock,
                                          struct TagOsTskSortedDelayList *tskDlyBase)
 {
+    struct TagTskCb *semOwnerTask = NULL;
+
     CPU_OVERTIME_SORT_LIST_UNLOCK(tskDlyBase);
     OsSplLock(pendedLock);
-    OsSemPrioLock();
+    /* 互斥信号量的阻塞链表在持有者semBLock内修改，pendedLock即信号量控制块首个成员semLock */
+    if (TSK_STATUS_TST(taskCB, OS_TSK_PEND) && (taskCB->taskPend == (void *)pendedLock)) {
+        semOwnerTask = OsSemIfOwnerLock((struct TagSemCb *)taskCB->taskPend);
+    }
     OsSpinLockTaskRq(taskCB);
     CPU_OVERTIME_SORT_LIST_LOCK(tskDlyBase);
     if (((taskCB->taskStatus & OS_TSK_INUSE) != 0) && (tskDlyBase == CPU_TSK_DELAY_BASE(taskCB->timeCoreID)) &&
@@ -418,11 +429,11 @@ OS_SEC_TEXT bool OsTskDlyScanHasPendLock(struct TagTskCb *taskCB, volatile uintp
         taskCB->taskPend = NULL;
 
         CPU_OVERTIME_SORT_LIST_UNLOCK(tskDlyBase);
-        OsSemPrioUnLock();
+        OsSemIfOwnerUnLock(semOwnerTask);
         OsSplUnlock(pendedLock);
     } else {
         OsSpinUnlockTaskRq(taskCB);
-        OsSemPrioUnLock();
+        OsSemIfOwnerUnLock(semOwnerTask);
         OsSplUnlock(pendedLock);
         return TRUE;
     }
@@ -476,6 +487,9 @@ OS_SEC_TEXT void OsTskDlyBaseScan(struct TagOsTskSortedDelayList *tskDlyBase)
 
     CPU_OVERTIME_SORT_LIST_LOCK(tskDlyBase);
 
+    /* 时间轮推进到当前tick，到期任务移到tskList上逐个唤醒 */
+    OsTmrWheelAdvance(&tskDlyBase->wheel, g_uniTicks, tskList);
+
     while (1) {
         if (ListEmpty(tskList)) {
             OsTskDlyNearestTicksRefresh(tskDlyBase);
@@ -504,6 +518,9 @@ OS_SEC_TEXT void OsTaskScan(void)
     struct TagOsTskSortedDelayList *tskDlyBase = CPU_TSK_DELAY_BASE(thisCoreID);
 
     OsTskDlyBaseScan(tskDlyBase);
+#if defined(OS_OPTION_SCHED_EDF)
+    OsDlTick(THIS_RUNQ());
+#endif
 }
 
 #if (OS_MAX_CORE_NUM > 1)
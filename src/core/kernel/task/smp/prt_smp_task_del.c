@@ -93,10 +93,11 @@ OS_SEC_L4_TEXT void OsTaskDeleteResFree(TskHandle taskPID, struct TagTskCb *task
     /* 任务信号量阻塞 */
     if (TSK_STATUS_TST(taskCB, OS_TSK_PEND)) {
         struct TagSemCb *pendSem = taskCB->taskPend;
+        struct TagTskCb *semOwnerTask;
         SEM_CB_LOCK(pendSem);
-        OsSemPrioLock();
+        semOwnerTask = OsSemIfOwnerLock(pendSem);
         ListDelete(&taskCB->pendList);
-        OsSemPrioUnLock();
+        OsSemIfOwnerUnLock(semOwnerTask);
         SEM_CB_UNLOCK(pendSem);
     }
 
@@ -118,12 +119,18 @@ OS_SEC_L4_TEXT void OsTaskDeleteResFree(TskHandle taskPID, struct TagTskCb *task
 
     if (TSK_STATUS_TST(taskCB, OS_TSK_DELAY | OS_TSK_TIMEOUT)) {
         OS_TSK_DELAY_LOCKED_DETACH(taskCB);
+#if defined(OS_OPTION_HRTIMER)
+        (void)OsHrtimerCancel(&taskCB->sleepTimer);
+#endif
     }
     return;
 }
 OS_SEC_L4_TEXT void OsTaskDeleteStatusInit(TskHandle taskPID, struct TagTskCb *taskCB)
 {
     OsSpinLockTaskRq(taskCB);
+#if defined(OS_OPTION_SCHED_EDF)
+    OsDlTaskRelease(taskCB);
+#endif
     taskCB->taskStatus = OS_TSK_UNUSED;
     taskCB->taskStatus &= ~OS_TSK_DELETING;
     OsSpinUnlockTaskRq(taskCB);
@@ -207,6 +207,8 @@ OS_SEC_ALW_INLINE INLINE void OsTskSmpDelaySysInit(void)
         tskDlyBase = CPU_TSK_DELAY_BASE(index);
         OS_LIST_INIT(&tskDlyBase->tskList);
         tskDlyBase->nearestTicks = OS_TICKLESS_FOREVER;
+        OsTmrWheelInit(&tskDlyBase->wheel, OFFSET_OF_FIELD(struct TagTskCb, expirationTick) -
+            OFFSET_OF_FIELD(struct TagTskCb, timerList), g_uniTicks);
         OsSpinLockInitInner(&tskDlyBase->spinLock);
     }
 #if defined(OS_OPTION_TICKLESS)
@@ -72,6 +72,11 @@ OS_SEC_ALW_INLINE INLINE void OsTskSMPTcbInit(struct TskInitParam *initParam, st
     taskCB->scheClass = RT_SINGLE_CLASS();
     taskCB->coreAllowedMask = (OS_CORE_MASK)OS_ALLCORES_MASK;
     taskCB->nrCoresAllowed = g_maxNumOfCores;
+#if defined(OS_OPTION_SCHED_EDF)
+    taskCB->dlRuntime = 0;
+    taskCB->dlBw = 0;
+    taskCB->dlThrottled = FALSE;
+#endif
 }
 
 OS_SEC_ALW_INLINE INLINE struct TagTskCb *OsGetCurrentTcb(void)
@@ -61,7 +61,7 @@ OS_SEC_L2_TEXT void OsTskIdleBgd(void)
 
 OS_SEC_ALW_INLINE INLINE void OsTskReadyAddOnly(struct TagTskCb *task)
 {
-    struct TagOsRunQue *rq = GET_RUNQ(task->coreID);
+    struct TagOsRunQue *rq = NULL;
     TSK_STATUS_SET(task, OS_TSK_READY);
 #if defined(OS_OPTION_RR_SCHED)
     task->timeSlice = g_timeSliceCycle;
@@ -69,6 +69,11 @@ OS_SEC_ALW_INLINE INLINE void OsTskReadyAddOnly(struct TagTskCb *task)
     if(UNLIKELY(task->isOnRq)){
         return;
     }
+#if defined(OS_OPTION_SMP_RT_BALANCE)
+    // 所在核无法立即运行该任务时，入队前将其放到优先级更低的核上
+    OsRtSelectTaskRq(task);
+#endif
+    rq = GET_RUNQ(task->coreID);
     OsEnqueueTask(rq, task, 0);
 
     OsIncNrRunning(rq);
@@ -76,7 +81,8 @@ OS_SEC_ALW_INLINE INLINE void OsTskReadyAddOnly(struct TagTskCb *task)
     return;
 }
 /*
- * 描述：将任务添加到就绪队列, 调用者确保不会换核，并锁上rq
+ * 描述：将任务添加到就绪队列, 调用者锁上任务所在rq
+ * 备注：使能OS_OPTION_SMP_RT_BALANCE时任务可能被放到其他核，返回时持有任务新所在rq的锁
  */
 OS_SEC_L0_TEXT void OsTskReadyAdd(struct TagTskCb *task)
 {
@@ -124,29 +130,16 @@ OS_SEC_L0_TEXT void OsTskReadyDel(struct TagTskCb *taskCb)
  */
 OS_SEC_L0_TEXT void OsTskTimerAdd(struct TagTskCb *taskCb, uintptr_t timeout)
 {
-    struct TagTskCb *tskDelay = NULL;
     struct TagOsTskSortedDelayList *tskDlyBase = NULL;
-    struct TagListObject *taskList = NULL;
 
     OS_SET_DLYBASE_AND_TSK_CORE(tskDlyBase, taskCb);
 
     taskCb->expirationTick = g_uniTicks + timeout;
-    taskList = &tskDlyBase->tskList;
 
     CPU_OVERTIME_SORT_LIST_LOCK(tskDlyBase);
 
-    if (ListEmpty(taskList)) {
-        ListTailAdd(&taskCb->timerList, taskList);
-    } else {
-        /* Put the task to right location */
-        LIST_FOR_EACH(tskDelay, taskList, struct TagTskCb, timerList) {
-            if (tskDelay->expirationTick > taskCb->expirationTick) {
-                break;
-            }
-        }
-
-        ListTailAdd(&taskCb->timerList, &tskDelay->timerList);
-    }
+    /* 按超时tick直接挂到时间轮对应的槽上 */
+    OsTmrWheelAdd(&tskDlyBase->wheel, &taskCb->timerList);
     OsTskDlyNearestTicksRefresh(tskDlyBase);
 
     CPU_OVERTIME_SORT_LIST_UNLOCK(tskDlyBase);
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-01
+ * Description: Task deadline schedule parameter implementation
+ */
+#include "prt_task_external.h"
+#include "prt_sched_external.h"
+#include "prt_task_sched_external.h"
+
+OS_SEC_ALW_INLINE INLINE U32 OsTaskDeadlineSetCheck(TskHandle taskPid, struct TskDeadlineParam *param)
+{
+    if (CHECK_TSK_PID_OVERFLOW(taskPid)) {
+        return OS_ERRNO_TSK_ID_INVALID;
+    }
+
+    if (TSK_GET_INDEX(taskPid) >= g_tskMaxNum) {
+        return OS_ERRNO_TSK_OPERATE_IDLE;
+    }
+
+    if (param == NULL) {
+        return OS_ERRNO_TSK_PTR_NULL;
+    }
+
+    if (param->runtime == 0) {
+        return OS_OK;
+    }
+
+    if ((param->runtime > param->deadline) || (param->deadline > param->period) ||
+        (param->period > OS_DL_PERIOD_MAX_US) || (OS_US2CYCLE(param->runtime, g_systemClock) == 0)) {
+        return OS_ERRNO_TSK_DEADLINE_PARAM_INVALID;
+    }
+
+    return OS_OK;
+}
+
+/* 截止期任务不迁移，必须只绑定在当前所在核上 */
+OS_SEC_ALW_INLINE INLINE bool OsTaskDeadlineBound(struct TagTskCb *taskCb)
+{
+    return (taskCb->nrCoresAllowed == 1) && CPUMASK_HAS_BIT(taskCb->coreAllowedMask, taskCb->coreID);
+}
+
+OS_SEC_ALW_INLINE INLINE void OsTaskDeadlineParamSet(struct TagTskCb *taskCb, struct TskDeadlineParam *param, U32 bw)
+{
+    if (param->runtime == 0) {
+        taskCb->dlRuntime = 0;
+        taskCb->dlDeadline = 0;
+        taskCb->dlPeriod = 0;
+    } else {
+        taskCb->dlRuntime = OS_US2CYCLE(param->runtime, g_systemClock);
+        taskCb->dlDeadline = OS_US2CYCLE(param->deadline, g_systemClock);
+        taskCb->dlPeriod = OS_US2CYCLE(param->period, g_systemClock);
+    }
+    taskCb->dlBw = bw;
+    /* 下次入队时按唤醒规则重新开始一个周期 */
+    taskCb->dlAbsDeadline = 0;
+    taskCb->dlRemain = 0;
+}
+
+/*
+ * 描述：设置指定任务的截止期调度参数
+ */
+OS_SEC_L4_TEXT U32 PRT_TaskSetDeadline(TskHandle taskPid, struct TskDeadlineParam *param)
+{
+    U32 ret;
+    U32 bw = 0;
+    U32 bwUsed;
+    bool isReady = FALSE;
+    uintptr_t intSave;
+    struct TagTskCb *taskCb = NULL;
+    struct TagOsRunQue *runQue = NULL;
+
+    ret = OsTaskDeadlineSetCheck(taskPid, param);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    if (param->runtime != 0) {
+        bw = (U32)DIV64((U64)param->runtime << OS_DL_BW_SHIFT, param->period);
+    }
+
+    taskCb = GET_TCB_HANDLE(taskPid);
+    intSave = OsIntLock();
+    OsSpinLockTaskRq(taskCb);
+    if (TSK_IS_UNUSED(taskCb)) {
+        OsSpinUnlockTaskRq(taskCb);
+        OsIntRestore(intSave);
+        return OS_ERRNO_TSK_NOT_CREATED;
+    }
+
+    if ((param->runtime != 0) && !OsTaskDeadlineBound(taskCb)) {
+        OsSpinUnlockTaskRq(taskCb);
+        OsIntRestore(intSave);
+        return OS_ERRNO_TSK_DEADLINE_NOT_BOUND;
+    }
+
+    /* 带宽准入控制，替换任务原有的带宽后不超过核的上限 */
+    runQue = GET_TASK_RQ(taskCb);
+    bwUsed = runQue->dlRq.bwUsed - taskCb->dlBw + bw;
+    if (bwUsed > OS_DL_BW_MAX) {
+        OsSpinUnlockTaskRq(taskCb);
+        OsIntRestore(intSave);
+        return OS_ERRNO_TSK_DEADLINE_BW_EXCEEDED;
+    }
+    runQue->dlRq.bwUsed = bwUsed;
+
+    isReady = (OS_TSK_READY & taskCb->taskStatus);
+
+    /* 按原调度类型出队，按新调度类型重新入队 */
+    if (isReady) {
+        OsTskReadyDel(taskCb);
+        OsTaskDeadlineParamSet(taskCb, param, bw);
+        taskCb->scheClass = OS_SCHED_CLASS(taskCb->coreID);
+        OsTskReadyAdd(taskCb);
+    } else {
+        OsTaskDeadlineParamSet(taskCb, param, bw);
+        taskCb->scheClass = OS_SCHED_CLASS(taskCb->coreID);
+    }
+    OsSpinUnlockTaskRq(taskCb);
+
+    if (isReady) {
+        OsTskSchedule();
+    }
+
+    OsIntRestore(intSave);
+    return OS_OK;
+}
+
+/*
+ * 描述：获取指定任务的截止期调度参数
+ */
+OS_SEC_L4_TEXT U32 PRT_TaskGetDeadline(TskHandle taskPid, struct TskDeadlineParam *param)
+{
+    uintptr_t intSave;
+    struct TagTskCb *taskCb = NULL;
+
+    if (CHECK_TSK_PID_OVERFLOW(taskPid)) {
+        return OS_ERRNO_TSK_ID_INVALID;
+    }
+
+    if (param == NULL) {
+        return OS_ERRNO_TSK_PTR_NULL;
+    }
+
+    taskCb = GET_TCB_HANDLE(taskPid);
+    intSave = OsIntLock();
+    OsSpinLockTaskRq(taskCb);
+    if (TSK_IS_UNUSED(taskCb)) {
+        OsSpinUnlockTaskRq(taskCb);
+        OsIntRestore(intSave);
+        return OS_ERRNO_TSK_NOT_CREATED;
+    }
+
+    param->runtime = (U32)DIV64(taskCb->dlRuntime * OS_SYS_US_PER_SECOND, g_systemClock);
+    param->deadline = (U32)DIV64(taskCb->dlDeadline * OS_SYS_US_PER_SECOND, g_systemClock);
+    param->period = (U32)DIV64(taskCb->dlPeriod * OS_SYS_US_PER_SECOND, g_systemClock);
+    OsSpinUnlockTaskRq(taskCb);
+    OsIntRestore(intSave);
+
+    return OS_OK;
+}
+
+/*
+ * 描述：任务删除时释放截止期带宽，调用者持有任务所在rq的锁
+ */
+OS_SEC_L4_TEXT void OsDlTaskRelease(struct TagTskCb *task)
+{
+    GET_TASK_RQ(task)->dlRq.bwUsed -= task->dlBw;
+    task->dlBw = 0;
+    task->dlRuntime = 0;
+    task->dlDeadline = 0;
+    task->dlPeriod = 0;
+    task->dlThrottled = FALSE;
+}
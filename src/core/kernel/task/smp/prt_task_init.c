@@ -330,6 +330,7 @@ OS_SEC_L4_TEXT void OsTskCreateTcbInit(uintptr_t stackPtr, struct TskInitParam *
 #endif
 
     OS_LIST_INIT(&taskCb->semBList);
+    OsSpinLockInitInner(&taskCb->semBLock);
     OS_LIST_INIT(&taskCb->pendList);
     OS_LIST_INIT(&taskCb->timerList);
 
@@ -65,25 +65,21 @@ OS_SEC_ALW_INLINE INLINE U32 OsTaskPrioritySetCheck(TskHandle taskPid, TskPrior
     return OS_OK;
 }
 
-OS_SEC_ALW_INLINE INLINE U32 OsSemPrioBListLock(struct TagTskCb *taskCb)
+OS_SEC_ALW_INLINE INLINE void OsSemPrioBListLock(struct TagTskCb *taskCb)
 {
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
-    if (!ListEmpty(&taskCb->semBList)) {
-        OsSemPrioLock();
-        return 1;
-    }
+    OsSemOwnerLock(taskCb);
+#else
+    (void)taskCb;
 #endif
-    return 0;
 }
 
-OS_SEC_ALW_INLINE INLINE void OsSemPrioBListUnLock(U32 flag)
+OS_SEC_ALW_INLINE INLINE void OsSemPrioBListUnLock(struct TagTskCb *taskCb)
 {
 #if defined(OS_OPTION_SEM_PRIO_INHERIT)
-    if (flag) {
-        OsSemPrioUnLock();
-    }
+    OsSemOwnerUnLock(taskCb);
 #else
-    (void)flag;
+    (void)taskCb;
 #endif
 }
 
@@ -96,7 +92,6 @@ OS_SEC_L4_TEXT U32 PRT_TaskSetPriority(TskHandle taskPid, TskPrior taskPrio)
     bool isReady = FALSE;
     uintptr_t intSave;
     struct TagTskCb *taskCb = NULL;
-    U32 semPrioLockFlag;
 
     ret = OsTaskPrioritySetCheck(taskPid, taskPrio);
     if (ret != OS_OK) {
@@ -105,13 +100,13 @@ OS_SEC_L4_TEXT U32 PRT_TaskSetPriority(TskHandle taskPid, TskPrior taskPrio)
 
     taskCb = GET_TCB_HANDLE(taskPid);
     intSave = OsIntLock();
-    // 如果持有信号量互斥锁，避免遍历semBList时和semBList产生变化，需要锁semIfPrio
-    semPrioLockFlag = OsSemPrioBListLock(taskCb);
+    // 避免遍历semBList及所持有互斥信号量的阻塞链表时发生变化，需要锁任务自身的semBLock
+    OsSemPrioBListLock(taskCb);
     OsSpinLockTaskRq(taskCb);
     if (TSK_IS_UNUSED(taskCb)) {
         OsIntRestore(intSave);
         OsSpinUnlockTaskRq(taskCb);
-        OsSemPrioBListUnLock(semPrioLockFlag);
+        OsSemPrioBListUnLock(taskCb);
         return OS_ERRNO_TSK_NOT_CREATED;
     }
 
@@ -120,7 +115,7 @@ OS_SEC_L4_TEXT U32 PRT_TaskSetPriority(TskHandle taskPid, TskPrior taskPrio)
         ret = g_checkPrioritySet(taskCb, taskPrio);
         if (ret != OS_OK) {
             OsSpinUnlockTaskRq(taskCb);
-            OsSemPrioBListUnLock(semPrioLockFlag);
+            OsSemPrioBListUnLock(taskCb);
             OsIntRestore(intSave);
             return ret;
         }
@@ -139,7 +134,7 @@ OS_SEC_L4_TEXT U32 PRT_TaskSetPriority(TskHandle taskPid, TskPrior taskPrio)
     }
     taskCb->origPriority = taskPrio;
     OsSpinUnlockTaskRq(taskCb);
-    OsSemPrioBListUnLock(semPrioLockFlag);
+    OsSemPrioBListUnLock(taskCb);
 
     /* reschedule if ready changed */
     if (isReady) {
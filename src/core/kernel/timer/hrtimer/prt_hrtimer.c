@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-15
+ * Description: 高精度单次定时器实现，不依赖tick，直接按cycle设置每核硬件定时器
+ */
+#include "prt_hrtimer_external.h"
+#include "prt_task_external.h"
+#include "prt_task_sched_external.h"
+#include "prt_mem_external.h"
+
+#if defined(OS_OPTION_SMP)
+#define OS_HRTIMER_CORE() THIS_CORE()
+#else
+#define OS_HRTIMER_CORE() 0U
+#endif
+
+/*
+ * 用户定时器控制块，空闲时通过timer.node挂在空闲链表上
+ */
+struct TagHrtimerCb {
+    struct TagHrtimer timer;
+    HrtimerProcFunc func;
+    uintptr_t arg;
+    bool used;
+};
+
+OS_SEC_BSS struct TagHrtimerBase g_hrtimerBase[OS_VAR_ARRAY_NUM];
+OS_SEC_BSS HrtimerSetEventFunc g_hrtimerSetEvent;
+OS_SEC_BSS struct TagHrtimerCb *g_hrtimerCbArray;
+OS_SEC_BSS U32 g_hrtimerMaxNum;
+OS_SEC_BSS struct TagListObject g_hrtimerFreeList;
+OS_SEC_BSS volatile uintptr_t g_hrtimerFreeLock;
+
+/*
+ * 描述：ns转换为cycle，向上取整，保证定时器不会早于指定时刻到期
+ */
+OS_SEC_TEXT U64 OsHrtimerNs2Cycle(U64 ns)
+{
+    U64 sec = DIV64(ns, OS_SYS_NS_PER_SECOND);
+    U64 rem = DIV64_REMAIN(ns, OS_SYS_NS_PER_SECOND);
+
+    return sec * g_systemClock + DIV64(rem * g_systemClock + OS_SYS_NS_PER_SECOND - 1, OS_SYS_NS_PER_SECOND);
+}
+
+/*
+ * 描述：cycle转换为ns，拆分秒和余数避免乘法溢出
+ */
+OS_SEC_TEXT U64 OsHrtimerCycle2Ns(U64 cycle)
+{
+    U64 sec = DIV64(cycle, g_systemClock);
+    U64 rem = DIV64_REMAIN(cycle, g_systemClock);
+
+    return sec * OS_SYS_NS_PER_SECOND + DIV64(rem * OS_SYS_NS_PER_SECOND, g_systemClock);
+}
+
+/*
+ * 描述：按链表头的超时时刻设置本核硬件定时器，调用者持有base锁
+ */
+OS_SEC_ALW_INLINE INLINE void OsHrtimerProgram(struct TagHrtimerBase *base)
+{
+    U64 next = OS_HRTIMER_EVENT_NONE;
+
+    if (!ListEmpty(&base->list)) {
+        next = LIST_COMPONENT(OS_LIST_FIRST(&base->list), struct TagHrtimer, node)->expire;
+    }
+
+    base->nextEvent = next;
+    g_hrtimerSetEvent(next);
+}
+
+/*
+ * 描述：将定时器从所在核的链表上摘除，返回定时器是否处于PENDING状态
+ * 备注：调用者已关中断；coreID在获取对应核的base锁后需要再次确认
+ */
+OS_SEC_TEXT bool OsHrtimerDetach(struct TagHrtimer *timer)
+{
+    U32 coreID;
+    bool pending;
+    struct TagHrtimerBase *base = NULL;
+
+    while (TRUE) {
+        if (timer->state == OS_HRTIMER_IDLE) {
+            return FALSE;
+        }
+
+        coreID = timer->coreID;
+        base = &g_hrtimerBase[coreID];
+        OsSplLock(&base->spinLock);
+        if (timer->coreID == coreID) {
+            break;
+        }
+        OsSplUnlock(&base->spinLock);
+    }
+
+    pending = (timer->state == OS_HRTIMER_PENDING);
+    if (pending) {
+        ListDelete(&timer->node);
+    }
+    timer->state = OS_HRTIMER_IDLE;
+    OsSplUnlock(&base->spinLock);
+
+    return pending;
+}
+
+/*
+ * 描述：在当前核上启动定时器，expire为绝对cycle
+ * 备注：链表按超时时刻升序排列，定时器成为链表头时重新设置硬件定时器
+ */
+OS_SEC_TEXT void OsHrtimerStart(struct TagHrtimer *timer, U64 expire)
+{
+    uintptr_t intSave;
+    struct TagHrtimer *iter = NULL;
+    struct TagHrtimerBase *base = NULL;
+    struct TagListObject *pos = NULL;
+
+    intSave = OsIntLock();
+    (void)OsHrtimerDetach(timer);
+
+    base = &g_hrtimerBase[OS_HRTIMER_CORE()];
+    OsSplLock(&base->spinLock);
+
+    timer->expire = expire;
+    timer->coreID = OS_HRTIMER_CORE();
+    timer->state = OS_HRTIMER_PENDING;
+
+    /* 同一时刻的定时器按启动先后到期，从尾部向前查找插入位置 */
+    pos = &base->list;
+    while (pos->prev != &base->list) {
+        iter = LIST_COMPONENT(pos->prev, struct TagHrtimer, node);
+        if (iter->expire <= expire) {
+            break;
+        }
+        pos = pos->prev;
+    }
+    ListTailAdd(&timer->node, pos);
+
+    if ((OS_LIST_FIRST(&base->list) == &timer->node) && (expire < base->nextEvent)) {
+        OsHrtimerProgram(base);
+    }
+
+    OsSplUnlock(&base->spinLock);
+    OsIntRestore(intSave);
+}
+
+/*
+ * 描述：停止定时器，返回定时器停止前是否处于PENDING状态
+ * 备注：链表头被摘除时不重新设置硬件，多余的一次中断在中断处理中直接返回
+ */
+OS_SEC_TEXT bool OsHrtimerCancel(struct TagHrtimer *timer)
+{
+    bool pending;
+    uintptr_t intSave;
+
+    intSave = OsIntLock();
+    pending = OsHrtimerDetach(timer);
+    OsIntRestore(intSave);
+
+    return pending;
+}
+
+/*
+ * 描述：任务睡眠定时器到期，唤醒任务
+ * 备注：定时器状态在rq锁内检查，任务已被删除或已被取消时不做处理
+ */
+OS_SEC_TEXT void OsHrtimerWakeTask(struct TagHrtimer *timer, uintptr_t arg)
+{
+    struct TagTskCb *taskCb = (struct TagTskCb *)arg;
+
+    OsSpinLockTaskRq(taskCb);
+    if ((timer->state == OS_HRTIMER_FIRING) && TSK_STATUS_TST(taskCb, OS_TSK_DELAY)) {
+        TSK_STATUS_CLEAR(taskCb, OS_TSK_DELAY);
+        if (!TSK_STATUS_TST(taskCb, OS_TSK_SUSPEND_READY_BLOCK)) {
+            OsTskReadyAddBgd(taskCb);
+#if !defined(OS_OPTION_SMP)
+            OsTskScheduleFast();
+#endif
+        }
+    }
+    OsSpinUnlockTaskRq(taskCb);
+}
+
+/*
+ * 描述：用户定时器到期，调用用户回调
+ */
+OS_SEC_TEXT void OsHrtimerUserProc(struct TagHrtimer *timer, uintptr_t arg)
+{
+    struct TagHrtimerCb *hrtimerCb = &g_hrtimerCbArray[arg];
+
+    (void)timer;
+    hrtimerCb->func((HrtimerHandle)arg, hrtimerCb->arg);
+}
+
+/*
+ * 描述：高精度定时器中断处理，执行本核所有已到期的定时器
+ */
+OS_SEC_TEXT void PRT_HrtimerISR(void)
+{
+    uintptr_t intSave;
+    struct TagHrtimer *timer = NULL;
+    struct TagHrtimerBase *base = NULL;
+
+    if (g_hrtimerSetEvent == NULL) {
+        return;
+    }
+
+    intSave = OsIntLock();
+    base = &g_hrtimerBase[OS_HRTIMER_CORE()];
+    OsSplLock(&base->spinLock);
+
+    while (!ListEmpty(&base->list)) {
+        timer = LIST_COMPONENT(OS_LIST_FIRST(&base->list), struct TagHrtimer, node);
+        if (timer->expire > OsCurCycleGet64()) {
+            break;
+        }
+
+        ListDelete(&timer->node);
+        timer->state = OS_HRTIMER_FIRING;
+        base->running = timer;
+
+        /* 回调中可能重新启动定时器或获取rq锁，释放base锁后执行 */
+        OsSplUnlock(&base->spinLock);
+        timer->func(timer, timer->arg);
+        OsSplLock(&base->spinLock);
+
+        base->running = NULL;
+
+        if (timer->state == OS_HRTIMER_FIRING) {
+            timer->state = OS_HRTIMER_IDLE;
+        }
+    }
+
+    OsHrtimerProgram(base);
+
+    OsSplUnlock(&base->spinLock);
+    OsIntRestore(intSave);
+}
+
+/*
+ * 描述：初始化高精度定时器
+ */
+OS_SEC_L4_TEXT U32 PRT_HrtimerInit(struct HrtimerInitPara *para)
+{
+    U32 idx;
+    struct TagHrtimerCb *hrtimerCb = NULL;
+
+    if (g_hrtimerSetEvent != NULL) {
+        return OS_ERRNO_HRTIMER_INIT_REPEATED;
+    }
+
+    if ((para == NULL) || (para->setNextEvent == NULL) || (para->maxNum == 0)) {
+        return OS_ERRNO_HRTIMER_PARA_INVALID;
+    }
+
+    hrtimerCb = (struct TagHrtimerCb *)OsMemAlloc(OS_MID_TIMER, OS_MEM_DEFAULT_FSC_PT,
+        para->maxNum * sizeof(struct TagHrtimerCb));
+    if (hrtimerCb == NULL) {
+        return OS_ERRNO_HRTIMER_NO_MEMORY;
+    }
+
+    if (memset_s(hrtimerCb, para->maxNum * sizeof(struct TagHrtimerCb), 0,
+        para->maxNum * sizeof(struct TagHrtimerCb)) != EOK) {
+        OS_GOTO_SYS_ERROR1();
+    }
+
+    OS_LIST_INIT(&g_hrtimerFreeList);
+    for (idx = 0; idx < para->maxNum; idx++) {
+        ListTailAdd(&hrtimerCb[idx].timer.node, &g_hrtimerFreeList);
+    }
+
+    for (idx = 0; idx < OS_VAR_ARRAY_NUM; idx++) {
+        g_hrtimerBase[idx].spinLock = 0;
+        OS_LIST_INIT(&g_hrtimerBase[idx].list);
+        g_hrtimerBase[idx].nextEvent = OS_HRTIMER_EVENT_NONE;
+        g_hrtimerBase[idx].running = NULL;
+    }
+
+    g_hrtimerCbArray = hrtimerCb;
+    g_hrtimerMaxNum = para->maxNum;
+    g_hrtimerSetEvent = para->setNextEvent;
+
+    return OS_OK;
+}
+
+/*
+ * 描述：按句柄获取已创建的用户定时器
+ */
+OS_SEC_ALW_INLINE INLINE U32 OsHrtimerCbGet(HrtimerHandle handle, struct TagHrtimerCb **hrtimerCb)
+{
+    if (g_hrtimerSetEvent == NULL) {
+        return OS_ERRNO_HRTIMER_NOT_INIT;
+    }
+
+    if ((handle >= g_hrtimerMaxNum) || !g_hrtimerCbArray[handle].used) {
+        return OS_ERRNO_HRTIMER_HANDLE_INVALID;
+    }
+
+    *hrtimerCb = &g_hrtimerCbArray[handle];
+    return OS_OK;
+}
+
+/*
+ * 描述：将超时时间转换为绝对cycle
+ */
+OS_SEC_ALW_INLINE INLINE U64 OsHrtimerExpireGet(U64 expireNs, U32 mode)
+{
+    if (mode == OS_HRTIMER_ABS) {
+        return OsHrtimerNs2Cycle(expireNs);
+    }
+
+    return OsCurCycleGet64() + OsHrtimerNs2Cycle(expireNs);
+}
+
+/*
+ * 描述：创建高精度定时器
+ */
+OS_SEC_L4_TEXT U32 PRT_HrtimerCreate(HrtimerProcFunc func, uintptr_t arg, HrtimerHandle *handle)
+{
+    uintptr_t intSave;
+    struct TagHrtimerCb *hrtimerCb = NULL;
+
+    if (g_hrtimerSetEvent == NULL) {
+        return OS_ERRNO_HRTIMER_NOT_INIT;
+    }
+
+    if ((func == NULL) || (handle == NULL)) {
+        return OS_ERRNO_HRTIMER_PARA_INVALID;
+    }
+
+    intSave = OsIntLock();
+    OsSplLock(&g_hrtimerFreeLock);
+    if (ListEmpty(&g_hrtimerFreeList)) {
+        OsSplUnlock(&g_hrtimerFreeLock);
+        OsIntRestore(intSave);
+        return OS_ERRNO_HRTIMER_MAXSIZE;
+    }
+
+    hrtimerCb = LIST_COMPONENT(OS_LIST_FIRST(&g_hrtimerFreeList), struct TagHrtimerCb, timer.node);
+    ListDelete(&hrtimerCb->timer.node);
+    OsSplUnlock(&g_hrtimerFreeLock);
+    OsIntRestore(intSave);
+
+    *handle = (HrtimerHandle)(hrtimerCb - g_hrtimerCbArray);
+    hrtimerCb->func = func;
+    hrtimerCb->arg = arg;
+    hrtimerCb->timer.func = OsHrtimerUserProc;
+    hrtimerCb->timer.arg = (uintptr_t)*handle;
+    hrtimerCb->timer.state = OS_HRTIMER_IDLE;
+    hrtimerCb->used = TRUE;
+
+    return OS_OK;
+}
+
+/*
+ * 描述：摘除待删除的定时器，回调正在其他核上执行时返回FALSE，不做处理
+ * 备注：调用者已关中断；取消后FIRING状态已被清除，以base->running判断回调是否在执行；
+ *       本核running为该定时器时说明在其回调中删除自身，回调返回后中断处理不再访问控制块内容
+ */
+OS_SEC_L4_TEXT bool OsHrtimerDetachForDelete(struct TagHrtimer *timer)
+{
+    U32 coreID;
+    struct TagHrtimerBase *base = NULL;
+
+    while (TRUE) {
+        coreID = timer->coreID;
+        base = &g_hrtimerBase[coreID];
+        OsSplLock(&base->spinLock);
+        if (timer->coreID == coreID) {
+            break;
+        }
+        OsSplUnlock(&base->spinLock);
+    }
+
+    if ((base->running == timer) && (coreID != OS_HRTIMER_CORE())) {
+        OsSplUnlock(&base->spinLock);
+        return FALSE;
+    }
+
+    if (timer->state == OS_HRTIMER_PENDING) {
+        ListDelete(&timer->node);
+    }
+    timer->state = OS_HRTIMER_IDLE;
+    OsSplUnlock(&base->spinLock);
+
+    return TRUE;
+}
+
+/*
+ * 描述：删除高精度定时器
+ */
+OS_SEC_L4_TEXT U32 PRT_HrtimerDelete(HrtimerHandle handle)
+{
+    U32 ret;
+    uintptr_t intSave;
+    struct TagHrtimerCb *hrtimerCb = NULL;
+
+    ret = OsHrtimerCbGet(handle, &hrtimerCb);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    intSave = OsIntLock();
+    if (!OsHrtimerDetachForDelete(&hrtimerCb->timer)) {
+        OsIntRestore(intSave);
+        return OS_ERRNO_HRTIMER_BUSY;
+    }
+
+    OsSplLock(&g_hrtimerFreeLock);
+    hrtimerCb->used = FALSE;
+    ListTailAdd(&hrtimerCb->timer.node, &g_hrtimerFreeList);
+    OsSplUnlock(&g_hrtimerFreeLock);
+    OsIntRestore(intSave);
+
+    return OS_OK;
+}
+
+/*
+ * 描述：启动高精度定时器
+ */
+OS_SEC_TEXT U32 PRT_HrtimerStart(HrtimerHandle handle, U64 expireNs, U32 mode)
+{
+    U32 ret;
+    struct TagHrtimerCb *hrtimerCb = NULL;
+
+    ret = OsHrtimerCbGet(handle, &hrtimerCb);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    if ((mode != OS_HRTIMER_REL) && (mode != OS_HRTIMER_ABS)) {
+        return OS_ERRNO_HRTIMER_MODE_INVALID;
+    }
+
+    OsHrtimerStart(&hrtimerCb->timer, OsHrtimerExpireGet(expireNs, mode));
+    return OS_OK;
+}
+
+/*
+ * 描述：停止高精度定时器
+ */
+OS_SEC_TEXT U32 PRT_HrtimerCancel(HrtimerHandle handle)
+{
+    U32 ret;
+    struct TagHrtimerCb *hrtimerCb = NULL;
+
+    ret = OsHrtimerCbGet(handle, &hrtimerCb);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    (void)OsHrtimerCancel(&hrtimerCb->timer);
+    return OS_OK;
+}
+
+/*
+ * 描述：获取当前时刻的ns数
+ */
+OS_SEC_TEXT U64 PRT_HrtimerGetNs(void)
+{
+    return OsHrtimerCycle2Ns(OsCurCycleGet64());
+}
+
+/*
+ * 描述：当前任务睡眠到指定时刻，由本核高精度定时器唤醒
+ * 备注：任务状态与PRT_TaskDelay相同，为OS_TSK_DELAY，但不挂在tick延时链表上
+ */
+OS_SEC_TEXT U32 PRT_HrtimerSleep(U64 expireNs, U32 mode)
+{
+    U64 expire;
+    uintptr_t intSave;
+    struct TagTskCb *runTask = NULL;
+
+    if (g_hrtimerSetEvent == NULL) {
+        return OS_ERRNO_HRTIMER_NOT_INIT;
+    }
+
+    if ((mode != OS_HRTIMER_REL) && (mode != OS_HRTIMER_ABS)) {
+        return OS_ERRNO_HRTIMER_MODE_INVALID;
+    }
+
+    expire = OsHrtimerExpireGet(expireNs, mode);
+
+    intSave = OsIntLock();
+    if (OS_INT_ACTIVE || (OS_TASK_LOCK_DATA != 0)) {
+        OsIntRestore(intSave);
+        return OS_ERRNO_HRTIMER_SLEEP_NOT_ALLOWED;
+    }
+
+    if (expire <= OsCurCycleGet64()) {
+        OsIntRestore(intSave);
+        return OS_OK;
+    }
+
+    runTask = RUNNING_TASK;
+    runTask->sleepTimer.func = OsHrtimerWakeTask;
+    runTask->sleepTimer.arg = (uintptr_t)runTask;
+
+    OsSpinLockTaskRq(runTask);
+    OsTskReadyDel(runTask);
+    TSK_STATUS_SET(runTask, OS_TSK_DELAY);
+    /* 不在tick延时链表上，删除任务时对timerList的摘除为空操作 */
+    OS_LIST_INIT(&runTask->timerList);
+    OsHrtimerStart(&runTask->sleepTimer, expire);
+    OsSpinUnlockTaskRq(runTask);
+
+    OsTskScheduleFastPs(intSave);
+
+    /* 定时器已在中断中到期，这里只清除FIRING状态 */
+    (void)OsHrtimerCancel(&runTask->sleepTimer);
+    OsIntRestore(intSave);
+
+    return OS_OK;
+}
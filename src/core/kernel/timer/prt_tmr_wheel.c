@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-07-08
+ * Description: 分层时间轮实现
+ */
+#include "prt_sys_external.h"
+#include "prt_tmr_wheel_external.h"
+
+/*
+ * 时间轮不变式：第0层节点的超时tick落在[curTick, curTick + 31]内；
+ * 第n层(n >= 1)节点所在的32^n tick块比curTick所在块晚1~31块，
+ * curTick走到块起点时把该块对应的槽级联到低层。
+ */
+
+/* 将from链表上的节点整体移到to链表尾部 */
+OS_SEC_ALW_INLINE INLINE void OsTmrWheelSplice(struct TagListObject *from, struct TagListObject *to)
+{
+    if (ListEmpty(from)) {
+        return;
+    }
+
+    from->next->prev = to->prev;
+    to->prev->next = from->next;
+    from->prev->next = to;
+    to->prev = from->prev;
+    OS_LIST_INIT(from);
+}
+
+/*
+ * 描述：初始化时间轮，keyOffset为超时tick字段相对链表节点的偏移，curTick为当前tick
+ */
+OS_SEC_L4_TEXT void OsTmrWheelInit(struct TagTmrWheel *wheel, uintptr_t keyOffset, U64 curTick)
+{
+    U32 level;
+    U32 idx;
+
+    wheel->curTick = curTick;
+    wheel->keyOffset = keyOffset;
+    for (level = 0; level < OS_TMR_WHEEL_LEVEL_NUM; level++) {
+        wheel->bitmap[level] = 0;
+        for (idx = 0; idx < OS_TMR_WHEEL_SLOT_NUM; idx++) {
+            OS_LIST_INIT(&wheel->slot[level][idx]);
+        }
+    }
+}
+
+/*
+ * 描述：按节点的超时tick插入时间轮，O(1)
+ * 备注：已超时的节点按curTick处理，超出时间轮范围的节点挂在最高层最远的槽上
+ */
+OS_SEC_TEXT void OsTmrWheelAdd(struct TagTmrWheel *wheel, struct TagListObject *node)
+{
+    U32 level;
+    U32 idx;
+    U64 block = 0;
+    U64 expire = OS_TMR_WHEEL_KEY(wheel, node);
+
+    if (expire < wheel->curTick) {
+        expire = wheel->curTick;
+    }
+
+    for (level = 0; level < OS_TMR_WHEEL_LEVEL_NUM; level++) {
+        block = expire >> OS_TMR_WHEEL_SHIFT(level);
+        if ((block - (wheel->curTick >> OS_TMR_WHEEL_SHIFT(level))) < OS_TMR_WHEEL_SLOT_NUM) {
+            break;
+        }
+    }
+
+    if (level == OS_TMR_WHEEL_LEVEL_NUM) {
+        level = OS_TMR_WHEEL_LEVEL_NUM - 1;
+        block = (wheel->curTick >> OS_TMR_WHEEL_SHIFT(level)) + OS_TMR_WHEEL_SLOT_MASK;
+    }
+
+    idx = (U32)block & OS_TMR_WHEEL_SLOT_MASK;
+    ListTailAdd(node, &wheel->slot[level][idx]);
+    wheel->bitmap[level] |= (1U << idx);
+}
+
+/*
+ * 描述：tick到达高层块起点时，把该块对应槽上的节点重新插入到低层
+ */
+OS_SEC_ALW_INLINE INLINE void OsTmrWheelCascade(struct TagTmrWheel *wheel, U64 tick)
+{
+    U32 level;
+    U32 idx;
+    struct TagListObject list;
+    struct TagListObject *node = NULL;
+
+    for (level = 1; level < OS_TMR_WHEEL_LEVEL_NUM; level++) {
+        if ((tick & ((1ULL << OS_TMR_WHEEL_SHIFT(level)) - 1)) != 0) {
+            break;
+        }
+
+        idx = (U32)(tick >> OS_TMR_WHEEL_SHIFT(level)) & OS_TMR_WHEEL_SLOT_MASK;
+        wheel->bitmap[level] &= ~(1U << idx);
+        OS_LIST_INIT(&list);
+        OsTmrWheelSplice(&wheel->slot[level][idx], &list);
+        while (!ListEmpty(&list)) {
+            node = OS_LIST_FIRST(&list);
+            ListDelete(node);
+            OsTmrWheelAdd(wheel, node);
+        }
+    }
+}
+
+/*
+ * 描述：获取时间轮上最近需要处理的tick，时间轮为空时返回OS_TICKLESS_FOREVER
+ * 备注：第0层为精确超时tick，高层为级联时间点，是超时tick的下界
+ */
+OS_SEC_TEXT U64 OsTmrWheelNearest(struct TagTmrWheel *wheel)
+{
+    U32 level;
+    U32 cur;
+    U32 bits;
+    U64 tick;
+    U64 nearest = OS_TICKLESS_FOREVER;
+
+    for (level = 0; level < OS_TMR_WHEEL_LEVEL_NUM; level++) {
+        bits = wheel->bitmap[level];
+        if (bits == 0) {
+            continue;
+        }
+
+        /* 从当前槽开始循环查找第一个非空槽 */
+        cur = (U32)(wheel->curTick >> OS_TMR_WHEEL_SHIFT(level)) & OS_TMR_WHEEL_SLOT_MASK;
+        bits = (bits >> cur) | (bits << ((OS_TMR_WHEEL_SLOT_NUM - cur) & OS_TMR_WHEEL_SLOT_MASK));
+        tick = ((wheel->curTick >> OS_TMR_WHEEL_SHIFT(level)) + OsGetRMB(bits)) << OS_TMR_WHEEL_SHIFT(level);
+        if (tick < nearest) {
+            nearest = tick;
+        }
+    }
+
+    return nearest;
+}
+
+/*
+ * 描述：时间轮推进到now，超时节点按超时先后移到expired链表尾部
+ * 备注：中间没有节点需要处理的tick直接跳过，tickless下长时间睡眠后也只处理非空槽
+ */
+OS_SEC_TEXT void OsTmrWheelAdvance(struct TagTmrWheel *wheel, U64 now, struct TagListObject *expired)
+{
+    U32 idx;
+    U64 next;
+
+    while (wheel->curTick <= now) {
+        next = OsTmrWheelNearest(wheel);
+        if (next > now) {
+            wheel->curTick = now + 1;
+            break;
+        }
+
+        if (next > wheel->curTick) {
+            wheel->curTick = next;
+        }
+
+        OsTmrWheelCascade(wheel, wheel->curTick);
+
+        idx = (U32)wheel->curTick & OS_TMR_WHEEL_SLOT_MASK;
+        wheel->bitmap[0] &= ~(1U << idx);
+        OsTmrWheelSplice(&wheel->slot[0][idx], expired);
+        wheel->curTick++;
+    }
+}
@@ -21,14 +21,7 @@
  */
 OS_SEC_TEXT void OsSwtmrNearestTicksRefresh(struct TagSwTmrSortLinkAttr *tmrSort)
 {
-    U64 ticks = OS_TICKLESS_FOREVER;
-    struct TagListObject *listObject = &tmrSort->sortLink;
-
-    if (!ListEmpty(listObject)) {
-        struct TagSwTmrCtrl *swtmr = (struct TagSwTmrCtrl *)(uintptr_t)listObject->next;
-        ticks = swtmr->expectedTick;
-    }
-    tmrSort->nearestTicks = ticks;
+    tmrSort->nearestTicks = OsTmrWheelNearest(&tmrSort->wheel);
 }
 #else
 OS_SEC_TEXT void OsSwtmrNearestTicksRefresh(struct TagSwTmrSortLinkAttr *tmrSort)
@@ -140,9 +133,13 @@ OS_SEC_TEXT void OsSwTmrAttrScan(struct TagSwTmrSortLinkAttr *tmrSort)
     intSave = OsIntLock();
     OsSplLock(&tmrSort->spinLock);
 
-    /* 从计时链表中获取超时链表 */
+    /* 时间轮推进到当前tick，到期定时器移到sortLink上形成超时链表 */
     listObject = &tmrSort->sortLink;
-    if (listObject->next == listObject) {  /* 没有计时定时器 */
+    OsTmrWheelAdvance(&tmrSort->wheel, g_uniTicks, listObject);
+    if (listObject->next == listObject) {  /* 没有超时定时器 */
+#if defined(OS_OPTION_TICKLESS)
+        OsSwtmrNearestTicksRefresh(tmrSort);
+#endif
         OsSplUnlock(&tmrSort->spinLock);
         OsIntRestore(intSave);
         return;
@@ -150,15 +147,8 @@ OS_SEC_TEXT void OsSwTmrAttrScan(struct TagSwTmrSortLinkAttr *tmrSort)
 
     outLink = (struct TagSwTmrCtrl*)(uintptr_t)listObject->next;
     object = listObject;
-    while (object->next !=listObject) {
+    while (object->next != listObject) {
         swtmr = (struct TagSwTmrCtrl*)(uintptr_t)object->next;
-        if(swtmr->expectedTick > g_uniTicks) {
-            if(swtmr->prev == (struct TagSwTmrCtrl*)(uintptr_t)listObject){
-                /* 如果第一个定时器rollNum > 0, 则表示没有超时链表为空*/
-                outLink = NULL;
-            }
-            break;
-        }
         swtmr->state = (U8)OS_TIMER_EXPIRED;
         object = object->next;
     }
@@ -237,15 +227,16 @@ OS_SEC_TEXT void OsSwTmrScan(void)
 }
 #endif
 #if defined(OS_OPTION_SMP)
-OS_SEC_ALW_INLINE INLINE struct TagListObject *OsSwTmrStartInner(struct TagSwTmrCtrl *swtmr, U32 interval)
+/*
+ * 描述：软件定时器的启动接口，按超时tick挂到所在核的时间轮上
+ */
+OS_SEC_TEXT void OsSwTmrStart(struct TagSwTmrCtrl *swtmr, U32 interval)
 {
-    struct TagSwTmrSortLinkAttr *tmrSort = NULL;
-    (void)interval;
+    struct TagSwTmrSortLinkAttr *tmrSort = CPU_SWTMR_SORT_LINK(swtmr->coreID);
 
-    tmrSort = CPU_SWTMR_SORT_LINK(swtmr->coreID);
+    swtmr->expectedTick = (U64)interval + g_uniTicks;
     swtmr->state = (U8)OS_TIMER_RUNNING;
-
-    return &tmrSort->sortLink;
+    OsTmrWheelAdd(&tmrSort->wheel, (struct TagListObject *)swtmr);
 }
 #else
 OS_SEC_ALW_INLINE INLINE struct TagListObject *OsSwTmrStartInner(struct TagSwTmrCtrl *swtmr, U32 interval)
@@ -267,7 +258,7 @@ OS_SEC_ALW_INLINE INLINE struct TagListObject *OsSwTmrStartInner(struct TagSwTmr
 
     return g_tmrSortLink.sortLink + sortIndex;
 }
-#endif
+
 /*
  * 描述：软件定时器的启动接口
  */
@@ -276,7 +267,7 @@ OS_SEC_TEXT void OsSwTmrStart(struct TagSwTmrCtrl *swtmr, U32 interval)
     struct TagSwTmrCtrl *temp = NULL;
     struct TagListObject *listObject = NULL;
 
-#if (defined(OS_OPTION_TICKLESS) || defined(OS_OPTION_SMP))
+#if defined(OS_OPTION_TICKLESS)
     /* 确认是否能直接进行64位操作 */
     swtmr->expectedTick = (U64) interval + g_uniTicks;
 #endif
@@ -297,17 +288,11 @@ OS_SEC_TEXT void OsSwTmrStart(struct TagSwTmrCtrl *swtmr, U32 interval)
         /* The First Node */
         temp = (struct TagSwTmrCtrl *)listObject->next;
         while (temp != (struct TagSwTmrCtrl *)listObject) {
-#if defined(OS_OPTION_SMP)
-            if(temp->expectedTick > swtmr->expectedTick) {
-                break;
-            }
-#else
             if (UWROLLNUM(temp->idxRollNum) > UWROLLNUM(swtmr->idxRollNum)) {
                 UWROLLNUMSUB(temp->idxRollNum, swtmr->idxRollNum);
                 break;
             }
             UWROLLNUMSUB(swtmr->idxRollNum, temp->idxRollNum);
-#endif
             temp = temp->next;
         }
         swtmr->next = temp;
@@ -316,3 +301,4 @@ OS_SEC_TEXT void OsSwTmrStart(struct TagSwTmrCtrl *swtmr, U32 interval)
         temp->prev = swtmr;
     }
 }
+#endif
@@ -372,6 +372,7 @@ OS_SEC_L4_TEXT U32 OsSwTmrResInit(void)
         tmrSort = CPU_SWTMR_SORT_LINK(idx);
         OS_LIST_INIT(&tmrSort->sortLink);
         tmrSort->nearestTicks = OS_TICKLESS_FOREVER;
+        OsTmrWheelInit(&tmrSort->wheel, OFFSET_OF_FIELD(struct TagSwTmrCtrl, expectedTick), g_uniTicks);
         OsSpinLockInitInner(&tmrSort->spinLock);
     }
 #else
@@ -132,8 +132,12 @@ OS_SEC_L2_TEXT void OsSwTmrStop(struct TagSwTmrCtrl *swtmr, bool reckonOff)
         swtmr->idxRollNum = OsSwTmrGetRemainTick(swtmr);
     }
 
+#if defined(OS_OPTION_SMP)
+    OsTmrWheelDel(&CPU_SWTMR_SORT_LINK(swtmr->coreID)->wheel, (struct TagListObject *)swtmr);
+#else
     swtmr->next->prev = swtmr->prev;
     swtmr->prev->next = swtmr->next;
+#endif
     /* 定时器被暂停，修改定时器状态 */
     swtmr->state = (U8)OS_TIMER_CREATED;
     swtmr->next = NULL;
@@ -1,5 +1,8 @@
 git clone https://github.com/brendangregg/FlameGraph.git
-# ip地址需修改为实际测试单板地址，默认192.168.0.11
-scp 192.168.0.11:/tmp/output.perf .
+# ip地址需修改为实际测试单板地址，默认192.168.0.11；ELF为构建生成的镜像文件，需与单板运行的镜像一致
+BOARD_IP=${BOARD_IP:-192.168.0.11}
+ELF=${ELF:-uniproton.elf}
+scp ${BOARD_IP}:/tmp/perf.data .
+perf script -i perf.data --vmlinux=${ELF} > output.perf
 ./FlameGraph/stackcollapse-perf.pl output.perf > output.folded
 ./FlameGraph/flamegraph.pl output.folded > output.svg
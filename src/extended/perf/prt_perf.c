@@ -305,7 +305,7 @@ static U32 OsPerfHdrInit(U32 id)
         .len        = sizeof(PerfDataHdr),
     };
 
-    return OsPerfOutPutWrite((char *)&head, head.len);
+    return OsPerfOutPutHdrWrite(&head);
 }
 
 void OsPerfUpdateEventCount(Event *event, U32 value)
@@ -503,6 +503,25 @@ void PRT_PerfFlushHookReg(const PERF_BUF_FLUSH_HOOK func)
     return;
 }
 
+U32 PRT_PerfDrainStart(const PERF_BUF_DRAIN_HOOK func, U32 interval)
+{
+    if (func == NULL) {
+        return OS_ERRNO_PERF_DRAIN_HOOK_NULL;
+    }
+
+    if (g_perfCb.status == PERF_UNINIT) {
+        return OS_ERRNO_PERF_STATUS_INVALID;
+    }
+
+    return OsPerfDrainStart(func, interval);
+}
+
+void PRT_PerfDrainStop(void)
+{
+    OsPerfDrainStop();
+    return;
+}
+
 void OsPerfSetIrqRegs(uintptr_t pc, uintptr_t fp)
 {
     struct TagTskCb *runTask = RUNNING_TASK;
@@ -29,6 +29,7 @@
 #define PERF_PC_MAX_NUM 1000
 #define PERF_BUFF_LEN 0x10000
 #define PERF_TASK_STACKSIZE 0x30000
+#define PERF_EXPORT_FILE "/tmp/perf.data"
 
 struct TagSamplePcCb {
     struct TagListObject pcList;
@@ -114,32 +115,25 @@ static void OsAddPcToList(const char *pc)
     return;
 }
 
-static void OsOutputCallChain(const char *callChain, FILE *fp)
+/* 导出为perf.data，拷贝到linux后可用perf report --vmlinux=<镜像ELF> -i perf.data解析 */
+static void OsExportBuff(const char *buf, U32 len)
 {
-    U32 i;
-    uintptr_t depth = 0;
-    char *curPoint = callChain;
-
-    memcpy_s(&depth, sizeof(uintptr_t), curPoint, sizeof(uintptr_t));
-    curPoint += sizeof(uintptr_t);
-    static U32 x = 0;
-    x++;
-    PRT_Printf("UniProton    888  %u:     250000 task-clock:ppp:\n", x);
-    if (fp != NULL) {
-        fprintf(fp, "UniProton    888  %u:     250000 task-clock:ppp:\n", x);
-    }
-
-    for (i = 0; i < depth; i++) {
-        PRT_Printf("1 0x%llx (1)\n", *(uintptr_t*)curPoint);
-        if (fp != NULL) {
-            fprintf(fp, "1 0x%llx (1)\n", *(uintptr_t*)curPoint);
-        }
-        curPoint += sizeof(uintptr_t);
+    U32 ret;
+
+    ret = PRT_PerfExportOpen(PERF_EXPORT_FILE);
+    if (ret != OS_OK) {
+        PRT_Printf("perf export open failed, ret = 0x%x\n", ret);
+        return;
     }
 
-    PRT_Printf("\n");
-    if (fp != NULL) {
-        fprintf(fp, "\n");
+    ret = PRT_PerfExportWrite(buf, len);
+    if (ret != OS_OK) {
+        PRT_Printf("perf export write failed, ret = 0x%x\n", ret);
+    }
+
+    ret = PRT_PerfExportClose();
+    if (ret != OS_OK) {
+        PRT_Printf("perf export close failed, ret = 0x%x\n", ret);
     }
 
     return;
@@ -151,10 +145,6 @@ static void OsBufferParser(const char *buf, U32 len)
     struct TagSamplePcCb *pcNode = NULL;
     U32 headLen = sizeof(PerfDataHdr);
     U32 sampleDataLen = sizeof(PerfSampleData);
-    FILE *fp = fopen("/tmp/output.perf", "w");
-    if (fp == NULL) {
-        PRT_Printf("fopen output.perf failed\n");
-    }
 
     curPoint += headLen;
     len -= headLen;
@@ -163,11 +153,6 @@ static void OsBufferParser(const char *buf, U32 len)
         curPoint += sampleDataLen;
         len -= sampleDataLen;
         OsAddPcToList(curPoint - sizeof(PerfBackTrace) - sizeof(uintptr_t));
-        OsOutputCallChain(curPoint - sizeof(PerfBackTrace), fp);
-    }
-
-    if (fp != NULL) {
-        fclose(fp);
     }
 
     return;
@@ -184,6 +169,7 @@ void OsPrintBuff(const char *buf, U32 len)
 
     OS_LIST_INIT(&g_perfList);
     OsBufferParser(buf, len);
+    OsExportBuff(buf, len);
 
     PRT_Printf("len=%u\n", len);
 
@@ -0,0 +1,710 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-08-12
+ * Description: 将采样数据导出为Linux perf工具可直接解析的perf.data文件
+ */
+
+#include <stdio.h>
+#include "prt_perf.h"
+#include "prt_mem.h"
+#include "prt_sys_external.h"
+#include "securec.h"
+#include "include/prt_perf_comm.h"
+#if defined(OS_OPTION_DYNAMIC_MODULE)
+#include "prt_dynamic_module.h"
+#endif
+
+/*
+ * 文件布局：文件头 | 数据段 | 特性段索引 | 特性段 | 事件id | 事件属性。
+ * 数据段之后的部分在PRT_PerfExportClose时写入，perf要求特性段索引紧跟在数据段之后。
+ * OS镜像按内核空间导出，映射名使用"[kernel.kallsyms]__text_start"，perf report通过--vmlinux指定镜像ELF解析符号；
+ * 动态模块按用户态共享库导出，perf按映射中的模块路径(可配合--symfs)查找模块ELF。
+ * 所有任务作为同一进程PERF_EXPORT_PID的线程导出，线程号即任务ID，线程名为任务名。
+ */
+#define PERF_FILE_MAGIC              0x32454C4946524550ULL /* "PERFILE2" */
+#define PERF_FILE_ATTR_SIZE          112                   /* PERF_ATTR_SIZE_VER5 */
+#define PERF_FILE_NAME_ALIGN         64
+#define PERF_FILE_FEAT_ARCH          6
+#define PERF_FILE_FEAT_NRCPUS        7
+#define PERF_FILE_FEAT_NUM           2
+
+#define PERF_EXPORT_PID              0x10000
+#define PERF_EXPORT_COMM             "UniProton"
+#define PERF_EXPORT_ARCH             "aarch64"             /* 当前perf只支持ARMv8 */
+#define PERF_EXPORT_KERNEL_MMAP      "[kernel.kallsyms]"
+#define PERF_EXPORT_KERNEL_REF_SYM   "__text_start"
+#define PERF_EXPORT_ATTR_MAX         16
+#define PERF_EXPORT_CHAIN_MAX        (2 * (PERF_MAX_CALLCHAIN_DEPTH + 1))
+#define PERF_EXPORT_MMAP_NAME_LEN    64
+
+/* Linux perf记录类型及字段定义，与include/uapi/linux/perf_event.h一致 */
+#define PERF_REC_MMAP                1
+#define PERF_REC_COMM                3
+#define PERF_REC_SAMPLE              9
+#define PERF_REC_MISC_KERNEL         1
+#define PERF_REC_MISC_USER           2
+
+#define PERF_SAMPLE_IP               (1ULL << 0)
+#define PERF_SAMPLE_TID              (1ULL << 1)
+#define PERF_SAMPLE_TIME             (1ULL << 2)
+#define PERF_SAMPLE_CALLCHAIN        (1ULL << 5)
+#define PERF_SAMPLE_CPU              (1ULL << 7)
+#define PERF_SAMPLE_PERIOD           (1ULL << 8)
+#define PERF_SAMPLE_IDENTIFIER       (1ULL << 16)
+#define PERF_EXPORT_SAMPLE_TYPE      (PERF_SAMPLE_IDENTIFIER | PERF_SAMPLE_IP | PERF_SAMPLE_TID | PERF_SAMPLE_TIME | \
+                                      PERF_SAMPLE_CPU | PERF_SAMPLE_PERIOD | PERF_SAMPLE_CALLCHAIN)
+
+#define PERF_CONTEXT_KERNEL          ((U64)-128)
+#define PERF_CONTEXT_USER            ((U64)-512)
+
+#define PERF_ATTR_TYPE_HARDWARE      0
+#define PERF_ATTR_TYPE_SOFTWARE      1
+#define PERF_ATTR_TYPE_HW_CACHE      3
+#define PERF_ATTR_TYPE_RAW           4
+#define PERF_ATTR_FLAG_MMAP          (1ULL << 8)
+#define PERF_ATTR_FLAG_COMM          (1ULL << 9)
+
+#define PERF_HW_CACHE_REFERENCES     2
+#define PERF_HW_CACHE_MISSES         3
+#define PERF_HW_BRANCH_INSTRUCTIONS  4
+#define PERF_HW_BRANCH_MISSES        5
+#define PERF_HW_CACHE_L1I_ACCESS     0x00001
+#define PERF_HW_CACHE_L1I_MISS       0x10001
+#define PERF_SW_CPU_CLOCK            0
+#define PERF_SW_CONTEXT_SWITCHES     3
+
+typedef struct {
+    U64 offset;
+    U64 size;
+} PerfFileSection;
+
+typedef struct {
+    U64 magic;
+    U64 size;
+    U64 attrSize;
+    PerfFileSection attrs;
+    PerfFileSection data;
+    PerfFileSection eventTypes;
+    U64 features[4];
+} PerfFileHeader;
+
+typedef struct {
+    U32 type;
+    U32 size;
+    U64 config;
+    U64 samplePeriod;
+    U64 sampleType;
+    U64 readFormat;
+    U64 flags;
+    U32 wakeupEvents;
+    U32 bpType;
+    U64 config1;
+    U64 config2;
+    U64 branchSampleType;
+    U64 sampleRegsUser;
+    U32 sampleStackUser;
+    S32 clockId;
+    U64 sampleRegsIntr;
+    U32 auxWatermark;
+    U16 sampleMaxStack;
+    U16 reserved;
+} PerfFileEventAttr;
+
+typedef struct {
+    PerfFileEventAttr attr;
+    PerfFileSection ids;
+} PerfFileAttr;
+
+typedef struct {
+    U32 type;
+    U16 misc;
+    U16 size;
+} PerfFileEventHdr;
+
+typedef struct {
+    PerfFileEventHdr hdr;
+    U32 pid;
+    U32 tid;
+    U64 start;
+    U64 len;
+    U64 pgoff;
+    char filename[PERF_EXPORT_MMAP_NAME_LEN];
+} PerfFileMmapEvent;
+
+typedef struct {
+    PerfFileEventHdr hdr;
+    U32 pid;
+    U32 tid;
+    char comm[OS_TSK_NAME_LEN + sizeof(U64)];
+} PerfFileCommEvent;
+
+typedef struct {
+    PerfFileEventHdr hdr;
+    U64 id;
+    U64 ip;
+    U32 pid;
+    U32 tid;
+    U64 time;
+    U32 cpu;
+    U32 res;
+    U64 period;
+    U64 nr;
+    U64 ips[PERF_EXPORT_CHAIN_MAX];
+} PerfFileSampleEvent;
+
+typedef struct {
+    PerfEventType type;
+    U32 eventId;
+    U32 period;
+} PerfExportAttr;
+
+typedef struct {
+    FILE *fp;
+    U64 dataSize;
+    PerfEventType eventType;
+    PerfSampleType sampleType;
+    U32 sampleLen;
+    U32 attrNr;
+    PerfExportAttr attrs[PERF_EXPORT_ATTR_MAX];
+    U32 commNum;
+    U8 *commDone;
+#if defined(OS_OPTION_DYNAMIC_MODULE)
+    U32 mapNr;
+    struct DynModuleMapInfo maps[OS_MAX_MODULE_NUM];
+#endif
+} PerfExportCB;
+
+/* 链接脚本未定义时弱符号地址为0，此时把整个地址空间都当作镜像 */
+extern char __text_start __attribute__((weak));
+extern char __text_end __attribute__((weak));
+
+OS_SEC_BSS static PerfExportCB g_perfExportCb;
+
+static U32 OsPerfExportWrite(const void *data, U32 len)
+{
+    if (fwrite(data, 1, len, g_perfExportCb.fp) != len) {
+        return OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+    }
+    return OS_OK;
+}
+
+static U32 OsPerfExportEvent(const PerfFileEventHdr *hdr)
+{
+    U32 ret = OsPerfExportWrite(hdr, hdr->size);
+    if (ret == OS_OK) {
+        g_perfExportCb.dataSize += hdr->size;
+    }
+    return ret;
+}
+
+static U32 OsPerfExportMmap(U16 misc, U32 pid, uintptr_t start, uintptr_t end, uintptr_t pgoff, const char *name)
+{
+    U32 len;
+    PerfFileMmapEvent event = {0};
+
+    event.hdr.type = PERF_REC_MMAP;
+    event.hdr.misc = misc;
+    event.pid = pid;
+    event.tid = pid;
+    event.start = start;
+    event.len = end - start;
+    event.pgoff = pgoff;
+    (void)strncpy_s(event.filename, sizeof(event.filename), name, sizeof(event.filename) - 1);
+
+    len = (U32)strlen(event.filename) + 1;
+    event.hdr.size = (U16)(offsetof(PerfFileMmapEvent, filename) + ALIGN(len, sizeof(U64)));
+    return OsPerfExportEvent(&event.hdr);
+}
+
+static U32 OsPerfExportComm(U32 tid, const char *name)
+{
+    U32 len;
+    PerfFileCommEvent event = {0};
+
+    event.hdr.type = PERF_REC_COMM;
+    event.pid = PERF_EXPORT_PID;
+    event.tid = tid;
+    (void)strncpy_s(event.comm, sizeof(event.comm), name, OS_TSK_NAME_LEN - 1);
+
+    len = (U32)strlen(event.comm) + 1;
+    event.hdr.size = (U16)(offsetof(PerfFileCommEvent, comm) + ALIGN(len, sizeof(U64)));
+    return OsPerfExportEvent(&event.hdr);
+}
+
+/* 任务第一次出现在采样中时导出任务名，采样期间已删除的任务用任务ID命名 */
+static U32 OsPerfExportTask(U32 tid)
+{
+    U32 idx = TSK_GET_INDEX(tid);
+    struct TskInfo info;
+    char name[OS_TSK_NAME_LEN];
+
+    if ((idx < g_perfExportCb.commNum) && (g_perfExportCb.commDone[idx] != 0)) {
+        return OS_OK;
+    }
+
+    if (PRT_TaskGetInfo(tid, &info) == OS_OK) {
+        (void)strncpy_s(name, sizeof(name), info.name, sizeof(name) - 1);
+    } else {
+        (void)snprintf_s(name, sizeof(name), sizeof(name) - 1, "task-%u", tid);
+    }
+
+    if (idx < g_perfExportCb.commNum) {
+        g_perfExportCb.commDone[idx] = 1;
+    }
+    return OsPerfExportComm(tid, name);
+}
+
+static U32 OsPerfExportKernelMap(void)
+{
+    uintptr_t start = (uintptr_t)&__text_start;
+    uintptr_t end = (uintptr_t)&__text_end;
+
+    if ((start == 0) || (end <= start)) {
+        return OsPerfExportMmap(PERF_REC_MISC_KERNEL, (U32)-1, 0, (uintptr_t)-1, 0, PERF_EXPORT_KERNEL_MMAP);
+    }
+    return OsPerfExportMmap(PERF_REC_MISC_KERNEL, (U32)-1, start, end, start,
+                            PERF_EXPORT_KERNEL_MMAP PERF_EXPORT_KERNEL_REF_SYM);
+}
+
+#if defined(OS_OPTION_DYNAMIC_MODULE)
+/* 模块可能在采样期间加载，每次导出前同步一次，新出现的模块补充映射记录 */
+static U32 OsPerfExportSyncMaps(void)
+{
+    U32 i;
+    U32 j;
+    U32 ret;
+    U32 num;
+    struct DynModuleMapInfo maps[OS_MAX_MODULE_NUM];
+    PerfExportCB *cb = &g_perfExportCb;
+
+    num = OsDynModuleGetMaps(maps, OS_MAX_MODULE_NUM);
+    for (i = 0; i < num; i++) {
+        for (j = 0; j < cb->mapNr; j++) {
+            if ((cb->maps[j].start == maps[i].start) && (strcmp(cb->maps[j].name, maps[i].name) == 0)) {
+                break;
+            }
+        }
+        if (j < cb->mapNr) {
+            continue;
+        }
+
+        ret = OsPerfExportMmap(PERF_REC_MISC_USER, PERF_EXPORT_PID, maps[i].start, maps[i].end, maps[i].vaddr,
+                               maps[i].name);
+        if (ret != OS_OK) {
+            return ret;
+        }
+    }
+
+    cb->mapNr = num;
+    (void)memcpy_s(cb->maps, sizeof(cb->maps), maps, num * sizeof(struct DynModuleMapInfo));
+    return OS_OK;
+}
+
+static bool OsPerfExportInModule(uintptr_t addr)
+{
+    U32 i;
+
+    for (i = 0; i < g_perfExportCb.mapNr; i++) {
+        if ((addr >= g_perfExportCb.maps[i].start) && (addr < g_perfExportCb.maps[i].end)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+#else
+static U32 OsPerfExportSyncMaps(void)
+{
+    return OS_OK;
+}
+
+static bool OsPerfExportInModule(uintptr_t addr)
+{
+    (void)addr;
+    return FALSE;
+}
+#endif
+
+/* 同一个(事件类型, 事件ID)对应perf.data中的一个事件，样本id为事件下标加1 */
+static U32 OsPerfExportAttrId(U32 eventId, U32 period)
+{
+    U32 i;
+    PerfExportCB *cb = &g_perfExportCb;
+
+    for (i = 0; i < cb->attrNr; i++) {
+        if ((cb->attrs[i].type == cb->eventType) && (cb->attrs[i].eventId == eventId)) {
+            return i + 1;
+        }
+    }
+
+    if (cb->attrNr == PERF_EXPORT_ATTR_MAX) {
+        return cb->attrNr;
+    }
+
+    cb->attrs[cb->attrNr].type = cb->eventType;
+    cb->attrs[cb->attrNr].eventId = eventId;
+    cb->attrs[cb->attrNr].period = period;
+    cb->attrNr++;
+    return cb->attrNr;
+}
+
+static void OsPerfExportAttrConfig(const PerfExportAttr *attr, PerfFileEventAttr *fileAttr)
+{
+    static const U32 hwType[PERF_COUNT_HW_MAX] = {
+        PERF_ATTR_TYPE_HARDWARE, PERF_ATTR_TYPE_HARDWARE, PERF_ATTR_TYPE_HARDWARE, PERF_ATTR_TYPE_HARDWARE,
+        PERF_ATTR_TYPE_HW_CACHE, PERF_ATTR_TYPE_HW_CACHE, PERF_ATTR_TYPE_HARDWARE, PERF_ATTR_TYPE_HARDWARE,
+    };
+    static const U64 hwConfig[PERF_COUNT_HW_MAX] = {
+        0, 1, PERF_HW_CACHE_REFERENCES, PERF_HW_CACHE_MISSES,
+        PERF_HW_CACHE_L1I_ACCESS, PERF_HW_CACHE_L1I_MISS, PERF_HW_BRANCH_INSTRUCTIONS, PERF_HW_BRANCH_MISSES,
+    };
+
+    fileAttr->type = PERF_ATTR_TYPE_RAW;
+    fileAttr->config = attr->eventId;
+
+    if ((attr->type == PERF_EVENT_TYPE_HW) && (attr->eventId < PERF_COUNT_HW_MAX)) {
+        fileAttr->type = hwType[attr->eventId];
+        fileAttr->config = hwConfig[attr->eventId];
+    } else if (attr->type == PERF_EVENT_TYPE_TIMED) {
+        fileAttr->type = PERF_ATTR_TYPE_SOFTWARE;
+        fileAttr->config = PERF_SW_CPU_CLOCK;
+    } else if ((attr->type == PERF_EVENT_TYPE_SW) && (attr->eventId == PERF_COUNT_SW_TASK_SWITCH)) {
+        fileAttr->type = PERF_ATTR_TYPE_SOFTWARE;
+        fileAttr->config = PERF_SW_CONTEXT_SWITCHES;
+    }
+}
+
+OS_SEC_ALW_INLINE INLINE U64 OsPerfExportContext(uintptr_t addr)
+{
+    return OsPerfExportInModule(addr) ? PERF_CONTEXT_USER : PERF_CONTEXT_KERNEL;
+}
+
+static void OsPerfExportChainAdd(PerfFileSampleEvent *event, U64 *context, uintptr_t addr)
+{
+    U64 cur = OsPerfExportContext(addr);
+
+    if (event->nr + 2 > PERF_EXPORT_CHAIN_MAX) {
+        return;
+    }
+
+    if (cur != *context) {
+        event->ips[event->nr++] = cur;
+        *context = cur;
+    }
+    event->ips[event->nr++] = addr;
+}
+
+OS_SEC_ALW_INLINE INLINE U64 OsPerfExportCycle2Ns(U64 cycle)
+{
+    U64 clock = OsSysGetClock();
+
+    if (clock == 0) {
+        return cycle;
+    }
+    return (cycle / clock) * OS_SYS_NS_PER_SECOND + (cycle % clock) * OS_SYS_NS_PER_SECOND / clock;
+}
+
+/* 采样记录按sampleType紧凑排列，字段不保证自然对齐，逐个拷贝 */
+static U32 OsPerfExportSample(const char *data)
+{
+    U32 i;
+    U32 ret;
+    U32 tid = PERF_EXPORT_PID;
+    U32 eventId = 0;
+    U32 period = 1;
+    U32 depth = 0;
+    U64 context = 0;
+    const char *p = data;
+    PerfSampleData sample = {0};
+    PerfFileSampleEvent event = {0};
+    PerfSampleType type = g_perfExportCb.sampleType;
+
+    if (type & PERF_RECORD_CPU) {
+        (void)memcpy_s(&sample.cpuid, sizeof(sample.cpuid), p, sizeof(sample.cpuid));
+        p += sizeof(sample.cpuid);
+    }
+    if (type & PERF_RECORD_TID) {
+        (void)memcpy_s(&tid, sizeof(tid), p, sizeof(tid));
+        p += sizeof(sample.taskId);
+    }
+    if (type & PERF_RECORD_TYPE) {
+        (void)memcpy_s(&eventId, sizeof(eventId), p, sizeof(eventId));
+        p += sizeof(sample.eventId);
+    }
+    if (type & PERF_RECORD_PERIOD) {
+        (void)memcpy_s(&period, sizeof(period), p, sizeof(period));
+        p += sizeof(sample.period);
+    }
+    if (type & PERF_RECORD_TIMESTAMP) {
+        (void)memcpy_s(&sample.time, sizeof(sample.time), p, sizeof(sample.time));
+        p += sizeof(sample.time);
+    }
+    if (type & PERF_RECORD_IP) {
+        (void)memcpy_s(&sample.pc, sizeof(sample.pc), p, sizeof(sample.pc));
+        p += sizeof(sample.pc);
+    }
+    if (type & PERF_RECORD_CALLCHAIN) {
+        /* 采集时深度只写入ipNr的低32位 */
+        (void)memcpy_s(&depth, sizeof(depth), p, sizeof(depth));
+        (void)memcpy_s(sample.callChain.ip, sizeof(sample.callChain.ip), p + sizeof(sample.callChain.ipNr),
+                       sizeof(sample.callChain.ip));
+        depth = (depth > PERF_MAX_CALLCHAIN_DEPTH) ? PERF_MAX_CALLCHAIN_DEPTH : depth;
+    }
+
+    if (((type & PERF_RECORD_IP) == 0) && (depth != 0)) {
+        sample.pc = sample.callChain.ip[0];
+    }
+
+    if (tid != PERF_EXPORT_PID) {
+        ret = OsPerfExportTask(tid);
+        if (ret != OS_OK) {
+            return ret;
+        }
+    }
+
+    event.hdr.type = PERF_REC_SAMPLE;
+    event.hdr.misc = OsPerfExportInModule(sample.pc) ? PERF_REC_MISC_USER : PERF_REC_MISC_KERNEL;
+    event.id = OsPerfExportAttrId(eventId, period);
+    event.ip = sample.pc;
+    event.pid = PERF_EXPORT_PID;
+    event.tid = tid;
+    event.time = OsPerfExportCycle2Ns(sample.time);
+    event.cpu = sample.cpuid;
+    event.period = period;
+
+    /* perf要求调用链以采样地址开始，回溯结果的第一层与采样地址相同时跳过 */
+    OsPerfExportChainAdd(&event, &context, sample.pc);
+    for (i = 0; i < depth; i++) {
+        if ((i == 0) && (sample.callChain.ip[0] == sample.pc)) {
+            continue;
+        }
+        OsPerfExportChainAdd(&event, &context, sample.callChain.ip[i]);
+    }
+
+    event.hdr.size = (U16)(offsetof(PerfFileSampleEvent, ips) + event.nr * sizeof(U64));
+    return OsPerfExportEvent(&event.hdr);
+}
+
+static U32 OsPerfExportSampleLen(PerfSampleType type)
+{
+    U32 len = 0;
+
+    len += (type & PERF_RECORD_CPU) ? sizeof(U32) : 0;
+    len += (type & PERF_RECORD_TID) ? sizeof(U32) : 0;
+    len += (type & PERF_RECORD_TYPE) ? sizeof(U32) : 0;
+    len += (type & PERF_RECORD_PERIOD) ? sizeof(U32) : 0;
+    len += (type & PERF_RECORD_TIMESTAMP) ? sizeof(U64) : 0;
+    len += (type & PERF_RECORD_IP) ? sizeof(uintptr_t) : 0;
+    len += (type & PERF_RECORD_CALLCHAIN) ? sizeof(PerfBackTrace) : 0;
+    return len;
+}
+
+/* 特性段：CPU架构和核数，perf annotate按架构选择反汇编器 */
+static U32 OsPerfExportFeatures(U64 *features)
+{
+    U32 ret;
+    U64 offset;
+    U32 nrCpus[2] = {PRT_KERNEL_CORE_NUM, PRT_KERNEL_CORE_NUM};
+    char arch[PERF_FILE_NAME_ALIGN] = PERF_EXPORT_ARCH;
+    U32 archLen = sizeof(arch);
+    PerfFileSection sections[PERF_FILE_FEAT_NUM];
+
+    offset = sizeof(PerfFileHeader) + g_perfExportCb.dataSize + sizeof(sections);
+    sections[0].offset = offset;
+    sections[0].size = sizeof(archLen) + sizeof(arch);
+    sections[1].offset = offset + sections[0].size;
+    sections[1].size = sizeof(nrCpus);
+
+    ret = OsPerfExportWrite(sections, sizeof(sections));
+    ret |= OsPerfExportWrite(&archLen, sizeof(archLen));
+    ret |= OsPerfExportWrite(arch, sizeof(arch));
+    ret |= OsPerfExportWrite(nrCpus, sizeof(nrCpus));
+    if (ret != OS_OK) {
+        return OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+    }
+
+    features[0] = (1ULL << PERF_FILE_FEAT_ARCH) | (1ULL << PERF_FILE_FEAT_NRCPUS);
+    return OS_OK;
+}
+
+static U32 OsPerfExportAttrs(PerfFileHeader *hdr)
+{
+    U32 i;
+    U64 id;
+    U64 idOffset = (U64)ftell(g_perfExportCb.fp);
+    PerfFileAttr fileAttr;
+    PerfExportCB *cb = &g_perfExportCb;
+
+    for (i = 0; i < cb->attrNr; i++) {
+        id = i + 1;
+        if (OsPerfExportWrite(&id, sizeof(id)) != OS_OK) {
+            return OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+        }
+    }
+
+    hdr->attrs.offset = idOffset + cb->attrNr * sizeof(U64);
+    hdr->attrs.size = cb->attrNr * sizeof(PerfFileAttr);
+    for (i = 0; i < cb->attrNr; i++) {
+        (void)memset_s(&fileAttr, sizeof(fileAttr), 0, sizeof(fileAttr));
+        OsPerfExportAttrConfig(&cb->attrs[i], &fileAttr.attr);
+        fileAttr.attr.size = PERF_FILE_ATTR_SIZE;
+        fileAttr.attr.samplePeriod = cb->attrs[i].period;
+        fileAttr.attr.sampleType = PERF_EXPORT_SAMPLE_TYPE;
+        fileAttr.attr.flags = PERF_ATTR_FLAG_MMAP | PERF_ATTR_FLAG_COMM;
+        fileAttr.attr.sampleMaxStack = PERF_MAX_CALLCHAIN_DEPTH;
+        fileAttr.ids.offset = idOffset + i * sizeof(U64);
+        fileAttr.ids.size = sizeof(U64);
+        if (OsPerfExportWrite(&fileAttr, sizeof(fileAttr)) != OS_OK) {
+            return OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+        }
+    }
+
+    return OS_OK;
+}
+
+static void OsPerfExportRelease(void)
+{
+    PerfExportCB *cb = &g_perfExportCb;
+
+    if (cb->fp != NULL) {
+        (void)fclose(cb->fp);
+    }
+    if (cb->commDone != NULL) {
+        (void)PRT_MemFree((U32)OS_MID_PERF, cb->commDone);
+    }
+    (void)memset_s(cb, sizeof(PerfExportCB), 0, sizeof(PerfExportCB));
+}
+
+U32 PRT_PerfExportOpen(const char *path)
+{
+    U32 ret;
+    PerfFileHeader hdr = {0};
+    PerfExportCB *cb = &g_perfExportCb;
+
+    if (path == NULL) {
+        return OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+    }
+
+    if (cb->fp != NULL) {
+        return OS_ERRNO_PERF_STATUS_INVALID;
+    }
+
+    cb->commNum = OS_MAX_TCB_NUM;
+    cb->commDone = (U8 *)PRT_MemAlloc((U32)OS_MID_PERF, OS_MEM_DEFAULT_FSC_PT, cb->commNum);
+    if (cb->commDone == NULL) {
+        cb->commNum = 0;
+        return OS_ERRNO_PERF_BUF_ERROR;
+    }
+    (void)memset_s(cb->commDone, cb->commNum, 0, cb->commNum);
+
+    cb->fp = fopen(path, "wb");
+    if (cb->fp == NULL) {
+        OsPerfExportRelease();
+        return OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+    }
+
+    /* 文件头在关闭时回填 */
+    ret = OsPerfExportWrite(&hdr, sizeof(hdr));
+    if (ret == OS_OK) {
+        ret = OsPerfExportComm(PERF_EXPORT_PID, PERF_EXPORT_COMM);
+    }
+    if (ret == OS_OK) {
+        ret = OsPerfExportKernelMap();
+    }
+    if (ret == OS_OK) {
+        ret = OsPerfExportSyncMaps();
+    }
+    if (ret != OS_OK) {
+        OsPerfExportRelease();
+    }
+    return ret;
+}
+
+U32 PRT_PerfExportWrite(const char *data, U32 len)
+{
+    U32 ret;
+    const PerfDataHdr *hdr = (const PerfDataHdr *)data;
+    PerfExportCB *cb = &g_perfExportCb;
+
+    if (cb->fp == NULL) {
+        return OS_ERRNO_PERF_STATUS_INVALID;
+    }
+
+    if ((data == NULL) || (len == 0)) {
+        return OS_OK;
+    }
+
+    /* PRT_PerfDataRead和导出任务读出的数据只会在开头带段头 */
+    if ((len >= sizeof(PerfDataHdr)) && (hdr->magic == PERF_DATA_MAGIC_WORD)) {
+        if ((hdr->len < sizeof(PerfDataHdr)) || (hdr->len > len)) {
+            return OS_ERRNO_PERF_EXPORT_DATA_INVALID;
+        }
+        cb->eventType = hdr->eventType;
+        cb->sampleType = hdr->sampleType;
+        cb->sampleLen = OsPerfExportSampleLen(hdr->sampleType);
+        data += hdr->len;
+        len -= hdr->len;
+    }
+
+    if (cb->sampleLen == 0) {
+        return OS_ERRNO_PERF_EXPORT_DATA_INVALID;
+    }
+
+    ret = OsPerfExportSyncMaps();
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    while (len >= cb->sampleLen) {
+        ret = OsPerfExportSample(data);
+        if (ret != OS_OK) {
+            return ret;
+        }
+        data += cb->sampleLen;
+        len -= cb->sampleLen;
+    }
+
+    return (len == 0) ? OS_OK : OS_ERRNO_PERF_EXPORT_DATA_INVALID;
+}
+
+U32 PRT_PerfExportClose(void)
+{
+    U32 ret;
+    PerfFileHeader hdr = {0};
+    PerfExportCB *cb = &g_perfExportCb;
+
+    if (cb->fp == NULL) {
+        return OS_ERRNO_PERF_STATUS_INVALID;
+    }
+
+    hdr.magic = PERF_FILE_MAGIC;
+    hdr.size = sizeof(PerfFileHeader);
+    hdr.attrSize = sizeof(PerfFileAttr);
+    hdr.data.offset = sizeof(PerfFileHeader);
+    hdr.data.size = cb->dataSize;
+
+    ret = OsPerfExportFeatures(hdr.features);
+    if (ret == OS_OK) {
+        ret = OsPerfExportAttrs(&hdr);
+    }
+    if ((ret == OS_OK) && (fseek(cb->fp, 0, SEEK_SET) != 0)) {
+        ret = OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+    }
+    if (ret == OS_OK) {
+        ret = OsPerfExportWrite(&hdr, sizeof(hdr));
+    }
+    if ((fflush(cb->fp) != 0) && (ret == OS_OK)) {
+        ret = OS_ERRNO_PERF_EXPORT_FILE_ERROR;
+    }
+
+    OsPerfExportRelease();
+    return ret;
+}
@@ -18,14 +18,52 @@ OS_SEC_BSS static PERF_BUF_NOTIFY_HOOK g_perfBufNotifyHook;
 OS_SEC_BSS static PERF_BUF_FLUSH_HOOK g_perfBufFlushHook;
 OS_SEC_BSS static PerfOutputCB g_perfOutputCb;
 
-static void OsPerfDefaultNotify(void)
+OS_SEC_ALW_INLINE INLINE U32 OsPerfCoreBufUsed(PerfCoreBuf *coreBuf, U32 head, U32 tail)
 {
-    printf("perf buf waterline notify!\n");
+    return (tail >= head) ? (tail - head) : (coreBuf->size - head + tail);
 }
 
+/* 从idx开始拷入len字节，环绕时分两段拷贝，返回新的写位置 */
+static U32 OsPerfCoreBufCopyIn(PerfCoreBuf *coreBuf, U32 idx, const char *src, U32 len)
+{
+    U32 first = coreBuf->size - idx;
+
+    if (first > len) {
+        first = len;
+    }
+
+    (void)memcpy_s(coreBuf->fifo + idx, first, src, first);
+    if (len > first) {
+        (void)memcpy_s(coreBuf->fifo, len - first, src + first, len - first);
+    }
+
+    idx += len;
+    return (idx >= coreBuf->size) ? (idx - coreBuf->size) : idx;
+}
+
+/* 从idx开始拷出len字节，环绕时分两段拷贝，返回新的读位置 */
+static U32 OsPerfCoreBufCopyOut(PerfCoreBuf *coreBuf, U32 idx, char *dest, U32 len)
+{
+    U32 first = coreBuf->size - idx;
+
+    if (first > len) {
+        first = len;
+    }
+
+    (void)memcpy_s(dest, first, coreBuf->fifo + idx, first);
+    if (len > first) {
+        (void)memcpy_s(dest + first, len - first, coreBuf->fifo, len - first);
+    }
+
+    idx += len;
+    return (idx >= coreBuf->size) ? (idx - coreBuf->size) : idx;
+}
+
+/* 缓冲区按核均分，每核的起始地址按cacheline对齐 */
 U32 OsPerfOutPutInit(void *buf, U32 size)
 {
-    U32 ret;
+    U32 i;
+    U32 coreSize;
     bool releaseFlag = FALSE;
 
     if (PERF_BUFFER_WATERMARK_ONE_N == 0) {
@@ -33,6 +71,12 @@ U32 OsPerfOutPutInit(void *buf, U32 size)
         return OS_ERROR;
     }
 
+    coreSize = (size / PRT_KERNEL_CORE_NUM) & ~(PERF_CACHE_LINE_SIZE - 1);
+    if (coreSize <= sizeof(U32) + sizeof(PerfSampleData)) {
+        printf("perf output buffer size 0x%x is too small for %u cores\n", size, PRT_KERNEL_CORE_NUM);
+        return OS_ERROR;
+    }
+
     if (buf == NULL) {
         buf = PRT_MemAlloc(OS_MID_PERF, OS_MEM_DEFAULT_PT0, size);
         if (buf == NULL) {
@@ -44,79 +88,206 @@ U32 OsPerfOutPutInit(void *buf, U32 size)
         (void)memset_s(buf, size, 0, size);
     }
 
-    ret = PRT_RingbufInit(&g_perfOutputCb.ringbuf, buf, size);
-    if (ret != OS_OK) {
+    if (memset_s(&g_perfOutputCb, sizeof(PerfOutputCB), 0, sizeof(PerfOutputCB)) != EOK) {
         goto RELEASE;
     }
 
-    g_perfOutputCb.waterMark = size / PERF_BUFFER_WATERMARK_ONE_N;
-    g_perfBufNotifyHook = OsPerfDefaultNotify;
-    return ret;
+    OsSpinLockInitInner(&g_perfOutputCb.readLock.rawLock);
+    for (i = 0; i < PRT_KERNEL_CORE_NUM; i++) {
+        g_perfOutputCb.coreBuf[i].fifo = (char *)buf + i * coreSize;
+        g_perfOutputCb.coreBuf[i].size = coreSize;
+    }
+
+    g_perfOutputCb.buf = buf;
+    g_perfOutputCb.size = size;
+    g_perfOutputCb.waterMark = coreSize / PERF_BUFFER_WATERMARK_ONE_N;
+    return OS_OK;
 RELEASE:
     if (releaseFlag) {
         (void)PRT_MemFree(OS_MID_PERF, buf);
     }
 
-    return ret;
+    return OS_ERROR;
 }
 
 void OsPerfOutPutFlush(void)
 {
     if (g_perfBufFlushHook != NULL) {
-        g_perfBufFlushHook(g_perfOutputCb.ringbuf.fifo, g_perfOutputCb.ringbuf.size);
+        g_perfBufFlushHook(g_perfOutputCb.buf, g_perfOutputCb.size);
     }
 
     return;
 }
 
+/* 从一个核的缓冲区读出整条记录，目的缓冲区放不下的记录留到下次读取 */
+static U32 OsPerfCoreBufRead(PerfCoreBuf *coreBuf, char *dest, U32 size)
+{
+    U32 len;
+    U32 next;
+    U32 total = 0;
+    U32 head = coreBuf->head;
+    U32 tail = __atomic_load_n(&coreBuf->tail, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+        next = OsPerfCoreBufCopyOut(coreBuf, head, (char *)&len, sizeof(U32));
+        if (len > size - total) {
+            break;
+        }
+        head = OsPerfCoreBufCopyOut(coreBuf, next, dest + total, len);
+        total += len;
+    }
+
+    __atomic_store_n(&coreBuf->head, head, __ATOMIC_RELEASE);
+    if (OsPerfCoreBufUsed(coreBuf, head, tail) < g_perfOutputCb.waterMark) {
+        coreBuf->notified = 0;
+    }
+
+    return total;
+}
+
+/*
+ * 段头在所有采样数据之前读出，之后轮流从各核读取，起始核每次后移一个，避免某个核一直读不到。
+ * 读锁只在读者之间互斥，写采样数据不需要加锁。
+ */
 U32 OsPerfOutPutRead(char *dest, U32 size)
 {
+    U32 i;
+    U32 total = 0;
+    uintptr_t intSave;
+    PerfOutputCB *cb = &g_perfOutputCb;
+
+    if ((dest == NULL) || (size == 0) || (cb->buf == NULL)) {
+        return 0;
+    }
+
     OsPerfOutPutFlush();
-    return PRT_RingbufRead(&g_perfOutputCb.ringbuf, dest, size);
+
+    intSave = PRT_SplIrqLock(&cb->readLock);
+    if (cb->hdrPending) {
+        if (size < cb->hdr.len) {
+            PRT_SplIrqUnlock(&cb->readLock, intSave);
+            return 0;
+        }
+        (void)memcpy_s(dest, size, &cb->hdr, cb->hdr.len);
+        total = cb->hdr.len;
+        cb->hdrPending = FALSE;
+    }
+
+    for (i = 0; i < PRT_KERNEL_CORE_NUM; i++) {
+        total += OsPerfCoreBufRead(&cb->coreBuf[(cb->readCore + i) % PRT_KERNEL_CORE_NUM], dest + total,
+                                   size - total);
+    }
+    cb->readCore = (cb->readCore + 1) % PRT_KERNEL_CORE_NUM;
+    PRT_SplIrqUnlock(&cb->readLock, intSave);
+
+    return total;
 }
 
-static int OsPerfOutPutBegin(U32 size)
+/* 段头由启动采样的核写入，单独保存，保证读出的数据以段头开始 */
+U32 OsPerfOutPutHdrWrite(PerfDataHdr *hdr)
 {
-    if (g_perfOutputCb.ringbuf.remain < size) {
-        printf("perf buf remain %u, and has no enough space for 0x%x\n", g_perfOutputCb.ringbuf.remain, size);
-        return FALSE;
+    uintptr_t intSave;
+    PerfOutputCB *cb = &g_perfOutputCb;
+
+    if (cb->buf == NULL) {
+        return OS_ERROR;
     }
 
-    return TRUE;
+    intSave = PRT_SplIrqLock(&cb->readLock);
+    (void)memcpy_s(&cb->hdr, sizeof(PerfDataHdr), hdr, sizeof(PerfDataHdr));
+    cb->hdrPending = TRUE;
+    PRT_SplIrqUnlock(&cb->readLock, intSave);
+
+    return OS_OK;
 }
 
-static void OsPerfOutPutEnd(void)
+/* 每次越过水线只通知一次，读者把数据读到水线以下后才会再次通知 */
+static void OsPerfOutPutEnd(PerfCoreBuf *coreBuf, U32 used)
 {
-    OsPerfOutPutFlush();
-    if (PRT_RingbufUsedSize(&g_perfOutputCb.ringbuf) >= g_perfOutputCb.waterMark) {
-        if (g_perfBufNotifyHook != NULL) {
-            g_perfBufNotifyHook();
-        }
+    if (g_perfBufFlushHook != NULL) {
+        g_perfBufFlushHook(coreBuf->fifo, coreBuf->size);
+    }
+
+    if ((used < g_perfOutputCb.waterMark) || (coreBuf->notified != 0)) {
+        return;
+    }
+
+    if (__atomic_exchange_n(&coreBuf->notified, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+
+    if (g_perfOutputCb.drainRunning) {
+        (void)PRT_SemPost(g_perfOutputCb.drainSem);
+    }
+
+    if (g_perfBufNotifyHook != NULL) {
+        g_perfBufNotifyHook();
     }
 
     return;
 }
 
+/*
+ * 写入本核的缓冲区，不加锁。本核的采样可能嵌套（如软件事件被采样中断打断），关本核中断保证单生产者。
+ * 缓冲区满时只计数丢弃的记录，不在中断上下文中打印。
+ */
 U32 OsPerfOutPutWrite(char *data, U32 size)
 {
-    if (!OsPerfOutPutBegin(size)) {
+    U32 head;
+    U32 tail;
+    U32 used;
+    uintptr_t intSave;
+    PerfCoreBuf *coreBuf = &g_perfOutputCb.coreBuf[PRT_GetCoreID()];
+
+    if (coreBuf->fifo == NULL) {
+        return OS_ERROR;
+    }
+
+    intSave = PRT_HwiLock();
+    tail = coreBuf->tail;
+    head = __atomic_load_n(&coreBuf->head, __ATOMIC_ACQUIRE);
+    used = OsPerfCoreBufUsed(coreBuf, head, tail);
+    /* 保留1字节区分空和满 */
+    if (coreBuf->size - used - 1 < size + sizeof(U32)) {
+        coreBuf->lost++;
+        PRT_HwiRestore(intSave);
         return OS_ERROR;
     }
 
-    PRT_RingbufWrite(&g_perfOutputCb.ringbuf, data, size);
+    tail = OsPerfCoreBufCopyIn(coreBuf, tail, (char *)&size, sizeof(U32));
+    tail = OsPerfCoreBufCopyIn(coreBuf, tail, data, size);
+    __atomic_store_n(&coreBuf->tail, tail, __ATOMIC_RELEASE);
+    PRT_HwiRestore(intSave);
 
-    OsPerfOutPutEnd();
+    OsPerfOutPutEnd(coreBuf, used + size + sizeof(U32));
     return OS_OK;
 }
 
 U32 OsPerfOutPutRemainSize()
 {
-    return g_perfOutputCb.ringbuf.remain;
+    U32 i;
+    U32 remain = 0;
+    PerfCoreBuf *coreBuf = NULL;
+
+    for (i = 0; i < PRT_KERNEL_CORE_NUM; i++) {
+        coreBuf = &g_perfOutputCb.coreBuf[i];
+        remain += coreBuf->size - OsPerfCoreBufUsed(coreBuf, coreBuf->head, coreBuf->tail);
+    }
+
+    return remain;
 }
 
 void OsPerfOutPutInfo(void)
 {
-    printf("dump section data, addr: %p length: %#x\n", g_perfOutputCb.ringbuf.fifo, g_perfOutputCb.ringbuf.size);
+    U32 i;
+    PerfCoreBuf *coreBuf = NULL;
+
+    printf("dump section data, addr: %p length: %#x\n", g_perfOutputCb.buf, g_perfOutputCb.size);
+    for (i = 0; i < PRT_KERNEL_CORE_NUM; i++) {
+        coreBuf = &g_perfOutputCb.coreBuf[i];
+        printf("core %u buf: %p used: %#x lost: %u\n", i, coreBuf->fifo,
+               OsPerfCoreBufUsed(coreBuf, coreBuf->head, coreBuf->tail), coreBuf->lost);
+    }
     return;
 }
 
@@ -130,4 +301,107 @@ void OsPerfFlushHookReg(const PERF_BUF_FLUSH_HOOK func)
 {
     g_perfBufFlushHook = func;
     return;
-}
\ No newline at end of file
+}
+
+static void OsPerfDrainOnce(void)
+{
+    U32 len;
+    PerfOutputCB *cb = &g_perfOutputCb;
+
+    while ((len = OsPerfOutPutRead(cb->drainBuf, PERF_DRAIN_BUF_LEN)) != 0) {
+        cb->drainHook(cb->drainBuf, len);
+    }
+
+    return;
+}
+
+/* 导出任务：任一核越过水线或等待超时后读出所有核的数据交给导出钩子，采样期间持续运行 */
+static void OsPerfDrainTask(uintptr_t param1, uintptr_t param2, uintptr_t param3, uintptr_t param4)
+{
+    PerfOutputCB *cb = &g_perfOutputCb;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+    (void)param4;
+
+    while (!cb->drainStop) {
+        (void)PRT_SemPend(cb->drainSem, cb->drainInterval);
+        OsPerfDrainOnce();
+    }
+
+    OsPerfDrainOnce();
+    cb->drainRunning = FALSE;
+    return;
+}
+
+U32 OsPerfDrainStart(const PERF_BUF_DRAIN_HOOK func, U32 interval)
+{
+    U32 ret;
+    struct TskInitParam taskParam = {0};
+    PerfOutputCB *cb = &g_perfOutputCb;
+
+    if (cb->drainRunning) {
+        return OS_ERRNO_PERF_DRAIN_STARTED;
+    }
+
+    cb->drainBuf = PRT_MemAlloc(OS_MID_PERF, OS_MEM_DEFAULT_PT0, PERF_DRAIN_BUF_LEN);
+    if (cb->drainBuf == NULL) {
+        return OS_ERRNO_PERF_BUF_ERROR;
+    }
+
+    ret = PRT_SemCreate(0, &cb->drainSem);
+    if (ret != OS_OK) {
+        goto FREE_BUF;
+    }
+
+    cb->drainHook = func;
+    cb->drainInterval = interval;
+    cb->drainStop = FALSE;
+    cb->drainRunning = TRUE;
+
+    taskParam.taskEntry = (TskEntryFunc)OsPerfDrainTask;
+    taskParam.taskPrio = PERF_DRAIN_TASK_PRIO;
+    taskParam.name = "PerfDrain";
+    taskParam.stackSize = PERF_DRAIN_TASK_STACK_SIZE;
+    ret = PRT_TaskCreate(&cb->drainTask, &taskParam);
+    if (ret != OS_OK) {
+        goto DELETE_SEM;
+    }
+
+    ret = PRT_TaskResume(cb->drainTask);
+    if (ret != OS_OK) {
+        (void)PRT_TaskDelete(cb->drainTask);
+        goto DELETE_SEM;
+    }
+
+    return OS_OK;
+DELETE_SEM:
+    cb->drainRunning = FALSE;
+    (void)PRT_SemDelete(cb->drainSem);
+FREE_BUF:
+    (void)PRT_MemFree(OS_MID_PERF, cb->drainBuf);
+    cb->drainBuf = NULL;
+    return ret;
+}
+
+/* 通知导出任务读出剩余数据后退出，等待其退出后释放资源 */
+void OsPerfDrainStop(void)
+{
+    PerfOutputCB *cb = &g_perfOutputCb;
+
+    if (!cb->drainRunning) {
+        return;
+    }
+
+    cb->drainStop = TRUE;
+    (void)PRT_SemPost(cb->drainSem);
+    while (cb->drainRunning) {
+        (void)PRT_TaskDelay(1);
+    }
+
+    (void)PRT_SemDelete(cb->drainSem);
+    (void)PRT_MemFree(OS_MID_PERF, cb->drainBuf);
+    cb->drainBuf = NULL;
+    cb->drainHook = NULL;
+    return;
+}
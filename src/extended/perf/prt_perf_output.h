@@ -17,7 +17,8 @@
 #define PRT_PERF_OUTPUT_H
 
 #include "include/prt_perf_comm.h"
-#include "prt_ringbuf.h"
+#include "prt_atomic.h"
+#include "prt_sem.h"
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -25,19 +26,51 @@ extern "C" {
 #endif /* __cplusplus */
 #endif /* __cplusplus */
 
+#define PERF_CACHE_LINE_SIZE    64
+
+/*
+ * 每核一个单生产者单消费者采样缓冲区，生产者为本核的采样路径，消费者为读取接口或导出任务。
+ * 每条记录前有4字节长度，消费者按整条记录读取。head和tail分属不同cacheline，避免两侧互相干扰。
+ */
+typedef struct {
+    volatile U32 tail;      /* write index, only updated by the owner core */
+    U32 lost;               /* records dropped because the buffer is full */
+    volatile U32 notified;  /* water mark notified, cleared by the consumer */
+    U32 size;               /* buffer size */
+    char *fifo;             /* buffer to store data */
+    volatile U32 head __attribute__((aligned(PERF_CACHE_LINE_SIZE)));  /* read index */
+} __attribute__((aligned(PERF_CACHE_LINE_SIZE))) PerfCoreBuf;
+
 typedef struct {
-    Ringbuf ringbuf;        /* ring buffer */
-    U32 waterMark;          /* notify water mark */
+    PerfCoreBuf coreBuf[PRT_KERNEL_CORE_NUM];
+    U32 waterMark;          /* notify water mark of each core buffer */
+    U32 readCore;           /* next core to read, make the readers fair to all cores */
+    struct PrtSpinLock readLock;  /* serialize the consumers, producers never take it */
+    PerfDataHdr hdr;        /* section header, read before samples */
+    bool hdrPending;
+    char *buf;              /* whole buffer */
+    U32 size;               /* whole buffer size */
+    /* drain task */
+    TskHandle drainTask;
+    SemHandle drainSem;
+    U32 drainInterval;
+    volatile bool drainStop;
+    volatile bool drainRunning;
+    char *drainBuf;
+    PERF_BUF_DRAIN_HOOK drainHook;
 } PerfOutputCB;
 
 extern U32 OsPerfOutPutInit(void *buf, U32 size);
 extern U32 OsPerfOutPutRead(char *dest, U32 size);
 extern U32 OsPerfOutPutWrite(char *data, U32 size);
+extern U32 OsPerfOutPutHdrWrite(PerfDataHdr *hdr);
 extern U32 OsPerfOutPutRemainSize();
 extern void OsPerfOutPutInfo(void);
 extern void OsPerfOutPutFlush(void);
 extern void OsPerfNotifyHookReg(const PERF_BUF_NOTIFY_HOOK func);
 extern void OsPerfFlushHookReg(const PERF_BUF_FLUSH_HOOK func);
+extern U32 OsPerfDrainStart(const PERF_BUF_DRAIN_HOOK func, U32 interval);
+extern void OsPerfDrainStop(void);
 
 #ifdef __cplusplus
 #if __cplusplus
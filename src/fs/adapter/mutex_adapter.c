@@ -1,5 +1,6 @@
 #include "nuttx/mutex.h"
 #include "prt_sem_external.h"
+#include "prt_posix_internal.h"
 
 int nxmutex_init(FAR mutex_t *mutex)
 {
@@ -42,24 +43,21 @@ int nxrmutex_unlock(FAR rmutex_t *rmutex)
 
 void nxmutex_reset(FAR mutex_t *mutex)
 {
-    SemHandle semHandle = mutex->mutex_sem;
-    struct TagSemCb *semCb = NULL;
-    semCb = GET_SEM(semHandle);
-    int count = 1;
+    U32 owner;
 
     PRT_TaskLock();
-    uintptr_t intSave = OsIntLock();
 
-    while (semCb->semCount == 0 && count > 0) {
-        PRT_SemPost(mutex->mutex_sem);
-        count--;
-    }
-
-    if (semCb->semCount == 0) {
-        semCb->semCount = count;
+    if (nxmutex_is_hold(mutex)) {
+        mutex->count = 1;
+        (void)pthread_mutex_unlock(mutex);
+    } else {
+        /* 没有任务阻塞时直接清除持有者，有等待者时只能由持有者释放 */
+        owner = OsMutexOwnerGet(&mutex->owner);
+        if ((owner & OS_MUTEX_WAITERS) == 0) {
+            (void)OsMutexOwnerCas(&mutex->owner, owner, 0);
+        }
     }
 
-    OsIntRestore(intSave);
     PRT_TaskUnlock();
 }
 
@@ -70,25 +68,27 @@ int nxrmutex_destroy(FAR rmutex_t *rmutex)
 
 bool nxmutex_is_hold(FAR mutex_t *mutex)
 {
-    return GET_SEM(mutex->mutex_sem)->semOwner == RUNNING_TASK->taskPid;
+    return (OsMutexOwnerGet(&mutex->owner) & ~OS_MUTEX_WAITERS) == OS_MUTEX_OWNER_ID(OsPthreadSelfPid());
 }
 
 bool nxrmutex_is_hold(FAR rmutex_t *rmutex)
 {
-    return GET_SEM(rmutex->mutex_sem)->semOwner == RUNNING_TASK->taskPid;
+    return nxmutex_is_hold(rmutex);
 }
 
 int nxrmutex_breaklock(FAR rmutex_t *rmutex, FAR unsigned int *count)
 {
     int ret = 0;
     *count = 0;
-    if (nxrmutex_is_hold(rmutex)) {
+    if (!nxrmutex_is_hold(rmutex)) {
         return ret;
     }
-    *count = GET_SEM(rmutex->mutex_sem)->semCount;
+    /* 一次释放所有递归持有 */
+    *count = rmutex->count;
+    rmutex->count = 1;
     ret = nxmutex_unlock(rmutex);
     if (ret != 0) {
-        GET_SEM(rmutex->mutex_sem)->semCount = *count;
+        rmutex->count = *count;
     }
 
     return ret;
@@ -104,8 +104,8 @@ int nxrmutex_restorelock(FAR rmutex_t *rmutex, unsigned int count)
     int ret = OK;
     if (count != 0) {
         ret = nxmutex_lock(rmutex);
-        if (ret != 0) {
-            GET_SEM(rmutex->mutex_sem)->semCount = count;
+        if (ret == 0) {
+            rmutex->count = count;
         }
     }
 
@@ -22,6 +22,7 @@ static struct log_list_elem *g_log_list_tail;
 void init_log_list(void)
 {
     g_log_list_head.cont.log_mem = NULL;
+    g_log_list_head.cont.log_len = 0;
     g_log_list_head.cont.log_num = 0;
     g_log_list_head.next = NULL;
     g_log_list_tail = &(g_log_list_head);
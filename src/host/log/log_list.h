@@ -9,8 +9,10 @@
 #define LOG_DEBUG(fmt, ...)
 #endif
 
+/* 一次批量读取的日志, log_len为字节数, log_num为其中的日志条数 */
 struct log_elem_content {
     void *log_mem;
+    uint32_t log_len;
     uint32_t log_num;
 };
 
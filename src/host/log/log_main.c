@@ -17,16 +17,36 @@
 #include <linux/printk.h>
 #include <linux/jiffies.h>
 #include <linux/string.h>
+#include <linux/random.h>
 #include <linux/of.h>
 #include <linux/of_address.h>
+#include <linux/of_irq.h>
+#include <linux/interrupt.h>
+#include <linux/wait.h>
+#include <linux/poll.h>
+#include <linux/mm.h>
 #include "log_main.h"
 #include "log_list.h"
 
-/* uint32_t [0, 4294967295] 条日志, 按照每秒1w条日志计算, 需要连续运行5天才会翻转 */
+/* head和tail为自由增长的uint32_t字节位置, 无符号差值处理翻转 */
 static struct task_struct *g_worker_thread = NULL;
 static void *g_ring_buffer = NULL;
-static uint8_t g_flag_valid;
-static uint8_t g_tmp_valid_flags[BUFFER_BLOCK_NUM];
+static uint64_t g_ring_phymem = 0;
+/* 启动时的head, mmap方式下由用户态通过IOC_SET_HEAD推进 */
+static uint32_t g_user_head;
+
+static int g_emit_mode = LOG_EMIT_PRINTK;
+module_param_named(emit_mode, g_emit_mode, int, 0444);
+MODULE_PARM_DESC(emit_mode, "0: printk by kernel thread, 1: mmap to user space");
+
+static uint32_t g_log_watermark = LOG_DEFAULT_WATERMARK;
+module_param_named(watermark, g_log_watermark, uint, 0444);
+MODULE_PARM_DESC(watermark, "unread bytes to ring the doorbell");
+
+/* 门铃中断, 从"oe,log_mem"节点的interrupts属性获取, 没有时按LOG_POLL_TIMEOUT轮询 */
+static int g_log_irq = 0;
+static atomic_t g_log_doorbell = ATOMIC_INIT(0);
+static DECLARE_WAIT_QUEUE_HEAD(g_log_wq);
 
 /**
  * struct log_mem - internal memory structure
@@ -40,9 +60,9 @@ static int g_log_major;
 
 #ifdef DEBUG
 static uint64_t g_pintk_count = 0;
-#define VPRINTK_DEBUG_FMT   "[%llu][Uni][%llu.%09llu][seq:%llu][pid:%u] %s"
+#define VPRINTK_DEBUG_FMT   "[%llu][Uni][%llu.%09llu][seq:%llu][pid:%u] %.*s"
 #else
-#define VPRINTK_FMT         "[Uni][%llu.%09llu][seq:%llu][pid:%u] %s"
+#define VPRINTK_FMT         "[Uni][%llu.%09llu][seq:%llu][pid:%u] %.*s"
 #endif
 
 static int vprintk_emit_wrapper(int facility, int level, ...)
@@ -60,27 +80,174 @@ static int vprintk_emit_wrapper(int facility, int level, ...)
     return ret;
 }
 
+/* 二进制日志格式化使用的缓冲区, 只在worker线程中使用 */
+static char g_bin_fmt[LOG_FMT_MAX_LEN];
+static char g_bin_str[BUFFER_BLOCK_SIZE];
+static char g_bin_text[BUFFER_BLOCK_SIZE];
+
+/* 根据编号从共享内存格式表中取出格式串, 编号为表内偏移加1 */
+static int log_fmt_get(uint32_t fmt_id, char *fmt)
+{
+    uint16_t len;
+    uint32_t off = fmt_id - 1;
+    const uint8_t *table = (uint8_t *)g_ring_buffer + LOG_FMT_TABLE_OFFSET;
+
+    if (fmt_id == 0 || off > LOG_FMT_TABLE_SIZE - sizeof(uint16_t)) {
+        return -EINVAL;
+    }
+    memcpy_fromio(&len, table + off, sizeof(uint16_t));
+    if (len == 0 || len >= LOG_FMT_MAX_LEN || len > LOG_FMT_TABLE_SIZE - off - sizeof(uint16_t)) {
+        return -EINVAL;
+    }
+    memcpy_fromio(fmt, table + off + sizeof(uint16_t), len);
+    fmt[len] = '\0';
+    return 0;
+}
+
+/*
+ * 按格式串逐个转换说明取出原始参数并格式化, 解析规则和UniProton侧OsLogFmtParse一致。
+ * 内核不支持浮点格式化, 浮点参数按原始位输出。
+ */
+static int log_bin_format(struct log_header *cur_log, char *out, size_t size)
+{
+    struct log_bin_header *bin = (struct log_bin_header *)cur_log->log_content;
+    const uint8_t *args = cur_log->log_content;
+    const char *p = g_bin_fmt;
+    const char *start;
+    char spec[32];
+    uint32_t off = sizeof(struct log_bin_header);
+    uint32_t arg = 0;
+    uint64_t val, str_len;
+    int len_mod;
+    size_t pos = 0;
+    char conv;
+
+    if (cur_log->len < sizeof(struct log_bin_header) || cur_log->len > cur_log->size - sizeof(struct log_header) ||
+        log_fmt_get(bin->fmt_id, g_bin_fmt) != 0) {
+        return scnprintf(out, size, "[bin log: unknown fmt id %u]", bin->fmt_id);
+    }
+
+    while (*p != '\0' && pos < size - 1) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        start = p++;
+        while (*p != '\0' && strchr("-+ #0'", *p) != NULL) {
+            p++;
+        }
+        while ((*p >= '0' && *p <= '9') || *p == '.') {
+            p++;
+        }
+        len_mod = 0;
+        while (*p == 'h') {
+            p++;
+        }
+        if (*p == 'l') {
+            len_mod = 1;
+            p++;
+            if (*p == 'l') {
+                len_mod = 2;
+                p++;
+            }
+        } else if (*p == 'j' || *p == 'q') {
+            len_mod = 2;
+            p++;
+        } else if (*p == 'z' || *p == 't') {
+            len_mod = 1;
+            p++;
+        }
+        conv = *p;
+        if (conv == '\0') {
+            break;
+        }
+        p++;
+
+        /* 参数被截断或转换说明过长时原样输出 */
+        if (p - start >= sizeof(spec) || arg >= bin->arg_num || off + sizeof(uint64_t) > cur_log->len) {
+            pos += scnprintf(out + pos, size - pos, "%.*s", (int)(p - start), start);
+            continue;
+        }
+        memcpy(spec, start, p - start);
+        spec[p - start] = '\0';
+        memcpy(&val, args + off, sizeof(uint64_t));
+        off += sizeof(uint64_t);
+        arg++;
+
+        switch (conv) {
+            case 's':
+                val = min_t(uint64_t, val, cur_log->len - off);
+                str_len = min_t(uint64_t, val, sizeof(g_bin_str) - 1);
+                memcpy(g_bin_str, args + off, str_len);
+                g_bin_str[str_len] = '\0';
+                off += ALIGN(val, sizeof(uint64_t));
+                pos += scnprintf(out + pos, size - pos, spec, g_bin_str);
+                break;
+            case 'p':
+                pos += scnprintf(out + pos, size - pos, "0x%llx", val);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                pos += scnprintf(out + pos, size - pos, "(f64)0x%llx", val);
+                break;
+            default:
+                if (len_mod == 2) {
+                    pos += scnprintf(out + pos, size - pos, spec, (long long)val);
+                } else if (len_mod == 1) {
+                    pos += scnprintf(out + pos, size - pos, spec, (long)val);
+                } else {
+                    pos += scnprintf(out + pos, size - pos, spec, (int)val);
+                }
+                break;
+        }
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
 /* 至少输出 emit_num 条日志，0代表全部输出 */
 static void log_emit(uint32_t emit_num)
 {
-    int ret, i;
-    uint32_t total_emit_num;
+    int ret, content_len;
+    uint32_t off;
+    uint32_t total_emit_num = 0;
     struct log_elem_content log_elem;
     struct log_header *cur_log;
+    char *content;
 
-    uint32_t count = 0;
     while (pop_log_elem(&log_elem) != -1) {
-        count++;
-        for (i = 0; i < log_elem.log_num; i++) {
-            cur_log = ((struct log_header *)(log_elem.log_mem + i * BUFFER_BLOCK_SIZE));
-            cur_log->log_content[cur_log->len] = '\0';
+        /* 记录的size在读取时已检查过, 按size逐条输出 */
+        for (off = 0; off < log_elem.log_len; off += cur_log->size) {
+            cur_log = (struct log_header *)(log_elem.log_mem + off);
+            if (cur_log->type == LOG_RECORD_PAD) {
+                continue;
+            }
+            if (cur_log->type == LOG_RECORD_BINARY) {
+                content_len = log_bin_format(cur_log, g_bin_text, sizeof(g_bin_text));
+                content = g_bin_text;
+            } else {
+                content_len = min_t(uint32_t, cur_log->len, cur_log->size - sizeof(struct log_header));
+                content = (char *)cur_log->log_content;
+            }
 #ifdef DEBUG
             g_pintk_count++;
             ret = vprintk_emit_wrapper((int)cur_log->facility, (int)cur_log->level, g_pintk_count, cur_log->sec,
-                cur_log->nano_sec, cur_log->sequence_num, cur_log->task_pid, cur_log->log_content);
+                cur_log->nano_sec, cur_log->sequence_num, cur_log->task_pid, content_len, content);
 #else
             ret = vprintk_emit_wrapper((int)cur_log->facility, (int)cur_log->level, cur_log->sec, cur_log->nano_sec,
-                cur_log->sequence_num, cur_log->task_pid, cur_log->log_content);
+                cur_log->sequence_num, cur_log->task_pid, content_len, content);
 #endif
         }
         total_emit_num += log_elem.log_num;
@@ -98,73 +265,50 @@ static void log_emit(uint32_t emit_num)
     return;
 }
 
-static uint8_t reverse_flag(uint8_t flag) 
-{
-    if (flag == 0) {
-        return 1;
-    }
-    if (flag == 1) {
-        return 0;
-    }
-    printk(KERN_ERR "[logWorker] error: illegal flag\n");
-    return flag;
-}
-
-static uint32_t check_valid_num(uint32_t head_index, uint32_t copy_num)
+/*
+ * 从head开始逐条检查记录头的提交字, 返回连续已提交的字节数, 遇到未提交的记录或达到单次读取上限为止。
+ * 只读取记录头的前8字节。记录头损坏时返回-EINVAL, urgent返回其中是否有需要立即输出的日志。
+ */
+static long log_scan(uint32_t head, uint32_t tail, uint32_t *rec_num, bool *urgent)
 {
-    const uint8_t *const valid_ptr = (uint8_t *)g_ring_buffer + VALID_FLAGS_OFFSET;
-    uint32_t tail_copy_num, head_copy_num, valid_num;
-    uint8_t valid_flag = g_flag_valid;
-    uint8_t rev_valid_flag = reverse_flag(valid_flag);
-    int i;
-
-    if (head_index + copy_num > BUFFER_BLOCK_NUM) {
-        // 到达结尾后，从头拷贝
-        tail_copy_num = BUFFER_BLOCK_NUM - head_index;
-        head_copy_num = head_index + copy_num - BUFFER_BLOCK_NUM;
-    } else {
-        tail_copy_num = copy_num;
-        head_copy_num = 0;
-    }
+    struct log_header cur_log;
+    uint32_t pos = head;
+    uint32_t num = 0;
 
-    valid_num = 0;
-    memcpy_fromio(g_tmp_valid_flags, valid_ptr + head_index, tail_copy_num);
-    for (i = 0; i < tail_copy_num; i++) {
-        if (g_tmp_valid_flags[i] == valid_flag) {
-            valid_num++;
-        } else {
-            return valid_num;
+    while (pos != tail && pos - head < LOG_BATCH_MAX_SIZE) {
+        memcpy_fromio(&cur_log, g_ring_buffer + (pos & LOG_RING_MASK), LOG_RECORD_PEEK_SIZE);
+        if (cur_log.commit != (pos ^ LOG_COMMIT_MAGIC)) {
+            break;
         }
-    }
-
-    if (head_copy_num != 0) {
-        memcpy_fromio(g_tmp_valid_flags, valid_ptr, head_copy_num);
-        for (i = 0; i < head_copy_num; i++) {
-            if (g_tmp_valid_flags[i] == rev_valid_flag) {
-                valid_num++;
-            } else {
-                return valid_num;
+        if (cur_log.size < LOG_RECORD_ALIGN || cur_log.size % LOG_RECORD_ALIGN != 0 ||
+            cur_log.size > BUFFER_BLOCK_SIZE || cur_log.size > tail - pos ||
+            (pos & LOG_RING_MASK) + cur_log.size > LOG_RING_SIZE ||
+            (cur_log.type != LOG_RECORD_PAD && cur_log.size < sizeof(struct log_header))) {
+            printk(KERN_ERR "[logWorker] invalid record, pos:%u, size:%u, type:%u\n", pos, cur_log.size,
+                cur_log.type);
+            return -EINVAL;
+        }
+        if (cur_log.type != LOG_RECORD_PAD) {
+            num++;
+            if (cur_log.level <= LOG_URGENT_LEVEL) {
+                *urgent = true;
             }
         }
+        pos += cur_log.size;
     }
-    return valid_num;
+    *rec_num = num;
+    return pos - head;
 }
 
-static void copy_log_buffer(void *log_buffer, uint32_t head_index, uint32_t copy_num)
+/* 拷贝[head, head + len)的日志, 记录不跨越环尾, 但一批记录可能跨越 */
+static void copy_log_buffer(void *log_buffer, uint32_t head, uint32_t len)
 {
-    uint32_t tail_copy_num, head_copy_num;
-    if (head_index + copy_num > BUFFER_BLOCK_NUM) {
-        // 到达结尾，从头拷贝
-        tail_copy_num = BUFFER_BLOCK_NUM - head_index;
-        head_copy_num = head_index + copy_num - BUFFER_BLOCK_NUM;
-    } else {
-        tail_copy_num = copy_num;
-        head_copy_num = 0;
-    }
+    uint32_t off = head & LOG_RING_MASK;
+    uint32_t first = min_t(uint32_t, len, LOG_RING_SIZE - off);
 
-    memcpy_fromio(log_buffer, g_ring_buffer + (head_index * BUFFER_BLOCK_SIZE), (tail_copy_num * BUFFER_BLOCK_SIZE));
-    if (head_copy_num != 0) {
-        memcpy_fromio(log_buffer + (tail_copy_num * BUFFER_BLOCK_SIZE), g_ring_buffer, (head_copy_num * BUFFER_BLOCK_SIZE));
+    memcpy_fromio(log_buffer, g_ring_buffer + off, first);
+    if (len > first) {
+        memcpy_fromio(log_buffer + first, g_ring_buffer, len - first);
     }
     return;
 }
@@ -185,6 +329,13 @@ static int init_reserved_mem(void)
         return 0;
     }
 
+    /* 门铃中断可选, 没有时按超时轮询 */
+    g_log_irq = of_irq_get(np, 0);
+    if (g_log_irq <= 0) {
+        printk(KERN_INFO "[logWorker] no doorbell irq, poll log every %d jiffies\n", LOG_POLL_TIMEOUT);
+        g_log_irq = 0;
+    }
+
     count = of_count_phandle_with_args(np, "memory-region", NULL);
     if (count <= 0) {
         printk(KERN_ERR "[logWorker] reserved mem is required for log\n");
@@ -221,153 +372,109 @@ static int init_reserved_mem(void)
     return 0;
 }
 
-/* 不应该返回 NULL, 返回错误码或者内存 */
-static void *log_read(uint32_t *num, bool check_log, uint32_t head_index)
+/*
+ * 批量读取已提交的日志, 一次拷贝后只更新一次head, 返回读取的字节数。
+ * 记录头损坏时丢弃head到tail之间的日志重新同步。
+ */
+static long log_read(uint32_t *local_head)
 {
     void *vmem = NULL;
-    uint32_t copy_num;
+    long len;
+    bool urgent = false;
+    uint32_t rec_num;
+    uint32_t head = *local_head;
+    uint32_t tail = *(volatile uint32_t *)(g_ring_buffer + TAIL_PTR_OFFSET);
+    volatile uint32_t *const head_ptr = (uint32_t *)(g_ring_buffer + HEAD_PTR_OFFSET);
 
-    if (num == NULL) {
-        return ERR_PTR(-EFAULT);
+    LOAD_FENCE();
+    if (tail - head > LOG_RING_SIZE) {
+        printk(KERN_ERR "[logWorker] invalid tail/head, tail:%u, head:%u\n", tail, head);
+        return -EINVAL;
     }
-    copy_num = *num;
 
-    if (copy_num == 0 || copy_num > BUFFER_BLOCK_NUM || head_index >= BUFFER_BLOCK_NUM) {
-        *num = 0;
-        return ERR_PTR(-EINVAL);
+    len = log_scan(head, tail, &rec_num, &urgent);
+    if (len == -EINVAL) {
+        printk(KERN_ERR "[logWorker] drop log, head:%u, tail:%u\n", head, tail);
+        *local_head = tail;
+        *head_ptr = tail;
+        STORE_FENCE();
+        return 0;
     }
-
-    if (check_log == true) {
-        copy_num = check_valid_num(head_index, copy_num);
+    if (len <= 0) {
+        return len;
     }
+    /* 看到提交字后再读取记录内容 */
     LOAD_FENCE();
 
-    if (copy_num == 0) {
-        *num = 0;
-        return ERR_PTR(-EAGAIN);
-    }
-
-    // TODO 设置每次拷贝的最大数量
-
-    vmem = vmalloc(copy_num * BUFFER_BLOCK_SIZE);
+    vmem = vmalloc(len);
     if (vmem == NULL) {
-        *num = 0;
-        return ERR_PTR(-ENOMEM);
+        return -ENOMEM;
     }
+    copy_log_buffer(vmem, head, len);
 
-    copy_log_buffer(vmem, head_index, copy_num);
-    *num = copy_num;
-    return vmem;
-}
-
-/* 返回NULL代表没有尝试读取日志 */
-static void *log_read_or_emit(uint32_t local_head, uint32_t curr_tail, uint32_t *read_num)
-{
-    void *log_mem = NULL;
-    uint32_t num = curr_tail - local_head;
-    uint32_t head_index = local_head % BUFFER_BLOCK_NUM;
-
-    if (curr_tail < local_head || curr_tail > local_head + BUFFER_BLOCK_NUM) {
-        printk(KERN_ERR "[logWorker] invalid tail/head, tail:%u, head:%u\n", curr_tail, local_head);
-        return ERR_PTR(-EINVAL);
-    }
-
-    if (BUFFER_BLOCK_NUM - num < BUFFER_NO_CHECK_COPY_THRESHOLD) {
-        // tail 即将追上一圈, 读取日志，不检查有效标记位
-        // TODO 1k缓冲可能不够
-        printk(KERN_ERR "[logWorker] tail is about to be full\n");
-        log_mem = log_read(&num, false, head_index);
-    } else if (num > BUFFER_COPY_THRESHOLD) {
-        // 有足够多的日志读取
-        log_mem = log_read(&num, true, head_index);
-    } else if (peek_log_elem(NULL) == -1) {
-        // 链表为空，继续读取日志
-        if (num == 0) {
-            // 没有可处理/读取的日志，休眠一下, TODO休眠暂定10ms
-            schedule_timeout(HZ/100);
-            LOAD_FENCE()
-            return NULL;
-        }
-        log_mem = log_read(&num, true, head_index);
-    } else {
-        // 处理链表中的日志
-        log_emit(LEAST_LOG_EMIT_NUM);
-        return NULL;
-    }
+    LOG_DEBUG("[logWorker] log head:%u, curr_tail:%u, read len:%ld, num:%u\n", head, tail, len, rec_num);
+    *local_head = head + len;
+    *head_ptr = head + len;
+    STORE_FENCE();
 
-    if (IS_ERR(log_mem) && PTR_ERR(log_mem) == -EAGAIN) {
-        /* 有日志阻塞, 无法读取有效日志, 优先处理链表中的日志 */
-        if (peek_log_elem(NULL) == -1) {
-            // 没有可处理/读取的日志，休眠一下, TODO休眠暂定10ms
-            schedule_timeout(HZ/100);
-        } else {
-            log_emit(LEAST_LOG_EMIT_NUM);
-        }
-        return NULL;
+    /* 读取到日志，添加进链表中 */
+    if (add_log_elem((struct log_elem_content){vmem, len, rec_num}) != 0) {
+        vfree(vmem);
+        return -ENOMEM;
     }
-
-    *read_num = num;
-    return log_mem;
+    return len;
 }
 
-static void log_worker_fix_overflow(uint32_t *local_head, uint32_t *local_tail, bool *is_overflow)
+/*
+ * 置位wait后复查, 已达到水线或有紧急日志时不进入等待, 和UniProton侧提交后检查wait配对。
+ * 返回true表示可以读取日志。
+ */
+static bool log_ready(uint32_t head)
 {
-    uint32_t head = *local_head;
-    uint32_t tail = *local_tail;
-    bool overflow = *is_overflow;
-    if (overflow) {
-        /* 恢复前一轮翻转特殊处理过的head */
-        head -= 2 * BUFFER_BLOCK_NUM;
-        overflow = false;
-    }
-
-    if (head > (__UINT32_MAX__ - BUFFER_BLOCK_NUM)) {
-        /* __UINT32_MAX__ + 1 是 2 * BUFFER_BLOCK_NUM  的整倍数 */
-        /* 接近翻转的情况下，让head和tail都向前移动两圈 */
-        head += 2 * BUFFER_BLOCK_NUM;
-        tail += 2 * BUFFER_BLOCK_NUM;
-        overflow = true;
-    }
-    *local_head = head;
-    *local_tail = tail;
-    *is_overflow = overflow;
-    return;
+    long len;
+    bool urgent = false;
+    uint32_t rec_num;
+    uint32_t tail;
+    volatile uint32_t *const wait_ptr = (uint32_t *)(g_ring_buffer + LOG_WAIT_OFFSET);
+
+    *wait_ptr = 1;
+    M_FENCE();
+    tail = *(volatile uint32_t *)(g_ring_buffer + TAIL_PTR_OFFSET);
+    len = log_scan(head, tail, &rec_num, &urgent);
+    if (len < 0 || len >= g_log_watermark || (len > 0 && urgent)) {
+        *wait_ptr = 0;
+        return true;
+    }
+    return false;
 }
 
-static int log_worker_last_read(uint32_t local_head, uint32_t curr_tail, bool is_overflow)
+/* 等待门铃, 不足水线的日志最多等待一个超时周期后读取 */
+static void log_worker_wait(uint32_t head)
 {
-    uint32_t read_num;
-    int ret = 0;
-    void *log_mem = NULL;
+    long timeout = (g_log_irq > 0) ? LOG_IDLE_TIMEOUT : LOG_POLL_TIMEOUT;
 
-    log_worker_fix_overflow(&local_head, &curr_tail, &is_overflow);
-
-    /* 如果 curr_tail 和 local_head 不一致，需要读取剩下的所有日志 */
-    if (curr_tail == local_head) {
-        g_worker_thread = NULL;
-        return 0;
+    if (log_ready(head)) {
+        return;
     }
+    (void)wait_event_interruptible_timeout(g_log_wq,
+        atomic_xchg(&g_log_doorbell, 0) != 0 || kthread_should_stop(), timeout);
+    *(volatile uint32_t *)(g_ring_buffer + LOG_WAIT_OFFSET) = 0;
+    STORE_FENCE();
+}
 
-    read_num = curr_tail - local_head;
-    if (curr_tail < local_head || curr_tail > local_head + BUFFER_BLOCK_NUM) {
-        printk(KERN_ERR "[logWorker] last read, invalid tail/head, tail:%u, head:%u\n", curr_tail, local_head);
-        return -EINVAL;
-    }
-    /* 读取所有日志, 无论是否有效 */
-    log_mem = log_read(&read_num, false, local_head % BUFFER_BLOCK_NUM);
-    ret = add_log_elem((struct log_elem_content){log_mem, read_num});
-    return ret;
+static irqreturn_t log_doorbell_irq(int irq, void *dev_id)
+{
+    (void)irq;
+    (void)dev_id;
+    atomic_set(&g_log_doorbell, 1);
+    wake_up_interruptible(&g_log_wq);
+    return IRQ_HANDLED;
 }
 
 int log_worker_thd(void *param)
 {
-    void *log_mem = NULL;
-    uint32_t curr_tail, read_num;
     long ret = 0;
-    bool is_overflow = 0;
-    uint32_t local_head = __UINT32_MAX__ - 2 * BUFFER_BLOCK_NUM + 1;
-    volatile uint32_t *const head_ptr = (uint32_t *)(g_ring_buffer + HEAD_PTR_OFFSET);
-    volatile uint32_t *const tail_ptr = (uint32_t *)(g_ring_buffer + TAIL_PTR_OFFSET);
+    uint32_t local_head = g_user_head;
     (void)param;
 
     if (g_ring_buffer == NULL) {
@@ -376,41 +483,24 @@ int log_worker_thd(void *param)
     }
 
     while (!kthread_should_stop()) {
-        curr_tail = *tail_ptr;
-        log_worker_fix_overflow(&local_head, &curr_tail, &is_overflow);
-
-        /* 根据head和tail, 读取日志或处理日志 */
-        log_mem = log_read_or_emit(local_head, curr_tail, &read_num);
-        if (IS_ERR(log_mem)) {
-            ret = PTR_ERR(log_mem);
+        /* 先尽快读空环形缓冲区归还空间, 再输出链表中的日志 */
+        ret = log_read(&local_head);
+        if (ret < 0) {
             goto LOG_EXIT;
         }
-        /* 未进行日志读取 */
-        if (log_mem == NULL) {
+        if (ret > 0) {
             continue;
         }
-        printk(KERN_INFO "[logWorker] log head:%u, curr_tail:%u, read num:%u\n", local_head, curr_tail, read_num);
-        /* 更新标记位，head指针 */
-        if (local_head % BUFFER_BLOCK_NUM + read_num >= BUFFER_BLOCK_NUM) {
-            g_flag_valid = reverse_flag(g_flag_valid);
-        }
-        local_head += read_num;
-        if (is_overflow) {
-            local_head -= 2 * BUFFER_BLOCK_NUM;
-            is_overflow = false;
-        }
-        *head_ptr = local_head;
-        STORE_FENCE();
-        /* 读取到日志，添加进链表中 */
-        ret = add_log_elem((struct log_elem_content){log_mem, read_num});
-        if (ret != 0) {
-            vfree(log_mem);
-            goto LOG_EXIT;
+        if (peek_log_elem(NULL) != -1) {
+            log_emit(LEAST_LOG_EMIT_NUM);
+            continue;
         }
+        log_worker_wait(local_head);
     }
-    curr_tail = *tail_ptr;
     /* 读取剩余日志 */
-    ret = log_worker_last_read(local_head, curr_tail, is_overflow);
+    do {
+        ret = log_read(&local_head);
+    } while (ret > 0);
 LOG_EXIT:
     /* 输出剩余日志 */
     log_emit(0);
@@ -418,9 +508,9 @@ LOG_EXIT:
 }
 
 /**
- * 读取日志内容，日志有效标记，最好有cache（memcpy应该会有预取），读取日志有效标记后需要加读取屏障。
+ * 读取日志内容，最好有cache（memcpy应该会有预取），读取提交字后需要加读取屏障。
  * 
- * 读取tail，最好没有cache，有cache获取更新会不太及时，但是每次读取有效标记后已经会有读屏障了，tail的值足够新。
+ * 读取tail，最好没有cache，有cache获取更新会不太及时，但是每次读取提交字后已经会有读屏障了，tail的值足够新。
  * 
  * 写入head，最好没有cache，有cache更新会不太及时，使用MEMREMAP_WT write through，只要不读取head，写入时就不会写入cache也
  * 不会建立cache，所以不能读取head，并且和读取的内容不能在同一个cacheline里面。
@@ -446,17 +536,28 @@ static int log_worker_start(uint64_t phymem)
     // TODO head tail 初始化, 为测试U32翻转功能正常，后续应该删除
     head_ptr = (volatile uint32_t *)(g_ring_buffer + HEAD_PTR_OFFSET);
     tail_ptr = (volatile uint32_t *)(g_ring_buffer + TAIL_PTR_OFFSET);
-    *head_ptr = __UINT32_MAX__ - 2 * BUFFER_BLOCK_NUM + 1;
-    *tail_ptr = __UINT32_MAX__ - 2 * BUFFER_BLOCK_NUM + 1;
+    g_user_head = (uint32_t)(0 - 2 * LOG_RING_SIZE);
+    *head_ptr = g_user_head;
+    *tail_ptr = g_user_head;
+    *(volatile uint32_t *)(g_ring_buffer + LOG_WATERMARK_OFFSET) = g_log_watermark;
+    /* 格式表已清空, 更换纪元让UniProton侧重新登记格式串, 纪元不为0 */
+    *(volatile uint32_t *)(g_ring_buffer + LOG_FMT_EPOCH_OFFSET) = get_random_u32() | 1;
     printk(KERN_ERR "[logWorker] log worker ring start:%lx, ring end:%lx\n",
         (uintptr_t)g_ring_buffer, ((uintptr_t)g_ring_buffer + SHM_MAP_SIZE));
     STORE_FENCE();
     printk(KERN_INFO "[logWorker] head:%u tail:%u\n", *head_ptr, *tail_ptr);
 
-    // 初始化标记位，链表
-    g_flag_valid = 1;
+    g_ring_phymem = phymem;
+    atomic_set(&g_log_doorbell, 0);
+
+    // 初始化链表
     init_log_list();
 
+    /* mmap方式由用户态程序读取, 不拉起线程 */
+    if (g_emit_mode == LOG_EMIT_MMAP) {
+        return 0;
+    }
+
     // 拉起线程
     g_worker_thread = kthread_run(log_worker_thd, g_ring_buffer, "Uniproton_log_worker");
     if (IS_ERR(g_worker_thread)) {
@@ -464,6 +565,7 @@ static int log_worker_start(uint64_t phymem)
         g_worker_thread = NULL;
         memunmap(g_ring_buffer);
         g_ring_buffer = NULL;
+        g_ring_phymem = 0;
         return PTR_ERR(g_worker_thread);
     }
     return 0;
@@ -483,11 +585,65 @@ static void log_worker_stop(void)
         STORE_FENCE();
         memunmap(g_ring_buffer);
         g_ring_buffer = NULL;
+        g_ring_phymem = 0;
     } else {
         printk(KERN_INFO "[logWorker] g_ring_buffer is NULL\n");
     }
 }
 
+/* mmap方式下用户态读取完日志后归还空间, 新的head不能超过tail */
+static long log_set_head(unsigned long arg)
+{
+    uint32_t head, tail;
+
+    if (g_emit_mode != LOG_EMIT_MMAP || g_ring_buffer == NULL) {
+        return -ENODEV;
+    }
+    if (copy_from_user(&head, (uint32_t __user *)arg, sizeof(uint32_t))) {
+        return -EFAULT;
+    }
+    tail = *(volatile uint32_t *)(g_ring_buffer + TAIL_PTR_OFFSET);
+    if (head - g_user_head > tail - g_user_head) {
+        printk(KERN_ERR "[logWorker] invalid head:%u, curr head:%u, tail:%u\n", head, g_user_head, tail);
+        return -EINVAL;
+    }
+    g_user_head = head;
+    *(volatile uint32_t *)(g_ring_buffer + HEAD_PTR_OFFSET) = head;
+    STORE_FENCE();
+    return 0;
+}
+
+/* 只读映射整个共享内存, 包含环形缓冲区, head/tail和格式表 */
+static int log_mmap(struct file *f, struct vm_area_struct *vma)
+{
+    unsigned long size = vma->vm_end - vma->vm_start;
+
+    if (g_emit_mode != LOG_EMIT_MMAP || g_ring_phymem == 0) {
+        return -ENODEV;
+    }
+    if (vma->vm_pgoff != 0 || size > SHM_MAP_SIZE) {
+        return -EINVAL;
+    }
+    if ((vma->vm_flags & VM_WRITE) != 0) {
+        return -EPERM;
+    }
+    vma->vm_flags &= ~VM_MAYWRITE;
+    return remap_pfn_range(vma, vma->vm_start, g_ring_phymem >> PAGE_SHIFT, size, vma->vm_page_prot);
+}
+
+/* 达到水线或有紧急日志时可读, 没有门铃中断时需要用户态设置poll超时 */
+static __poll_t log_poll(struct file *f, poll_table *wait)
+{
+    if (g_emit_mode != LOG_EMIT_MMAP || g_ring_buffer == NULL) {
+        return EPOLLERR;
+    }
+    poll_wait(f, &g_log_wq, wait);
+    if (log_ready(g_user_head)) {
+        return EPOLLIN | EPOLLRDNORM;
+    }
+    return 0;
+}
+
 static long log_ioctl(struct file *f, unsigned int cmd, unsigned long arg) {
     int ret;
     uint64_t phymem = 0;
@@ -528,6 +684,8 @@ static long log_ioctl(struct file *f, unsigned int cmd, unsigned long arg) {
     } else if (cmd == IOC_STOP) {
         log_worker_stop();
         return 0;
+    } else if (cmd == IOC_SET_HEAD) {
+        return log_set_head(arg);
     } else {
         return -EINVAL;
     }
@@ -537,6 +695,8 @@ static long log_ioctl(struct file *f, unsigned int cmd, unsigned long arg) {
 static const struct file_operations log_worker_fops = {
     .unlocked_ioctl = log_ioctl,
     .compat_ioctl = compat_ptr_ioctl,
+    .mmap = log_mmap,
+    .poll = log_poll,
     .llseek = generic_file_llseek,
 };
 
@@ -591,19 +751,41 @@ static int __init log_worker_init(void)
         return ret;
     }
 
+    if (g_log_irq > 0) {
+        ret = request_irq(g_log_irq, log_doorbell_irq, 0, LOG_DEVICE_NAME, NULL);
+        if (ret) {
+            printk(KERN_ERR "[logWorker] request doorbell irq %d fail, ret:%d, poll log\n", g_log_irq, ret);
+            g_log_irq = 0;
+        }
+    }
+
     if (g_log_mem[0].phy_addr != 0) {
         ret = log_worker_start(g_log_mem[0].phy_addr);
         if (ret) {
-            return ret;
+            goto err_irq;
         }
     }
-    return register_log_dev();
+    ret = register_log_dev();
+    if (ret) {
+        log_worker_stop();
+        goto err_irq;
+    }
+    return 0;
+
+err_irq:
+    if (g_log_irq > 0) {
+        free_irq(g_log_irq, NULL);
+    }
+    return ret;
 }
 
 static void __exit log_worker_exit(void)
 {
     log_worker_stop();
     unregister_log_dev();
+    if (g_log_irq > 0) {
+        free_irq(g_log_irq, NULL);
+    }
 }
 
 module_init(log_worker_init);
@@ -7,41 +7,84 @@
 #define LOG_MEM_MAX         1
 #define LOG_DEVICE_NAME     "logW"
 
-#define BUFFER_BLOCK_NUM 0x4000
-#define BUFFER_BLOCK_SIZE 0x400 /* 1KB */
-// 未读日志数量超过该数值，进行一次读取
-#define BUFFER_COPY_THRESHOLD 0x200
+#define BUFFER_BLOCK_SIZE 0x400 /* 单条记录最大1KB, 含日志头 */
 
-// 剩余缓存块低于该数值，读取日志时不检查有效标记位
-#define BUFFER_NO_CHECK_COPY_THRESHOLD 0x400
+// 单次批量读取的最大字节数
+#define LOG_BATCH_MAX_SIZE 0x100000
+
+// 未读日志达到该字节数时UniProton侧敲门铃, 可通过模块参数watermark修改
+#define LOG_DEFAULT_WATERMARK 0x10000
+
+// 不低于该级别的日志不等待水线, 立即通知
+#define LOG_URGENT_LEVEL 3
+
+// 有门铃中断时空闲等待的超时时间, 没有门铃中断时按该间隔轮询
+#define LOG_IDLE_TIMEOUT HZ
+#define LOG_POLL_TIMEOUT (HZ / 100)
 
 // 空闲时一次性至少输出该数值的日志
 #define LEAST_LOG_EMIT_NUM 0x200
 
+// 日志输出方式, printk由内核线程输出, mmap由用户态程序映射共享内存自行读取
+#define LOG_EMIT_PRINTK 0
+#define LOG_EMIT_MMAP   1
+
 /*
-    TOTAL size = 0x4000 * 0x400 + 0x4000 + 0x100 * 2 = 0x1004200
+    TOTAL size = 0x1000000 + 0x100 * 3 = 0x1004300
     +=========
     |
     |
-    |   ring buffer size: BUFFER_BLOCK_NUM * BUFFER_BLOCK_SIZE = 16MB
+    |   ring buffer size: LOG_RING_SIZE = 16MB, 按字节分配的变长记录
     |
     |
     +--------
+    |   head (one cacheline 64 byte), @0x1004000
+    |   tail (one cacheline 64 byte), @0x1004100
+    +-----------
+    |   fmt epoch (one cacheline 64 byte), @0x1004200
+    |   fmt tail (one cacheline 64 byte)
+    |   doorbell wait (one cacheline 64 byte)
+    |   doorbell watermark (one cacheline 64 byte)
+    +-----------
     |
-    |   valid flag size: BUFFER_BLOCK_NUM * sizeof(U8) = 16 KB
+    |   fmt table size: LOG_FMT_TABLE_SIZE = 992 KB, @0x1008000
     |
-    +-----------
-    |   head (one cacheline 64 byte)
-    |   tail (one cacheline 64 byte)
     +=========
+
+    head和tail为自由增长的字节位置, 记录位于环中(pos & LOG_RING_MASK)处, 按8字节对齐且不跨越环尾。
+    记录头的commit等于记录起始位置异或LOG_COMMIT_MAGIC时记录已写完, 读者按size跳到下一条记录,
+    LOG_RECORD_PAD类型的记录只用于填充环尾, 没有内容。mmap方式下用户态程序按同样的规则读取,
+    处理完后通过IOC_SET_HEAD归还空间。
 */
 #define SHM_MAP_SIZE        0x1100000UL
-#define SHM_USED_SIZE       0x1004200UL // ~16MB
-#define VALID_FLAGS_OFFSET  0x1000000UL
-#define VALID_FLAGS_SIZE    0x4000UL
+#define SHM_USED_SIZE       0x1004300UL // ~16MB
 #define HEAD_PTR_OFFSET     0x1004000UL
 #define TAIL_PTR_OFFSET     0x1004100UL
 
+#define LOG_RING_SIZE       0x1000000U
+#define LOG_RING_MASK       (LOG_RING_SIZE - 1)
+#define LOG_RECORD_ALIGN    8U
+// 记录头中能单独读取的前8字节, 包含commit, size, type, level
+#define LOG_RECORD_PEEK_SIZE 8U
+
+// 二进制日志格式表, 启动时清空并更换纪元, UniProton侧发现纪元变化后重新登记格式串
+#define LOG_FMT_EPOCH_OFFSET    0x1004200UL
+#define LOG_FMT_TAIL_OFFSET     0x1004240UL
+#define LOG_FMT_TABLE_OFFSET    0x1008000UL
+#define LOG_FMT_TABLE_SIZE      0xF8000UL
+#define LOG_FMT_MAX_LEN         0x100
+
+// 门铃控制字, 睡眠前置位wait, UniProton侧达到水线或有紧急日志时清除wait并发送中断
+#define LOG_WAIT_OFFSET         0x1004280UL
+#define LOG_WATERMARK_OFFSET    0x10042C0UL
+
+#define LOG_COMMIT_MAGIC        0x4C4F4701U
+
+// 记录类型
+#define LOG_RECORD_TEXT         0U
+#define LOG_RECORD_BINARY       1U
+#define LOG_RECORD_PAD          2U
+
 // TODO 适配其他架构/用linux自带的...
 // armv8 memory fence
 #define STORE_FENCE() __asm__ __volatile__ ("dmb st" : : : "memory");
@@ -52,19 +95,31 @@
 #define MAGIC_NUMBER		'L'
 #define IOC_START		_IOW(MAGIC_NUMBER, 0, uint64_t)
 #define IOC_STOP		_IO(MAGIC_NUMBER, 1)
-#define IOC_MAXNR		1
+#define IOC_SET_HEAD		_IOW(MAGIC_NUMBER, 2, uint32_t)
+#define IOC_MAXNR		2
 
 struct log_header {
+    uint32_t commit;
+    uint16_t size;
+    uint8_t type;
+    uint8_t level;
     uint64_t sec;
     uint64_t nano_sec;
     uint64_t sequence_num;
     uint32_t task_pid;
     uint16_t len;
     uint8_t facility;
-    uint8_t level;
+    uint8_t reserved;
     uint8_t log_content[];
 };
 
+/* 二进制记录, 之后为arg_num个8字节参数, 字符串参数为8字节长度加内容并补齐到8字节 */
+struct log_bin_header {
+    uint32_t fmt_id;
+    uint8_t arg_num;
+    uint8_t reserved[3];
+};
+
 struct log_mem {
     uint64_t phy_addr;
     uint64_t size;
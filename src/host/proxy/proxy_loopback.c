@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-08-12
+ * Description: 代理回环测试，客户端为src/component/proxy的原始代码，服务端线程在同一进程内
+ *              按Linux侧代理服务的语义处理请求，用于验证共享内存大块读写并对比往返次数
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+
+#include <openamp/rpmsg.h>
+#include "prt_sem.h"
+#include "rpc_internal_model.h"
+#include "prt_proxy_ext.h"
+
+#define LOOPBACK_FILE_SIZE  (1024 * 1024)
+#define LOOPBACK_SHM_SIZE   (1024 * 1024)
+#define LOOPBACK_MAX_SEMS   256
+#define LOOPBACK_QUEUE_LEN  256
+
+ssize_t PRT_ProxyReadLoop(int fd, void *buf, size_t count);
+ssize_t PRT_ProxyWrite(int fd, const void *buf, size_t count);
+int PRT_ProxyOpen(const char *filename, int flags, ...);
+int PRT_ProxyClose(int fd);
+int rpmsg_client_cb(struct rpmsg_endpoint *ept, void *data, size_t len, uint32_t src, void *priv);
+void rpmsg_set_default_ept(struct rpmsg_endpoint *ept);
+
+struct LoopbackMsg {
+    size_t len;
+    unsigned char data[PROXY_MAX_BUF_LEN];
+};
+
+static struct rpmsg_endpoint g_ept;
+static struct LoopbackMsg g_queue[LOOPBACK_QUEUE_LEN];
+static unsigned int g_queueHead;
+static unsigned int g_queueTail;
+static pthread_mutex_t g_queueLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_queueCond = PTHREAD_COND_INITIALIZER;
+static unsigned long g_msgCount;
+
+/* 服务端视角的共享内存区，回环时物理地址就是进程内地址 */
+static unsigned char *g_shmBase;
+static unsigned long long g_shmSize;
+
+static sem_t g_sems[LOOPBACK_MAX_SEMS];
+static U32 g_semNum;
+
+U32 PRT_SemCreate(U32 count, SemHandle *semHandle)
+{
+    U32 idx = __atomic_fetch_add(&g_semNum, 1, __ATOMIC_RELAXED);
+
+    if (idx >= LOOPBACK_MAX_SEMS || sem_init(&g_sems[idx], 0, count) != 0) {
+        return 1;
+    }
+    *semHandle = idx;
+    return OS_OK;
+}
+
+U32 PRT_SemPend(SemHandle semHandle, U32 timeout)
+{
+    (void)timeout;
+    while (sem_wait(&g_sems[semHandle]) != 0) {
+    }
+    return OS_OK;
+}
+
+U32 PRT_SemPost(SemHandle semHandle)
+{
+    return (sem_post(&g_sems[semHandle]) == 0) ? OS_OK : 1;
+}
+
+int rpmsg_send(struct rpmsg_endpoint *ept, const void *data, int len)
+{
+    struct LoopbackMsg *msg = NULL;
+
+    (void)ept;
+    if (len <= 0 || (size_t)len > PROXY_MAX_BUF_LEN) {
+        return RPMSG_ERR_PARAM;
+    }
+
+    pthread_mutex_lock(&g_queueLock);
+    while (g_queueTail - g_queueHead == LOOPBACK_QUEUE_LEN) {
+        pthread_cond_wait(&g_queueCond, &g_queueLock);
+    }
+    msg = &g_queue[g_queueTail % LOOPBACK_QUEUE_LEN];
+    memcpy(msg->data, data, len);
+    msg->len = len;
+    g_queueTail++;
+    g_msgCount++;
+    pthread_cond_broadcast(&g_queueCond);
+    pthread_mutex_unlock(&g_queueLock);
+    return len;
+}
+
+static void *ShmResolve(unsigned long offset, uint32_t count)
+{
+    if (g_shmBase == NULL || offset > g_shmSize || count > g_shmSize - offset) {
+        return NULL;
+    }
+    return g_shmBase + offset;
+}
+
+/* 按Linux侧代理服务的语义处理一个请求，返回应答长度 */
+static size_t ServeOne(const unsigned char *data, unsigned char *resp)
+{
+    unsigned long funcId = *(const unsigned long *)data;
+    rpc_resp_base_t *base = (rpc_resp_base_t *)resp;
+    rpc_common_resp_t *common = (rpc_common_resp_t *)resp;
+    rpc_csret_resp_t *csret = (rpc_csret_resp_t *)resp;
+    void *addr = NULL;
+
+    base->trace_id = ((const rpc_fcommon_req_t *)data)->trace_id;
+    base->errnum = 0;
+    switch (funcId) {
+        case OPEN_ID: {
+            const rpc_open_req_t *req = (const rpc_open_req_t *)data;
+            common->ret = open(req->buf, req->flags, req->mode);
+            base->errnum = (common->ret < 0) ? errno : 0;
+            return sizeof(*common);
+        }
+        case CLOSE_ID: {
+            const rpc_close_req_t *req = (const rpc_close_req_t *)data;
+            common->ret = close(req->fd);
+            base->errnum = (common->ret < 0) ? errno : 0;
+            return sizeof(*common);
+        }
+        case READ_ID: {
+            const rpc_read_req_t *req = (const rpc_read_req_t *)data;
+            rpc_read_resp_t *r = (rpc_read_resp_t *)resp;
+            r->ret = read(req->fd, r->buf, (req->count < MAX_STRING_LEN) ? req->count : MAX_STRING_LEN);
+            base->errnum = (r->ret < 0) ? errno : 0;
+            return sizeof(*r);
+        }
+        case WRITE_ID: {
+            const rpc_write_req_t *req = (const rpc_write_req_t *)data;
+            csret->ret = write(req->fd, req->buf, req->count);
+            base->errnum = (csret->ret < 0) ? errno : 0;
+            return sizeof(*csret);
+        }
+        case BULKSHM_ID: {
+            const rpc_bulkshm_req_t *req = (const rpc_bulkshm_req_t *)data;
+            g_shmBase = (unsigned char *)(uintptr_t)req->phys_addr;
+            g_shmSize = req->size;
+            common->ret = 0;
+            return sizeof(*common);
+        }
+        case NCPYREAD_ID: {
+            const rpc_ncpyread_req_t *req = (const rpc_ncpyread_req_t *)data;
+            addr = ShmResolve(req->baddr_offset, req->count);
+            csret->ret = (addr == NULL) ? -1 : read(req->fd, addr, req->count);
+            base->errnum = (addr == NULL) ? EFAULT : ((csret->ret < 0) ? errno : 0);
+            return sizeof(*csret);
+        }
+        case NCPYWRITE_ID: {
+            const rpc_ncpywrite_req_t *req = (const rpc_ncpywrite_req_t *)data;
+            addr = ShmResolve(req->baddr_offset, req->count);
+            csret->ret = (addr == NULL) ? -1 : write(req->fd, addr, req->count);
+            base->errnum = (addr == NULL) ? EFAULT : ((csret->ret < 0) ? errno : 0);
+            return sizeof(*csret);
+        }
+        default:
+            common->ret = -1;
+            base->errnum = ENOSYS;
+            return sizeof(*common);
+    }
+}
+
+static void *ServerTask(void *arg)
+{
+    struct LoopbackMsg msg;
+    struct rpmsg_proxy_answer answer;
+    size_t len;
+
+    (void)arg;
+    while (1) {
+        pthread_mutex_lock(&g_queueLock);
+        while (g_queueHead == g_queueTail) {
+            pthread_cond_wait(&g_queueCond, &g_queueLock);
+        }
+        msg = g_queue[g_queueHead % LOOPBACK_QUEUE_LEN];
+        g_queueHead++;
+        pthread_cond_broadcast(&g_queueCond);
+        pthread_mutex_unlock(&g_queueLock);
+
+        answer.id = (uint32_t)*(unsigned long *)msg.data;
+        answer.status = 0;
+        len = ServeOne(msg.data, answer.params);
+        (void)rpmsg_client_cb(&g_ept, &answer, offsetof(struct rpmsg_proxy_answer, params) + len, 0, NULL);
+    }
+    return NULL;
+}
+
+static double NowUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int ReadCase(const char *path, const unsigned char *expect, const char *name)
+{
+    unsigned char *buf = malloc(LOOPBACK_FILE_SIZE);
+    unsigned long msgs = g_msgCount;
+    double start;
+    ssize_t ret;
+    int fd;
+
+    fd = PRT_ProxyOpen(path, O_RDONLY);
+    if (buf == NULL || fd < 0) {
+        printf("%s: open failed %d\n", name, errno);
+        free(buf);
+        return -1;
+    }
+
+    start = NowUs();
+    ret = PRT_ProxyReadLoop(fd, buf, LOOPBACK_FILE_SIZE);
+    printf("%-12s read  %7zd bytes %6lu msgs %9.1f us\n", name, ret, g_msgCount - msgs, NowUs() - start);
+    (void)PRT_ProxyClose(fd);
+
+    if (ret != LOOPBACK_FILE_SIZE || memcmp(buf, expect, LOOPBACK_FILE_SIZE) != 0) {
+        printf("%s: read data mismatch\n", name);
+        free(buf);
+        return -1;
+    }
+    free(buf);
+    return 0;
+}
+
+static int WriteCase(const char *path, const unsigned char *data, const char *name)
+{
+    unsigned char *check = malloc(LOOPBACK_FILE_SIZE);
+    unsigned long msgs = g_msgCount;
+    size_t done = 0;
+    double start;
+    ssize_t ret;
+    int fd;
+
+    fd = PRT_ProxyOpen(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (check == NULL || fd < 0) {
+        printf("%s: open failed %d\n", name, errno);
+        free(check);
+        return -1;
+    }
+
+    start = NowUs();
+    while (done < LOOPBACK_FILE_SIZE) {
+        ret = PRT_ProxyWrite(fd, data + done, LOOPBACK_FILE_SIZE - done);
+        if (ret <= 0) {
+            break;
+        }
+        done += (size_t)ret;
+    }
+    printf("%-12s write %7zu bytes %6lu msgs %9.1f us\n", name, done, g_msgCount - msgs, NowUs() - start);
+    (void)PRT_ProxyClose(fd);
+
+    fd = open(path, O_RDONLY);
+    ret = (fd < 0) ? -1 : read(fd, check, LOOPBACK_FILE_SIZE);
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (done != LOOPBACK_FILE_SIZE || ret != LOOPBACK_FILE_SIZE || memcmp(check, data, LOOPBACK_FILE_SIZE) != 0) {
+        printf("%s: write data mismatch\n", name);
+        free(check);
+        return -1;
+    }
+    free(check);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    char path[] = "/tmp/proxy_loopback_XXXXXX";
+    unsigned char *data = malloc(LOOPBACK_FILE_SIZE);
+    void *shm = malloc(LOOPBACK_SHM_SIZE);
+    pthread_t server;
+    int failed = 0;
+    int fd;
+
+    (void)argc;
+    (void)argv;
+    if (data == NULL || shm == NULL) {
+        return 1;
+    }
+    srand(1);
+    for (size_t i = 0; i < LOOPBACK_FILE_SIZE; i++) {
+        data[i] = (unsigned char)rand();
+    }
+
+    fd = mkstemp(path);
+    if (fd < 0 || write(fd, data, LOOPBACK_FILE_SIZE) != LOOPBACK_FILE_SIZE) {
+        return 1;
+    }
+    close(fd);
+
+    pthread_create(&server, NULL, ServerTask, NULL);
+    rpmsg_set_default_ept(&g_ept);
+
+    failed |= ReadCase(path, data, "inline");
+    failed |= WriteCase(path, data, "inline");
+
+    if (PRT_ProxyBulkInit(shm, (uintptr_t)shm, LOOPBACK_SHM_SIZE) != 0) {
+        printf("bulk init failed %d\n", errno);
+        failed = 1;
+    } else {
+        failed |= ReadCase(path, data, "bulk");
+        failed |= WriteCase(path, data, "bulk");
+    }
+
+    unlink(path);
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,7 @@
+/* 回环测试桩：musl在这里提供定长整数类型，宿主机改用stdint.h */
+#ifndef PROXY_STUB_BITS_ALLTYPES_H
+#define PROXY_STUB_BITS_ALLTYPES_H
+
+#include <stdint.h>
+
+#endif
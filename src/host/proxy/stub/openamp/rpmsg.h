@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-08-12
+ * Description: 回环测试桩，rpmsg_send直接投递给同进程内的服务端线程
+ */
+#ifndef PROXY_STUB_RPMSG_H
+#define PROXY_STUB_RPMSG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RPMSG_SUCCESS       0
+#define RPMSG_ERR_NO_MEM    (-2002)
+#define RPMSG_ERR_PARAM     (-2005)
+#define RPMSG_ERR_INIT      (-2007)
+#define RPMSG_ERR_ADDR      (-2008)
+
+struct rpmsg_endpoint {
+    int dummy;
+};
+
+int rpmsg_send(struct rpmsg_endpoint *ept, const void *data, int len);
+
+#endif /* PROXY_STUB_RPMSG_H */
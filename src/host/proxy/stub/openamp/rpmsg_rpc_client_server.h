@@ -0,0 +1,4 @@
+/* 回环测试桩，代理代码在本配置下不使用该头文件中的内容 */
+#ifndef PROXY_STUB_OPENAMP_RPMSG_RPC_CLIENT_SERVER_H
+#define PROXY_STUB_OPENAMP_RPMSG_RPC_CLIENT_SERVER_H
+#endif
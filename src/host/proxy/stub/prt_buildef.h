@@ -0,0 +1,4 @@
+/* 回环测试桩：不打开OS_OPTION_PROXY，避免代理接口以弱别名覆盖宿主机libc */
+#ifndef PROXY_STUB_PRT_BUILDEF_H
+#define PROXY_STUB_PRT_BUILDEF_H
+#endif
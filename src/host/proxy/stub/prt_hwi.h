@@ -0,0 +1,17 @@
+/* 回环测试桩：服务端运行在独立线程，关中断在宿主机上没有意义 */
+#ifndef PROXY_STUB_PRT_HWI_H
+#define PROXY_STUB_PRT_HWI_H
+
+#include <stdint.h>
+
+static inline uintptr_t PRT_HwiLock(void)
+{
+    return 0;
+}
+
+static inline void PRT_HwiRestore(uintptr_t intSave)
+{
+    (void)intSave;
+}
+
+#endif
@@ -0,0 +1,15 @@
+/* 回环测试桩：信号量映射到POSIX信号量 */
+#ifndef PROXY_STUB_PRT_SEM_H
+#define PROXY_STUB_PRT_SEM_H
+
+#include "prt_typedef.h"
+
+#define OS_WAIT_FOREVER 0xFFFFFFFFU
+
+typedef U32 SemHandle;
+
+U32 PRT_SemCreate(U32 count, SemHandle *semHandle);
+U32 PRT_SemPend(SemHandle semHandle, U32 timeout);
+U32 PRT_SemPost(SemHandle semHandle);
+
+#endif
@@ -0,0 +1,15 @@
+/* 回环测试桩 */
+#ifndef PROXY_STUB_PRT_TYPEDEF_H
+#define PROXY_STUB_PRT_TYPEDEF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint8_t U8;
+typedef uint16_t U16;
+typedef uint32_t U32;
+typedef uint64_t U64;
+
+#define OS_OK 0U
+
+#endif
@@ -0,0 +1,28 @@
+/* 回环测试桩：代理代码只用到memcpy_s/memset_s */
+#ifndef PROXY_STUB_SECUREC_H
+#define PROXY_STUB_SECUREC_H
+
+#include <errno.h>
+#include <string.h>
+
+#define EOK 0
+
+static inline int memcpy_s(void *dest, size_t destMax, const void *src, size_t count)
+{
+    if (dest == NULL || src == NULL || count > destMax) {
+        return EINVAL;
+    }
+    memcpy(dest, src, count);
+    return EOK;
+}
+
+static inline int memset_s(void *dest, size_t destMax, int c, size_t count)
+{
+    if (dest == NULL || count > destMax) {
+        return EINVAL;
+    }
+    memset(dest, c, count);
+    return EOK;
+}
+
+#endif
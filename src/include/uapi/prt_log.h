@@ -76,6 +76,40 @@ extern bool PRT_IsLogInit(void);
 
 extern void PRT_LogGetStatus(U8 *switchStat, U8 *levelStat);
 
+/* 日志门铃钩子，host等待日志且未读日志达到水线时调用，一般由平台实现为向host发送中断 */
+typedef void (*LogDoorbellFunc)(void);
+
+/* 注册日志门铃钩子，未注册时host按超时轮询 */
+extern void PRT_LogSetDoorbell(LogDoorbellFunc func);
+
+/* 二进制日志单条记录最多携带的参数个数 */
+#define OS_LOG_BIN_ARG_MAX 12
+
+/* 二进制日志调用点描述，由PRT_LOG_BIN为每个调用点静态定义，用户不应直接修改 */
+struct LogFmtDesc {
+    const char *fmt;
+    /* 格式串在共享内存格式表中的编号，0表示未登记 */
+    volatile U32 id;
+    /* 登记时的host纪元，host重启后重新登记 */
+    volatile U32 epoch;
+    /* 格式串解析状态 */
+    volatile U8 state;
+    U8 argNum;
+    U8 argType[OS_LOG_BIN_ARG_MAX];
+};
+
+/* 只记录格式串编号和参数原始值，由host侧日志读取模块完成格式化，接口通过PRT_LOG_BIN使用 */
+extern U32 PRT_LogBinary(enum OsLogLevel level, enum OsLogFacility facility, struct LogFmtDesc *desc, ...);
+
+/*
+ * 二进制日志，用法与PRT_LogFormat相同，fmt必须是字符串常量。
+ * %s参数按内容拷贝，不支持*宽度和%n，不支持的格式串自动按文本日志记录。
+ */
+#define PRT_LOG_BIN(level, facility, fmt, ...) ({                                    \
+    static struct LogFmtDesc logFmtDesc_ = {(fmt), 0, 0, 0, 0, {0}};                \
+    PRT_LogBinary((level), (facility), &logFmtDesc_, ##__VA_ARGS__);                \
+})
+
 #else
 
 #define PRT_Log(level, facility, str, strLen) 0
@@ -86,6 +120,8 @@ extern void PRT_LogGetStatus(U8 *switchStat, U8 *levelStat);
 #define PRT_LogSetFilter(level) 0
 #define PRT_LogSetFilterByFacility(facility, level) 0
 #define PRT_IsLogInit() true
+#define PRT_LogSetDoorbell(func)
+#define PRT_LOG_BIN(level, facility, fmt, ...) 0
 
 #endif
 
@@ -15,6 +15,7 @@
 #ifndef PRT_MEM_H
 #define PRT_MEM_H
 
+#include "prt_buildef.h"
 #include "prt_module.h"
 #include "prt_errno.h"
 
@@ -132,6 +133,78 @@ extern "C" {
  */
 #define OS_ERRNO_FSCMEM_ALLOC_NO_MEMORY OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x0c)
 
+/*
+ * 内存错误码：获取内存缓存统计信息时，核号或规格索引非法。
+ *
+ * 值: 0x0200010d
+ *
+ * 解决方案: 核号需小于最大核数，规格索引需小于#OS_MEM_CACHE_CLASS_NUM。
+ */
+#define OS_ERRNO_MEM_CACHE_PARA_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x0d)
+
+/*
+ * 内存错误码：获取内存缓存统计信息时，出参指针为空。
+ *
+ * 值: 0x0200010e
+ *
+ * 解决方案: 请检查出参指针的有效性。
+ */
+#define OS_ERRNO_MEM_CACHE_PTR_NULL OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x0e)
+
+/*
+ * 内存错误码：分区号非法，或指定分区尚未创建。
+ *
+ * 值: 0x0200010f
+ *
+ * 解决方案: 创建分区时分区号取值范围[#OS_MEM_DEFAULT_PTNUM,#OS_MEM_PT_NUM)，申请内存前需先创建分区。
+ */
+#define OS_ERRNO_MEM_PTNO_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x0f)
+
+/*
+ * 内存错误码：创建分区时，指定的分区号已被创建。
+ *
+ * 值: 0x02000110
+ *
+ * 解决方案: 更换分区号。
+ */
+#define OS_ERRNO_MEM_PT_ALREADY_CREATED OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x10)
+
+/*
+ * 内存错误码：创建分区时，分区内存与已创建的分区重叠。
+ *
+ * 值: 0x02000111
+ *
+ * 解决方案: 检查分区起始地址和大小。
+ */
+#define OS_ERRNO_MEM_PT_OVERLAP OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x11)
+
+/*
+ * 内存错误码：创建分区时，分区算法非法。
+ *
+ * 值: 0x02000112
+ *
+ * 解决方案: 分区算法取值需小于#MEM_ARITH_BUTT，且对应算法已编译使能。
+ */
+#define OS_ERRNO_MEM_ARITH_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x12)
+
+/*
+ * 内存错误码：获取分区信息时，出参指针为空。
+ *
+ * 值: 0x02000113
+ *
+ * 解决方案: 请检查出参指针的有效性。
+ */
+#define OS_ERRNO_MEM_PTINFO_PTR_NULL OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x13)
+
+/*
+ * 内存错误码：原地调整内存块大小时，后一相邻空闲块不足或该内存块不支持原地调整。
+ *
+ * 值: 0x02000114
+ *
+ * 解决方案: 重新申请内存并拷贝数据。
+ */
+#define OS_ERRNO_MEM_RESIZE_NO_SPACE OS_ERRNO_BUILD_ERROR(OS_MID_MEM, 0x14)
+
 /*
  * 系统缺省的内存分区数量。
  */
@@ -139,6 +212,11 @@ extern "C" {
 #define OS_MEM_DEFAULT_PT1 1
 #define OS_MEM_DEFAULT_PTNUM 2
 
+/*
+ * 内存分区号上限，分区号取值范围[0,#OS_MEM_PT_NUM)，用户分区号取值范围[#OS_MEM_DEFAULT_PTNUM,#OS_MEM_PT_NUM)。
+ */
+#define OS_MEM_PT_NUM 255
+
 /*
  * 缺省私有FSC内存分区。
  */
@@ -149,11 +227,29 @@ extern "C" {
  */
 #define OS_MEM_ADDR_ALIGN sizeof(uintptr_t)
 
+/*
+ * 每核内存缓存的规格个数，规格大小依次为16、32、64、128、256、512、1024、2048字节。
+ */
+#define OS_MEM_CACHE_CLASS_NUM 8
+
+/*
+ * 每核内存缓存单个规格的统计信息。
+ */
+struct MemCacheStat {
+    U32 blkSize;   /* 规格大小，单位字节 */
+    U32 cachedNum; /* 当前缓存的空闲块个数 */
+    U64 allocHit;  /* 申请时缓存命中次数 */
+    U64 allocMiss; /* 申请时缓存为空，需要从FSC批量补充的次数 */
+    U64 freeHit;   /* 释放时放入缓存的次数 */
+    U64 freeDrain; /* 释放时缓存已满，批量归还FSC的次数 */
+};
+
 /*
  * 内存算法类型。
  */
 enum MemArith {
     MEM_ARITH_FSC,          // 私有FSC算法
+    MEM_ARITH_TLSF,         // 两级分离适配TLSF算法，申请释放时间有界，需使能OS_OPTION_MEM_TLSF
     MEM_ARITH_BUTT          // 内存算法非法
 };
 
@@ -177,6 +273,48 @@ enum MemAlign {
     MEM_ADDR_BUTT /* 字节对齐非法 */
 };
 
+/*
+ * 内存分区信息。
+ */
+struct MemPtInfo {
+    enum MemArith arith;  /* 分区算法 */
+    uintptr_t startAddr;  /* 可分配区域起始地址 */
+    uintptr_t totalSize;  /* 可分配区域大小 */
+    uintptr_t usedSize;   /* 已使用大小 */
+    uintptr_t peakUsage;  /* 使用峰值 */
+};
+
+/*
+ * 内存统计的模块个数，下标为模块号，最后一项汇总模块号不小于#OS_MID_BUTT的申请。
+ */
+#define OS_MEM_STAT_MID_NUM (OS_MID_BUTT + 1)
+
+/*
+ * 空闲块大小直方图的区间个数，第i个区间统计大小在[2^i, 2^(i+1))字节的空闲块。
+ */
+#define OS_MEM_FRAG_CLASS_NUM 32
+
+/*
+ * 单个模块在分区中的内存使用统计，大小均包含块控制头。
+ */
+struct MemMidStat {
+    uintptr_t usedSize;  /* 当前占用大小 */
+    uintptr_t peakSize;  /* 占用峰值 */
+    U32 allocCnt;        /* 申请成功次数 */
+    U32 freeCnt;         /* 释放成功次数 */
+};
+
+/*
+ * 分区内存统计信息。
+ */
+struct MemStats {
+    struct MemMidStat mid[OS_MEM_STAT_MID_NUM]; /* 按模块号统计的使用情况 */
+    U32 freeBlkNum[OS_MEM_FRAG_CLASS_NUM];      /* 空闲块大小直方图 */
+    U32 freeBlkTotal;                           /* 空闲块总个数 */
+    uintptr_t freeSize;                         /* 空闲块总大小 */
+    uintptr_t maxFreeBlk;                       /* 最大空闲块大小 */
+};
+
 /*
  * @brief 向已创建的指定分区申请内存。
  *
@@ -191,7 +329,7 @@ enum MemAlign {
  * </ul>
  *
  * @param mid  [IN]  类型#U32，申请的模块号。
- * @param ptNo [IN]  类型#U8，分区号，范围[0,#OS_MEM_MAX_PT_NUM+2)。
+ * @param ptNo [IN]  类型#U8，分区号，范围[0,#OS_MEM_PT_NUM)。
  * @param size [IN]  类型#U32，申请的大小。
  *
  * @retval #NULL  0，申请失败。
@@ -215,7 +353,7 @@ extern void *PRT_MemAlloc(U32 mid, U8 ptNo, U32 size);
  * </ul>
  *
  * @param mid      [IN]  类型#U32，申请的模块号。
- * @param ptNo     [IN]  类型#U8，分区号，范围[0,#OS_MEM_MAX_PT_NUM+2)。
+ * @param ptNo     [IN]  类型#U8，分区号，范围[0,#OS_MEM_PT_NUM)。
  * @param size     [IN]  类型#U32，申请的大小。
  * @param alignPow [IN]  类型#enum MemAlign，动态对齐。
  *
@@ -250,6 +388,143 @@ extern void *PRT_MemAllocAlign(U32 mid, U8 ptNo, U32 size, enum MemAlign alignPo
  */
 extern U32 PRT_MemFree(U32 mid, void *addr);
 
+/*
+ * @brief 原地调整已申请内存块的大小。
+ *
+ * @par 描述
+ * 将addr指向的内存块调整为可容纳size字节，内存首地址不变。
+ * 缩小时将多余部分切分为空闲块归还分区；扩大时并入物理上紧随其后的空闲块。
+ * @attention
+ * <ul>
+ * <li>后一相邻内存块已被使用或空闲空间不足时返回失败，原内存块保持不变，调用者需自行重新申请并拷贝。</li>
+ * <li>每核小块缓存管理的内存块不支持原地调整。</li>
+ * </ul>
+ *
+ * @param mid  [IN]  类型#U32，模块号。
+ * @param addr [IN]  类型#void *，已申请的内存首地址。
+ * @param size [IN]  类型#U32，调整后的大小。
+ *
+ * @retval #OS_OK  0x00000000，调整成功。
+ * @retval #OS_ERRNO_MEM_RESIZE_NO_SPACE  0x02000114，无法原地调整。
+ * @retval #其它值，调整失败。
+ * @par 依赖
+ * <ul><li>prt_mem.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_MemAlloc | PRT_MemFree
+ */
+extern U32 PRT_MemResize(U32 mid, void *addr, U32 size);
+
+/*
+ * @brief 创建内存分区。
+ *
+ * @par 描述
+ * 在addr起始、大小为size的内存上创建分区号为ptNo的内存分区，之后可通过#PRT_MemAlloc向该分区申请内存。
+ * @attention
+ * <ul>
+ * <li>分区号0为系统缺省FSC分区，1为系统保留分区，用户分区号取值范围[#OS_MEM_DEFAULT_PTNUM,#OS_MEM_PT_NUM)。</li>
+ * <li>分区控制块从分区内存头部划分，可用大小略小于size。</li>
+ * <li>每个分区有独立的空闲链表和锁，不同分区的申请释放互不竞争。</li>
+ * <li>释放时根据内存地址自动找到所属分区，仍使用#PRT_MemFree。</li>
+ * <li>#MEM_ARITH_TLSF算法需使能OS_OPTION_MEM_TLSF，申请释放耗时与碎片程度无关，适用于硬实时场景。</li>
+ * </ul>
+ *
+ * @param ptNo  [IN]  类型#U8，分区号。
+ * @param arith [IN]  类型#enum MemArith，分区算法。
+ * @param addr  [IN]  类型#void *，分区起始地址。
+ * @param size  [IN]  类型#U32，分区大小。
+ *
+ * @retval #OS_OK  0x00000000，创建成功。
+ * @retval #其它值，创建失败。
+ * @par 依赖
+ * <ul><li>prt_mem.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_MemAlloc | PRT_MemPtGetInfo
+ */
+extern U32 PRT_MemPtCreate(U8 ptNo, enum MemArith arith, void *addr, U32 size);
+
+/*
+ * @brief 获取内存分区信息。
+ *
+ * @par 描述
+ * 获取分区号为ptNo的内存分区的起始地址、大小及使用情况。
+ * @attention 无
+ *
+ * @param ptNo   [IN]  类型#U8，分区号。
+ * @param ptInfo [OUT] 类型#struct MemPtInfo *，分区信息。
+ *
+ * @retval #OS_OK  0x00000000，获取成功。
+ * @retval #其它值，获取失败。
+ * @par 依赖
+ * <ul><li>prt_mem.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_MemPtCreate
+ */
+extern U32 PRT_MemPtGetInfo(U8 ptNo, struct MemPtInfo *ptInfo);
+
+/*
+ * @brief 获取内存分区的按模块统计及空闲块分布。
+ *
+ * @par 描述
+ * 获取分区ptNo中各模块号的占用大小、峰值、申请释放次数，以及空闲块大小直方图。
+ * @attention
+ * <ul>
+ * <li>按模块统计在申请释放时随分区用量一并更新，开销为常数。</li>
+ * <li>空闲块直方图需遍历分区全部空闲链表，遍历期间持有分区锁，不建议在实时路径上调用。</li>
+ * <li>每核小块缓存中的内存块统计在#OS_MID_MEM下，不区分实际使用的模块。</li>
+ * </ul>
+ *
+ * @param ptNo  [IN]  类型#U8，分区号。
+ * @param stats [OUT] 类型#struct MemStats *，统计信息。
+ *
+ * @retval #OS_OK  0x00000000，获取成功。
+ * @retval #其它值，获取失败。
+ * @par 依赖
+ * <ul><li>prt_mem.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_MemPtGetInfo
+ */
+extern U32 PRT_MemGetStats(U8 ptNo, struct MemStats *stats);
+
+#if defined(OS_OPTION_MEM_CACHE)
+/*
+ * @brief 获取每核内存缓存指定规格的统计信息。
+ *
+ * @par 描述
+ * 获取核coreId上规格索引为classIdx的内存缓存的命中、未命中及批量归还统计。
+ * @attention
+ * <ul>
+ * <li>仅在打开OS_OPTION_MEM_CACHE时提供。</li>
+ * <li>统计值在各核上无锁更新，读取的是近似快照。</li>
+ * </ul>
+ *
+ * @param coreId   [IN]  类型#U32，核号。
+ * @param classIdx [IN]  类型#U32，规格索引，范围[0,#OS_MEM_CACHE_CLASS_NUM)。
+ * @param stat     [OUT] 类型#struct MemCacheStat *，统计信息。
+ *
+ * @retval #OS_OK  0x00000000，获取成功。
+ * @retval #其它值，获取失败。
+ * @par 依赖
+ * <ul><li>prt_mem.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_MemCacheFlush
+ */
+extern U32 PRT_MemCacheGetStat(U32 coreId, U32 classIdx, struct MemCacheStat *stat);
+
+/*
+ * @brief 将本核内存缓存中的空闲块全部归还FSC分区。
+ *
+ * @par 描述
+ * 将当前核所有规格缓存的空闲内存块释放回FSC分区，便于大块内存申请或内存泄漏排查。
+ * @attention
+ * <ul>
+ * <li>仅在打开OS_OPTION_MEM_CACHE时提供。</li>
+ * </ul>
+ *
+ * @param 无。
+ *
+ * @retval 无。
+ * @par 依赖
+ * <ul><li>prt_mem.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_MemCacheGetStat
+ */
+extern void PRT_MemCacheFlush(void);
+#endif
+
 #ifdef __cplusplus
 #if __cplusplus
 }
@@ -132,6 +132,11 @@ typedef enum {
 // Perf sample data buffer's water mark 1/N
 #define PERF_BUFFER_WATERMARK_ONE_N         2
 
+// Perf drain task's priority, stack size and the max bytes passed to the drain hook at once
+#define PERF_DRAIN_TASK_PRIO                10
+#define PERF_DRAIN_TASK_STACK_SIZE          0x2000
+#define PERF_DRAIN_BUF_LEN                  0x1000
+
 enum PerfStatus {
     PERF_UNINIT,
     PERF_STARTED,
@@ -144,6 +149,9 @@ typedef void (*PERF_BUF_NOTIFY_HOOK)(void);
 // Define the type of the perf sample data buffer flush hook function
 typedef void (*PERF_BUF_FLUSH_HOOK)(void *addr, U32 size);
 
+// Define the type of the perf sample data drain hook function, called in the drain task
+typedef void (*PERF_BUF_DRAIN_HOOK)(const char *data, U32 size);
+
 /*
  * Perf error code: Bad status.
  *
@@ -216,6 +224,42 @@ typedef void (*PERF_BUF_FLUSH_HOOK)(void *addr, U32 size);
  */
 #define OS_ERRNO_PERF_CONFIG_NULL      OS_ERRNO_BUILD_ERROR(OS_MID_PERF, 0x07)
 
+/*
+ * Perf error code: Perf drain hook is null.
+ *
+ * Value: 0x02001708
+ *
+ * Solution: Check if the input params of drain hook is null.
+ */
+#define OS_ERRNO_PERF_DRAIN_HOOK_NULL       OS_ERRNO_BUILD_ERROR(OS_MID_PERF, 0x08)
+
+/*
+ * Perf error code: Perf drain task is already started.
+ *
+ * Value: 0x02001709
+ *
+ * Solution: Stop the drain task before starting it again.
+ */
+#define OS_ERRNO_PERF_DRAIN_STARTED         OS_ERRNO_BUILD_ERROR(OS_MID_PERF, 0x09)
+
+/*
+ * Perf error code: Perf export file can not be created or written.
+ *
+ * Value: 0x0200170a
+ *
+ * Solution: Check the export file path and the free space of the file system.
+ */
+#define OS_ERRNO_PERF_EXPORT_FILE_ERROR     OS_ERRNO_BUILD_ERROR(OS_MID_PERF, 0x0a)
+
+/*
+ * Perf error code: Perf export data is not read from the perf buffer.
+ *
+ * Value: 0x0200170b
+ *
+ * Solution: Pass the data read by PRT_PerfDataRead or the drain hook without modification.
+ */
+#define OS_ERRNO_PERF_EXPORT_DATA_INVALID   OS_ERRNO_BUILD_ERROR(OS_MID_PERF, 0x0b)
+
 typedef enum {
     PERF_EVENT_TYPE_HW,      // boards common hw events
     PERF_EVENT_TYPE_TIMED,   // hrtimer timed events
@@ -468,6 +512,113 @@ void PRT_PerfNotifyHookReg(const PERF_BUF_NOTIFY_HOOK func);
  */
 void PRT_PerfFlushHookReg(const PERF_BUF_FLUSH_HOOK func);
 
+/**
+ * @brief Start a task to drain perf sample data while sampling.
+ *
+ * @par Description
+ * <ul>
+ * <li> Create a drain task, which reads sample data of all cores and passes it to the drain hook.</li>
+ * <li> The task wakes up when a core buffer reaches the water mark or the interval expires.</li>
+ * </ul>
+ * @attention
+ * Perf must be inited. Samples are only written to the per core buffers, so the hook should stream the data
+ * out (to the host via shared memory or to a file) instead of holding it.
+ *
+ * @param  func                      [IN] Drain hook function.
+ * @param  interval                  [IN] Max ticks between two drains, OS_WAIT_FOREVER means only drain on water mark.
+ *
+ * @retval #OS_OK                              Drain task started.
+ * @retval #OS_ERRNO_PERF_STATUS_INVALID       Perf is not inited.
+ * @retval #OS_ERRNO_PERF_DRAIN_HOOK_NULL      Drain hook is null.
+ * @retval #OS_ERRNO_PERF_DRAIN_STARTED        Drain task is already started.
+ * @par Dependency:
+ * <ul>
+ * <li>prt_perf.h: the header file that contains the API declaration.</li>
+ * </ul>
+ */
+U32 PRT_PerfDrainStart(const PERF_BUF_DRAIN_HOOK func, U32 interval);
+
+/**
+ * @brief Stop the perf drain task.
+ *
+ * @par Description
+ * Drain the remaining sample data to the drain hook, then stop the drain task.
+ * @attention
+ * Must be called in task context.
+ *
+ * @retval None.
+ * @par Dependency:
+ * <ul>
+ * <li>prt_perf.h: the header file that contains the API declaration.</li>
+ * </ul>
+ */
+void PRT_PerfDrainStop(void);
+
+/**
+ * @brief Create a perf.data file to export sample data.
+ *
+ * @par Description
+ * <ul>
+ * <li> Create the file and write the mmap records of the OS image and the loaded dynamic modules.</li>
+ * <li> The file can be parsed by Linux perf report/script/annotate, use --vmlinux to specify the OS image ELF.</li>
+ * </ul>
+ * @attention
+ * Only one export file can be opened at the same time.
+ *
+ * @param  path                      [IN] Export file path.
+ *
+ * @retval #OS_OK                              Export file created.
+ * @retval #OS_ERRNO_PERF_STATUS_INVALID       Export file is already opened.
+ * @retval #OS_ERRNO_PERF_BUF_ERROR            Alloc memory failed.
+ * @retval #OS_ERRNO_PERF_EXPORT_FILE_ERROR    Path is null or the file can not be created.
+ * @par Dependency:
+ * <ul>
+ * <li>prt_perf.h: the header file that contains the API declaration.</li>
+ * </ul>
+ */
+U32 PRT_PerfExportOpen(const char *path);
+
+/**
+ * @brief Convert sample data to perf.data records.
+ *
+ * @par Description
+ * Convert the data read by PRT_PerfDataRead or passed to the drain hook, a task name record is written the first
+ * time a task appears in the samples.
+ * @attention
+ * Must be called in task context.
+ *
+ * @param  data                      [IN] Sample data.
+ * @param  len                       [IN] Sample data length.
+ *
+ * @retval #OS_OK                              Data converted.
+ * @retval #OS_ERRNO_PERF_STATUS_INVALID       Export file is not opened.
+ * @retval #OS_ERRNO_PERF_EXPORT_FILE_ERROR    Write file failed.
+ * @retval #OS_ERRNO_PERF_EXPORT_DATA_INVALID  Data is not read from the perf buffer.
+ * @par Dependency:
+ * <ul>
+ * <li>prt_perf.h: the header file that contains the API declaration.</li>
+ * </ul>
+ */
+U32 PRT_PerfExportWrite(const char *data, U32 len);
+
+/**
+ * @brief Finish and close the perf.data file.
+ *
+ * @par Description
+ * Write the event attributes and the file header, then close the file.
+ * @attention
+ * None.
+ *
+ * @retval #OS_OK                              Export file closed.
+ * @retval #OS_ERRNO_PERF_STATUS_INVALID       Export file is not opened.
+ * @retval #OS_ERRNO_PERF_EXPORT_FILE_ERROR    Write file failed.
+ * @par Dependency:
+ * <ul>
+ * <li>prt_perf.h: the header file that contains the API declaration.</li>
+ * </ul>
+ */
+U32 PRT_PerfExportClose(void);
+
 #ifdef __cplusplus
 #if __cplusplus
 }
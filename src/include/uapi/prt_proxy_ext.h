@@ -1,6 +1,7 @@
 #ifndef PRT_PROXY_EXT_H
 #define PRT_PROXY_EXT_H
 
+#include <sys/types.h>
 #include "prt_buildef.h"
 
 #ifdef OS_SUPPORT_LIBXML2
@@ -16,4 +17,30 @@ int PRT_ProxyPrintf(const char *format, ...);
 int PRT_ProxyGetDents64(int fd, char *buf, int len);
 
 int PRT_ProxyWriteStdOut(const char *buf, int len);
+
+/*
+ * 注册与Linux侧共享的大块数据区并协商映射，成功后超过MAX_STRING_LEN的read/write
+ * 经由该区域传递，rpmsg消息只携带块偏移。需要Linux侧代理服务支持BULKSHM请求，
+ * 协商失败时返回负值并保持原有的内联拷贝方式。
+ */
+int PRT_ProxyBulkInit(void *base, unsigned long long phys_addr, size_t size);
+
+/*
+ * 异步代理请求的完成回调，ret/errnum与对应同步接口的返回值和errno一致。
+ * 回调在rpmsg接收任务中执行，可以继续提交异步请求，但不能调用同步代理接口。
+ */
+typedef void (*PRT_ProxyAsyncCb)(ssize_t ret, int errnum, void *arg);
+
+/*
+ * 异步代理接口：请求发送后立即返回0，失败返回负值。
+ * 读类接口的buf在回调执行前必须保持有效；写类接口在返回前已拷贝数据。
+ * 单次长度上限与同步接口相同，同时在途的请求数受代理槽位数限制。
+ */
+int PRT_ProxyReadAsync(int fd, void *buf, size_t count, PRT_ProxyAsyncCb cb, void *arg);
+
+int PRT_ProxyWriteAsync(int fd, const void *buf, size_t count, PRT_ProxyAsyncCb cb, void *arg);
+
+int PRT_ProxyRecvAsync(int sockfd, void *buf, size_t len, int flags, PRT_ProxyAsyncCb cb, void *arg);
+
+int PRT_ProxySendAsync(int sockfd, const void *buf, size_t len, int flags, PRT_ProxyAsyncCb cb, void *arg);
 #endif /* PRT_PROXY_EXT_H */
@@ -15,6 +15,7 @@
 #ifndef PRT_QUEUE_H
 #define PRT_QUEUE_H
 
+#include "prt_buildef.h"
 #include "prt_module.h"
 #include "prt_errno.h"
 
@@ -195,6 +196,61 @@ extern "C" {
  */
 #define OS_ERRNO_QUEUE_NSIZE_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x13)
 
+/*
+ * 队列错误码：操作与队列模式不匹配。
+ *
+ * 值: 0x02000c14
+ *
+ * 解决方案: 零拷贝队列只能使用PRT_QueueLoan/PRT_QueueCommit/PRT_QueueAcquire/PRT_QueueRelease读写，
+ * 普通队列只能使用PRT_QueueRead/PRT_QueueWrite读写。
+ */
+#define OS_ERRNO_QUEUE_MODE_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x14)
+
+/*
+ * 队列错误码：零拷贝队列借出缓冲区时内存不足。
+ *
+ * 值: 0x02000c15
+ *
+ * 解决方案: 增大创建队列时指定的内存分区，或及时释放已读取的缓冲区。
+ */
+#define OS_ERRNO_QUEUE_LOAN_NO_MEMORY OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x15)
+
+/*
+ * 队列错误码：零拷贝缓冲区非法，不是从该队列借出，已被释放，或提交长度超过借出长度。
+ *
+ * 值: 0x02000c16
+ *
+ * 解决方案: 只提交和释放从同一队列借出的缓冲区，且每个缓冲区只释放一次。
+ */
+#define OS_ERRNO_QUEUE_LOAN_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x16)
+
+/*
+ * 队列错误码：单生产者单消费者队列的节点个数不是2的幂。
+ *
+ * 值: 0x02000c17
+ *
+ * 解决方案: 节点个数配置为2的幂。
+ */
+#define OS_ERRNO_QUEUE_SPSC_NUM_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x17)
+
+/*
+ * 队列错误码：批量读写队列时消息个数为0。
+ *
+ * 值: 0x02000c18
+ *
+ * 解决方案: 输入正确的入参。
+ */
+#define OS_ERRNO_QUEUE_BATCH_NUM_ZERO OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x18)
+
+/*
+ * 队列错误码：零拷贝缓冲区已提交到队列中，不能再次提交或归还。
+ *
+ * 值: 0x02000c19
+ *
+ * 解决方案: 每个借出的缓冲区只提交一次，提交后由读取者通过PRT_QueueAcquire取出并归还。
+ */
+#define OS_ERRNO_QUEUE_LOAN_COMMITTED OS_ERRNO_BUILD_ERROR(OS_MID_QUEUE, 0x19)
+
 /*
  * 队列优先级类型
  */
@@ -296,6 +352,70 @@ extern U32 PRT_QueueRead(U32 queueId, void *bufferAddr, U32 *len, U32 timeOut);
  */
 extern U32 PRT_QueueWrite(U32 queueId, void *bufferAddr, U32 bufferSize, U32 timeOut, U32 prio);
 
+/*
+ * @brief 批量读队列。
+ *
+ * @par 描述
+ * 一次持锁读取指定队列中最多maxNum个消息，第i个消息存入bufferAddr + i * msgSize地址，
+ * 读取结束后统一唤醒阻塞在写队列上的任务，只触发一次调度。
+ * @attention
+ * <ul>
+ * <li>队列为空时按timeOut阻塞等待，有一个消息可读即返回，不等待凑满maxNum个消息。</li>
+ * <li>消息大于msgSize时只读取msgSize大小的数据。</li>
+ * <li>bufferAddr的大小不能小于maxNum * msgSize，单位是BYTE。</li>
+ * <li>阻塞模式不能在idle钩子使用，需用户保证。</li>
+ * <li>在osStart之前不能调用该接口，需用户保证。</li>
+ * </ul>
+ * @param queueId    [IN]  类型#U32，队列ID。
+ * @param bufferAddr [OUT] 类型#void *，存放读取消息的起始地址。
+ * @param msgSize    [IN]  类型#U32，每个消息在bufferAddr中占用的大小。
+ * @param lens       [OUT] 类型#U32 *，输出每个消息的实际大小，为NULL时不输出。
+ * @param maxNum     [IN]  类型#U32，最多读取的消息个数。
+ * @param num        [OUT] 类型#U32 *，实际读取的消息个数。
+ * @param timeOut    [IN]  类型#U32，超时时间。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ *
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueRead | PRT_QueueWriteBatch
+ */
+extern U32 PRT_QueueReadBatch(U32 queueId, void *bufferAddr, U32 msgSize, U32 *lens, U32 maxNum, U32 *num,
+                              U32 timeOut);
+
+/*
+ * @brief 批量写队列。
+ *
+ * @par 描述
+ * 一次持锁向指定队列写入最多msgNum个大小为msgSize的消息，第i个消息位于bufferAddr + i * msgSize地址，
+ * 写入结束后统一唤醒阻塞在读队列上的任务，只触发一次调度。
+ * @attention
+ * <ul>
+ * <li>队列满时按timeOut阻塞等待，有一个空闲节点即写入，空闲节点不足时只写入部分消息，由num返回写入个数。</li>
+ * <li>紧急消息整体加到队列头上，批内消息保持原有先后顺序。</li>
+ * <li>需保证msgSize大小小于或等于队列结点大小，单位是BYTE。</li>
+ * <li>阻塞模式不能在idle钩子使用，需用户保证。</li>
+ * <li>在osStart之前不能调用该接口，需用户保证。</li>
+ * </ul>
+ * @param queueId    [IN]  类型#U32，队列ID。
+ * @param bufferAddr [IN]  类型#void *，待写入消息的起始地址。
+ * @param msgSize    [IN]  类型#U32，每个消息的大小。
+ * @param msgNum     [IN]  类型#U32，待写入的消息个数。
+ * @param num        [OUT] 类型#U32 *，实际写入的消息个数。
+ * @param timeOut    [IN]  类型#U32，超时时间。
+ * @param prio       [IN]  类型#U32，优先级, 取值OS_QUEUE_NORMAL或OS_QUEUE_URGENT。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ *
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueWrite | PRT_QueueReadBatch
+ */
+extern U32 PRT_QueueWriteBatch(U32 queueId, void *bufferAddr, U32 msgSize, U32 msgNum, U32 *num, U32 timeOut,
+                               U32 prio);
+
 /*
  * @brief 删除队列。
  *
@@ -361,6 +481,211 @@ extern U32 PRT_QueueGetUsedPeak(U32 queueId, U32 *queueUsedNum);
  */
 extern U32 PRT_QueueGetNodeNum(U32 queueId, U32 taskPid, U32 *queueNum);
 
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+/*
+ * @brief 创建零拷贝队列。
+ *
+ * @par 描述
+ * 创建一个只传递缓冲区引用的队列，消息缓冲区按消息实际大小从指定内存分区借出，
+ * 读写队列时只在队列锁内移动指针，关中断时间与消息大小无关。
+ * @attention
+ * <ul>
+ * <li>零拷贝队列只能使用PRT_QueueLoan/PRT_QueueCommit/PRT_QueueAcquire/PRT_QueueRelease读写。</li>
+ * <li>删除队列时，队列中未被读取的缓冲区一并释放。</li>
+ * </ul>
+ * @param nodeNum [IN]  类型#U16，队列节点个数，即同时在队列中的最大消息数，不能为0。
+ * @param ptNo    [IN]  类型#U8，借出缓冲区使用的内存分区号。
+ * @param queueId [OUT] 类型#U32 *，存储队列ID，ID从1开始。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueLoan | PRT_QueueDelete
+ */
+extern U32 PRT_QueueCreateZeroCopy(U16 nodeNum, U8 ptNo, U32 *queueId);
+
+/*
+ * @brief 从零拷贝队列借出消息缓冲区。
+ *
+ * @par 描述
+ * 从队列创建时指定的内存分区申请size字节的消息缓冲区，由调用者填写消息后通过PRT_QueueCommit提交。
+ * @attention
+ * <ul>
+ * <li>缓冲区申请不持有队列锁，可在中断中调用。</li>
+ * <li>提交失败的缓冲区仍归调用者所有，需要调用PRT_QueueRelease释放。</li>
+ * </ul>
+ * @param queueId    [IN]  类型#U32，队列ID。
+ * @param size       [IN]  类型#U32，消息缓冲区大小，不能为0。
+ * @param bufferAddr [OUT] 类型#void **，借出的消息缓冲区地址。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueCommit | PRT_QueueRelease
+ */
+extern U32 PRT_QueueLoan(U32 queueId, U32 size, void **bufferAddr);
+
+/*
+ * @brief 向零拷贝队列提交消息。
+ *
+ * @par 描述
+ * 把借出的消息缓冲区挂入队列，缓冲区所有权随之转移给读取者。
+ * @attention
+ * <ul>
+ * <li>size不能超过借出时的大小。</li>
+ * <li>提交成功的缓冲区不能再次提交，返回#OS_ERRNO_QUEUE_LOAN_COMMITTED。</li>
+ * <li>阻塞语义与PRT_QueueWrite相同，阻塞等待的是空闲队列节点。</li>
+ * </ul>
+ * @param queueId    [IN]  类型#U32，队列ID。
+ * @param bufferAddr [IN]  类型#void *，PRT_QueueLoan借出的消息缓冲区。
+ * @param size       [IN]  类型#U32，消息的实际大小。
+ * @param timeOut    [IN]  类型#U32，超时时间。
+ * @param prio       [IN]  类型#U32，优先级, 取值OS_QUEUE_NORMAL或OS_QUEUE_URGENT。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueLoan | PRT_QueueAcquire
+ */
+extern U32 PRT_QueueCommit(U32 queueId, void *bufferAddr, U32 size, U32 timeOut, U32 prio);
+
+/*
+ * @brief 从零拷贝队列读取消息。
+ *
+ * @par 描述
+ * 取出队列中最早的消息，返回消息缓冲区地址和大小，缓冲区所有权转移给调用者。
+ * @attention
+ * <ul>
+ * <li>消息处理完后需要调用PRT_QueueRelease归还缓冲区。</li>
+ * <li>阻塞语义与PRT_QueueRead相同。</li>
+ * </ul>
+ * @param queueId    [IN]  类型#U32，队列ID。
+ * @param bufferAddr [OUT] 类型#void **，消息缓冲区地址。
+ * @param len        [OUT] 类型#U32 *，消息大小。
+ * @param timeOut    [IN]  类型#U32，超时时间。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueRelease
+ */
+extern U32 PRT_QueueAcquire(U32 queueId, void **bufferAddr, U32 *len, U32 timeOut);
+
+/*
+ * @brief 归还零拷贝队列的消息缓冲区。
+ *
+ * @par 描述
+ * 释放PRT_QueueAcquire读取到的缓冲区，或PRT_QueueLoan借出后未提交的缓冲区。
+ * 已提交、尚未被读取的缓冲区不能归还，返回#OS_ERRNO_QUEUE_LOAN_COMMITTED。
+ * @param queueId    [IN]  类型#U32，队列ID。
+ * @param bufferAddr [IN]  类型#void *，消息缓冲区地址。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueLoan | PRT_QueueAcquire
+ */
+extern U32 PRT_QueueRelease(U32 queueId, void *bufferAddr);
+#endif
+
+#if defined(OS_OPTION_QUEUE_SPSC)
+/*
+ * 单生产者单消费者队列句柄。
+ */
+typedef uintptr_t SpscQueHandle;
+
+/*
+ * @brief 创建单生产者单消费者队列。
+ *
+ * @par 描述
+ * 创建一个无锁环形队列，用于一个生产者(通常为中断处理函数)向一个消费者任务传递定长数据。
+ * @attention
+ * <ul>
+ * <li>节点个数必须为2的幂。</li>
+ * <li>同一时刻只能有一个生产者和一个消费者，中断生产者需绑定到单个核。</li>
+ * </ul>
+ * @param entryNum  [IN]  类型#U32，队列节点个数。
+ * @param entrySize [IN]  类型#U32，每个节点的大小，单位BYTE。
+ * @param handle    [OUT] 类型#SpscQueHandle *，队列句柄。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueSpscDelete
+ */
+extern U32 PRT_QueueSpscCreate(U32 entryNum, U32 entrySize, SpscQueHandle *handle);
+
+/*
+ * @brief 删除单生产者单消费者队列。
+ *
+ * @par 描述
+ * 删除队列并释放队列内存，队列中未读取的数据被丢弃。
+ * @attention
+ * <ul>
+ * <li>需保证删除时生产者和消费者都不再访问该队列。</li>
+ * </ul>
+ * @param handle [IN]  类型#SpscQueHandle，队列句柄。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueSpscCreate
+ */
+extern U32 PRT_QueueSpscDelete(SpscQueHandle handle);
+
+/*
+ * @brief 向单生产者单消费者队列写入一个节点。
+ *
+ * @par 描述
+ * 无锁、无等待写入，可在中断中调用。只有消费者已阻塞等待时才唤醒消费者。
+ * @attention
+ * <ul>
+ * <li>队列满时直接返回#OS_ERRNO_QUEUE_NO_SOURCE，不阻塞。</li>
+ * </ul>
+ * @param handle [IN]  类型#SpscQueHandle，队列句柄。
+ * @param entry  [IN]  类型#const void *，待写入数据，长度为创建时的节点大小。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueSpscGet
+ */
+extern U32 PRT_QueueSpscPut(SpscQueHandle handle, const void *entry);
+
+/*
+ * @brief 从单生产者单消费者队列批量读取节点。
+ *
+ * @par 描述
+ * 一次读取最多maxNum个节点到buf中，实际读取个数通过num返回。队列为空时按timeOut阻塞等待。
+ * @attention
+ * <ul>
+ * <li>buf长度不小于maxNum * 节点大小。</li>
+ * <li>非空时不加锁、不进入调度；只有队列为空需要阻塞时才使用内部信号量。</li>
+ * <li>timeOut为单次阻塞的超时时间，被唤醒后队列仍为空时重新等待。</li>
+ * </ul>
+ * @param handle  [IN]  类型#SpscQueHandle，队列句柄。
+ * @param buf     [OUT] 类型#void *，读取数据存放地址。
+ * @param maxNum  [IN]  类型#U32，最多读取的节点个数。
+ * @param num     [OUT] 类型#U32 *，实际读取的节点个数。
+ * @param timeOut [IN]  类型#U32，超时时间。
+ *
+ * @retval #OS_OK  0x00000000，操作成功。
+ * @retval #其它值，操作失败。
+ * @par 依赖
+ * @li prt_queue.h：该接口声明所在的头文件。
+ * @see PRT_QueueSpscPut
+ */
+extern U32 PRT_QueueSpscGet(SpscQueHandle handle, void *buf, U32 maxNum, U32 *num, U32 timeOut);
+#endif
+
 #ifdef __cplusplus
 #if __cplusplus
 }
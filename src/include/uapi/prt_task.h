@@ -919,6 +919,42 @@ extern "C" {
  */
 #define OS_ERRNO_TSK_HAVE_MUTEX_SEM OS_ERRNO_BUILD_ERROR(OS_MID_TSK, 0x28)
 
+/*
+ * 任务错误码：设置截止期调度参数时参数非法
+ *
+ * 值: 0x02000329
+ *
+ * 解决方案: 参数需满足0 < runtime <= deadline <= period，period不超过10秒
+ */
+#define OS_ERRNO_TSK_DEADLINE_PARAM_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_TSK, 0x29)
+
+/*
+ * 任务错误码：设置截止期调度参数时任务未绑定到单个核
+ *
+ * 值: 0x0200032a
+ *
+ * 解决方案: 截止期任务按核独立调度，设置参数前先通过PRT_TaskCoreBind将任务绑定到一个核
+ */
+#define OS_ERRNO_TSK_DEADLINE_NOT_BOUND OS_ERRNO_BUILD_ERROR(OS_MID_TSK, 0x2a)
+
+/*
+ * 任务错误码：设置截止期调度参数时所在核的带宽不足
+ *
+ * 值: 0x0200032b
+ *
+ * 解决方案: 减小任务的runtime或增大period，或将任务绑定到其他核
+ */
+#define OS_ERRNO_TSK_DEADLINE_BW_EXCEEDED OS_ERRNO_BUILD_ERROR(OS_MID_TSK, 0x2b)
+
+/*
+ * 任务错误码：对截止期任务进行绑核操作
+ *
+ * 值: 0x0200032c
+ *
+ * 解决方案: 先将任务恢复为固定优先级任务，绑核后再设置截止期调度参数
+ */
+#define OS_ERRNO_TSK_DEADLINE_BIND OS_ERRNO_BUILD_ERROR(OS_MID_TSK, 0x2c)
+
 
 // #if defined(OS_OPTION_SMP)
 
@@ -1129,6 +1165,20 @@ struct TskInitParam {
     U16 policy;
 };
 
+/*
+ * 任务截止期调度参数的结构体定义，单位us。
+ *
+ * runtime为0表示固定优先级任务。
+ */
+struct TskDeadlineParam {
+    /* 每个周期内可运行的时间预算 */
+    U32 runtime;
+    /* 相对截止期，从周期开始计算 */
+    U32 deadline;
+    /* 周期 */
+    U32 period;
+};
+
 /*
  * @brief 创建任务，但不激活任务。
  *
@@ -1610,6 +1660,53 @@ extern void PRT_TaskLockNoIntLock(void);
 extern U32 PRT_TaskCoreBind(TskHandle taskPid, U32 coreMask);
 #endif
 
+#if defined(OS_OPTION_SCHED_EDF)
+/*
+ * @brief 设置任务的截止期调度参数。
+ *
+ * @par 描述
+ * 将任务设置为截止期任务，任务每个周期可运行runtime时间，需在deadline内完成。
+ * 截止期任务按绝对截止期最早优先调度，先于同核的固定优先级任务运行；预算用完后任务被限流到下一周期。
+ *
+ * @attention
+ * <ul>
+ * <li>任务必须已绑定到单个核，截止期任务不支持核间迁移，设置后不能再绑核。</li>
+ * <li>每个核截止期任务的带宽(runtime/period)总和不超过95%，超出时返回#OS_ERRNO_TSK_DEADLINE_BW_EXCEEDED。</li>
+ * <li>runtime为0时将任务恢复为固定优先级任务并释放其带宽。</li>
+ * <li>预算在tick中断中检查，超支最多一个tick，超支部分从下一周期扣除。</li>
+ * </ul>
+ *
+ * @param taskPid [IN]  类型#TskHandle，任务PID。
+ * @param param   [IN]  类型#struct TskDeadlineParam *，截止期调度参数。
+ *
+ * @retval #OS_OK  0x00000000，设置成功。
+ * @retval #其它值，设置失败。
+ * @par 依赖
+ * <ul><li>prt_task.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_TaskGetDeadline
+ */
+extern U32 PRT_TaskSetDeadline(TskHandle taskPid, struct TskDeadlineParam *param);
+
+/*
+ * @brief 获取任务的截止期调度参数。
+ *
+ * @par 描述
+ * 获取任务的截止期调度参数，固定优先级任务的参数全部为0。
+ *
+ * @attention  无
+ *
+ * @param taskPid [IN]  类型#TskHandle，任务PID。
+ * @param param   [OUT] 类型#struct TskDeadlineParam *，截止期调度参数。
+ *
+ * @retval #OS_OK  0x00000000，获取成功。
+ * @retval #其它值，获取失败。
+ * @par 依赖
+ * <ul><li>prt_task.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_TaskSetDeadline
+ */
+extern U32 PRT_TaskGetDeadline(TskHandle taskPid, struct TskDeadlineParam *param);
+#endif
+
 #if defined(OS_OPTION_POSIX_SIGNAL)
 /*
  * @brief 设置任务的周期性执行
@@ -15,6 +15,7 @@
 #ifndef PRT_TIMER_H
 #define PRT_TIMER_H
 
+#include "prt_buildef.h"
 #include "prt_module.h"
 #include "prt_errno.h"
 
@@ -205,6 +206,87 @@ enum TimerFlag {
  */
 #define OS_ERRNO_SWTMR_RET_PTR_NULL OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x13)
 
+/*
+ * 高精度定时器错误码：高精度定时器未初始化。
+ *
+ * 值: 0x02000d14
+ *
+ * 解决方案: 先调用PRT_HrtimerInit注册硬件定时器接口。
+ */
+#define OS_ERRNO_HRTIMER_NOT_INIT OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x14)
+
+/*
+ * 高精度定时器错误码：高精度定时器重复初始化。
+ *
+ * 值: 0x02000d15
+ *
+ * 解决方案: PRT_HrtimerInit只能调用一次。
+ */
+#define OS_ERRNO_HRTIMER_INIT_REPEATED OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x15)
+
+/*
+ * 高精度定时器错误码：初始化参数非法。
+ *
+ * 值: 0x02000d16
+ *
+ * 解决方案: 硬件接口不能为空，最大定时器个数不能为0。
+ */
+#define OS_ERRNO_HRTIMER_PARA_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x16)
+
+/*
+ * 高精度定时器错误码：申请控制块内存失败。
+ *
+ * 值: 0x02000d17
+ *
+ * 解决方案: 减少最大定时器个数或增大内存分区。
+ */
+#define OS_ERRNO_HRTIMER_NO_MEMORY OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x17)
+
+/*
+ * 高精度定时器错误码：没有空闲的定时器。
+ *
+ * 值: 0x02000d18
+ *
+ * 解决方案: 删除不用的定时器或增大最大定时器个数。
+ */
+#define OS_ERRNO_HRTIMER_MAXSIZE OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x18)
+
+/*
+ * 高精度定时器错误码：定时器句柄非法或定时器未创建。
+ *
+ * 值: 0x02000d19
+ *
+ * 解决方案: 使用PRT_HrtimerCreate返回的句柄。
+ */
+#define OS_ERRNO_HRTIMER_HANDLE_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x19)
+
+/*
+ * 高精度定时器错误码：定时模式非法。
+ *
+ * 值: 0x02000d1a
+ *
+ * 解决方案: 定时模式只能为OS_HRTIMER_REL或OS_HRTIMER_ABS。
+ */
+#define OS_ERRNO_HRTIMER_MODE_INVALID OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x1a)
+
+/*
+ * 高精度定时器错误码：在中断中或锁任务调度时进行高精度睡眠。
+ *
+ * 值: 0x02000d1b
+ *
+ * 解决方案: 只在任务中、未锁任务调度时调用PRT_HrtimerSleep。
+ */
+#define OS_ERRNO_HRTIMER_SLEEP_NOT_ALLOWED OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x1b)
+
+/*
+ * 高精度定时器错误码：删除定时器时其回调正在其他核上执行。
+ *
+ * 值: 0x02000d1c
+ *
+ * 解决方案: 等待回调执行完成后重新删除。
+ */
+#define OS_ERRNO_HRTIMER_BUSY OS_ERRNO_BUILD_ERROR(OS_MID_TIMER, 0x1c)
+
 /*
  * 定时器句柄定义
  */
@@ -511,6 +593,199 @@ extern U32 PRT_SwTmrInfoGet(TimerHandle tmrHandle, struct SwTmrInfo *info);
  */
 extern U32 PRT_TimerGetOverrun(U32 mid, TimerHandle tmrHandle, U32 *overrun);
 
+#if defined(OS_OPTION_HRTIMER)
+/* 高精度定时器超时时间为相对当前时刻的ns数 */
+#define OS_HRTIMER_REL 0U
+/* 高精度定时器超时时间为绝对时刻的ns数，与CLOCK_MONOTONIC为同一时基 */
+#define OS_HRTIMER_ABS 1U
+
+/* 高精度定时器不需要中断时传给硬件接口的cycle值 */
+#define OS_HRTIMER_EVENT_NONE ((U64)-1)
+
+/*
+ * 高精度定时器句柄定义
+ */
+typedef U32 HrtimerHandle;
+
+/*
+ * 高精度定时器回调函数类型定义，在定时器所在核的中断上下文中执行
+ */
+typedef void (*HrtimerProcFunc)(HrtimerHandle handle, uintptr_t arg);
+
+/*
+ * 设置本核硬件定时器下一次中断的函数类型定义。
+ * cycle为PRT_ClkGetCycleCount64时基下的绝对值，为OS_HRTIMER_EVENT_NONE时关闭中断。
+ */
+typedef void (*HrtimerSetEventFunc)(U64 cycle);
+
+/*
+ * 高精度定时器初始化参数
+ */
+struct HrtimerInitPara {
+    /* 设置本核硬件定时器比较值的接口，由BSP提供 */
+    HrtimerSetEventFunc setNextEvent;
+    /* 可创建的最大定时器个数，不包括任务睡眠使用的定时器 */
+    U32 maxNum;
+};
+
+/*
+ * @brief 初始化高精度定时器。
+ *
+ * @par 描述
+ * 注册每核私有硬件定时器的编程接口，并申请定时器控制块。
+ *
+ * @attention
+ * <ul>
+ * <li>高精度定时器与tick无关，硬件定时器不能与tick中断共用同一个比较器。</li>
+ * <li>硬件定时器中断处理函数中需要调用#PRT_HrtimerISR。</li>
+ * </ul>
+ *
+ * @param para [IN]  类型#struct HrtimerInitPara *，初始化参数。
+ *
+ * @retval #OS_OK  0x00000000，初始化成功。
+ * @retval #其他值  初始化失败。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_HrtimerISR
+ */
+extern U32 PRT_HrtimerInit(struct HrtimerInitPara *para);
+
+/*
+ * @brief 高精度定时器中断处理函数。
+ *
+ * @par 描述
+ * 处理本核已到期的高精度定时器，并按最近的到期时间重新设置硬件定时器。
+ *
+ * @attention
+ * <ul>
+ * <li>由BSP在每个核的高精度硬件定时器中断中调用。</li>
+ * </ul>
+ *
+ * @param 无。
+ *
+ * @retval 无
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_HrtimerInit
+ */
+extern void PRT_HrtimerISR(void);
+
+/*
+ * @brief 创建高精度单次定时器。
+ *
+ * @par 描述
+ * 创建一个高精度单次定时器，创建后处于停止状态。
+ *
+ * @attention 无
+ *
+ * @param func   [IN]  类型#HrtimerProcFunc，定时器回调函数。
+ * @param arg    [IN]  类型#uintptr_t，回调函数参数。
+ * @param handle [OUT] 类型#HrtimerHandle *，定时器句柄。
+ *
+ * @retval #OS_OK  0x00000000，创建成功。
+ * @retval #其他值  创建失败。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_HrtimerDelete
+ */
+extern U32 PRT_HrtimerCreate(HrtimerProcFunc func, uintptr_t arg, HrtimerHandle *handle);
+
+/*
+ * @brief 删除高精度定时器。
+ *
+ * @par 描述
+ * 停止并删除高精度定时器。
+ *
+ * @attention
+ * <ul>
+ * <li>回调正在其他核上执行时返回#OS_ERRNO_HRTIMER_BUSY，定时器不会被删除，需等回调返回后重新删除。</li>
+ * <li>允许在定时器自身的回调中删除该定时器。</li>
+ * </ul>
+ *
+ * @param handle [IN]  类型#HrtimerHandle，定时器句柄。
+ *
+ * @retval #OS_OK  0x00000000，删除成功。
+ * @retval #其他值  删除失败。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_HrtimerCreate
+ */
+extern U32 PRT_HrtimerDelete(HrtimerHandle handle);
+
+/*
+ * @brief 启动高精度单次定时器。
+ *
+ * @par 描述
+ * 在当前核上启动定时器，到期后在当前核的中断上下文中执行回调函数。
+ *
+ * @attention
+ * <ul>
+ * <li>定时器已启动时重新按新的超时时间启动。</li>
+ * <li>超时时间已过的定时器在下一次硬件定时器中断中立即执行。</li>
+ * </ul>
+ *
+ * @param handle   [IN]  类型#HrtimerHandle，定时器句柄。
+ * @param expireNs [IN]  类型#U64，超时时间，单位ns。
+ * @param mode     [IN]  类型#U32，#OS_HRTIMER_REL或#OS_HRTIMER_ABS。
+ *
+ * @retval #OS_OK  0x00000000，启动成功。
+ * @retval #其他值  启动失败。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_HrtimerCancel
+ */
+extern U32 PRT_HrtimerStart(HrtimerHandle handle, U64 expireNs, U32 mode);
+
+/*
+ * @brief 停止高精度定时器。
+ *
+ * @par 描述
+ * 停止尚未到期的定时器。
+ *
+ * @attention 无
+ *
+ * @param handle [IN]  类型#HrtimerHandle，定时器句柄。
+ *
+ * @retval #OS_OK  0x00000000，停止成功。
+ * @retval #其他值  停止失败。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see PRT_HrtimerStart
+ */
+extern U32 PRT_HrtimerCancel(HrtimerHandle handle);
+
+/*
+ * @brief 获取高精度定时器当前时刻。
+ *
+ * @par 描述
+ * 获取当前时刻的ns数，与CLOCK_MONOTONIC为同一时基。
+ *
+ * @attention 无
+ *
+ * @param 无。
+ *
+ * @retval 当前时刻，单位ns。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see 无
+ */
+extern U64 PRT_HrtimerGetNs(void);
+
+/*
+ * @brief 当前任务高精度睡眠。
+ *
+ * @par 描述
+ * 当前任务睡眠到指定时刻，由高精度定时器唤醒，不按tick取整。
+ *
+ * @attention
+ * <ul>
+ * <li>只能在任务中调用，锁任务调度时不能调用。</li>
+ * </ul>
+ *
+ * @param expireNs [IN]  类型#U64，超时时间，单位ns。
+ * @param mode     [IN]  类型#U32，#OS_HRTIMER_REL或#OS_HRTIMER_ABS。
+ *
+ * @retval #OS_OK  0x00000000，睡眠结束。
+ * @retval #其他值  睡眠失败。
+ * <ul><li>prt_timer.h：该接口声明所在的头文件。</li></ul>
+ * @see 无
+ */
+extern U32 PRT_HrtimerSleep(U64 expireNs, U32 mode);
+#endif
+
 #ifdef __cplusplus
 #if __cplusplus
 }
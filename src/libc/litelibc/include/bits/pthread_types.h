@@ -27,6 +27,10 @@ typedef struct __pthread_mutex_s {
     unsigned char type;
     unsigned char magic;
     unsigned short mutex_sem;
+    /* 持有者字，无竞争时加解锁只对该字做CAS */
+    volatile unsigned int owner;
+    /* 持有者的递归加锁次数 */
+    unsigned int count;
 } pthread_mutex_t;
 #define __DEFINED_pthread_mutex_t
 
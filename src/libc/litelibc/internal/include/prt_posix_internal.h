@@ -37,6 +37,21 @@ typedef void * (*prt_pthread_startroutine)(void *);
 
 typedef pthread_mutex_t prt_pthread_mutex_t;
 
+/*
+ * 获取当前任务PID，SMP下读取核号和该核运行任务之间可能发生迁移，需要短暂关本核中断
+ */
+OS_SEC_ALW_INLINE INLINE U32 OsPthreadSelfPid(void)
+{
+#if defined(OS_OPTION_SMP)
+    uintptr_t intSave = OsIntLock();
+    U32 taskPid = RUNNING_TASK->taskPid;
+    OsIntRestore(intSave);
+    return taskPid;
+#else
+    return RUNNING_TASK->taskPid;
+#endif
+}
+
 extern void (*g_pthread_keys_destor[PTHREAD_KEYS_MAX])(void *);
 
 #define PTHREAD_TERMINATED  2
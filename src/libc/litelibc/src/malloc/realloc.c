@@ -34,6 +34,10 @@ void *realloc(void *p, size_t n)
     if (oldSize == n) {
         return p;
     }
+    /* 优先原地缩小或并入后一相邻空闲块，避免拷贝 */
+    if ((n <= U32_MAX) && (PRT_MemResize(0, p, (U32)n) == OS_OK)) {
+        return p;
+    }
     newPtr = malloc(n);
     if (!newPtr) {
         return NULL;
@@ -136,6 +136,9 @@ OS_SEC_ALW_INLINE INLINE void OsPthreadCreateTcbInit(uintptr_t stackPtr, pthread
 #endif
 
     INIT_LIST_OBJECT(&tskCb->semBList);
+#if defined(OS_OPTION_SMP)
+    OsSpinLockInitInner(&tskCb->semBLock);
+#endif
     INIT_LIST_OBJECT(&tskCb->pendList);
     INIT_LIST_OBJECT(&tskCb->timerList);
 #if defined(OS_OPTION_POSIX_SIGNAL)
@@ -160,6 +163,11 @@ OS_SEC_ALW_INLINE INLINE void OsPthreadCreateTcbInit(uintptr_t stackPtr, pthread
     tskCb->scheClass = RT_SINGLE_CLASS();
     tskCb->coreAllowedMask = (OS_CORE_MASK)OS_ALLCORES_MASK;
     tskCb->nrCoresAllowed = g_maxNumOfCores;
+#if defined(OS_OPTION_SCHED_EDF)
+    tskCb->dlRuntime = 0;
+    tskCb->dlBw = 0;
+    tskCb->dlThrottled = FALSE;
+#endif
 #endif
 }
 
@@ -29,6 +29,10 @@ int pthread_mutex_destroy(pthread_mutex_t *mutex)
         PRT_HwiRestore(intSave);
         return EINVAL;
     }
+    if (mutex->owner != 0) {
+        PRT_HwiRestore(intSave);
+        return EBUSY;
+    }
     PRT_HwiRestore(intSave);
 
     ret = PRT_SemDelete(mutex->mutex_sem);
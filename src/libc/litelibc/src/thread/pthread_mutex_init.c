@@ -54,6 +54,8 @@ int pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr)
     if (ret != OS_OK) {
         return EINVAL;
     }
+    mutex->owner = 0;
+    mutex->count = 0;
     mutex->magic = MUTEX_MAGIC;
 
     return OS_OK;
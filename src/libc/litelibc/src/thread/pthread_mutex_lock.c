@@ -19,28 +19,38 @@
 int __pthread_mutex_lock(pthread_mutex_t *mutex)
 {
     U32 ret;
-    U32 intSave;
+    U32 self;
 
     if (OsMutexParamCheck(mutex) != OS_OK) {
         return EINVAL;
     }
 
-    SEM_INIT_IRQ_LOCK(intSave);
     if (mutex->magic != MUTEX_MAGIC) {
-        SEM_INIT_IRQ_UNLOCK(intSave);
         return EINVAL;
     }
 
-    if (mutex->type == PTHREAD_MUTEX_ERRORCHECK && OsSemBusy(mutex->mutex_sem)) {
-        SEM_INIT_IRQ_UNLOCK(intSave);
-        return EINVAL;
+    /* 无竞争时只对持有者字做一次CAS，不进入内核信号量 */
+    self = OS_MUTEX_OWNER_ID(OsPthreadSelfPid());
+    if (OsMutexOwnerCas(&mutex->owner, 0, self)) {
+        mutex->count = 1;
+        return OS_OK;
+    }
+
+    if ((OsMutexOwnerGet(&mutex->owner) & ~OS_MUTEX_WAITERS) == self) {
+        if (mutex->type == PTHREAD_MUTEX_RECURSIVE) {
+            mutex->count++;
+            return OS_OK;
+        }
+        if (mutex->type == PTHREAD_MUTEX_ERRORCHECK) {
+            return EDEADLK;
+        }
     }
-    SEM_INIT_IRQ_UNLOCK(intSave);
 
-    ret = PRT_SemPend(mutex->mutex_sem, OS_WAIT_FOREVER);
+    ret = OsSemMutexPend(mutex->mutex_sem, &mutex->owner, OS_WAIT_FOREVER);
     if (ret != OS_OK) {
         return EINVAL;
     }
+    mutex->count = 1;
 
     return OS_OK;
 }
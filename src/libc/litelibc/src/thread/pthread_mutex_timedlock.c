@@ -21,7 +21,7 @@
 int PRT_PthreadMutexTimedlock(prt_pthread_mutex_t *mutex, const struct timespec *time)
 {
     U32 ret;
-    U32 intSave;
+    U32 self;
     U32 ticks;
 
     if (time == NULL) {
@@ -32,30 +32,42 @@ int PRT_PthreadMutexTimedlock(prt_pthread_mutex_t *mutex, const struct timespec
         return EINVAL;
     }
 
-    intSave = PRT_HwiLock();
     if (mutex->magic != MUTEX_MAGIC) {
-        PRT_HwiRestore(intSave);
         return EINVAL;
     }
 
     if (time->tv_sec < 0 || time->tv_nsec < 0) {
-        PRT_HwiRestore(intSave);
         return EINVAL;
     }
 
-    PRT_HwiRestore(intSave);
+    self = OS_MUTEX_OWNER_ID(OsPthreadSelfPid());
+    if (OsMutexOwnerCas(&mutex->owner, 0, self)) {
+        mutex->count = 1;
+        return OS_OK;
+    }
+
+    if ((OsMutexOwnerGet(&mutex->owner) & ~OS_MUTEX_WAITERS) == self) {
+        if (mutex->type == PTHREAD_MUTEX_RECURSIVE) {
+            mutex->count++;
+            return OS_OK;
+        }
+        if (mutex->type == PTHREAD_MUTEX_ERRORCHECK) {
+            return EDEADLK;
+        }
+    }
 
     ret = OsTimeOut2Ticks(time, &ticks);
     if (ret != OS_OK) {
         return (int)ret;
     }
 
-    ret = PRT_SemPend(mutex->mutex_sem, ticks);
+    ret = OsSemMutexPend(mutex->mutex_sem, &mutex->owner, ticks);
     if (ret != OS_OK) {
-        ret = (ret == OS_ERRNO_SEM_TIMEOUT) ? ETIMEDOUT : EINVAL;
+        return (ret == OS_ERRNO_SEM_TIMEOUT) ? ETIMEDOUT : EINVAL;
     }
+    mutex->count = 1;
 
-    return (int)ret;
+    return OS_OK;
 }
 
 int __pthread_mutex_timedlock(pthread_mutex_t *mutex, const struct timespec *time)
@@ -18,31 +18,29 @@
 
 int __pthread_mutex_trylock(pthread_mutex_t *mutex)
 {
-    U32 ret;
-    U32 intSave;
+    U32 self;
 
     if (OsMutexParamCheck(mutex) != OS_OK) {
         return EINVAL;
     }
 
-    intSave = PRT_HwiLock();
     if (mutex->magic != MUTEX_MAGIC) {
-        PRT_HwiRestore(intSave);
         return EINVAL;
     }
 
-    if (OsSemBusy(mutex->mutex_sem)) {
-        PRT_HwiRestore(intSave);
-        return EBUSY;
+    self = OS_MUTEX_OWNER_ID(OsPthreadSelfPid());
+    if (OsMutexOwnerCas(&mutex->owner, 0, self)) {
+        mutex->count = 1;
+        return OS_OK;
     }
-    PRT_HwiRestore(intSave);
 
-    ret = PRT_SemPend(mutex->mutex_sem, OS_WAIT_FOREVER);
-    if (ret != OS_OK) {
-        return EINVAL;
+    if ((mutex->type == PTHREAD_MUTEX_RECURSIVE) &&
+        ((OsMutexOwnerGet(&mutex->owner) & ~OS_MUTEX_WAITERS) == self)) {
+        mutex->count++;
+        return OS_OK;
     }
 
-    return OS_OK;
+    return EBUSY;
 }
 
 weak_alias(__pthread_mutex_trylock, pthread_mutex_trylock);
\ No newline at end of file
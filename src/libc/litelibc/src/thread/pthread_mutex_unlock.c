@@ -19,20 +19,31 @@
 int __pthread_mutex_unlock(pthread_mutex_t *mutex)
 {
     U32 ret;
-    U32 intSave;
+    U32 self;
 
     if (OsMutexParamCheck(mutex) != OS_OK) {
         return EINVAL;
     }
 
-    SEM_INIT_IRQ_LOCK(intSave);
     if (mutex->magic != MUTEX_MAGIC) {
-        SEM_INIT_IRQ_UNLOCK(intSave);
         return EINVAL;
     }
-    SEM_INIT_IRQ_UNLOCK(intSave);
 
-    ret = PRT_SemPost(mutex->mutex_sem);
+    self = OS_MUTEX_OWNER_ID(OsPthreadSelfPid());
+    if ((OsMutexOwnerGet(&mutex->owner) & ~OS_MUTEX_WAITERS) != self) {
+        return EPERM;
+    }
+
+    if (--mutex->count != 0) {
+        return OS_OK;
+    }
+
+    /* 没有任务阻塞时只做一次CAS；有等待者时由内核把锁交给首个等待任务 */
+    if (OsMutexOwnerCas(&mutex->owner, self, 0)) {
+        return OS_OK;
+    }
+
+    ret = OsSemMutexPost(mutex->mutex_sem, &mutex->owner);
     if (ret != OS_OK) {
         return EINVAL;
     }
@@ -16,6 +16,39 @@
 #include <errno.h>
 #include "prt_posix_internal.h"
 #include "prt_sys_external.h"
+#include "prt_timer.h"
+
+#if defined(OS_OPTION_HRTIMER)
+/*
+ * 高精度定时器睡眠，不按tick取整，超时时刻统一换算为CLOCK_MONOTONIC时基。
+ * 高精度定时器未初始化时返回OS_ERRNO_HRTIMER_NOT_INIT，由调用者回退到tick睡眠。
+ */
+static U32 OsClockHrSleep(clockid_t clk, int flags, const struct timespec *req)
+{
+	struct timespec real;
+	struct timespec hw;
+	U64 nanosec = (U64)req->tv_sec * OS_SYS_NS_PER_SECOND + (U64)req->tv_nsec;
+	U64 delta;
+
+	if (!flags) {
+		return PRT_HrtimerSleep(nanosec, OS_HRTIMER_REL);
+	}
+
+	if (clk == CLOCK_REALTIME) {
+		/* 先取REALTIME再取MONOTONIC，两次读取间的误差只会使唤醒略晚 */
+		OsTimeGetRealTime(&real);
+		OsTimeGetHwTime(&hw);
+		delta = ((U64)real.tv_sec * OS_SYS_NS_PER_SECOND + (U64)real.tv_nsec) -
+			((U64)hw.tv_sec * OS_SYS_NS_PER_SECOND + (U64)hw.tv_nsec);
+		if (nanosec <= delta) {
+			return OS_OK;
+		}
+		nanosec -= delta;
+	}
+
+	return PRT_HrtimerSleep(nanosec, OS_HRTIMER_ABS);
+}
+#endif
 
 int __clock_nanosleep(clockid_t clk, int flags, const struct timespec *req, struct timespec *rem)
 {
@@ -27,9 +60,24 @@ int __clock_nanosleep(clockid_t clk, int flags, const struct timespec *req, stru
 	if (clk == CLOCK_THREAD_CPUTIME_ID) {
 		return EINVAL;
 	}
-	if (clk != CLOCK_REALTIME) {
+	if ((clk != CLOCK_REALTIME) && (clk != CLOCK_MONOTONIC)) {
+		return EINVAL;
+	}
+	if (!OsTimeCheckSpec(req)) {
 		return EINVAL;
 	}
+#if defined(OS_OPTION_HRTIMER)
+	ret = (int)OsClockHrSleep(clk, flags, req);
+	if (ret != (int)OS_ERRNO_HRTIMER_NOT_INIT) {
+		if (ret != OS_OK) {
+			return EINVAL;
+		}
+		if (rem != NULL) {
+			rem->tv_sec = rem->tv_nsec = 0;
+		}
+		return OS_OK;
+	}
+#endif
 	if (!flags) {
 		if(nanosleep(req, rem) != OS_OK) {
 			return EINVAL;
@@ -37,7 +85,7 @@ int __clock_nanosleep(clockid_t clk, int flags, const struct timespec *req, stru
 		return OS_OK;
 	}
 
-	ret = clock_gettime(CLOCK_REALTIME, &tmp);
+	ret = clock_gettime(clk, &tmp);
 	if (ret != OS_OK) {
 		return ret;
 	}
@@ -15,11 +15,15 @@
 #include <time.h>
 #include "prt_posix_internal.h"
 #include "prt_sys_external.h"
+#include "prt_timer.h"
 
 int nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
 {
     U64 nanosec;
     U64 tick;
+#if defined(OS_OPTION_HRTIMER)
+    U32 ret;
+#endif
     const U32 nsPerTick = OS_SYS_NS_PER_SECOND / g_tickModInfo.tickPerSecond;
 
     struct TagTskCb *curTskCb = RUNNING_TASK;
@@ -35,6 +39,20 @@ int nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
     }
 
     nanosec = (U64)rqtp->tv_sec * OS_SYS_NS_PER_SECOND + (U64)rqtp->tv_nsec;
+#if defined(OS_OPTION_HRTIMER)
+    /* 高精度定时器已初始化时不按tick取整 */
+    ret = PRT_HrtimerSleep(nanosec, OS_HRTIMER_REL);
+    if (ret != OS_ERRNO_HRTIMER_NOT_INIT) {
+        if (ret != OS_OK) {
+            errno = EINVAL;
+            return PTHREAD_OP_FAIL;
+        }
+        if (rmtp != NULL) {
+            rmtp->tv_sec = rmtp->tv_nsec = 0;
+        }
+        return OS_OK;
+    }
+#endif
     tick = ((nanosec + nsPerTick - 1) / nsPerTick) + 1; // 睡眠时间不得小于rqtp规定的时间
 
     if (tick >= U32_MAX) {
@@ -18,15 +18,10 @@
 /* 判断初始化内存地址和大小是否为4字节对齐 */
 #define OS_MEM_GETBIT(addr) (addr & (uintptr_t)(sizeof(uintptr_t) - 1))
 
-OS_SEC_BSS struct TagMemFuncLib g_memArithAPI; /* 算法对应API */
-OS_SEC_BSS struct TagFscMemCtrl g_fscMemNodeList[OS_FSC_MEM_LAST_IDX];
-OS_SEC_DATA U32 g_fscMemBitMap = 1;
-uintptr_t g_memTotalSize = 0;
-uintptr_t g_memUsage = 0;
-uintptr_t g_memPeakUsage = 0;
-uintptr_t g_memStartAddr = 0;
-
-OS_SEC_TEXT struct TagFscMemCtrl *OsFscMemSearch(U32 size, U32 *idx)
+OS_SEC_BSS struct TagMemFuncLib g_memArithAPI[MEM_ARITH_BUTT]; /* 各算法对应API，按enum MemArith索引 */
+OS_SEC_BSS struct TagFscMemPt g_fscMemDefaultPt;
+
+OS_SEC_TEXT struct TagFscMemCtrl *OsFscMemSearch(struct TagFscMemPt *fscPt, U32 size, U32 *idx)
 {
     U32 staIdx;
     struct TagFscMemCtrl *currBlk = NULL;
@@ -36,11 +31,11 @@ OS_SEC_TEXT struct TagFscMemCtrl *OsFscMemSearch(U32 size, U32 *idx)
     *idx = staIdx + 1;
 
     while (TRUE) {
-        *idx = OsGetLmb1((g_fscMemBitMap << *idx) >> *idx);
+        *idx = OsGetLmb1((fscPt->bitMap << *idx) >> *idx);
         if (OS_FSC_MEM_LAST_IDX <= *idx) {
             *idx = staIdx;
 
-            headBlk = &g_fscMemNodeList[*idx];
+            headBlk = &fscPt->nodeList[*idx];
             currBlk = headBlk->next;
 
             /* 空闲链表非空 */
@@ -57,10 +52,10 @@ OS_SEC_TEXT struct TagFscMemCtrl *OsFscMemSearch(U32 size, U32 *idx)
             return NULL;
         }
 
-        headBlk = &g_fscMemNodeList[*idx];
+        headBlk = &fscPt->nodeList[*idx];
         /* 空闲链表为空，清除BitMap标志位 */
         if (headBlk->next == headBlk) {
-            g_fscMemBitMap &= ~(OS_FSC_MEM_IDX2BIT(*idx));
+            fscPt->bitMap &= ~(OS_FSC_MEM_IDX2BIT(*idx));
         } else {
             break;
         }
@@ -70,17 +65,17 @@ OS_SEC_TEXT struct TagFscMemCtrl *OsFscMemSearch(U32 size, U32 *idx)
     return currBlk;
 }
 
-OS_SEC_TEXT void *OsFscMemAllocInner(U32 mid, U32 size, uintptr_t align)
+OS_SEC_TEXT void *OsFscMemAllocInner(U32 mid, struct TagMemPtCb *ptCb, U32 size, uintptr_t align)
 {
     U32 idx;
     U32 allocSize;
     U32 *blkTailMagic = NULL;
     uintptr_t usrAddr;
+    struct TagFscMemPt *fscPt = (struct TagFscMemPt *)ptCb->arithCb;
     struct TagFscMemCtrl *plotBlk = NULL;
     struct TagFscMemCtrl *currBlk = NULL;
     struct TagFscMemCtrl *nextBlk = NULL;
 
-    (void)mid;
     if (size == 0) {
         OS_REPORT_ERROR(OS_ERRNO_MEM_ALLOC_SIZE_ZERO);
         return NULL;
@@ -98,7 +93,7 @@ OS_SEC_TEXT void *OsFscMemAllocInner(U32 mid, U32 size, uintptr_t align)
         return NULL;
     }
 
-    currBlk = OsFscMemSearch(allocSize, &idx);
+    currBlk = OsFscMemSearch(fscPt, allocSize, &idx);
     if (currBlk == NULL) {
         return NULL;
     }
@@ -110,7 +105,7 @@ OS_SEC_TEXT void *OsFscMemAllocInner(U32 mid, U32 size, uintptr_t align)
         /* 调整链表 */
         if (idx != OS_FSC_MEM_SZ2IDX(currBlk->size)) {
             OsFscMemDelete(currBlk);
-            OsFscMemInsert(currBlk, g_fscMemNodeList, &g_fscMemBitMap);
+            OsFscMemInsert(currBlk, fscPt->nodeList, &fscPt->bitMap);
         }
 
         plotBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)currBlk->size);
@@ -134,15 +129,13 @@ OS_SEC_TEXT void *OsFscMemAllocInner(U32 mid, U32 size, uintptr_t align)
     currBlk->prev = 0;
     usrAddr = (((uintptr_t)currBlk + OS_FSC_MEM_SLICE_HEAD_SIZE + align - 1) & ~(align - 1));
     OsMemSetHeadAddr(usrAddr, ((uintptr_t)currBlk + OS_FSC_MEM_SLICE_HEAD_SIZE));
-    g_memUsage += currBlk->size;
-    if (g_memPeakUsage < g_memUsage) {
-        g_memPeakUsage = g_memUsage;
-    }
+    OsMemPtUsageAdd(ptCb, currBlk, mid);
     return (void *)usrAddr;
 }
 
-OS_SEC_TEXT U32 OsFscMemFree(void *addr)
+OS_SEC_TEXT U32 OsFscMemFree(struct TagMemPtCb *ptCb, void *addr)
 {
+    struct TagFscMemPt *fscPt = (struct TagFscMemPt *)ptCb->arithCb;
     struct TagFscMemCtrl *prevBlk = NULL; /* 前一内存块指针 */
     struct TagFscMemCtrl *currBlk = NULL; /* 当前内存块指针 */
     struct TagFscMemCtrl *nextBlk = NULL; /* 后一内存块指针 */
@@ -165,6 +158,8 @@ OS_SEC_TEXT U32 OsFscMemFree(void *addr)
         return OS_ERRNO_MEM_OVERWRITE;
     }
 
+    /* 合并时控制头会被清除，先扣减用量 */
+    OsMemPtUsageSub(ptCb, currBlk);
     nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + blkSize);
 
     /* 后一内存块未使用，当前模块释放后与其合并 */
@@ -192,35 +187,124 @@ OS_SEC_TEXT U32 OsFscMemFree(void *addr)
     }
 
     /* 合并后的总内存块插入链表 */
-    OsFscMemInsert(currBlk, g_fscMemNodeList, &g_fscMemBitMap);
+    OsFscMemInsert(currBlk, fscPt->nodeList, &fscPt->bitMap);
 
     nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)currBlk->size);
     nextBlk->prevSize = currBlk->size;
-    g_memUsage -= blkSize;
 
     return OS_OK;
 }
 
-OS_SEC_TEXT void *OsMemAlloc(enum MoudleId mid, U8 ptNo, U32 size)
+/*
+ * 描述：原地调整内存块大小，缩小时切出尾部空闲块，扩大时并入后一相邻空闲块
+ */
+OS_SEC_TEXT U32 OsFscMemResize(struct TagMemPtCb *ptCb, void *addr, U32 size)
+{
+    struct TagFscMemPt *fscPt = (struct TagFscMemPt *)ptCb->arithCb;
+    struct TagFscMemCtrl *currBlk = NULL;
+    struct TagFscMemCtrl *nextBlk = NULL;
+    struct TagFscMemCtrl *plotBlk = NULL;
+    U32 *blkTailMagic = NULL;
+    uintptr_t blkSize;
+    uintptr_t newSize;
+    uintptr_t totalSize;
+
+    currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+    blkSize = currBlk->size;
+    if ((currBlk->next != OS_FSC_MEM_MAGIC_USED) || (blkSize == 0)) {
+        return OS_ERRNO_MEM_FREE_SH_DAMAGED;
+    }
+
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + blkSize - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    if (*blkTailMagic != OS_FSC_MEM_TAIL_MAGIC) {
+        return OS_ERRNO_MEM_OVERWRITE;
+    }
+
+    if (size >= OS_FSC_MEM_MAXVAL) {
+        return OS_ERRNO_MEM_ALLOC_SIZETOOLARGE;
+    }
+
+    /* 用户地址相对控制头的偏移保持不变 */
+    newSize = ((uintptr_t)addr - (uintptr_t)currBlk) + ALIGN(size, OS_FSC_MEM_SIZE_ALIGN) + OS_FSC_MEM_TAIL_SIZE;
+    nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + blkSize);
+    totalSize = blkSize;
+
+    if (newSize > blkSize) {
+        if ((nextBlk->next == OS_FSC_MEM_MAGIC_USED) || (blkSize + nextBlk->size < newSize)) {
+            return OS_ERRNO_MEM_RESIZE_NO_SPACE;
+        }
+        OsFscMemDelete(nextBlk);
+        totalSize += nextBlk->size;
+        nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + totalSize);
+    } else if (nextBlk->next != OS_FSC_MEM_MAGIC_USED) {
+        /* 缩小时后一块空闲，切出的部分与其合并 */
+        OsFscMemDelete(nextBlk);
+        totalSize += nextBlk->size;
+        if (memset_s(nextBlk, sizeof(struct TagFscMemCtrl), 0, sizeof(struct TagFscMemCtrl)) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+        nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + totalSize);
+    }
+
+    if (totalSize >= newSize + OS_FSC_MEM_MIN_SIZE) {
+        plotBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + newSize);
+        plotBlk->size = totalSize - newSize;
+        plotBlk->prevSize = 0;
+        OsFscMemInsert(plotBlk, fscPt->nodeList, &fscPt->bitMap);
+        nextBlk->prevSize = plotBlk->size;
+        currBlk->size = newSize;
+    } else {
+        nextBlk->prevSize = 0;
+        currBlk->size = totalSize;
+    }
+
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + currBlk->size - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    *blkTailMagic = OS_FSC_MEM_TAIL_MAGIC;
+
+    OsMemPtUsageResize(ptCb, currBlk, blkSize);
+    return OS_OK;
+}
+
+/*
+ * 描述：按位图遍历非空的空闲链表，统计空闲块分布
+ */
+OS_SEC_TEXT void OsFscMemFragStat(struct TagMemPtCb *ptCb, struct MemStats *stats)
 {
-    (void)ptNo;
-    return OsFscMemAllocInner(mid, size, OS_FSC_MEM_SIZE_ALIGN);
+    U32 idx;
+    struct TagFscMemPt *fscPt = (struct TagFscMemPt *)ptCb->arithCb;
+    struct TagFscMemCtrl *headBlk = NULL;
+    struct TagFscMemCtrl *currBlk = NULL;
+
+    for (idx = 0; idx < OS_FSC_MEM_LAST_IDX; idx++) {
+        if ((fscPt->bitMap & OS_FSC_MEM_IDX2BIT(idx)) == 0) {
+            continue;
+        }
+
+        headBlk = &fscPt->nodeList[idx];
+        for (currBlk = headBlk->next; currBlk != headBlk; currBlk = currBlk->next) {
+            OsMemFragStatAdd(stats, currBlk->size);
+        }
+    }
 }
 
-OS_SEC_TEXT void *OsMemAllocAlign(U32 mid, U8 ptNo, U32 size, enum MemAlign alignPow)
+OS_SEC_TEXT void *OsFscMemAlloc(U32 mid, struct TagMemPtCb *ptCb, U32 size)
+{
+    return OsFscMemAllocInner(mid, ptCb, size, OS_FSC_MEM_SIZE_ALIGN);
+}
+
+OS_SEC_TEXT void *OsFscMemAllocAlign(U32 mid, struct TagMemPtCb *ptCb, U32 size, enum MemAlign alignPow)
 {
-    (void)ptNo;
     if (alignPow >= MEM_ADDR_BUTT || alignPow < MEM_ADDR_ALIGN_004) {
         OS_REPORT_ERROR(OS_ERRNO_MEM_ALLOC_ALIGNPOW_INVALID);
         return NULL;
     }
-    return OsFscMemAllocInner(mid, size, (1U << (U32)alignPow));
+    return OsFscMemAllocInner(mid, ptCb, size, (1U << (U32)alignPow));
 }
 
 /*
- * 描述：初始化内存
+ * 描述：在fscPt上初始化FSC分区
  */
-OS_SEC_TEXT U32 OsFscMemInit(uintptr_t addr, U32 size)
+OS_SEC_TEXT U32 OsFscMemPtInitInner(struct TagMemPtCb *ptCb, struct TagFscMemPt *fscPt, uintptr_t addr, U32 size)
 {
     U32 idx;
     struct TagFscMemCtrl *headBlk = NULL;
@@ -253,7 +337,7 @@ OS_SEC_TEXT U32 OsFscMemInit(uintptr_t addr, U32 size)
     }
 
     /* 链表初始化，指向自己 */
-    headBlk = &g_fscMemNodeList[0];
+    headBlk = &fscPt->nodeList[0];
     for (idx = 0; idx < OS_FSC_MEM_LAST_IDX; idx++, headBlk++) {
         headBlk->prev = headBlk;
         headBlk->next = headBlk;
@@ -261,14 +345,14 @@ OS_SEC_TEXT U32 OsFscMemInit(uintptr_t addr, U32 size)
 
     size -= OS_FSC_MEM_USED_HEAD_SIZE;
 
-    g_fscMemBitMap |= 1U << (31 - OS_FSC_MEM_LAST_IDX);
+    fscPt->bitMap = 1U << (31 - OS_FSC_MEM_LAST_IDX);
 
     /* 获取索引号 */
     idx = OS_FSC_MEM_SZ2IDX(size);
-    g_fscMemBitMap |= OS_FSC_MEM_IDX2BIT(idx);
+    fscPt->bitMap |= OS_FSC_MEM_IDX2BIT(idx);
 
     /* 挂载链表初始化 */
-    headBlk = &g_fscMemNodeList[idx];
+    headBlk = &fscPt->nodeList[idx];
     currBlk = (struct TagFscMemCtrl *)(uintptr_t)addr;
     currBlk->next = headBlk;
     currBlk->prevSize = 0;
@@ -277,16 +361,59 @@ OS_SEC_TEXT U32 OsFscMemInit(uintptr_t addr, U32 size)
     headBlk->next = currBlk;
     headBlk->prev = currBlk;
 
-    g_memTotalSize = (uintptr_t)size;
-    g_memStartAddr = addr;
-
     nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)currBlk->size);
     nextBlk->next = OS_FSC_MEM_MAGIC_USED;
     nextBlk->size = 0;
 
-    g_memArithAPI.alloc = OsMemAlloc;
-    g_memArithAPI.allocAlign = OsMemAllocAlign;
-    g_memArithAPI.free = OsFscMemFree;
+    ptCb->arithCb = fscPt;
+    ptCb->startAddr = addr;
+    ptCb->totalSize = (uintptr_t)size;
+    ptCb->usage = 0;
+    ptCb->peakUsage = 0;
+
+    return OS_OK;
+}
+
+/*
+ * 描述：用户创建的FSC分区，FSC控制块从分区内存头部划分
+ */
+OS_SEC_TEXT U32 OsFscMemPtInit(struct TagMemPtCb *ptCb, uintptr_t addr, U32 size)
+{
+    if (size <= sizeof(struct TagFscMemPt)) {
+        return OS_ERRNO_MEM_PTCREATE_SIZE_ISTOOSMALL;
+    }
+
+    return OsFscMemPtInitInner(ptCb, (struct TagFscMemPt *)addr, addr + sizeof(struct TagFscMemPt),
+        (U32)(size - sizeof(struct TagFscMemPt)) & ~(U32)(sizeof(uintptr_t) - 1));
+}
+
+/*
+ * 描述：初始化内存
+ */
+OS_SEC_TEXT U32 OsFscMemInit(uintptr_t addr, U32 size)
+{
+    U32 ret;
+    struct TagMemFuncLib *api = &g_memArithAPI[MEM_ARITH_FSC];
+
+    api->alloc = OsFscMemAlloc;
+    api->allocAlign = OsFscMemAllocAlign;
+    api->free = OsFscMemFree;
+    api->resize = OsFscMemResize;
+    api->fragStat = OsFscMemFragStat;
+    api->ptInit = OsFscMemPtInit;
+
+#if defined(OS_OPTION_MEM_TLSF)
+    OsTlsfMemApiInit(&g_memArithAPI[MEM_ARITH_TLSF]);
+#endif
+
+    ret = OsFscMemPtInitInner(&g_memDefaultPt, &g_fscMemDefaultPt, addr, size);
+    if (ret != OS_OK) {
+        return ret;
+    }
+
+    g_memDefaultPt.ptNo = OS_MEM_DEFAULT_FSC_PT;
+    g_memDefaultPt.arith = MEM_ARITH_FSC;
+    g_memDefaultPt.api = api;
 
     g_osMemAlloc = OsMemAlloc;
 
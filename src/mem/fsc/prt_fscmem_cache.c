@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-06-12
+ * Description: Fsc 内存前端的每核小块缓存实现
+ */
+#include "prt_sys_external.h"
+#include "prt_fscmem_internal.h"
+
+OS_SEC_BSS struct TagMemCache g_memCache[OS_VAR_ARRAY_NUM];
+
+#if defined(OS_OPTION_SMP)
+#define OS_MEM_CACHE_CUR() (&g_memCache[THIS_CORE()])
+#else
+#define OS_MEM_CACHE_CUR() (&g_memCache[0])
+#endif
+
+/* 申请大小向上取整到缓存规格，超出缓存规格时返回OS_MEM_CACHE_CLASS_NUM */
+OS_SEC_ALW_INLINE INLINE U32 OsMemCacheSz2Idx(U32 size)
+{
+    if (size <= OS_MEM_CACHE_MIN_SIZE) {
+        return 0;
+    }
+
+    if (size > OS_MEM_CACHE_MAX_SIZE) {
+        return OS_MEM_CACHE_CLASS_NUM;
+    }
+
+    return (32U - OsGetLmb1(size - 1)) - OS_MEM_CACHE_MIN_SHIFT;
+}
+
+/*
+ * 缓存块交给申请模块或归还缓存时转移模块统计。分区统计中缓存块始终归属OS_MID_MEM，
+ * 转移量记在本核缓存中，不持分区锁，读取统计时合并。
+ */
+OS_SEC_ALW_INLINE INLINE void OsMemCacheMidMove(struct TagMemCache *cache, struct TagFscMemCtrl *blk, U32 from, U32 to)
+{
+    blk->prev = (struct TagFscMemCtrl *)(((uintptr_t)blk->prev & ~OS_MEM_BLK_MID_MASK) |
+        ((uintptr_t)to << OS_MEM_BLK_MID_SHIFT));
+    cache->midStat[from].usedSize -= (intptr_t)blk->size;
+    cache->midStat[to].usedSize += (intptr_t)blk->size;
+}
+
+/*
+ * 描述：从FSC分区批量申请内存块补充缓存，返回补充的个数，调用者已关中断。
+ * 缓存中的块在分区统计中归属OS_MID_MEM。
+ */
+OS_SEC_TEXT U32 OsMemCacheRefill(struct TagMemCacheClass *cls, U32 idx)
+{
+    void *addr;
+    struct TagFscMemCtrl *currBlk = NULL;
+
+    MEM_PT_LOCK(&g_memDefaultPt);
+    while (cls->count < OS_MEM_CACHE_BATCH) {
+        addr = OsFscMemAllocInner(OS_MID_MEM, &g_memDefaultPt, OS_MEM_CACHE_MIN_SIZE << idx, OS_FSC_MEM_SIZE_ALIGN);
+        if (addr == NULL) {
+            break;
+        }
+
+        currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+        OS_MEM_CACHE_TAG_SET(currBlk, OS_MEM_CACHE_TAG_FREE | idx);
+        cls->blk[cls->count] = addr;
+        cls->count++;
+    }
+    MEM_PT_UNLOCK(&g_memDefaultPt);
+
+    return cls->count;
+}
+
+/*
+ * 描述：将缓存栈底最久未使用的num个内存块归还FSC分区，调用者已关中断
+ */
+OS_SEC_TEXT void OsMemCacheDrain(struct TagMemCacheClass *cls, U32 num)
+{
+    U32 loop;
+    struct TagFscMemCtrl *currBlk = NULL;
+
+    if (num > cls->count) {
+        num = cls->count;
+    }
+
+    MEM_PT_LOCK(&g_memDefaultPt);
+    for (loop = 0; loop < num; loop++) {
+        currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)cls->blk[loop]);
+        OS_MEM_CACHE_TAG_SET(currBlk, 0);
+        (void)OsFscMemFree(&g_memDefaultPt, cls->blk[loop]);
+    }
+    MEM_PT_UNLOCK(&g_memDefaultPt);
+
+    for (loop = num; loop < cls->count; loop++) {
+        cls->blk[loop - num] = cls->blk[loop];
+    }
+    cls->count -= num;
+}
+
+OS_SEC_TEXT void *OsMemCacheAlloc(U32 mid, U8 ptNo, U32 size)
+{
+    U32 idx;
+    U32 midIdx;
+    void *addr;
+    struct TagMemCache *cache = OS_MEM_CACHE_CUR();
+    struct TagMemCacheClass *cls = NULL;
+    struct TagFscMemCtrl *currBlk = NULL;
+
+    /* 非缺省分区及0字节申请交由分区算法处理 */
+    if (ptNo != OS_MEM_DEFAULT_FSC_PT || size == 0) {
+        return NULL;
+    }
+
+    idx = OsMemCacheSz2Idx(size);
+    if (idx >= OS_MEM_CACHE_CLASS_NUM) {
+        return NULL;
+    }
+
+    cls = &cache->cls[idx];
+    if (cls->count != 0) {
+        cls->allocHit++;
+    } else {
+        cls->allocMiss++;
+        if (OsMemCacheRefill(cls, idx) == 0) {
+            return NULL;
+        }
+    }
+
+    cls->count--;
+    addr = cls->blk[cls->count];
+    currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+    OS_MEM_CACHE_TAG_SET(currBlk, OS_MEM_CACHE_TAG_USED | idx);
+
+    midIdx = OS_MEM_MID_STAT_IDX(mid);
+    OsMemCacheMidMove(cache, currBlk, (U32)OS_MID_MEM, midIdx);
+    cache->midStat[midIdx].allocCnt++;
+
+    return addr;
+}
+
+OS_SEC_TEXT U32 OsMemCacheFree(void *addr)
+{
+    U32 idx;
+    U32 tag;
+    U32 midIdx;
+    U32 *blkTailMagic = NULL;
+    struct TagMemCache *cache = OS_MEM_CACHE_CUR();
+    struct TagMemCacheClass *cls = NULL;
+    struct TagFscMemCtrl *currBlk = NULL;
+
+    if (addr == NULL) {
+        return OS_MEM_CACHE_BYPASS;
+    }
+
+    currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+    if (currBlk->next != OS_FSC_MEM_MAGIC_USED) {
+        return OS_MEM_CACHE_BYPASS;
+    }
+
+    tag = OS_MEM_CACHE_TAG_GET(currBlk);
+    idx = tag & OS_MEM_CACHE_IDX_MASK;
+    if ((tag & OS_MEM_CACHE_TAG_MASK) == OS_MEM_CACHE_TAG_FREE) {
+        /* 已在缓存中的块被重复释放 */
+        return OS_ERRNO_MEM_FREE_SH_DAMAGED;
+    }
+
+    if (((tag & OS_MEM_CACHE_TAG_MASK) != OS_MEM_CACHE_TAG_USED) || (idx >= OS_MEM_CACHE_CLASS_NUM)) {
+        return OS_MEM_CACHE_BYPASS;
+    }
+
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + currBlk->size - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    if (*blkTailMagic != OS_FSC_MEM_TAIL_MAGIC) {
+        return OS_ERRNO_MEM_OVERWRITE;
+    }
+
+    /* 先把块的统计归还OS_MID_MEM，归还FSC分区时按OS_MID_MEM扣减 */
+    midIdx = (U32)(((uintptr_t)currBlk->prev & OS_MEM_BLK_MID_MASK) >> OS_MEM_BLK_MID_SHIFT);
+    midIdx = OS_MEM_MID_STAT_IDX(midIdx);
+    OsMemCacheMidMove(cache, currBlk, midIdx, (U32)OS_MID_MEM);
+    cache->midStat[midIdx].freeCnt++;
+
+    cls = &cache->cls[idx];
+    if (cls->count == OS_MEM_CACHE_DEPTH) {
+        cls->freeDrain++;
+        OsMemCacheDrain(cls, OS_MEM_CACHE_BATCH);
+    } else {
+        cls->freeHit++;
+    }
+
+    OS_MEM_CACHE_TAG_SET(currBlk, OS_MEM_CACHE_TAG_FREE | idx);
+    cls->blk[cls->count] = addr;
+    cls->count++;
+
+    return OS_OK;
+}
+
+OS_SEC_TEXT bool OsMemCacheOwned(void *addr)
+{
+    struct TagFscMemCtrl *currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+
+    return ((currBlk->next == OS_FSC_MEM_MAGIC_USED) &&
+        ((OS_MEM_CACHE_TAG_GET(currBlk) & OS_MEM_CACHE_TAG_MASK) == OS_MEM_CACHE_TAG_USED));
+}
+
+/*
+ * 描述：合并各核缓存的模块统计转移量，调用者已持有缺省分区锁。其它核的转移量无锁读取，结果为近似快照，
+ * 缓存块的占用峰值按合并后的占用估算。
+ */
+OS_SEC_TEXT void OsMemCacheStatMerge(struct MemMidStat *mid)
+{
+    U32 core;
+    U32 idx;
+    struct TagMemCacheMidStat *delta = NULL;
+
+    for (core = 0; core < OS_VAR_ARRAY_NUM; core++) {
+        for (idx = 0; idx < OS_MEM_STAT_MID_NUM; idx++) {
+            delta = &g_memCache[core].midStat[idx];
+            mid[idx].usedSize += (uintptr_t)delta->usedSize;
+            mid[idx].allocCnt += delta->allocCnt;
+            mid[idx].freeCnt += delta->freeCnt;
+        }
+    }
+
+    for (idx = 0; idx < OS_MEM_STAT_MID_NUM; idx++) {
+        if (mid[idx].peakSize < mid[idx].usedSize) {
+            mid[idx].peakSize = mid[idx].usedSize;
+        }
+    }
+}
+
+/*
+ * 描述：将本核所有规格的缓存块归还FSC分区，返回归还的块个数，调用者已关中断
+ */
+OS_SEC_TEXT U32 OsMemCacheFlush(void)
+{
+    U32 idx;
+    U32 num = 0;
+    struct TagMemCache *cache = OS_MEM_CACHE_CUR();
+
+    for (idx = 0; idx < OS_MEM_CACHE_CLASS_NUM; idx++) {
+        num += cache->cls[idx].count;
+        OsMemCacheDrain(&cache->cls[idx], cache->cls[idx].count);
+    }
+
+    return num;
+}
+
+OS_SEC_TEXT void PRT_MemCacheFlush(void)
+{
+    uintptr_t intSave;
+
+    intSave = PRT_HwiLock();
+    (void)OsMemCacheFlush();
+    PRT_HwiRestore(intSave);
+}
+
+OS_SEC_TEXT U32 PRT_MemCacheGetStat(U32 coreId, U32 classIdx, struct MemCacheStat *stat)
+{
+    struct TagMemCacheClass *cls = NULL;
+
+#if defined(OS_OPTION_SMP)
+    if (coreId >= OS_MAX_CORE_NUM) {
+        return OS_ERRNO_MEM_CACHE_PARA_INVALID;
+    }
+#else
+    if (coreId != THIS_CORE()) {
+        return OS_ERRNO_MEM_CACHE_PARA_INVALID;
+    }
+    coreId = 0;
+#endif
+
+    if (classIdx >= OS_MEM_CACHE_CLASS_NUM) {
+        return OS_ERRNO_MEM_CACHE_PARA_INVALID;
+    }
+
+    if (stat == NULL) {
+        return OS_ERRNO_MEM_CACHE_PTR_NULL;
+    }
+
+    cls = &g_memCache[coreId].cls[classIdx];
+    stat->blkSize = OS_MEM_CACHE_MIN_SIZE << classIdx;
+    stat->cachedNum = cls->count;
+    stat->allocHit = cls->allocHit;
+    stat->allocMiss = cls->allocMiss;
+    stat->freeHit = cls->freeHit;
+    stat->freeDrain = cls->freeDrain;
+
+    return OS_OK;
+}
@@ -32,6 +32,61 @@
 #define OS_FSC_MEM_SIZE_ALIGN OS_MEM_ADDR_ALIGN
 #define OS_FSC_MEM_MIN_SIZE (OS_FSC_MEM_SLICE_HEAD_SIZE + OS_FSC_MEM_SIZE_ALIGN)
 
+#if defined(OS_OPTION_MEM_CACHE)
+#define OS_MEM_CACHE_MIN_SHIFT 4U
+#define OS_MEM_CACHE_MIN_SIZE (1U << OS_MEM_CACHE_MIN_SHIFT)
+#define OS_MEM_CACHE_MAX_SIZE (OS_MEM_CACHE_MIN_SIZE << (OS_MEM_CACHE_CLASS_NUM - 1))
+/* 每个规格最多缓存的空闲块个数，以及每次从FSC补充或归还FSC的块个数 */
+#define OS_MEM_CACHE_DEPTH 16U
+#define OS_MEM_CACHE_BATCH (OS_MEM_CACHE_DEPTH / 2)
+
+/*
+ * 缓存块复用控制头prev字段的bit0~7做标记，高4位为标记类型，低4位记录规格索引。
+ * bit8~15为申请模块统计索引，高16位可能与对齐偏移复用，更新标记时需保留。
+ */
+#define OS_MEM_CACHE_TAG_BITS ((uintptr_t)0xFFU)
+#define OS_MEM_CACHE_TAG_MASK 0xF0U
+#define OS_MEM_CACHE_IDX_MASK 0x0FU
+#define OS_MEM_CACHE_TAG_USED 0xC0U
+#define OS_MEM_CACHE_TAG_FREE 0xD0U
+#define OS_MEM_CACHE_TAG_GET(blk) ((U32)((uintptr_t)(blk)->prev & OS_MEM_CACHE_TAG_BITS))
+#define OS_MEM_CACHE_TAG_SET(blk, tag) \
+    ((blk)->prev = (struct TagFscMemCtrl *)(((uintptr_t)(blk)->prev & ~OS_MEM_CACHE_TAG_BITS) | (uintptr_t)(tag)))
+#endif
+
+/*
+ * 模块内结构体定义
+ */
+/* FSC算法分区控制块 */
+struct TagFscMemPt {
+    U32 bitMap;
+    struct TagFscMemCtrl nodeList[OS_FSC_MEM_LAST_IDX];
+};
+
+#if defined(OS_OPTION_MEM_CACHE)
+/* 单个规格的缓存，blk按栈方式使用，栈顶为最近释放的块 */
+struct TagMemCacheClass {
+    U32 count;
+    void *blk[OS_MEM_CACHE_DEPTH];
+    U64 allocHit;
+    U64 allocMiss;
+    U64 freeHit;
+    U64 freeDrain;
+};
+
+/* 缓存块交给申请模块后的模块统计转移量，块在其它核释放时本核转移量可能为负 */
+struct TagMemCacheMidStat {
+    intptr_t usedSize;
+    U32 allocCnt;
+    U32 freeCnt;
+};
+
+struct TagMemCache {
+    struct TagMemCacheClass cls[OS_MEM_CACHE_CLASS_NUM];
+    struct TagMemCacheMidStat midStat[OS_MEM_STAT_MID_NUM];
+};
+#endif
+
 /*
  * 模块内全局变量声明
  */
@@ -42,6 +97,7 @@
 extern void *OsFscMemSplit(U8 ptNo, uintptr_t size, uintptr_t align,
                            struct TagFscMemCtrl *fscFreeListHead, U32 *bitMapPtr);
 extern U32 OsMemPtParaCheck(uintptr_t addr, uintptr_t size, uintptr_t *ptAddr);
+extern void *OsFscMemAllocInner(U32 mid, struct TagMemPtCb *ptCb, U32 size, uintptr_t align);
 
 /*
  * 模块内内联函数定义
@@ -25,6 +25,7 @@
 /*
  * 模块间函数声明
  */
-extern U32 OsFscMemFree(void *addr);
+struct TagMemPtCb;
+extern U32 OsFscMemFree(struct TagMemPtCb *ptCb, void *addr);
 
 #endif /* PRT_FSCMEM_EXTERNAL_H */
@@ -15,6 +15,56 @@
 #include "prt_mem_internal.h"
 #include "prt_perf.h"
 
+OS_SEC_BSS struct TagMemPtCb g_memDefaultPt;
+
+/*
+ * 描述：检查新分区的分区号不重复、内存范围[addr, addr + size)不与已有分区重叠，调用者持有初始化锁
+ */
+OS_SEC_TEXT U32 OsMemPtCheck(U8 ptNo, uintptr_t addr, U32 size)
+{
+    uintptr_t base;
+    struct TagMemPtCb *currPt = NULL;
+
+    /* 从缺省分区开始检查，释放时按地址查找分区也是先查缺省分区，不能在缺省分区申请的内存上再建分区 */
+    for (currPt = &g_memDefaultPt; currPt != NULL; currPt = currPt->next) {
+        if (currPt->ptNo == ptNo) {
+            return OS_ERRNO_MEM_PT_ALREADY_CREATED;
+        }
+
+        /* 非缺省分区的控制块位于分区内存头部，范围从控制块算起 */
+        base = (currPt == &g_memDefaultPt) ? currPt->startAddr : (uintptr_t)currPt;
+        if ((addr < currPt->startAddr + currPt->totalSize) && (base < addr + size)) {
+            return OS_ERRNO_MEM_PT_OVERLAP;
+        }
+    }
+
+    return OS_OK;
+}
+
+OS_SEC_TEXT void *OsMemAlloc(enum MoudleId mid, U8 ptNo, U32 size)
+{
+    struct TagMemPtCb *ptCb = OsMemPtGet(ptNo);
+
+    if (ptCb == NULL) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_PTNO_INVALID);
+        return NULL;
+    }
+
+    return ptCb->api->alloc(mid, ptCb, size);
+}
+
+OS_SEC_TEXT void *OsMemAllocAlign(U32 mid, U8 ptNo, U32 size, enum MemAlign alignPow)
+{
+    struct TagMemPtCb *ptCb = OsMemPtGet(ptNo);
+
+    if (ptCb == NULL) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_PTNO_INVALID);
+        return NULL;
+    }
+
+    return ptCb->api->allocAlign(mid, ptCb, size, alignPow);
+}
+
 OS_SEC_TEXT void *PRT_MemAlloc(U32 mid, U8 ptNo, U32 size)
 {
 #if defined(OS_OPTION_PERF) && defined(OS_OPTION_PERF_SW_PMU)
@@ -22,10 +72,39 @@ OS_SEC_TEXT void *PRT_MemAlloc(U32 mid, U8 ptNo, U32 size)
 #endif
     void *addr;
     uintptr_t intSave;
+    struct TagMemPtCb *ptCb = NULL;
 
+#if defined(OS_OPTION_MEM_CACHE)
     intSave = PRT_HwiLock();
-    addr = g_memArithAPI.alloc(mid, ptNo, size);
+    addr = OsMemCacheAlloc(mid, ptNo, size);
     PRT_HwiRestore(intSave);
+    if (addr != NULL) {
+        return addr;
+    }
+#endif
+
+    ptCb = OsMemPtGet(ptNo);
+    if (ptCb == NULL) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_PTNO_INVALID);
+        return NULL;
+    }
+
+    MEM_PT_IRQ_LOCK(ptCb, intSave);
+    addr = ptCb->api->alloc(mid, ptCb, size);
+    MEM_PT_IRQ_UNLOCK(ptCb, intSave);
+
+#if defined(OS_OPTION_MEM_CACHE)
+    /* 缺省分区内存不足时，将本核缓存的空闲块归还分区后重试一次 */
+    if (addr == NULL && ptNo == OS_MEM_DEFAULT_FSC_PT) {
+        intSave = PRT_HwiLock();
+        if (OsMemCacheFlush() != 0) {
+            MEM_PT_LOCK(ptCb);
+            addr = ptCb->api->alloc(mid, ptCb, size);
+            MEM_PT_UNLOCK(ptCb);
+        }
+        PRT_HwiRestore(intSave);
+    }
+#endif
 
     return addr;
 }
@@ -34,10 +113,16 @@ OS_SEC_TEXT void *PRT_MemAllocAlign(U32 mid, U8 ptNo, U32 size, enum MemAlign al
 {
     void *addr;
     uintptr_t intSave;
+    struct TagMemPtCb *ptCb = OsMemPtGet(ptNo);
 
-    intSave = PRT_HwiLock();
-    addr = g_memArithAPI.allocAlign(mid, ptNo, size, alignPow);
-    PRT_HwiRestore(intSave);
+    if (ptCb == NULL) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_PTNO_INVALID);
+        return NULL;
+    }
+
+    MEM_PT_IRQ_LOCK(ptCb, intSave);
+    addr = ptCb->api->allocAlign(mid, ptCb, size, alignPow);
+    MEM_PT_IRQ_UNLOCK(ptCb, intSave);
 
     return addr;
 }
@@ -46,11 +131,181 @@ OS_SEC_TEXT U32 PRT_MemFree(U32 mid, void *addr)
 {
     U32 ret;
     uintptr_t intSave;
+    struct TagMemPtCb *ptCb = NULL;
 
     (void)mid;
+    if (addr == NULL) {
+        return OS_ERRNO_MEM_FREE_ADDR_INVALID;
+    }
+
+#if defined(OS_OPTION_MEM_CACHE)
     intSave = PRT_HwiLock();
-    ret = g_memArithAPI.free(addr);
+    ret = OsMemCacheFree(addr);
     PRT_HwiRestore(intSave);
+    if (ret != OS_MEM_CACHE_BYPASS) {
+        return ret;
+    }
+#endif
+
+    ptCb = OsMemPtFind((uintptr_t)addr);
+    if (ptCb == NULL) {
+        return OS_ERRNO_MEM_FREE_ADDR_INVALID;
+    }
+
+    MEM_PT_IRQ_LOCK(ptCb, intSave);
+    ret = ptCb->api->free(ptCb, addr);
+    MEM_PT_IRQ_UNLOCK(ptCb, intSave);
+
+    return ret;
+}
+
+OS_SEC_TEXT U32 PRT_MemResize(U32 mid, void *addr, U32 size)
+{
+    U32 ret;
+    uintptr_t intSave;
+    struct TagMemPtCb *ptCb = NULL;
+
+    (void)mid;
+    if (addr == NULL) {
+        return OS_ERRNO_MEM_FREE_ADDR_INVALID;
+    }
+
+    if (size == 0) {
+        return OS_ERRNO_MEM_ALLOC_SIZE_ZERO;
+    }
+
+#if defined(OS_OPTION_MEM_CACHE)
+    if (OsMemCacheOwned(addr)) {
+        return OS_ERRNO_MEM_RESIZE_NO_SPACE;
+    }
+#endif
+
+    ptCb = OsMemPtFind((uintptr_t)addr);
+    if (ptCb == NULL) {
+        return OS_ERRNO_MEM_FREE_ADDR_INVALID;
+    }
+
+    if (ptCb->api->resize == NULL) {
+        return OS_ERRNO_MEM_RESIZE_NO_SPACE;
+    }
+
+    MEM_PT_IRQ_LOCK(ptCb, intSave);
+    ret = ptCb->api->resize(ptCb, addr, size);
+    MEM_PT_IRQ_UNLOCK(ptCb, intSave);
 
     return ret;
 }
+
+OS_SEC_TEXT U32 PRT_MemPtCreate(U8 ptNo, enum MemArith arith, void *addr, U32 size)
+{
+    U32 ret;
+    U32 ptSize;
+    uintptr_t intSave;
+    uintptr_t ptAddr;
+    struct TagMemPtCb *ptCb = NULL;
+    struct TagMemFuncLib *api = NULL;
+
+    if (ptNo < OS_MEM_DEFAULT_PTNUM || ptNo >= OS_MEM_PT_NUM) {
+        return OS_ERRNO_MEM_PTNO_INVALID;
+    }
+
+    /* 未编译使能的算法API为空 */
+    if (arith >= MEM_ARITH_BUTT || g_memArithAPI[arith].ptInit == NULL) {
+        return OS_ERRNO_MEM_ARITH_INVALID;
+    }
+    api = &g_memArithAPI[arith];
+
+    if (addr == NULL) {
+        return OS_ERRNO_MEM_INITADDR_ISINVALID;
+    }
+
+    /* 分区控制块从分区内存头部划分 */
+    ptAddr = ALIGN((uintptr_t)addr, sizeof(uintptr_t));
+    if ((ptAddr - (uintptr_t)addr) + sizeof(struct TagMemPtCb) >= size) {
+        return OS_ERRNO_MEM_PTCREATE_SIZE_ISTOOSMALL;
+    }
+    ptSize = size - (U32)((ptAddr - (uintptr_t)addr) + sizeof(struct TagMemPtCb));
+
+    /* ptInit会清零整个区域，检查通过前不能写分区内存，否则会破坏与之重叠的已有分区 */
+    MEM_INIT_IRQ_LOCK(intSave);
+    ret = OsMemPtCheck(ptNo, (uintptr_t)addr, size);
+    if (ret != OS_OK) {
+        MEM_INIT_IRQ_UNLOCK(intSave);
+        return ret;
+    }
+
+    ptCb = (struct TagMemPtCb *)ptAddr;
+    if (memset_s(ptCb, sizeof(struct TagMemPtCb), 0, sizeof(struct TagMemPtCb)) != EOK) {
+        OS_GOTO_SYS_ERROR1();
+    }
+    ptCb->ptNo = ptNo;
+    ptCb->arith = arith;
+    ptCb->api = api;
+
+    ret = api->ptInit(ptCb, ptAddr + sizeof(struct TagMemPtCb), ptSize);
+    if (ret != OS_OK) {
+        MEM_INIT_IRQ_UNLOCK(intSave);
+        return ret;
+    }
+
+    /* 挂到链表头，读者无锁遍历，next需在发布前设置好 */
+    ptCb->next = g_memDefaultPt.next;
+    g_memDefaultPt.next = ptCb;
+    MEM_INIT_IRQ_UNLOCK(intSave);
+
+    return OS_OK;
+}
+
+OS_SEC_TEXT U32 PRT_MemGetStats(U8 ptNo, struct MemStats *stats)
+{
+    uintptr_t intSave;
+    struct TagMemPtCb *ptCb = NULL;
+
+    if (stats == NULL) {
+        return OS_ERRNO_MEM_PTINFO_PTR_NULL;
+    }
+
+    ptCb = OsMemPtGet(ptNo);
+    if (ptCb == NULL) {
+        return OS_ERRNO_MEM_PTNO_INVALID;
+    }
+
+    (void)memset_s(stats, sizeof(struct MemStats), 0, sizeof(struct MemStats));
+
+    MEM_PT_IRQ_LOCK(ptCb, intSave);
+    (void)memcpy_s(stats->mid, sizeof(stats->mid), ptCb->midStat, sizeof(ptCb->midStat));
+#if defined(OS_OPTION_MEM_CACHE)
+    if (ptCb == &g_memDefaultPt) {
+        OsMemCacheStatMerge(stats->mid);
+    }
+#endif
+    ptCb->api->fragStat(ptCb, stats);
+    MEM_PT_IRQ_UNLOCK(ptCb, intSave);
+
+    return OS_OK;
+}
+
+OS_SEC_TEXT U32 PRT_MemPtGetInfo(U8 ptNo, struct MemPtInfo *ptInfo)
+{
+    uintptr_t intSave;
+    struct TagMemPtCb *ptCb = NULL;
+
+    if (ptInfo == NULL) {
+        return OS_ERRNO_MEM_PTINFO_PTR_NULL;
+    }
+
+    ptCb = OsMemPtGet(ptNo);
+    if (ptCb == NULL) {
+        return OS_ERRNO_MEM_PTNO_INVALID;
+    }
+
+    MEM_PT_IRQ_LOCK(ptCb, intSave);
+    ptInfo->arith = ptCb->arith;
+    ptInfo->startAddr = ptCb->startAddr;
+    ptInfo->totalSize = ptCb->totalSize;
+    ptInfo->usedSize = ptCb->usage;
+    ptInfo->peakUsage = ptCb->peakUsage;
+    MEM_PT_IRQ_UNLOCK(ptCb, intSave);
+
+    return OS_OK;
+}
@@ -19,28 +19,211 @@
 #include "prt_attr_external.h"
 #include "prt_lib_external.h"
 #include "prt_cpu_external.h"
+#include "prt_raw_spinlock_external.h"
 
 /*
  * 模块内宏定义
  */
 #define OS_MEM_ADDR_ALIGN_TYPE_TO_SIZE(size) (0x1UL << (U32)(size))
 
+/* SMP下分区可被各核同时访问，除关本核中断外还需要持有分区自旋锁 */
+#if defined(OS_OPTION_SMP)
+#define MEM_PT_LOCK(ptCb)    OS_MCMUTEX_LOCK(0, &(ptCb)->lock)
+#define MEM_PT_UNLOCK(ptCb)    OS_MCMUTEX_UNLOCK(0, &(ptCb)->lock)
+#define MEM_PT_IRQ_LOCK(ptCb, intSave)    OS_MCMUTEX_IRQ_LOCK(0, &(ptCb)->lock, (intSave))
+#define MEM_PT_IRQ_UNLOCK(ptCb, intSave)    OS_MCMUTEX_IRQ_UNLOCK(0, &(ptCb)->lock, (intSave))
+#define MEM_INIT_IRQ_LOCK(intSave)    OS_MCMUTEX_IRQ_LOCK(0, &g_mcInitGuard, (intSave))
+#define MEM_INIT_IRQ_UNLOCK(intSave)    OS_MCMUTEX_IRQ_UNLOCK(0, &g_mcInitGuard, (intSave))
+#else
+#define MEM_PT_LOCK(ptCb)    (void)(ptCb)
+#define MEM_PT_UNLOCK(ptCb)    (void)(ptCb)
+#define MEM_PT_IRQ_LOCK(ptCb, intSave)    ((intSave) = PRT_HwiLock())
+#define MEM_PT_IRQ_UNLOCK(ptCb, intSave)    PRT_HwiRestore(intSave)
+#define MEM_INIT_IRQ_LOCK(intSave)    ((intSave) = PRT_HwiLock())
+#define MEM_INIT_IRQ_UNLOCK(intSave)    PRT_HwiRestore(intSave)
+#endif
+
+/*
+ * 已用块控制头prev字段的bit8~15记录申请模块的统计索引，bit0~7供每核缓存打标记，
+ * 默认对齐时高16位与对齐偏移复用。
+ */
+#define OS_MEM_BLK_MID_SHIFT 8U
+#define OS_MEM_BLK_MID_MASK ((uintptr_t)0xFFU << OS_MEM_BLK_MID_SHIFT)
+#define OS_MEM_MID_STAT_IDX(mid) (((mid) < (U32)OS_MID_BUTT) ? (mid) : (U32)OS_MID_BUTT)
+
+/* 内存块不属于每核缓存，需要交由分区算法释放 */
+#define OS_MEM_CACHE_BYPASS 1U
+
+struct TagMemPtCb;
+
 /* 申请一个内存块 */
-typedef void *(*MemAllocFunc)(enum MoudleId mid, U8 ptNo, U32 size);
+typedef void *(*MemAllocFunc)(U32 mid, struct TagMemPtCb *ptCb, U32 size);
 
 /* 申请size字节并返回指向已分配内存的指针，内存地址将按照alignPow动态对齐 */
-typedef void *(*MemAllocAlignFunc)(U32 mid, U8 ptNo, U32 size, enum MemAlign alignPow);
+typedef void *(*MemAllocAlignFunc)(U32 mid, struct TagMemPtCb *ptCb, U32 size, enum MemAlign alignPow);
 
 /* 释放一个内存块  */
-typedef U32 (*MemFreeFunc)(void *addr);
+typedef U32 (*MemFreeFunc)(struct TagMemPtCb *ptCb, void *addr);
+
+/* 原地调整一个内存块的大小，不可调整时返回OS_ERRNO_MEM_RESIZE_NO_SPACE */
+typedef U32 (*MemResizeFunc)(struct TagMemPtCb *ptCb, void *addr, U32 size);
+
+/* 遍历空闲链表统计空闲块分布，调用者已持有分区锁 */
+typedef void (*MemFragStatFunc)(struct TagMemPtCb *ptCb, struct MemStats *stats);
+
+/* 在addr起始的size字节上初始化分区，算法控制块从该内存头部划分 */
+typedef U32 (*MemPtInitFunc)(struct TagMemPtCb *ptCb, uintptr_t addr, U32 size);
 
 struct TagMemFuncLib {
     void *addr;        /* 分区起始地址 */
     MemAllocFunc alloc; /* 申请一个内存块 */
     MemAllocAlignFunc allocAlign; /* 申请size字节并返回指向已分配内存的指针，内存地址将按照alignPow动态对齐 */
     MemFreeFunc free;   /* 释放一个内存块 */
+    MemResizeFunc resize; /* 原地调整一个内存块的大小 */
+    MemFragStatFunc fragStat; /* 统计空闲块分布 */
+    MemPtInitFunc ptInit; /* 初始化一个分区 */
+};
+
+/* 分区控制块，缺省分区为静态变量，其余分区位于分区内存头部 */
+struct TagMemPtCb {
+#if defined(OS_OPTION_SMP)
+    /* 分区锁 */
+    volatile uintptr_t lock;
+#endif
+    /* 下一个已创建的分区 */
+    struct TagMemPtCb *next;
+    /* 分区号 */
+    U8 ptNo;
+    /* 分区算法 */
+    enum MemArith arith;
+    /* 分区算法对应API */
+    struct TagMemFuncLib *api;
+    /* 算法私有控制块 */
+    void *arithCb;
+    /* 可分配区域起始地址 */
+    uintptr_t startAddr;
+    /* 可分配区域大小 */
+    uintptr_t totalSize;
+    /* 已使用大小 */
+    uintptr_t usage;
+    /* 使用峰值 */
+    uintptr_t peakUsage;
+    /* 按模块号统计的使用情况 */
+    struct MemMidStat midStat[OS_MEM_STAT_MID_NUM];
 };
 
-extern struct TagMemFuncLib g_memArithAPI; /* 算法对应API */
+extern struct TagMemFuncLib g_memArithAPI[MEM_ARITH_BUTT]; /* 各算法对应API，按enum MemArith索引 */
+extern struct TagMemPtCb g_memDefaultPt;
+extern volatile uintptr_t g_mcInitGuard;
+
+#if defined(OS_OPTION_MEM_CACHE)
+/* 以下接口调用前需已关本核中断 */
+extern void *OsMemCacheAlloc(U32 mid, U8 ptNo, U32 size);
+extern U32 OsMemCacheFree(void *addr);
+extern U32 OsMemCacheFlush(void);
+/* 内存块是否由每核缓存管理，缓存块大小固定，不能原地调整 */
+extern bool OsMemCacheOwned(void *addr);
+/* 将各核缓存的模块统计转移量合并到缺省分区的模块统计中 */
+extern void OsMemCacheStatMerge(struct MemMidStat *mid);
+#endif
+
+#if defined(OS_OPTION_MEM_TLSF)
+extern void OsTlsfMemApiInit(struct TagMemFuncLib *api);
+#endif
+
+extern U32 OsMemPtCheck(U8 ptNo, uintptr_t addr, U32 size);
+
+/* 根据分区号查找分区，缺省分区优先判断，其余分区个数较少，直接遍历 */
+OS_SEC_ALW_INLINE INLINE struct TagMemPtCb *OsMemPtGet(U8 ptNo)
+{
+    struct TagMemPtCb *ptCb = &g_memDefaultPt;
+
+    while (ptCb != NULL) {
+        if (ptCb->ptNo == ptNo && ptCb->api != NULL) {
+            return ptCb;
+        }
+        ptCb = ptCb->next;
+    }
+    return NULL;
+}
+
+/* 根据内存地址查找其所属分区 */
+OS_SEC_ALW_INLINE INLINE struct TagMemPtCb *OsMemPtFind(uintptr_t addr)
+{
+    struct TagMemPtCb *ptCb = &g_memDefaultPt;
+
+    while (ptCb != NULL) {
+        if (addr >= ptCb->startAddr && addr < ptCb->startAddr + ptCb->totalSize) {
+            return ptCb;
+        }
+        ptCb = ptCb->next;
+    }
+    return NULL;
+}
+
+/* 记录已用块的申请模块，并累加分区及模块用量，调用者已持有分区锁 */
+OS_SEC_ALW_INLINE INLINE void OsMemPtUsageAdd(struct TagMemPtCb *ptCb, struct TagFscMemCtrl *blk, U32 mid)
+{
+    U32 idx = OS_MEM_MID_STAT_IDX(mid);
+    struct MemMidStat *stat = &ptCb->midStat[idx];
+
+    blk->prev = (struct TagFscMemCtrl *)(((uintptr_t)blk->prev & ~OS_MEM_BLK_MID_MASK) |
+        ((uintptr_t)idx << OS_MEM_BLK_MID_SHIFT));
+
+    ptCb->usage += blk->size;
+    if (ptCb->peakUsage < ptCb->usage) {
+        ptCb->peakUsage = ptCb->usage;
+    }
+
+    stat->usedSize += blk->size;
+    if (stat->peakSize < stat->usedSize) {
+        stat->peakSize = stat->usedSize;
+    }
+    stat->allocCnt++;
+}
+
+OS_SEC_ALW_INLINE INLINE struct MemMidStat *OsMemBlkMidStat(struct TagMemPtCb *ptCb, struct TagFscMemCtrl *blk)
+{
+    U32 idx = (U32)(((uintptr_t)blk->prev & OS_MEM_BLK_MID_MASK) >> OS_MEM_BLK_MID_SHIFT);
+
+    return &ptCb->midStat[OS_MEM_MID_STAT_IDX(idx)];
+}
+
+/* 已用块释放前扣减分区及模块用量，调用者已持有分区锁 */
+OS_SEC_ALW_INLINE INLINE void OsMemPtUsageSub(struct TagMemPtCb *ptCb, struct TagFscMemCtrl *blk)
+{
+    struct MemMidStat *stat = OsMemBlkMidStat(ptCb, blk);
+
+    ptCb->usage -= blk->size;
+    stat->usedSize -= blk->size;
+    stat->freeCnt++;
+}
+
+/* 已用块原地调整大小后更新用量，调用者已持有分区锁 */
+OS_SEC_ALW_INLINE INLINE void OsMemPtUsageResize(struct TagMemPtCb *ptCb, struct TagFscMemCtrl *blk, uintptr_t oldSize)
+{
+    struct MemMidStat *stat = OsMemBlkMidStat(ptCb, blk);
+
+    ptCb->usage = ptCb->usage - oldSize + blk->size;
+    if (ptCb->peakUsage < ptCb->usage) {
+        ptCb->peakUsage = ptCb->usage;
+    }
+
+    stat->usedSize = stat->usedSize - oldSize + blk->size;
+    if (stat->peakSize < stat->usedSize) {
+        stat->peakSize = stat->usedSize;
+    }
+}
+
+/* 将一个空闲块计入空闲块分布统计 */
+OS_SEC_ALW_INLINE INLINE void OsMemFragStatAdd(struct MemStats *stats, uintptr_t size)
+{
+    stats->freeBlkNum[31U - OsGetLmb1((U32)size)]++;
+    stats->freeBlkTotal++;
+    stats->freeSize += size;
+    if (stats->maxFreeBlk < size) {
+        stats->maxFreeBlk = size;
+    }
+}
 
 #endif /* PRT_MEM_INTERNAL_H */
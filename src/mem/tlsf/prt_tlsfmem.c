@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-06-20
+ * Description: TLSF(两级分离适配)内存算法实现，申请和释放均不遍历空闲链表
+ */
+#include "prt_tlsfmem_internal.h"
+
+/* 判断初始化内存地址和大小是否为指针宽度对齐 */
+#define OS_MEM_GETBIT(addr) (addr & (uintptr_t)(sizeof(uintptr_t) - 1))
+
+/*
+ * 描述：查找满足size的空闲块，仅做两次位图查找，不遍历链表
+ */
+OS_SEC_TEXT struct TagFscMemCtrl *OsTlsfMemSearch(struct TagTlsfMemPt *tlsfPt, U32 size)
+{
+    U32 fl;
+    U32 sl;
+    U32 slMap;
+    U32 flMap;
+
+    OsTlsfMappingSearch(size, &fl, &sl);
+    if (fl >= OS_TLSF_FL_NUM) {
+        return NULL;
+    }
+
+    /* 同一一级区间内更大的子区间 */
+    slMap = tlsfPt->slBitMap[fl] & (~0U << sl);
+    if (slMap == 0) {
+        /* 更大的一级区间，取其中最小的非空子区间 */
+        flMap = tlsfPt->flBitMap & (~0U << (fl + 1));
+        if (flMap == 0) {
+            return NULL;
+        }
+
+        fl = OsTlsfFfs(flMap);
+        slMap = tlsfPt->slBitMap[fl];
+    }
+    sl = OsTlsfFfs(slMap);
+
+    return tlsfPt->freeList[fl][sl];
+}
+
+OS_SEC_TEXT void *OsTlsfMemAllocInner(U32 mid, struct TagMemPtCb *ptCb, U32 size, uintptr_t align)
+{
+    U32 allocSize;
+    U32 *blkTailMagic = NULL;
+    uintptr_t usrAddr;
+    struct TagTlsfMemPt *tlsfPt = (struct TagTlsfMemPt *)ptCb->arithCb;
+    struct TagFscMemCtrl *currBlk = NULL;
+    struct TagFscMemCtrl *plotBlk = NULL;
+    struct TagFscMemCtrl *nextBlk = NULL;
+
+    if (size == 0) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_ALLOC_SIZE_ZERO);
+        return NULL;
+    }
+
+    if (align < sizeof(uintptr_t)) {
+        align = sizeof(uintptr_t);
+    }
+
+    /* 与FSC相同，预留对齐可能补齐的大小及控制头、尾部魔术字 */
+    allocSize = ALIGN(size, OS_TLSF_MEM_SIZE_ALIGN) + (align - OS_TLSF_MEM_SIZE_ALIGN) +
+        OS_FSC_MEM_USED_HEAD_SIZE + OS_FSC_MEM_TAIL_SIZE;
+    if ((allocSize < size) || allocSize >= ((OS_TLSF_MEM_MAXVAL - OS_FSC_MEM_USED_HEAD_SIZE) - OS_FSC_MEM_TAIL_SIZE)) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_ALLOC_SIZETOOLARGE);
+        return NULL;
+    }
+
+    currBlk = OsTlsfMemSearch(tlsfPt, allocSize);
+    if (currBlk == NULL) {
+        OS_REPORT_ERROR(OS_ERRNO_FSCMEM_ALLOC_NO_MEMORY);
+        return NULL;
+    }
+    OsTlsfMemDelete(tlsfPt, currBlk);
+
+    /* 前部分配给用户，剩余部分作为新的空闲块挂回 */
+    if (OS_FSC_MEM_SZGET(currBlk) >= (allocSize + OS_TLSF_MEM_MIN_SIZE)) {
+        plotBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)allocSize);
+        plotBlk->size = currBlk->size - allocSize;
+        plotBlk->prevSize = 0;
+        OsTlsfMemInsert(tlsfPt, plotBlk);
+
+        nextBlk = (struct TagFscMemCtrl *)((uintptr_t)plotBlk + (uintptr_t)plotBlk->size);
+        nextBlk->prevSize = plotBlk->size;
+        currBlk->size = allocSize;
+    } else {
+        nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)currBlk->size);
+        nextBlk->prevSize = 0;
+    }
+
+    currBlk->next = OS_FSC_MEM_MAGIC_USED;
+
+    /* 设置内存越界检查魔术字 */
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + (uintptr_t)currBlk->size - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    *blkTailMagic = OS_FSC_MEM_TAIL_MAGIC;
+
+    // currBlk->prev 复用为内存对齐的偏移地址
+    currBlk->prev = 0;
+    usrAddr = (((uintptr_t)currBlk + OS_FSC_MEM_SLICE_HEAD_SIZE + align - 1) & ~(align - 1));
+    OsMemSetHeadAddr(usrAddr, ((uintptr_t)currBlk + OS_FSC_MEM_SLICE_HEAD_SIZE));
+    OsMemPtUsageAdd(ptCb, currBlk, mid);
+    return (void *)usrAddr;
+}
+
+OS_SEC_TEXT U32 OsTlsfMemFree(struct TagMemPtCb *ptCb, void *addr)
+{
+    struct TagTlsfMemPt *tlsfPt = (struct TagTlsfMemPt *)ptCb->arithCb;
+    struct TagFscMemCtrl *prevBlk = NULL; /* 前一内存块指针 */
+    struct TagFscMemCtrl *currBlk = NULL; /* 当前内存块指针 */
+    struct TagFscMemCtrl *nextBlk = NULL; /* 后一内存块指针 */
+    U32 *blkTailMagic = NULL;
+    uintptr_t blkSize;
+
+    if (addr == NULL) {
+        return OS_ERRNO_MEM_FREE_ADDR_INVALID;
+    }
+
+    currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+    blkSize = currBlk->size;
+
+    if ((currBlk->next != OS_FSC_MEM_MAGIC_USED) || (currBlk->size == 0)) {
+        return OS_ERRNO_MEM_FREE_SH_DAMAGED;
+    }
+
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + blkSize - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    if (*blkTailMagic != OS_FSC_MEM_TAIL_MAGIC) {
+        return OS_ERRNO_MEM_OVERWRITE;
+    }
+
+    /* 合并时控制头会被清除，先扣减用量 */
+    OsMemPtUsageSub(ptCb, currBlk);
+    nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + blkSize);
+
+    /* 后一内存块未使用，当前模块释放后与其合并 */
+    if (nextBlk->next != OS_FSC_MEM_MAGIC_USED) {
+        OsTlsfMemDelete(tlsfPt, nextBlk);
+
+        currBlk->size += nextBlk->size;
+
+        if (memset_s(nextBlk, sizeof(struct TagFscMemCtrl), 0, sizeof(struct TagFscMemCtrl)) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+    }
+
+    /* 前一内存块未使用，当前内存模块与其合并，先按原大小摘链 */
+    if (currBlk->prevSize != 0) {
+        prevBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk - (uintptr_t)currBlk->prevSize);
+        OsTlsfMemDelete(tlsfPt, prevBlk);
+
+        prevBlk->size += currBlk->size;
+
+        if (memset_s(currBlk, sizeof(struct TagFscMemCtrl), 0, sizeof(struct TagFscMemCtrl)) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+        currBlk = prevBlk;
+    }
+
+    /* 合并后的总内存块插入链表 */
+    OsTlsfMemInsert(tlsfPt, currBlk);
+
+    nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)currBlk->size);
+    nextBlk->prevSize = currBlk->size;
+
+    return OS_OK;
+}
+
+/*
+ * 描述：原地调整内存块大小，缩小时切出尾部空闲块，扩大时并入后一相邻空闲块
+ */
+OS_SEC_TEXT U32 OsTlsfMemResize(struct TagMemPtCb *ptCb, void *addr, U32 size)
+{
+    struct TagTlsfMemPt *tlsfPt = (struct TagTlsfMemPt *)ptCb->arithCb;
+    struct TagFscMemCtrl *currBlk = NULL;
+    struct TagFscMemCtrl *nextBlk = NULL;
+    struct TagFscMemCtrl *plotBlk = NULL;
+    U32 *blkTailMagic = NULL;
+    uintptr_t blkSize;
+    uintptr_t newSize;
+    uintptr_t totalSize;
+
+    currBlk = (struct TagFscMemCtrl *)OsMemGetHeadAddr((uintptr_t)addr);
+    blkSize = currBlk->size;
+    if ((currBlk->next != OS_FSC_MEM_MAGIC_USED) || (blkSize == 0)) {
+        return OS_ERRNO_MEM_FREE_SH_DAMAGED;
+    }
+
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + blkSize - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    if (*blkTailMagic != OS_FSC_MEM_TAIL_MAGIC) {
+        return OS_ERRNO_MEM_OVERWRITE;
+    }
+
+    if (size >= OS_TLSF_MEM_MAXVAL) {
+        return OS_ERRNO_MEM_ALLOC_SIZETOOLARGE;
+    }
+
+    /* 用户地址相对控制头的偏移保持不变 */
+    newSize = ((uintptr_t)addr - (uintptr_t)currBlk) + ALIGN(size, OS_TLSF_MEM_SIZE_ALIGN) + OS_FSC_MEM_TAIL_SIZE;
+    nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + blkSize);
+    totalSize = blkSize;
+
+    if (newSize > blkSize) {
+        if ((nextBlk->next == OS_FSC_MEM_MAGIC_USED) || (blkSize + nextBlk->size < newSize)) {
+            return OS_ERRNO_MEM_RESIZE_NO_SPACE;
+        }
+        OsTlsfMemDelete(tlsfPt, nextBlk);
+        totalSize += nextBlk->size;
+        nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + totalSize);
+    } else if (nextBlk->next != OS_FSC_MEM_MAGIC_USED) {
+        /* 缩小时后一块空闲，切出的部分与其合并 */
+        OsTlsfMemDelete(tlsfPt, nextBlk);
+        totalSize += nextBlk->size;
+        if (memset_s(nextBlk, sizeof(struct TagFscMemCtrl), 0, sizeof(struct TagFscMemCtrl)) != EOK) {
+            OS_GOTO_SYS_ERROR1();
+        }
+        nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + totalSize);
+    }
+
+    if (totalSize >= newSize + OS_TLSF_MEM_MIN_SIZE) {
+        plotBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + newSize);
+        plotBlk->size = totalSize - newSize;
+        plotBlk->prevSize = 0;
+        OsTlsfMemInsert(tlsfPt, plotBlk);
+        nextBlk->prevSize = plotBlk->size;
+        currBlk->size = newSize;
+    } else {
+        nextBlk->prevSize = 0;
+        currBlk->size = totalSize;
+    }
+
+    blkTailMagic = (U32 *)((uintptr_t)currBlk + currBlk->size - (uintptr_t)OS_FSC_MEM_TAIL_SIZE);
+    *blkTailMagic = OS_FSC_MEM_TAIL_MAGIC;
+
+    OsMemPtUsageResize(ptCb, currBlk, blkSize);
+    return OS_OK;
+}
+
+/*
+ * 描述：按两级位图遍历非空的空闲链表，统计空闲块分布
+ */
+OS_SEC_TEXT void OsTlsfMemFragStat(struct TagMemPtCb *ptCb, struct MemStats *stats)
+{
+    U32 fl;
+    U32 sl;
+    U32 flMap;
+    U32 slMap;
+    struct TagTlsfMemPt *tlsfPt = (struct TagTlsfMemPt *)ptCb->arithCb;
+    struct TagFscMemCtrl *currBlk = NULL;
+
+    for (flMap = tlsfPt->flBitMap; flMap != 0; flMap &= flMap - 1) {
+        fl = OsTlsfFfs(flMap);
+        for (slMap = tlsfPt->slBitMap[fl]; slMap != 0; slMap &= slMap - 1) {
+            sl = OsTlsfFfs(slMap);
+            for (currBlk = tlsfPt->freeList[fl][sl]; currBlk != NULL; currBlk = currBlk->next) {
+                OsMemFragStatAdd(stats, currBlk->size);
+            }
+        }
+    }
+}
+
+OS_SEC_TEXT void *OsTlsfMemAlloc(U32 mid, struct TagMemPtCb *ptCb, U32 size)
+{
+    return OsTlsfMemAllocInner(mid, ptCb, size, OS_TLSF_MEM_SIZE_ALIGN);
+}
+
+OS_SEC_TEXT void *OsTlsfMemAllocAlign(U32 mid, struct TagMemPtCb *ptCb, U32 size, enum MemAlign alignPow)
+{
+    if (alignPow >= MEM_ADDR_BUTT || alignPow < MEM_ADDR_ALIGN_004) {
+        OS_REPORT_ERROR(OS_ERRNO_MEM_ALLOC_ALIGNPOW_INVALID);
+        return NULL;
+    }
+    return OsTlsfMemAllocInner(mid, ptCb, size, (1U << (U32)alignPow));
+}
+
+/*
+ * 描述：用户创建的TLSF分区，TLSF控制块从分区内存头部划分
+ */
+OS_SEC_TEXT U32 OsTlsfMemPtInit(struct TagMemPtCb *ptCb, uintptr_t addr, U32 size)
+{
+    struct TagTlsfMemPt *tlsfPt = (struct TagTlsfMemPt *)addr;
+    struct TagFscMemCtrl *currBlk = NULL;
+    struct TagFscMemCtrl *nextBlk = NULL;
+
+    if ((void *)(uintptr_t)addr == NULL) {
+        return OS_ERRNO_MEM_INITADDR_ISINVALID;
+    }
+
+    if (OS_MEM_GETBIT(addr) != 0U) {
+        return OS_ERRNO_MEM_INITADDR_INVALID;
+    }
+
+    if (size <= sizeof(struct TagTlsfMemPt) + OS_FSC_MEM_USED_HEAD_SIZE + OS_TLSF_MEM_MIN_SIZE) {
+        return OS_ERRNO_MEM_PTCREATE_SIZE_ISTOOSMALL;
+    }
+
+    if (size > OS_TLSF_MEM_MAXVAL) {
+        return OS_ERRNO_MEM_PTCREATE_SIZE_ISTOOBIG;
+    }
+
+    if (memset_s((void *)(uintptr_t)addr, size, 0, size) != EOK) {
+        OS_GOTO_SYS_ERROR1();
+    }
+
+    addr += sizeof(struct TagTlsfMemPt);
+    size = ((size - (U32)sizeof(struct TagTlsfMemPt)) & ~(U32)(sizeof(uintptr_t) - 1)) - OS_FSC_MEM_USED_HEAD_SIZE;
+
+    /* 整个可用区域作为一个空闲块，尾部预留一个已用控制头作为边界 */
+    currBlk = (struct TagFscMemCtrl *)(uintptr_t)addr;
+    currBlk->prevSize = 0;
+    currBlk->size = size;
+    OsTlsfMemInsert(tlsfPt, currBlk);
+
+    nextBlk = (struct TagFscMemCtrl *)((uintptr_t)currBlk + (uintptr_t)currBlk->size);
+    nextBlk->next = OS_FSC_MEM_MAGIC_USED;
+    nextBlk->size = 0;
+
+    ptCb->arithCb = tlsfPt;
+    ptCb->startAddr = addr;
+    ptCb->totalSize = (uintptr_t)size;
+    ptCb->usage = 0;
+    ptCb->peakUsage = 0;
+
+    return OS_OK;
+}
+
+/*
+ * 描述：注册TLSF算法API，由缺省分区初始化时调用
+ */
+OS_SEC_TEXT void OsTlsfMemApiInit(struct TagMemFuncLib *api)
+{
+    api->alloc = OsTlsfMemAlloc;
+    api->allocAlign = OsTlsfMemAllocAlign;
+    api->free = OsTlsfMemFree;
+    api->resize = OsTlsfMemResize;
+    api->fragStat = OsTlsfMemFragStat;
+    api->ptInit = OsTlsfMemPtInit;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-06-20
+ * Description: TLSF内存算法模块的模块内头文件。
+ */
+#ifndef PRT_TLSFMEM_INTERNAL_H
+#define PRT_TLSFMEM_INTERNAL_H
+
+#include "prt_fscmem_external.h"
+#include "prt_cpu_external.h"
+#include "prt_lib_external.h"
+#include "../prt_mem_internal.h"
+
+/*
+ * 模块内宏定义
+ */
+/* 每个一级区间再按二级划分为2^OS_TLSF_SL_SHIFT个子区间 */
+#define OS_TLSF_SL_SHIFT 4U
+#define OS_TLSF_SL_NUM (1U << OS_TLSF_SL_SHIFT)
+
+/* 小于OS_TLSF_SMALL_SIZE的块全部落在一级索引0，二级按OS_TLSF_SMALL_STEP线性划分 */
+#define OS_TLSF_FL_SHIFT (OS_TLSF_SL_SHIFT + 3U)
+#define OS_TLSF_SMALL_SIZE (1U << OS_TLSF_FL_SHIFT)
+#define OS_TLSF_SMALL_STEP (OS_TLSF_SMALL_SIZE / OS_TLSF_SL_NUM)
+
+/* 块大小上限与FSC一致，小于2^OS_FSC_MEM_LAST_IDX */
+#define OS_TLSF_FL_NUM (OS_FSC_MEM_LAST_IDX - OS_TLSF_FL_SHIFT + 1U)
+
+#define OS_TLSF_MEM_SIZE_ALIGN OS_MEM_ADDR_ALIGN
+#define OS_TLSF_MEM_MIN_SIZE (OS_FSC_MEM_SLICE_HEAD_SIZE + OS_TLSF_MEM_SIZE_ALIGN)
+#define OS_TLSF_MEM_MAXVAL ((1U << OS_FSC_MEM_LAST_IDX) - OS_TLSF_MEM_SIZE_ALIGN)
+
+/*
+ * 模块内结构体定义
+ */
+/*
+ * TLSF算法分区控制块。
+ * 内存块沿用struct TagFscMemCtrl控制头和尾部魔术字，空闲块的next/prev为所在空闲链表的前后节点，
+ * 链表以NULL结尾；已用块的next为OS_FSC_MEM_MAGIC_USED。
+ */
+struct TagTlsfMemPt {
+    /* 第fl位置位表示slBitMap[fl]非0 */
+    U32 flBitMap;
+    /* 第sl位置位表示freeList[fl][sl]非空 */
+    U32 slBitMap[OS_TLSF_FL_NUM];
+    struct TagFscMemCtrl *freeList[OS_TLSF_FL_NUM][OS_TLSF_SL_NUM];
+};
+
+/*
+ * 模块内内联函数定义
+ */
+/* 最高置位bit序号，value非0，编译为单条CLZ指令 */
+OS_SEC_ALW_INLINE INLINE U32 OsTlsfFls(U32 value)
+{
+    return 31U - (U32)__builtin_clz(value);
+}
+
+/* 最低置位bit序号，value非0 */
+OS_SEC_ALW_INLINE INLINE U32 OsTlsfFfs(U32 value)
+{
+    return (U32)__builtin_ctz(value);
+}
+
+/* 计算块大小所属的空闲链表，用于插入和删除 */
+OS_SEC_ALW_INLINE INLINE void OsTlsfMapping(U32 size, U32 *fl, U32 *sl)
+{
+    U32 bit;
+
+    if (size < OS_TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size / OS_TLSF_SMALL_STEP;
+        return;
+    }
+
+    bit = OsTlsfFls(size);
+    *sl = (size >> (bit - OS_TLSF_SL_SHIFT)) ^ OS_TLSF_SL_NUM;
+    *fl = bit - (OS_TLSF_FL_SHIFT - 1U);
+}
+
+/* 申请时先将大小向上取整到所属子区间的上界，保证找到的链表中任一块都满足申请 */
+OS_SEC_ALW_INLINE INLINE void OsTlsfMappingSearch(U32 size, U32 *fl, U32 *sl)
+{
+    if (size < OS_TLSF_SMALL_SIZE) {
+        size = ALIGN(size, OS_TLSF_SMALL_STEP);
+    } else {
+        size += (1U << (OsTlsfFls(size) - OS_TLSF_SL_SHIFT)) - 1U;
+    }
+
+    OsTlsfMapping(size, fl, sl);
+}
+
+OS_SEC_ALW_INLINE INLINE void OsTlsfMemInsert(struct TagTlsfMemPt *tlsfPt, struct TagFscMemCtrl *currBlk)
+{
+    U32 fl;
+    U32 sl;
+    struct TagFscMemCtrl *headBlk = NULL;
+
+    OsTlsfMapping((U32)currBlk->size, &fl, &sl);
+    headBlk = tlsfPt->freeList[fl][sl];
+
+    currBlk->prev = NULL;
+    currBlk->next = headBlk;
+    if (headBlk != NULL) {
+        headBlk->prev = currBlk;
+    }
+    tlsfPt->freeList[fl][sl] = currBlk;
+
+    tlsfPt->flBitMap |= (1U << fl);
+    tlsfPt->slBitMap[fl] |= (1U << sl);
+}
+
+OS_SEC_ALW_INLINE INLINE void OsTlsfMemDelete(struct TagTlsfMemPt *tlsfPt, struct TagFscMemCtrl *currBlk)
+{
+    U32 fl;
+    U32 sl;
+
+    if (currBlk->next != NULL) {
+        currBlk->next->prev = currBlk->prev;
+    }
+
+    if (currBlk->prev != NULL) {
+        currBlk->prev->next = currBlk->next;
+        return;
+    }
+
+    /* 链表头节点，需要更新链表头及位图 */
+    OsTlsfMapping((U32)currBlk->size, &fl, &sl);
+    tlsfPt->freeList[fl][sl] = currBlk->next;
+    if (currBlk->next == NULL) {
+        tlsfPt->slBitMap[fl] &= ~(1U << sl);
+        if (tlsfPt->slBitMap[fl] == 0) {
+            tlsfPt->flBitMap &= ~(1U << fl);
+        }
+    }
+}
+
+#endif /* PRT_TLSFMEM_INTERNAL_H */
@@ -77,7 +77,14 @@ void sys_init(void)
 
 u32_t sys_now(void)
 {
-    return (U32)(((U32)PRT_TickGetCount() * OsSysGetTickPerSecond()) / OsSysGetTickPerSecond());
+    U64 cycle = PRT_ClkGetCycleCount64();
+
+    /* 优先使用cycle计数，精度不受tick周期限制；未注册cycle获取钩子时按tick换算为ms */
+    if (cycle != 0) {
+        return (U32)PRT_ClkCycle2Ms(cycle);
+    }
+
+    return (U32)((PRT_TickGetCount() * OS_SYS_MS_PER_SECOND) / OsSysGetTickPerSecond());
 }
 
 /**
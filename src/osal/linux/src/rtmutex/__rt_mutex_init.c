@@ -5,7 +5,7 @@ void __rt_mutex_init(struct rt_mutex *lock, const char *name, struct lock_class_
 {
     (void)name;
     (void)key;
-    int ret = pthread_mutex_init((pthread_mutex_t *)lock, NULL);
+    int ret = pthread_mutex_init(&lock->mutex, NULL);
     if (ret != 0) {
         printf("[Error] mutex init fail\n");
     }
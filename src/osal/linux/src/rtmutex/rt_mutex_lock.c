@@ -3,7 +3,7 @@
 
 void rt_mutex_lock(struct rt_mutex *lock)
 {
-    int ret = pthread_mutex_lock((pthread_mutex_t *)lock);
+    int ret = pthread_mutex_lock(&lock->mutex);
     if (ret != 0) {
         printf("[Error] mutex lock fail\n");
     }
@@ -3,7 +3,7 @@
 
 void rt_mutex_unlock(struct rt_mutex *lock)
 {
-    int ret = pthread_mutex_unlock((pthread_mutex_t *)lock);
+    int ret = pthread_mutex_unlock(&lock->mutex);
     if (ret != 0) {
         printf("[Error] mutex lock fail\n");
     }
@@ -1,6 +1,7 @@
 #include <linux/wait.h>
 #include "prt_sem.h"
 #include "prt_task_external.h"
+#include "prt_task_sched_external.h"
 
 // 参考 OsTaskScan
 void wake_up(struct wait_queue_head *wq_head)
@@ -11,9 +12,12 @@ void wake_up(struct wait_queue_head *wq_head)
     intSave = OsIntLock();
     LIST_FOR_EACH(taskCb, &wq_head->waitList, struct TagTskCb, waitList) {
         ListDelete(&taskCb->waitList);
+        /* OsTskReadyAdd要求持有任务所在rq锁，rt均衡后任务可能迁到其他核，解锁时按任务当前所在核释放 */
+        OsSpinLockTaskRq(taskCb);
         OsTskReadyAdd(taskCb);
         KTHREAD_TSK_STATE_SET(taskCb, TASK_RUNNING);
         TSK_STATUS_CLEAR(taskCb, OS_TSK_WAITQUEUE_PEND);
+        OsSpinUnlockTaskRq(taskCb);
         taskCb = LIST_COMPONENT(&wq_head->waitList, struct TagTskCb, waitList);
     }
     OsTskSchedule();
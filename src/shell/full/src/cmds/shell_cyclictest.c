@@ -7,6 +7,9 @@
 #define LOOP_NUMS_DEFAULT 1000
 
 extern void cyclictest_entry(U64 interval, U64 loopNums);
+#if defined(OS_OPTION_SMP)
+extern void cyclictest_smp_entry(U64 interval, U64 loopNums, U32 threadNum);
+#endif
 
 int OsShellCmdCyclictest(int argc, const char **argv)
 {
@@ -17,6 +20,17 @@ int OsShellCmdCyclictest(int argc, const char **argv)
 
     U64 interval, loopNums;
     char *endptr = NULL;
+#if defined(OS_OPTION_SMP)
+    U32 threadNum;
+    if (argc == 2 && !strcmp("-t", argv[0])) {
+        threadNum = (U32)strtoul(argv[1], &endptr, 0);
+        if (endptr == NULL || *endptr != '\0') {
+            goto invalid_cmd_input;
+        }
+        cyclictest_smp_entry(INTERVAL_US_DEFAULT, LOOP_NUMS_DEFAULT, threadNum);
+        return OS_OK;
+    }
+#endif
     if (argc == 2) {
         if (!strcmp("-i", argv[0])) {
             interval = (U64)strtoul(argv[1], &endptr, 0);
@@ -63,5 +77,8 @@ int OsShellCmdCyclictest(int argc, const char **argv)
 
 invalid_cmd_input:
     printf("\nUsage: cyclictest [-i] [interval] [-l] [loopNum]\n");
+#if defined(OS_OPTION_SMP)
+    printf("       cyclictest -t [threadNum]\n");
+#endif
     return OS_OK;
 }
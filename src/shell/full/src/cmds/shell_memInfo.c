@@ -13,16 +13,49 @@
  */
 
 #include "shcmd.h"
+#include "prt_mem.h"
 
-extern uintptr_t g_memTotalSize;
-extern uintptr_t g_memUsage;
-extern uintptr_t g_memPeakUsage;
-extern uintptr_t g_memStartAddr;
+#define OS_SHELL_MEM_PT_MAX 0xFFU
 
 static double OsShellGetMemUsageRate(uintptr_t usedSize, uintptr_t totalSize) {
     return (usedSize * 100.0 / totalSize);
 }
 
+#if defined(OS_OPTION_MEM_CACHE)
+static void OsShellMemCacheInfo(void)
+{
+    U32 coreId;
+    U32 idx;
+    struct MemCacheStat stat;
+
+    PRINTK("\nCore  BlkSize  Cached  AllocHit              AllocMiss             FreeHit               FreeDrain\n");
+    PRINTK("----  -------  ------  --------------------  --------------------  --------------------  "
+        "--------------------\n");
+    for (coreId = 0; coreId < OS_MAX_CORE_NUM; coreId++) {
+        for (idx = 0; idx < OS_MEM_CACHE_CLASS_NUM; idx++) {
+            if (PRT_MemCacheGetStat(coreId, idx, &stat) != OS_OK) {
+                break;
+            }
+            PRINTK("%-4u  %-7u  %-6u  %-20llu  %-20llu  %-20llu  %-20llu\n", coreId, stat.blkSize, stat.cachedNum,
+                (unsigned long long)stat.allocHit, (unsigned long long)stat.allocMiss,
+                (unsigned long long)stat.freeHit, (unsigned long long)stat.freeDrain);
+        }
+    }
+}
+#endif
+
+static const char *OsShellMemArithName(enum MemArith arith)
+{
+    switch (arith) {
+        case MEM_ARITH_FSC:
+            return "MEM_ARITH_FSC";
+        case MEM_ARITH_TLSF:
+            return "MEM_ARITH_TLSF";
+        default:
+            return "UNKNOWN";
+    }
+}
+
 int OsShellCmdMemInfo(int argc, const char **argv)
 {
     if (argc > 0) {
@@ -35,20 +68,34 @@ int OsShellCmdMemInfo(int argc, const char **argv)
     PRINTK("-----  ----------------  ----------------  ----------------  ----------  "
         "----------  ----------  ----------  ----------\n");
 
-    double memUsageRate = OsShellGetMemUsageRate(g_memUsage, g_memTotalSize);
-
-    if (sizeof(uintptr_t) == 4) {
-        PRINTK("0      MEM_ARITH_FSC     %#-16x  %#-16x  %-10u  "
-            "%-10u  %-10u  %-10u  %.2fpercent\n",
-            g_memStartAddr, g_memStartAddr + g_memTotalSize - 1, g_memTotalSize,
-            g_memUsage, (g_memTotalSize - g_memUsage), g_memPeakUsage, memUsageRate);
-    } else {
-        PRINTK("0      MEM_ARITH_FSC     %#-16lx  %#-16lx  %-10lu  "
-            "%-10lu  %-10lu  %-10lu  %.2fpercent\n",
-            g_memStartAddr, g_memStartAddr + g_memTotalSize - 1, g_memTotalSize,
-            g_memUsage, (g_memTotalSize - g_memUsage), g_memPeakUsage, memUsageRate);
+    U32 ptNo;
+    double memUsageRate;
+    struct MemPtInfo ptInfo;
+
+    /* 分区号不连续，逐个查询已创建的分区 */
+    for (ptNo = 0; ptNo < OS_SHELL_MEM_PT_MAX; ptNo++) {
+        if (PRT_MemPtGetInfo((U8)ptNo, &ptInfo) != OS_OK) {
+            continue;
+        }
+
+        memUsageRate = OsShellGetMemUsageRate(ptInfo.usedSize, ptInfo.totalSize);
+        if (sizeof(uintptr_t) == 4) {
+            PRINTK("%-5u  %-16s  %#-16x  %#-16x  %-10u  "
+                "%-10u  %-10u  %-10u  %.2fpercent\n", ptNo, OsShellMemArithName(ptInfo.arith),
+                ptInfo.startAddr, ptInfo.startAddr + ptInfo.totalSize - 1, ptInfo.totalSize,
+                ptInfo.usedSize, (ptInfo.totalSize - ptInfo.usedSize), ptInfo.peakUsage, memUsageRate);
+        } else {
+            PRINTK("%-5u  %-16s  %#-16lx  %#-16lx  %-10lu  "
+                "%-10lu  %-10lu  %-10lu  %.2fpercent\n", ptNo, OsShellMemArithName(ptInfo.arith),
+                ptInfo.startAddr, ptInfo.startAddr + ptInfo.totalSize - 1, ptInfo.totalSize,
+                ptInfo.usedSize, (ptInfo.totalSize - ptInfo.usedSize), ptInfo.peakUsage, memUsageRate);
+        }
     }
 
+#if defined(OS_OPTION_MEM_CACHE)
+    OsShellMemCacheInfo();
+#endif
+
     return OS_OK;
 }
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Technologies Co., Ltd. All rights reserved.
+ *
+ * UniProton is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ * 	http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * See the Mulan PSL v2 for more details.
+ * Create: 2024-06-24
+ * Description: memStat命令行实现
+ */
+
+#include "shcmd.h"
+#include "prt_mem.h"
+
+static struct MemStats g_shellMemStats;
+
+static void ShowMemMidStats(struct MemStats *stats)
+{
+    U32 mid;
+
+    PRINTK("Mid   UsedSize    PeakSize    AllocCnt    FreeCnt\n");
+    PRINTK("----  ----------  ----------  ----------  ----------\n");
+    for (mid = 0; mid < OS_MEM_STAT_MID_NUM; mid++) {
+        if (stats->mid[mid].allocCnt == 0) {
+            continue;
+        }
+        if (mid == OS_MID_BUTT) {
+            PRINTK("%-4s  ", "oth");
+        } else {
+            PRINTK("%-4u  ", mid);
+        }
+        PRINTK("%-10lu  %-10lu  %-10u  %-10u\n", (unsigned long)stats->mid[mid].usedSize,
+            (unsigned long)stats->mid[mid].peakSize, stats->mid[mid].allocCnt, stats->mid[mid].freeCnt);
+    }
+}
+
+static void ShowMemFragStats(struct MemStats *stats)
+{
+    U32 idx;
+
+    PRINTK("\nFreeBlkTotal: %u  FreeSize: %lu  MaxFreeBlk: %lu\n", stats->freeBlkTotal,
+        (unsigned long)stats->freeSize, (unsigned long)stats->maxFreeBlk);
+    PRINTK("BlkSize         Count\n");
+    PRINTK("--------------  ----------\n");
+    for (idx = 0; idx < OS_MEM_FRAG_CLASS_NUM; idx++) {
+        if (stats->freeBlkNum[idx] == 0) {
+            continue;
+        }
+        PRINTK("[2^%-2u, 2^%-2u)  %-10u\n", idx, idx + 1, stats->freeBlkNum[idx]);
+    }
+}
+
+int OsShellCmdMemStat(int argc, const char **argv)
+{
+    U32 ret;
+    U32 ptNo = OS_MEM_DEFAULT_FSC_PT;
+    char *endptr = NULL;
+
+    if (argc > 1 || (argc == 1 && !strcmp("--help", argv[0]))) {
+        PRINTK("\nUsage: memStat [ptNo]\n");
+        return OS_OK;
+    }
+
+    if (argc == 1) {
+        ptNo = strtoul(argv[0], &endptr, 0);
+        if (endptr == NULL || endptr == argv[0] || *endptr != '\0' || ptNo > 0xFFU) {
+            PRINTK("Invalid ptNo.\n");
+            return OS_ERROR;
+        }
+    }
+
+    /* 统计结构较大，避免占用shell任务栈 */
+    ret = PRT_MemGetStats((U8)ptNo, &g_shellMemStats);
+    if (ret != OS_OK) {
+        PRINTK("Get pt %u stats failed, ret 0x%x.\n", ptNo, ret);
+        return OS_ERROR;
+    }
+
+    ShowMemMidStats(&g_shellMemStats);
+    ShowMemFragStats(&g_shellMemStats);
+
+    return OS_OK;
+}
+
+SHELLCMD_ENTRY(memStat_shellcmd, CMD_TYPE_EX, "memStat", 0, (CmdCallBackFunc)OsShellCmdMemStat);
@@ -15,6 +15,7 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include <time.h>
 #include "prt_typedef.h"
 #include "prt_attr_external.h"
@@ -30,44 +31,45 @@
 static volatile uintptr_t g_logMemBase = 0;
 static volatile U32 g_sequenceNum = 0;
 static volatile U8 g_logOn = 1;
+static volatile LogDoorbellFunc g_logDoorbell = NULL;
 
 static volatile enum OsLogLevel g_logFilter[LOG_FACILITY_NUM] =
     {OS_LOG_NONE, OS_LOG_NONE, OS_LOG_NONE, OS_LOG_NONE, OS_LOG_NONE, OS_LOG_NONE, OS_LOG_NONE, OS_LOG_NONE};
 
 static OS_SEC_L2_TEXT U32 OsLog(enum OsLogLevel level, enum OsLogFacility facility, const char *str, size_t strLen);
 
-#if defined(OS_OPTION_SMP)
-static struct PrtSpinLock g_logLock;
-static OS_SEC_L2_TEXT uintptr_t OsLogLockOn()
-{
-    return PRT_SplIrqLock(&g_logLock);
-}
-
-static OS_SEC_L2_TEXT void OsLogLockRestore(uintptr_t value)
-{
-    PRT_SplIrqUnlock(&g_logLock, value);
-}
-#else
-static OS_SEC_L2_TEXT uintptr_t OsLogLockOn()
-{
-    return PRT_HwiLock();
-}
-
-static OS_SEC_L2_TEXT void OsLogLockRestore(uintptr_t value)
-{
-    return PRT_HwiRestore(value);
-}
-#endif
-
-OS_SEC_ALW_INLINE INLINE U32 OsAtomicReadU32(volatile void *addr)
-{
-    return *(volatile U32 *)addr;
-}
-
-OS_SEC_ALW_INLINE INLINE void OsAtomicSetU32(volatile void *addr, U32 val)
-{
-    *(volatile U32 *)addr = val;
-}
+/* 已预留的日志记录 */
+struct OsLogSlot {
+    U8 *mem;
+    /* 记录在环中的起始位置，用于生成提交字 */
+    U32 pos;
+    U32 size;
+    U32 sequenceNum;
+};
+
+/* 调用点描述的解析状态 */
+#define OS_LOG_FMT_UNPARSED 0
+#define OS_LOG_FMT_BINARY 1
+#define OS_LOG_FMT_TEXT 2
+
+/* 格式串中的长度修饰 */
+#define OS_LOG_LEN_NONE 0
+#define OS_LOG_LEN_LONG 1
+#define OS_LOG_LEN_LLONG 2
+#define OS_LOG_LEN_SIZE 3
+
+/* 二进制记录的参数类型，决定va_arg的取值方式 */
+enum OsLogArgType {
+    OS_LOG_ARG_INT,
+    OS_LOG_ARG_UINT,
+    OS_LOG_ARG_LONG,
+    OS_LOG_ARG_ULONG,
+    OS_LOG_ARG_LLONG,
+    OS_LOG_ARG_SIZE,
+    OS_LOG_ARG_PTR,
+    OS_LOG_ARG_DOUBLE,
+    OS_LOG_ARG_STR,
+};
 
 OS_SEC_ALW_INLINE INLINE U32 OsCheckLog(enum OsLogLevel level, enum OsLogFacility facility)
 {
@@ -80,17 +82,10 @@ OS_SEC_ALW_INLINE INLINE U32 OsCheckLog(enum OsLogLevel level, enum OsLogFacilit
 /* 只能调用一次 */
 OS_SEC_L2_TEXT U32 PRT_LogInit(uintptr_t memBase)
 {
-    int ret;
     LOAD_FENCE();
     if (g_logMemBase != 0) {
         return 0;
     }
-#if defined(OS_OPTION_SMP)
-    ret = PRT_SplLockInit(&g_logLock);
-    if (ret) {
-        return -1;
-    }
-#endif
     g_logMemBase = memBase;
     STORE_FENCE();
     return 0;
@@ -149,113 +144,147 @@ OS_SEC_L2_TEXT void PRT_LogGetStatus(U8 *switchStat, U8 *levelStat)
     *levelStat = (U8)g_logFilter[0];
 }
 
-static OS_SEC_L2_TEXT void OsLogGetTailAndHead(U32 *head, U32 *tail)
+/* 原子操作，不需要锁 */
+OS_SEC_L2_TEXT void PRT_LogSetDoorbell(LogDoorbellFunc func)
 {
-    /* 保证获取head值时, tail未发生变化 (U32翻转并且刚好回到原点概率过小）*/
-    U32 tail1, tail2, currHead;
-    volatile U32 *const headPtr = (U32 *)(g_logMemBase + HEAD_PTR_OFFSET);
-    volatile U32 *const tailPtr = (U32 *)(g_logMemBase + TAIL_PTR_OFFSET);
-    do {
-        tail1 = OsAtomicReadU32(tailPtr);
-        LOAD_FENCE();
-        currHead = OsAtomicReadU32(headPtr);
-        LOAD_FENCE();
-        tail2 = OsAtomicReadU32(tailPtr);
-    } while (tail1 != tail2);
-    *tail = tail2;
-    *head = currHead;
-    return;
+    g_logDoorbell = func;
 }
 
-static OS_SEC_L2_TEXT U32 OsLogUpdateTail(U32 *tail)
+/*
+ * 无锁预留size字节：tail只在未超出host侧head一圈时才能前移，预留失败的核重新读取tail重试，
+ * 不关中断，不同核之间不串行。记录不跨越环尾，剩余空间不足时连同填充一起预留。
+ */
+static OS_SEC_L2_TEXT U32 OsLogUpdateTail(U32 size, U32 *pos, U32 *padLen)
 {
-    uintptr_t intSave;
-    U32 currHead, currTail;
-    bool isOverflow;
+    U32 currHead, currTail, off, pad;
+    volatile U32 *const headPtr = (U32 *)(g_logMemBase + HEAD_PTR_OFFSET);
     volatile U32 *const tailPtr = (U32 *)(g_logMemBase + TAIL_PTR_OFFSET);
 
-    /* 获取 tail, head, 检查范围, 并更新tail */
-    while (1) {
-        isOverflow = false;
-        OsLogGetTailAndHead(&currHead, &currTail);
-        if (currHead >  U32_MAX - BUFFER_BLOCK_NUM) {
-            isOverflow = true;
-            currTail += 2 * BUFFER_BLOCK_NUM;
-            currHead += 2 * BUFFER_BLOCK_NUM;
-        }
-        if (currTail < currHead || currTail >= currHead + BUFFER_BLOCK_NUM) {
-            /* 范围错误 */
+    currTail = __atomic_load_n(tailPtr, __ATOMIC_ACQUIRE);
+    do {
+        currHead = __atomic_load_n(headPtr, __ATOMIC_ACQUIRE);
+        off = currTail & LOG_RING_MASK;
+        pad = (off + size > LOG_RING_SIZE) ? (LOG_RING_SIZE - off) : 0;
+        /* 无符号差值同时处理了U32翻转 */
+        if ((U32)(currTail - currHead) > LOG_RING_SIZE - size - pad) {
+            /* 范围错误或缓冲区已满 */
             return -1;
         }
-        if (isOverflow) {
-            currTail -= 2 * BUFFER_BLOCK_NUM;
-        }
-        intSave = OsLogLockOn();
-        M_FENCE()
-        /* 检查期间, tail未发生变化, 多核可以用原子操作cmpxchg替换 */
-        if (currTail == OsAtomicReadU32(tailPtr)) {
-            OsAtomicSetU32(tailPtr, currTail + 1);
-            OsLogLockRestore(intSave);
-            *tail = currTail;
-            return 0;
-        }
-        OsLogLockRestore(intSave);
-    }
+    } while (!__atomic_compare_exchange_n(tailPtr, &currTail, currTail + pad + size, false, __ATOMIC_ACQ_REL,
+                                          __ATOMIC_ACQUIRE));
+
+    *pos = currTail;
+    *padLen = pad;
+    return 0;
 }
 
-static OS_SEC_L2_TEXT U32 OsLog(enum OsLogLevel level, enum OsLogFacility facility, const char *str, size_t strLen)
+/* 提交字最后写入，host看到提交字时记录内容已经完整 */
+OS_SEC_ALW_INLINE INLINE void OsLogSetCommit(U8 *mem, U32 pos)
 {
-    uintptr_t intSave;
-    U32 currTail, logIndex, sequenceNum, ret;
-    U8 validFlag;
-    U8 *targetMem;
-    struct logHeader header;
-    TskHandle taskPid = -1;
-    struct timespec ts = {0, 0};
-    volatile U8 *const validPtr = (U8 *)(g_logMemBase + VALID_FLAGS_OFFSET);
+    STORE_FENCE();
+    *(volatile U32 *)mem = pos ^ LOG_COMMIT_MAGIC;
+}
 
-    intSave = OsLogLockOn();
-    /* 多核可以用原子自增替换 */
-    sequenceNum = g_sequenceNum;
-    g_sequenceNum++;
-    OsLogLockRestore(intSave);
+/* 预留一条内容长度为len的记录，返回记录地址 */
+static OS_SEC_L2_TEXT U32 OsLogReserve(struct OsLogSlot *slot, U32 len)
+{
+    U32 pos, pad;
+    struct logHeader *padHeader = NULL;
 
-    if (OsLogUpdateTail(&currTail)) {
+    slot->size = (sizeof(struct logHeader) + len + LOG_RECORD_ALIGN - 1) & ~(LOG_RECORD_ALIGN - 1);
+    slot->sequenceNum = __atomic_fetch_add(&g_sequenceNum, 1, __ATOMIC_RELAXED);
+
+    if (OsLogUpdateTail(slot->size, &pos, &pad)) {
         return -1;
     }
 
-    /* 计算当前的有效标记位, 奇数圈1, 偶数圈0 */
-    logIndex = currTail % (2 * BUFFER_BLOCK_NUM);
-    if (logIndex < BUFFER_BLOCK_NUM) {
-        validFlag = 1;
-    } else {
-        validFlag = 0;
+    if (pad != 0) {
+        /* 填充记录只需要前8字节，host按size跳过 */
+        padHeader = (struct logHeader *)(g_logMemBase + (pos & LOG_RING_MASK));
+        padHeader->size = (U16)pad;
+        padHeader->type = LOG_RECORD_PAD;
+        OsLogSetCommit((U8 *)padHeader, pos);
+        pos += pad;
     }
-    logIndex = logIndex % (BUFFER_BLOCK_NUM);
+
+    slot->pos = pos;
+    slot->mem = (U8 *)g_logMemBase + (pos & LOG_RING_MASK);
+    return 0;
+}
+
+/*
+ * host在睡眠前置位wait并复查环中的记录，device提交后检查wait，两侧之间都有全屏障，
+ * 因此host不会在有紧急日志或已达水线时错过通知。交换wait为0的核负责敲门铃，避免重复通知。
+ */
+static OS_SEC_L2_TEXT void OsLogDoorbell(U32 end, U8 level)
+{
+    U32 head;
+    LogDoorbellFunc func = g_logDoorbell;
+    volatile U32 *const waitPtr = (U32 *)(g_logMemBase + LOG_WAIT_OFFSET);
+    volatile U32 *const headPtr = (U32 *)(g_logMemBase + HEAD_PTR_OFFSET);
+    volatile U32 *const watermarkPtr = (U32 *)(g_logMemBase + LOG_WATERMARK_OFFSET);
+
+    if (func == NULL) {
+        return;
+    }
+
+    M_FENCE();
+    if (*waitPtr == 0) {
+        return;
+    }
+
+    head = *headPtr;
+    if ((level > OS_LOG_ERR) && ((U32)(end - head) < *watermarkPtr)) {
+        return;
+    }
+
+    if (__atomic_exchange_n(waitPtr, 0, __ATOMIC_ACQ_REL) != 0) {
+        func();
+    }
+}
+
+/* 日志内容写入后填写日志头并提交 */
+static OS_SEC_L2_TEXT void OsLogCommit(struct OsLogSlot *slot, U8 type, U8 level, enum OsLogFacility facility,
+                                       U16 len)
+{
+    struct logHeader header;
+    TskHandle taskPid = -1;
+    struct timespec ts = {0, 0};
 
     clock_gettime(CLOCK_REALTIME, &ts);
+    header.commit = 0;
+    header.size = (U16)slot->size;
+    header.type = type;
+    header.level = level;
     header.sec = ts.tv_sec;
     header.nanoSec = ts.tv_nsec;
-    header.sequenceNum = sequenceNum;
+    header.sequenceNum = slot->sequenceNum;
     PRT_TaskSelf(&taskPid);
     header.taskPid = taskPid;
-    header.len = strLen;
+    header.len = len;
     header.facility = facility;
-    header.level = level;
+    header.reserved = 0;
+    (void)memcpy_s(slot->mem + sizeof(U32), sizeof(struct logHeader) - sizeof(U32),
+                   (U8 *)&header + sizeof(U32), sizeof(struct logHeader) - sizeof(U32));
 
-    targetMem = (U8 *)g_logMemBase + (logIndex * BUFFER_BLOCK_SIZE);
-    (void)memcpy_s(targetMem, sizeof(struct logHeader), &header, sizeof(struct logHeader));
-    ret = memcpy_s(targetMem + sizeof(struct logHeader), LOG_MAX_SIZE, str, strLen);
+    OsLogSetCommit(slot->mem, slot->pos);
+    OsLogDoorbell(slot->pos + slot->size, level);
+}
 
-    STORE_FENCE();
+static OS_SEC_L2_TEXT U32 OsLog(enum OsLogLevel level, enum OsLogFacility facility, const char *str, size_t strLen)
+{
+    U32 ret;
+    struct OsLogSlot slot;
+
+    if (OsLogReserve(&slot, (U32)strLen)) {
+        return -1;
+    }
 
-    /* 设置有效标记位 */
-    *(volatile U8 *)(validPtr + logIndex) = validFlag;
+    ret = memcpy_s(slot.mem + sizeof(struct logHeader), LOG_MAX_SIZE, str, strLen);
+    OsLogCommit(&slot, LOG_RECORD_TEXT, (U8)level, facility, (U16)strLen);
     if (ret != EOK) {
         return -1;
     }
-    /* 保证有效标记位及时更新，不然最后一个日志可能获取较慢 */
-    STORE_FENCE();
     return 0;
 }
 
@@ -279,12 +308,30 @@ OS_SEC_L2_TEXT U32 PRT_Log(enum OsLogLevel level, enum OsLogFacility facility, c
     return OsLog(level, facility, str, strLen);
 }
 
-extern U32 PRT_LogFormat(enum OsLogLevel level, enum OsLogFacility facility, const char *fmt, ...)
+static OS_SEC_L2_TEXT U32 OsLogVFormat(enum OsLogLevel level, enum OsLogFacility facility, const char *fmt,
+                                       va_list vaList)
 {
     int len;
-    va_list vaList;
     char buff[BUFFER_BLOCK_SIZE];
 
+    memset_s(buff, BUFFER_BLOCK_SIZE, 0, BUFFER_BLOCK_SIZE);
+    // 字符串格式化由用户负责
+    len = vsnprintf_s(buff, BUFFER_BLOCK_SIZE, BUFFER_BLOCK_SIZE, fmt, vaList);
+    if (len < 0) {
+        return len;
+    }
+
+    if (len > (LOG_MAX_SIZE - 1)) {
+        len = LOG_MAX_SIZE - 1;
+    }
+    return OsLog(level, facility, buff, len);
+}
+
+extern U32 PRT_LogFormat(enum OsLogLevel level, enum OsLogFacility facility, const char *fmt, ...)
+{
+    U32 ret;
+    va_list vaList;
+
     LOAD_FENCE();
     if (g_logMemBase == 0) {
         return -1;
@@ -298,17 +345,285 @@ extern U32 PRT_LogFormat(enum OsLogLevel level, enum OsLogFacility facility, con
         return 0;
     }
 
-    memset_s(buff, BUFFER_BLOCK_SIZE, 0, BUFFER_BLOCK_SIZE);
     va_start(vaList, fmt);
-    // 字符串格式化由用户负责
-    len = vsnprintf_s(buff, BUFFER_BLOCK_SIZE, BUFFER_BLOCK_SIZE, fmt, vaList);
+    ret = OsLogVFormat(level, facility, fmt, vaList);
     va_end(vaList);
-    if (len < 0) {
-        return len;
+    return ret;
+}
+
+/*
+ * 解析格式串，记录每个转换说明对应的参数类型。
+ * 不支持的写法(*宽度、%n、long double、参数过多、格式串过长)整体退化为文本日志。
+ * 解析规则需要和host侧log_main.c中的log_bin_format保持一致。
+ */
+static OS_SEC_L2_TEXT void OsLogFmtParse(struct LogFmtDesc *desc)
+{
+    const char *p = desc->fmt;
+    U32 num = 0;
+    U32 lenMod;
+    bool isSigned;
+    U8 type;
+
+    if (strnlen(desc->fmt, LOG_FMT_MAX_LEN) >= LOG_FMT_MAX_LEN) {
+        goto TEXT;
     }
 
-    if (len > (LOG_MAX_SIZE - 1)) {
-        len = LOG_MAX_SIZE - 1;
+    while (*p != '\0') {
+        if (*p++ != '%') {
+            continue;
+        }
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+        while ((*p != '\0') && (strchr("-+ #0'", *p) != NULL)) {
+            p++;
+        }
+        while (((*p >= '0') && (*p <= '9')) || (*p == '.')) {
+            p++;
+        }
+        if (*p == '*') {
+            goto TEXT;
+        }
+
+        lenMod = OS_LOG_LEN_NONE;
+        while (*p == 'h') {
+            p++;
+        }
+        if (*p == 'l') {
+            lenMod = OS_LOG_LEN_LONG;
+            p++;
+            if (*p == 'l') {
+                lenMod = OS_LOG_LEN_LLONG;
+                p++;
+            }
+        } else if ((*p == 'j') || (*p == 'q')) {
+            lenMod = OS_LOG_LEN_LLONG;
+            p++;
+        } else if ((*p == 'z') || (*p == 't')) {
+            lenMod = OS_LOG_LEN_SIZE;
+            p++;
+        }
+
+        if (num >= OS_LOG_BIN_ARG_MAX) {
+            goto TEXT;
+        }
+
+        isSigned = false;
+        switch (*p) {
+            case 'd':
+            case 'i':
+                isSigned = true;
+                /* fall through */
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'c':
+                if (lenMod == OS_LOG_LEN_LLONG) {
+                    type = OS_LOG_ARG_LLONG;
+                } else if (lenMod == OS_LOG_LEN_SIZE) {
+                    type = OS_LOG_ARG_SIZE;
+                } else if (lenMod == OS_LOG_LEN_LONG) {
+                    type = isSigned ? OS_LOG_ARG_LONG : OS_LOG_ARG_ULONG;
+                } else {
+                    type = isSigned ? OS_LOG_ARG_INT : OS_LOG_ARG_UINT;
+                }
+                break;
+            case 'p':
+                type = OS_LOG_ARG_PTR;
+                break;
+            case 's':
+                type = OS_LOG_ARG_STR;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                type = OS_LOG_ARG_DOUBLE;
+                break;
+            default:
+                goto TEXT;
+        }
+        desc->argType[num++] = type;
+        p++;
     }
-    return OsLog(level, facility, buff, len);
+
+    desc->argNum = (U8)num;
+    __atomic_store_n(&desc->state, OS_LOG_FMT_BINARY, __ATOMIC_RELEASE);
+    return;
+
+TEXT:
+    __atomic_store_n(&desc->state, OS_LOG_FMT_TEXT, __ATOMIC_RELEASE);
+}
+
+/*
+ * 把格式串登记到共享内存格式表，表项为U16长度加格式串，编号为表内偏移加1。
+ * host每次启动会清空格式表并更换纪元，调用点发现纪元变化后重新登记。
+ * 并发登记同一个调用点只会多占一个表项，任一编号都有效。
+ */
+static OS_SEC_L2_TEXT U32 OsLogFmtRegister(struct LogFmtDesc *desc, U32 epoch)
+{
+    U32 off, size;
+    U16 len = (U16)strnlen(desc->fmt, LOG_FMT_MAX_LEN);
+    volatile U32 *const fmtTailPtr = (U32 *)(g_logMemBase + LOG_FMT_TAIL_OFFSET);
+    U8 *const table = (U8 *)(g_logMemBase + LOG_FMT_TABLE_OFFSET);
+
+    size = (sizeof(U16) + len + sizeof(U32) - 1) & ~(sizeof(U32) - 1);
+    off = __atomic_load_n(fmtTailPtr, __ATOMIC_RELAXED);
+    do {
+        if ((off > LOG_FMT_TABLE_SIZE) || (size > LOG_FMT_TABLE_SIZE - off)) {
+            /* 格式表已满 */
+            return -1;
+        }
+    } while (!__atomic_compare_exchange_n(fmtTailPtr, &off, off + size, false, __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
+
+    (void)memcpy_s(table + off, sizeof(U16), &len, sizeof(U16));
+    (void)memcpy_s(table + off + sizeof(U16), len, desc->fmt, len);
+    STORE_FENCE();
+
+    desc->id = off + 1;
+    __atomic_store_n(&desc->epoch, epoch, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/*
+ * 按参数类型打包参数原始值，每个参数占8字节，字符串参数为长度加内容并补齐到8字节。
+ * payload为NULL时只计算长度，返回值为打包后的长度，不超过limit。
+ */
+static OS_SEC_L2_TEXT U32 OsLogBinaryPack(struct LogFmtDesc *desc, va_list vaList, U8 *payload, U32 limit)
+{
+    U32 i;
+    U32 off = sizeof(struct logBinHeader);
+    U64 val;
+    U64 strLen;
+    double dval;
+    const char *str = NULL;
+    struct logBinHeader *bin = (struct logBinHeader *)payload;
+
+    for (i = 0; i < desc->argNum; i++) {
+        if (off + sizeof(U64) > limit) {
+            break;
+        }
+        switch (desc->argType[i]) {
+            case OS_LOG_ARG_INT:
+                val = (U64)(S64)va_arg(vaList, int);
+                break;
+            case OS_LOG_ARG_UINT:
+                val = (U64)va_arg(vaList, unsigned int);
+                break;
+            case OS_LOG_ARG_LONG:
+                val = (U64)(S64)va_arg(vaList, long);
+                break;
+            case OS_LOG_ARG_ULONG:
+                val = (U64)va_arg(vaList, unsigned long);
+                break;
+            case OS_LOG_ARG_LLONG:
+                val = (U64)va_arg(vaList, long long);
+                break;
+            case OS_LOG_ARG_SIZE:
+                val = (U64)va_arg(vaList, size_t);
+                break;
+            case OS_LOG_ARG_PTR:
+                val = (U64)(uintptr_t)va_arg(vaList, void *);
+                break;
+            case OS_LOG_ARG_DOUBLE:
+                dval = va_arg(vaList, double);
+                (void)memcpy_s(&val, sizeof(val), &dval, sizeof(dval));
+                break;
+            default:
+                str = va_arg(vaList, const char *);
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                strLen = strnlen(str, limit - off - sizeof(U64));
+                if (payload != NULL) {
+                    *(U64 *)(payload + off) = strLen;
+                    (void)memcpy_s(payload + off + sizeof(U64), limit - off - sizeof(U64), str, strLen);
+                }
+                off += sizeof(U64) + (U32)((strLen + sizeof(U64) - 1) & ~(sizeof(U64) - 1));
+                continue;
+        }
+        if (payload != NULL) {
+            *(U64 *)(payload + off) = val;
+        }
+        off += sizeof(U64);
+    }
+
+    if (bin != NULL) {
+        bin->fmtId = desc->id;
+        bin->argNum = (U8)i;
+    }
+    return off;
+}
+
+/* 先计算记录长度再按长度预留，参数直接打包到共享内存 */
+static OS_SEC_L2_TEXT U32 OsLogBinaryWrite(enum OsLogLevel level, enum OsLogFacility facility,
+                                           struct LogFmtDesc *desc, va_list vaList)
+{
+    U32 len;
+    va_list sizeList;
+    struct OsLogSlot slot;
+
+    va_copy(sizeList, vaList);
+    len = OsLogBinaryPack(desc, sizeList, NULL, LOG_MAX_SIZE);
+    va_end(sizeList);
+
+    if (OsLogReserve(&slot, len)) {
+        return -1;
+    }
+
+    /* 字符串在两次遍历之间变长时按第一次的长度截断 */
+    len = OsLogBinaryPack(desc, vaList, slot.mem + sizeof(struct logHeader), len);
+    OsLogCommit(&slot, LOG_RECORD_BINARY, (U8)level, facility, (U16)len);
+    return 0;
+}
+
+OS_SEC_L2_TEXT U32 PRT_LogBinary(enum OsLogLevel level, enum OsLogFacility facility, struct LogFmtDesc *desc, ...)
+{
+    U32 ret;
+    U32 epoch;
+    va_list vaList;
+
+    LOAD_FENCE();
+    if (g_logMemBase == 0) {
+        return -1;
+    }
+    if (OsCheckLog(level, facility) || desc == NULL || desc->fmt == NULL) {
+        return -1;
+    }
+
+    /* 检查是否被过滤 */
+    if ((!g_logOn) || (level >= g_logFilter[facility - OS_LOG_F0])) {
+        return 0;
+    }
+
+    if (__atomic_load_n(&desc->state, __ATOMIC_ACQUIRE) == OS_LOG_FMT_UNPARSED) {
+        OsLogFmtParse(desc);
+    }
+
+    va_start(vaList, desc);
+    if (desc->state == OS_LOG_FMT_BINARY) {
+        epoch = __atomic_load_n((volatile U32 *)(g_logMemBase + LOG_FMT_EPOCH_OFFSET), __ATOMIC_ACQUIRE);
+        if ((desc->id != 0) && (__atomic_load_n(&desc->epoch, __ATOMIC_ACQUIRE) == epoch)) {
+            ret = OsLogBinaryWrite(level, facility, desc, vaList);
+            va_end(vaList);
+            return ret;
+        }
+        if (OsLogFmtRegister(desc, epoch) == 0) {
+            ret = OsLogBinaryWrite(level, facility, desc, vaList);
+            va_end(vaList);
+            return ret;
+        }
+    }
+
+    /* 格式串不支持二进制记录或格式表已满时按文本记录 */
+    ret = OsLogVFormat(level, facility, desc->fmt, vaList);
+    va_end(vaList);
+    return ret;
 }
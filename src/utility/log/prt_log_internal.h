@@ -18,26 +18,64 @@
 
 #include "prt_log.h"
 
-#define SHM_USED_SIZE 0x1004200UL // ~16MB
-#define VALID_FLAGS_OFFSET 0x1000000UL
-#define VALID_FLAGS_SIZE 0x4000UL
+#define SHM_USED_SIZE 0x1004300UL // ~16MB
 #define HEAD_PTR_OFFSET 0x1004000UL
 #define TAIL_PTR_OFFSET 0x1004100UL
 
-#define BUFFER_BLOCK_NUM 0x4000UL
-#define BUFFER_BLOCK_SIZE 0x400UL /* 1KB */
+/*
+ * 日志区为16MB的字节环，head和tail为自由增长的字节位置，由host和device分别推进。
+ * 记录按8字节对齐且不跨越环尾，环尾剩余空间不足时先写一条填充记录。
+ */
+#define LOG_RING_SIZE 0x1000000UL
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+#define LOG_RECORD_ALIGN 8U
+#define BUFFER_BLOCK_SIZE 0x400UL /* 单条记录最大1KB，含日志头 */
+
+/* 二进制日志的格式表，由host在启动时清空并更换纪元 */
+#define LOG_FMT_EPOCH_OFFSET 0x1004200UL
+#define LOG_FMT_TAIL_OFFSET 0x1004240UL
+#define LOG_FMT_TABLE_OFFSET 0x1008000UL
+#define LOG_FMT_TABLE_SIZE 0xF8000UL
+#define LOG_FMT_MAX_LEN 0x100UL
+
+/*
+ * 门铃控制字：host睡眠前置位wait，device提交记录后若wait已置位，
+ * 且未读字节数达到水线或日志级别不低于OS_LOG_ERR，则清除wait并通知host。
+ */
+#define LOG_WAIT_OFFSET 0x1004280UL
+#define LOG_WATERMARK_OFFSET 0x10042C0UL
 
+/* 记录提交字为记录起始位置异或该值，host据此判断记录已写完且不是上一圈的残留 */
+#define LOG_COMMIT_MAGIC 0x4C4F4701U
+
+/* 记录类型 */
+#define LOG_RECORD_TEXT 0U
+#define LOG_RECORD_BINARY 1U
+#define LOG_RECORD_PAD 2U
+
+/* 前8字节可单独读取，host据此找到下一条记录 */
 struct logHeader {
+    U32 commit;
+    U16 size;
+    U8 type;
+    U8 level;
     U64 sec;
     U64 nanoSec;
     U64 sequenceNum;
     U32 taskPid;
     U16 len;
     U8 facility;
-    U8 level;
+    U8 reserved;
     U8 logContent[];
 };
 
+/* 二进制记录，位于logContent，之后为argNum个8字节参数，字符串参数为8字节长度加内容并补齐到8字节 */
+struct logBinHeader {
+    U32 fmtId;
+    U8 argNum;
+    U8 reserved[3];
+};
+
 #if defined(OS_ARCH_ARMV7_M) || defined(OS_ARCH_ARMV7_R)
     #define STORE_FENCE() __asm__ __volatile__ ("dmb sy" : : : "memory");
     #define M_FENCE() __asm__ __volatile__ ("dmb sy" : : : "memory");
@@ -1,7 +1,11 @@
 #include <float.h>
+#include <stdio.h>
+#include <string.h>
 #include "prt_task.h"
 #include "prt_sys.h"
 #include "prt_hwi.h"
+#include "prt_sem.h"
+#include "prt_clk.h"
 #include "prt_config.h"
 #include "cpu_config.h"
 
@@ -90,4 +94,179 @@ void cyclictest_entry(U64 interval, U64 loopNums)
         printf("PRT_TaskResume failed, ret = %d\n", ret);
         return;
     }
-}
\ No newline at end of file
+}
+#if defined(OS_OPTION_SMP)
+/*
+ * 多核唤醒时延测试：主线程按周期同时唤醒多个测量线程，测量线程记录从唤醒到得到运行的时延。
+ * 所有线程创建在同一个核上，测量线程可运行在所有核上，主线程绑定在创建核且优先级更高，
+ * 被唤醒的测量线程无法在主线程所在核立即运行。未使能OS_OPTION_SMP_RT_BALANCE时测量线程
+ * 只能在该核上依次运行，使能后被推到空闲核并行运行。
+ */
+#define CYC_SMP_MAX_THREADS 16
+#define CYC_SMP_WORK_US 20
+
+struct CycSmpThread {
+    SemHandle sem;
+    U64 max;
+    U64 sum;
+    U32 cnt;
+    U32 coreSeen;
+};
+
+static struct CycSmpThread g_cycSmpThread[CYC_SMP_MAX_THREADS];
+static SemHandle g_cycSmpDoneSem;
+static volatile U64 g_cycSmpRelease;
+static volatile bool g_cycSmpStop;
+static U32 g_cycSmpThreadNum;
+
+static U32 CyclicSmpCurCore(void)
+{
+    TskHandle self;
+    struct TskInfo info;
+
+    if (PRT_TaskSelf(&self) != OS_OK || PRT_TaskGetInfo(self, &info) != OS_OK) {
+        return 0;
+    }
+    return info.core;
+}
+
+static void CyclicSmpWaiter(uintptr_t idx)
+{
+    struct CycSmpThread *thread = &g_cycSmpThread[idx];
+    U64 workCycle = g_timerFrequency / OS_SYS_US_PER_SECOND * CYC_SMP_WORK_US;
+    U64 now;
+    U64 diff;
+
+    while (PRT_SemPend(thread->sem, OS_WAIT_FOREVER) == OS_OK) {
+        if (g_cycSmpStop) {
+            break;
+        }
+
+        now = PRT_ClkGetCycleCount64();
+        diff = now - g_cycSmpRelease;
+        thread->max = diff > thread->max ? diff : thread->max;
+        thread->sum += diff;
+        thread->cnt++;
+        thread->coreSeen |= 1U << CyclicSmpCurCore();
+
+        /* 模拟实时线程被唤醒后的处理 */
+        while (PRT_ClkGetCycleCount64() - now < workCycle) {
+        }
+        (void)PRT_SemPost(g_cycSmpDoneSem);
+    }
+    (void)PRT_SemPost(g_cycSmpDoneSem);
+}
+
+static void CyclicSmpMaster(void)
+{
+    U32 i;
+    U32 loop_cnt;
+    U64 tick = g_timeIntervalUs / US_PER_TICK + (g_timeIntervalUs % US_PER_TICK > 0);
+    U64 cyclePerUs = g_timerFrequency / OS_SYS_US_PER_SECOND;
+    float worst = 0;
+    float avg;
+
+    printf("\n===cyclictest smp thread start===\n");
+    printf("\ncyclictest smp interval is %llu us, loop num is %llu, thread num is %u\n",
+        g_timeIntervalUs, g_loopNums, g_cycSmpThreadNum);
+    for (loop_cnt = 0; loop_cnt < g_loopNums; loop_cnt++) {
+        if (PRT_TaskDelay((U32)tick) != OS_OK) {
+            printf("\nPRT_TaskDelay failed\n");
+            break;
+        }
+
+        g_cycSmpRelease = PRT_ClkGetCycleCount64();
+        for (i = 0; i < g_cycSmpThreadNum; i++) {
+            (void)PRT_SemPost(g_cycSmpThread[i].sem);
+        }
+        for (i = 0; i < g_cycSmpThreadNum; i++) {
+            (void)PRT_SemPend(g_cycSmpDoneSem, OS_WAIT_FOREVER);
+        }
+    }
+
+    g_cycSmpStop = TRUE;
+    for (i = 0; i < g_cycSmpThreadNum; i++) {
+        (void)PRT_SemPost(g_cycSmpThread[i].sem);
+    }
+    for (i = 0; i < g_cycSmpThreadNum; i++) {
+        (void)PRT_SemPend(g_cycSmpDoneSem, OS_WAIT_FOREVER);
+    }
+
+    for (i = 0; i < g_cycSmpThreadNum; i++) {
+        struct CycSmpThread *thread = &g_cycSmpThread[i];
+        avg = (thread->cnt == 0) ? 0 : (float)(thread->sum / thread->cnt) / (float)cyclePerUs;
+        printf("\nthread %u: max %.2f us, avg %.2f us, cores 0x%x\n", i, (float)thread->max / (float)cyclePerUs,
+            avg, thread->coreSeen);
+        worst = ((float)thread->max / (float)cyclePerUs > worst) ? (float)thread->max / (float)cyclePerUs : worst;
+        (void)PRT_SemDelete(thread->sem);
+    }
+    (void)PRT_SemDelete(g_cycSmpDoneSem);
+    printf("\nWorst wakeup latency is %.2f us\n", worst);
+    printf("\n===cyclictest smp thread finish===\n");
+}
+
+void cyclictest_smp_entry(U64 interval, U64 loopNums, U32 threadNum)
+{
+    U32 ret;
+    U32 i;
+    TskHandle taskId;
+    struct TskInitParam param = {0};
+
+    if (threadNum == 0 || threadNum > CYC_SMP_MAX_THREADS) {
+        printf("thread num should be in [1, %u]\n", CYC_SMP_MAX_THREADS);
+        return;
+    }
+
+    g_timeIntervalUs = interval;
+    g_loopNums = loopNums;
+    g_cycSmpThreadNum = threadNum;
+    g_cycSmpStop = FALSE;
+    (void)memset(g_cycSmpThread, 0, sizeof(g_cycSmpThread));
+
+    ret = PRT_SemCreate(0, &g_cycSmpDoneSem);
+    if (ret) {
+        printf("PRT_SemCreate failed, ret = %d\n", ret);
+        return;
+    }
+
+    param.stackSize = 0x800;
+    param.taskEntry = (TskEntryFunc)CyclicSmpWaiter;
+    param.taskPrio = OS_TSK_PRIORITY_05;
+    param.name = "TASK_CYC_W";
+    for (i = 0; i < threadNum; i++) {
+        ret = PRT_SemCreate(0, &g_cycSmpThread[i].sem);
+        if (ret) {
+            printf("PRT_SemCreate failed, ret = %d\n", ret);
+            return;
+        }
+        param.args[0] = i;
+        ret = PRT_TaskCreate(&taskId, &param);
+        if (ret) {
+            printf("PRT_TaskCreate failed, ret = %d\n", ret);
+            return;
+        }
+        (void)PRT_TaskResume(taskId);
+    }
+
+    param.taskEntry = (TskEntryFunc)CyclicSmpMaster;
+    param.taskPrio = OS_TSK_PRIORITY_04;
+    param.name = "TASK_CYC_M";
+    ret = PRT_TaskCreate(&taskId, &param);
+    if (ret) {
+        printf("PRT_TaskCreate failed, ret = %d\n", ret);
+        return;
+    }
+
+    ret = PRT_TaskCoreBind(taskId, 1U << CyclicSmpCurCore());
+    if (ret) {
+        printf("PRT_TaskCoreBind failed, ret = %d\n", ret);
+        return;
+    }
+
+    ret = PRT_TaskResume(taskId);
+    if (ret) {
+        printf("PRT_TaskResume failed, ret = %d\n", ret);
+        return;
+    }
+}
+#endif
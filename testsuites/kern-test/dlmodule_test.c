@@ -0,0 +1,158 @@
+#include "prt_config.h"
+#include "prt_task.h"
+#include "prt_clk.h"
+#include "securec.h"
+#include "prt_dynamic_module.h"
+#include "kern_test_public.h"
+
+/* 加载基准使用的共享库及其导出函数，文件路径为Linux侧路径，文件不存在时跳过加载计时 */
+#ifndef DLMODULE_TEST_FILE
+#define DLMODULE_TEST_FILE "/opt/libtest.so"
+#endif
+#ifndef DLMODULE_TEST_SYM
+#define DLMODULE_TEST_SYM "GetTest"
+#endif
+
+#define TEST_LOOKUP_ROUND 16
+#define TEST_LOAD_ROUND 8
+
+/* 导出256个测试符号扩大OS符号表，函数返回值与名字中的序号一致，用于校验解析结果 */
+#define TEST_DL_FUNC(n) \
+    U32 test_dl_sym_##n(void) { return 0x##n; } \
+    OS_SYMBOL_EXPORT(test_dl_sym_##n)
+#define TEST_DL_FUNC16(n) \
+    TEST_DL_FUNC(n##0) TEST_DL_FUNC(n##1) TEST_DL_FUNC(n##2) TEST_DL_FUNC(n##3) \
+    TEST_DL_FUNC(n##4) TEST_DL_FUNC(n##5) TEST_DL_FUNC(n##6) TEST_DL_FUNC(n##7) \
+    TEST_DL_FUNC(n##8) TEST_DL_FUNC(n##9) TEST_DL_FUNC(n##a) TEST_DL_FUNC(n##b) \
+    TEST_DL_FUNC(n##c) TEST_DL_FUNC(n##d) TEST_DL_FUNC(n##e) TEST_DL_FUNC(n##f)
+
+TEST_DL_FUNC16(0) TEST_DL_FUNC16(1) TEST_DL_FUNC16(2) TEST_DL_FUNC16(3)
+TEST_DL_FUNC16(4) TEST_DL_FUNC16(5) TEST_DL_FUNC16(6) TEST_DL_FUNC16(7)
+TEST_DL_FUNC16(8) TEST_DL_FUNC16(9) TEST_DL_FUNC16(a) TEST_DL_FUNC16(b)
+TEST_DL_FUNC16(c) TEST_DL_FUNC16(d) TEST_DL_FUNC16(e) TEST_DL_FUNC16(f)
+
+extern int os_symtab_start;
+extern int os_symtab_end;
+extern U64 OsDynModuleFindSymFromOs(const char *symName);
+
+typedef U32 (*test_dl_fn)(void);
+typedef int (*test_dl_get)(void);
+
+/* 改动前的查找方式，作为对比基线 */
+static U64 test_dl_linear_find(const struct DynModuleSymTab *symTab, U32 symNum, const char *symName)
+{
+    U32 i;
+
+    for (i = 0; i < symNum; i++) {
+        if ((symTab[i].name != NULL) && (strcmp(symName, symTab[i].name) == 0)) {
+            return (U64)(uintptr_t)symTab[i].addr;
+        }
+    }
+    return 0;
+}
+
+static int test_dlmodule_os_sym(void)
+{
+    const struct DynModuleSymTab *symTab = (const struct DynModuleSymTab *)&os_symtab_start;
+    U32 symNum = (U32)((const struct DynModuleSymTab *)&os_symtab_end - symTab);
+    U32 round;
+    U32 i;
+    U32 sorted = 1;
+    U64 start;
+    U64 first;
+    U64 hashCost;
+    U64 linearCost;
+    U64 addr;
+    char name[32];
+
+    for (i = 1; i < symNum; i++) {
+        if (strcmp(symTab[i - 1].name, symTab[i].name) >= 0) {
+            sorted = 0;
+        }
+    }
+    TEST_IF_ERR_RET(!sorted, "[dlmodule] os symtab not sorted, check SORT_BY_NAME(.OsSymTab.*) in ld");
+
+    /* 第一次查找包含建立哈希索引的时间 */
+    start = PRT_ClkGetCycleCount64();
+    addr = OsDynModuleFindSymFromOs(symTab[0].name);
+    first = PRT_ClkGetCycleCount64() - start;
+    TEST_IF_ERR_RET(addr != (U64)(uintptr_t)symTab[0].addr, "[dlmodule] first lookup wrong address");
+
+    start = PRT_ClkGetCycleCount64();
+    for (round = 0; round < TEST_LOOKUP_ROUND; round++) {
+        for (i = 0; i < symNum; i++) {
+            addr = OsDynModuleFindSymFromOs(symTab[i].name);
+            TEST_IF_ERR_RET(addr != (U64)(uintptr_t)symTab[i].addr, "[dlmodule] hash lookup wrong address");
+        }
+    }
+    hashCost = PRT_ClkGetCycleCount64() - start;
+
+    start = PRT_ClkGetCycleCount64();
+    for (round = 0; round < TEST_LOOKUP_ROUND; round++) {
+        for (i = 0; i < symNum; i++) {
+            addr = test_dl_linear_find(symTab, symNum, symTab[i].name);
+            TEST_IF_ERR_RET(addr != (U64)(uintptr_t)symTab[i].addr, "[dlmodule] linear lookup wrong address");
+        }
+    }
+    linearCost = PRT_ClkGetCycleCount64() - start;
+
+    for (i = 0; i < 0x100; i++) {
+        (void)sprintf_s(name, sizeof(name), "test_dl_sym_%02x", i);
+        addr = OsDynModuleFindSymFromOs(name);
+        TEST_IF_ERR_RET(addr == 0, "[dlmodule] test symbol not found");
+        TEST_IF_ERR_RET(((test_dl_fn)(uintptr_t)addr)() != i, "[dlmodule] test symbol resolved to wrong function");
+    }
+    TEST_IF_ERR_RET(OsDynModuleFindSymFromOs("test_dl_sym_none") != 0, "[dlmodule] missing symbol found");
+
+    TEST_LOG_FMT("[dlmodule] %u os symbols, index build+first lookup %llu cycles", symNum, first);
+    TEST_LOG_FMT("[dlmodule] hash lookup avg %llu cycles, linear lookup avg %llu cycles",
+        hashCost / (TEST_LOOKUP_ROUND * symNum), linearCost / (TEST_LOOKUP_ROUND * symNum));
+    return 0;
+}
+
+static int test_dlmodule_load(void)
+{
+    U32 round;
+    U64 start;
+    U64 cost;
+    U64 loadSum = 0;
+    U64 loadMax = 0;
+    U64 findSum = 0;
+    void *handle = NULL;
+    test_dl_get get = NULL;
+
+    for (round = 0; round < TEST_LOAD_ROUND; round++) {
+        start = PRT_ClkGetCycleCount64();
+        handle = OsDynModuleLoad(DLMODULE_TEST_FILE, 0);
+        cost = PRT_ClkGetCycleCount64() - start;
+        if (handle == NULL) {
+            TEST_LOG_FMT("[dlmodule] skip load benchmark, %s: %s", DLMODULE_TEST_FILE, OsDynModuleGetError());
+            return 0;
+        }
+        loadSum += cost;
+        loadMax = (cost > loadMax) ? cost : loadMax;
+
+        start = PRT_ClkGetCycleCount64();
+        get = (test_dl_get)OsDynModuleFind(handle, DLMODULE_TEST_SYM);
+        findSum += PRT_ClkGetCycleCount64() - start;
+        OsDynModuleUnload(handle);
+        TEST_IF_ERR_RET(get == NULL, "[dlmodule] module symbol not found");
+    }
+
+    TEST_LOG_FMT("[dlmodule] load %s avg %llu cycles, max %llu cycles", DLMODULE_TEST_FILE,
+        loadSum / TEST_LOAD_ROUND, loadMax);
+    TEST_LOG_FMT("[dlmodule] module symbol lookup avg %llu cycles", findSum / TEST_LOAD_ROUND);
+    return 0;
+}
+
+test_case_t g_cases[] = {
+    TEST_CASE_Y(test_dlmodule_os_sym),
+    TEST_CASE_Y(test_dlmodule_load),
+};
+
+int g_test_case_size = sizeof(g_cases);
+
+void prt_kern_test_end()
+{
+    TEST_LOG("dlmodule test finished\n");
+}
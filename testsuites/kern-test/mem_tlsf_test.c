@@ -0,0 +1,279 @@
+#include "prt_config.h"
+#include "prt_task.h"
+#include "prt_mem.h"
+#include "prt_log.h"
+#include "prt_clk.h"
+#include "prt_hwi.h"
+#include "securec.h"
+#include "kern_test_public.h"
+
+#define TEST_PT_SIZE 0x40000
+#define TEST_PT_FSC 2
+#define TEST_PT_TLSF 3
+#define TEST_PT_OVERLAP 4
+
+#define TEST_SLOT_NUM 512
+#define TEST_CHURN_ROUND 20000
+#define TEST_SIZE_MIN 16
+#define TEST_SIZE_MAX 1024
+
+/* 构造同规格空闲块时使用：大量小空洞，最后一个空洞略大，只有它能满足申请 */
+#define TEST_HOLE_SIZE 600
+#define TEST_PIN_SIZE 16
+#define TEST_LAST_HOLE_SIZE 960
+#define TEST_SCAN_REQ_SIZE 900
+
+static U8 g_testFscPtMem[TEST_PT_SIZE] __attribute__((aligned(16)));
+static U8 g_testTlsfPtMem[TEST_PT_SIZE] __attribute__((aligned(16)));
+static void *g_testSlot[TEST_SLOT_NUM];
+static void *g_testPin[TEST_SLOT_NUM];
+static U32 g_testSeed;
+
+struct test_mem_cost {
+    U64 allocMax;
+    U64 allocSum;
+    U64 freeMax;
+    U64 freeSum;
+    U32 allocCnt;
+    U32 freeCnt;
+};
+
+static U32 test_mem_rand(void)
+{
+    g_testSeed = g_testSeed * 1103515245U + 12345U;
+    return g_testSeed >> 8;
+}
+
+static int test_mem_pt_create(void)
+{
+    static int created = 0;
+    U32 ret;
+
+    if (created) {
+        return 0;
+    }
+
+    ret = PRT_MemPtCreate(TEST_PT_FSC, MEM_ARITH_FSC, g_testFscPtMem, TEST_PT_SIZE);
+    TEST_IF_ERR_RET(ret, "[mem_tlsf] create fsc pt fail");
+    ret = PRT_MemPtCreate(TEST_PT_TLSF, MEM_ARITH_TLSF, g_testTlsfPtMem, TEST_PT_SIZE);
+    TEST_IF_ERR_RET(ret, "[mem_tlsf] create tlsf pt fail, check OS_OPTION_MEM_TLSF");
+    created = 1;
+    return 0;
+}
+
+/* 关中断测量单次申请耗时，排除任务切换和中断干扰 */
+static void *test_mem_alloc_cost(U8 ptNo, U32 size, struct test_mem_cost *cost)
+{
+    void *addr;
+    U64 start;
+    U64 elapse;
+    uintptr_t intSave;
+
+    intSave = PRT_HwiLock();
+    start = PRT_ClkGetCycleCount64();
+    addr = PRT_MemAlloc(0, ptNo, size);
+    elapse = PRT_ClkGetCycleCount64() - start;
+    PRT_HwiRestore(intSave);
+
+    if (addr != NULL) {
+        cost->allocMax = (elapse > cost->allocMax) ? elapse : cost->allocMax;
+        cost->allocSum += elapse;
+        cost->allocCnt++;
+    }
+    return addr;
+}
+
+static U32 test_mem_free_cost(void *addr, struct test_mem_cost *cost)
+{
+    U32 ret;
+    U64 start;
+    U64 elapse;
+    uintptr_t intSave;
+
+    intSave = PRT_HwiLock();
+    start = PRT_ClkGetCycleCount64();
+    ret = PRT_MemFree(0, addr);
+    elapse = PRT_ClkGetCycleCount64() - start;
+    PRT_HwiRestore(intSave);
+
+    cost->freeMax = (elapse > cost->freeMax) ? elapse : cost->freeMax;
+    cost->freeSum += elapse;
+    cost->freeCnt++;
+    return ret;
+}
+
+static void test_mem_cost_show(const char *name, struct test_mem_cost *cost)
+{
+    TEST_LOG_FMT("[mem_tlsf] %s alloc cnt:%u max:%llu avg:%llu, free cnt:%u max:%llu avg:%llu", name,
+        cost->allocCnt, cost->allocMax, (cost->allocCnt == 0) ? 0 : cost->allocSum / cost->allocCnt,
+        cost->freeCnt, cost->freeMax, (cost->freeCnt == 0) ? 0 : cost->freeSum / cost->freeCnt);
+}
+
+/* 随机大小随机槽位反复申请释放，使分区逐渐碎片化，统计最坏耗时 */
+static int test_mem_churn(U8 ptNo, struct test_mem_cost *cost)
+{
+    U32 round;
+    U32 idx;
+    U32 size;
+    U32 ret;
+
+    (void)memset_s(cost, sizeof(*cost), 0, sizeof(*cost));
+    (void)memset_s(g_testSlot, sizeof(g_testSlot), 0, sizeof(g_testSlot));
+    g_testSeed = 0x5a5a;
+
+    for (round = 0; round < TEST_CHURN_ROUND; round++) {
+        idx = test_mem_rand() % TEST_SLOT_NUM;
+        if (g_testSlot[idx] != NULL) {
+            ret = test_mem_free_cost(g_testSlot[idx], cost);
+            TEST_IF_ERR_RET(ret, "[mem_tlsf] churn free fail");
+            g_testSlot[idx] = NULL;
+        } else {
+            size = TEST_SIZE_MIN + test_mem_rand() % (TEST_SIZE_MAX - TEST_SIZE_MIN);
+            g_testSlot[idx] = test_mem_alloc_cost(ptNo, size, cost);
+        }
+    }
+
+    for (idx = 0; idx < TEST_SLOT_NUM; idx++) {
+        if (g_testSlot[idx] != NULL) {
+            ret = test_mem_free_cost(g_testSlot[idx], cost);
+            TEST_IF_ERR_RET(ret, "[mem_tlsf] churn free fail");
+            g_testSlot[idx] = NULL;
+        }
+    }
+    return 0;
+}
+
+/*
+ * 构造FSC最坏场景：更大规格的链表全部为空，当前规格链表里有大量放不下的空洞，
+ * 唯一满足申请的空闲块位于链表尾部，FSC需线性遍历整个链表，TLSF只做位图查找
+ */
+static int test_mem_same_class(U8 ptNo, struct test_mem_cost *cost)
+{
+    U32 num;
+    U32 idx;
+    U32 ret;
+    void *last = NULL;
+    void *addr = NULL;
+
+    (void)memset_s(cost, sizeof(*cost), 0, sizeof(*cost));
+
+    /* 先占住一个略大空洞及其隔离块 */
+    last = PRT_MemAlloc(0, ptNo, TEST_LAST_HOLE_SIZE);
+    g_testPin[0] = PRT_MemAlloc(0, ptNo, TEST_PIN_SIZE);
+    if (last == NULL || g_testPin[0] == NULL) {
+        TEST_IF_ERR_RET(1, "[mem_tlsf] same class prepare fail");
+    }
+
+    /* 空洞和隔离块交替排布直到分区用尽，释放后空洞无法合并 */
+    for (num = 0; num < TEST_SLOT_NUM - 1; num++) {
+        g_testSlot[num] = PRT_MemAlloc(0, ptNo, TEST_HOLE_SIZE);
+        if (g_testSlot[num] == NULL) {
+            break;
+        }
+        g_testPin[num + 1] = PRT_MemAlloc(0, ptNo, TEST_PIN_SIZE);
+        if (g_testPin[num + 1] == NULL) {
+            (void)PRT_MemFree(0, g_testSlot[num]);
+            break;
+        }
+    }
+    /* 剩余零散内存用隔离块填满，保证没有更大规格的空闲块；分区仅供本用例使用，填充块不再回收 */
+    while (PRT_MemAlloc(0, ptNo, TEST_PIN_SIZE) != NULL) {
+    }
+
+    /* 略大空洞最先释放，FSC头插后位于链表尾部 */
+    (void)PRT_MemFree(0, last);
+    for (idx = 0; idx < num; idx++) {
+        (void)PRT_MemFree(0, g_testSlot[idx]);
+    }
+
+    addr = test_mem_alloc_cost(ptNo, TEST_SCAN_REQ_SIZE, cost);
+    if (addr == NULL) {
+        TEST_IF_ERR_RET(1, "[mem_tlsf] same class alloc fail");
+    }
+    ret = test_mem_free_cost(addr, cost);
+    TEST_IF_ERR_RET(ret, "[mem_tlsf] same class free fail");
+    TEST_LOG_FMT("[mem_tlsf] pt %u, %u holes in same class", (U32)ptNo, num);
+
+    for (idx = 0; idx <= num; idx++) {
+        (void)PRT_MemFree(0, g_testPin[idx]);
+    }
+    return 0;
+}
+
+static int test_mem_frag_churn(void)
+{
+    struct test_mem_cost fsc;
+    struct test_mem_cost tlsf;
+
+    if (test_mem_pt_create() != 0) {
+        return g_testResult;
+    }
+
+    if (test_mem_churn(TEST_PT_FSC, &fsc) != 0 || test_mem_churn(TEST_PT_TLSF, &tlsf) != 0) {
+        return g_testResult;
+    }
+
+    test_mem_cost_show("fsc churn", &fsc);
+    test_mem_cost_show("tlsf churn", &tlsf);
+    return 0;
+}
+
+static int test_mem_worst_search(void)
+{
+    struct test_mem_cost fsc;
+    struct test_mem_cost tlsf;
+
+    if (test_mem_pt_create() != 0) {
+        return g_testResult;
+    }
+
+    if (test_mem_same_class(TEST_PT_FSC, &fsc) != 0 || test_mem_same_class(TEST_PT_TLSF, &tlsf) != 0) {
+        return g_testResult;
+    }
+
+    test_mem_cost_show("fsc same class", &fsc);
+    test_mem_cost_show("tlsf same class", &tlsf);
+    if (tlsf.allocMax > fsc.allocMax) {
+        TEST_LOG("[mem_tlsf] warning: tlsf worst alloc slower than fsc");
+    }
+    return 0;
+}
+
+/* 与已有分区重叠的创建请求被拒绝，且不能改写已有分区的内存 */
+static int test_mem_pt_overlap(void)
+{
+    U32 ret;
+    U32 idx;
+    U8 *blk = NULL;
+
+    if (test_mem_pt_create() != 0) {
+        return g_testResult;
+    }
+
+    blk = PRT_MemAlloc(0, TEST_PT_FSC, 0x100);
+    TEST_IF_ERR_RET(blk == NULL, "[mem_tlsf] alloc fsc block fail");
+    (void)memset_s(blk, 0x100, 0xa5, 0x100);
+
+    ret = PRT_MemPtCreate(TEST_PT_OVERLAP, MEM_ARITH_FSC, g_testFscPtMem, TEST_PT_SIZE / 2);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_MEM_PT_OVERLAP, "[mem_tlsf] overlapping pt not rejected");
+
+    for (idx = 0; idx < 0x100; idx++) {
+        TEST_IF_ERR_RET(blk[idx] != 0xa5, "[mem_tlsf] overlapping pt create corrupted live pt");
+    }
+    ret = PRT_MemFree(0, blk);
+    TEST_IF_ERR_RET(ret, "[mem_tlsf] free fsc block after overlap fail");
+    return 0;
+}
+
+test_case_t g_cases[] = {
+    TEST_CASE_Y(test_mem_pt_overlap),
+    TEST_CASE_Y(test_mem_frag_churn),
+    TEST_CASE_Y(test_mem_worst_search),
+};
+
+int g_test_case_size = sizeof(g_cases);
+
+void prt_kern_test_end()
+{
+    TEST_LOG("mem tlsf test finished\n");
+}
@@ -0,0 +1,538 @@
+#include "prt_config.h"
+#include "prt_task.h"
+#include "prt_mem.h"
+#include "prt_queue.h"
+#include "securec.h"
+#include "kern_test_public.h"
+
+/* 测试主任务优先级为25，辅助任务优先级更高，被唤醒时立即抢占主任务 */
+#define TEST_TASK_PRIO_HIGH 24
+#define TEST_QUEUE_NODE_NUM 4
+#define TEST_MSG_SIZE 16
+
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+/* 零拷贝队列的缓冲区从独立分区借出，用分区用量校验缓冲区是否全部归还 */
+#define TEST_ZC_PT 2
+#define TEST_ZC_PT_SIZE 0x4000
+
+static U8 g_testZcPtMem[TEST_ZC_PT_SIZE] __attribute__((aligned(16)));
+static volatile U32 g_testZcRecv = 0;
+
+static uintptr_t test_zc_used(void)
+{
+    struct MemPtInfo info = {0};
+
+    (void)PRT_MemPtGetInfo(TEST_ZC_PT, &info);
+    return info.usedSize;
+}
+
+static U32 test_zc_commit(U32 queueId, U32 size, U8 fill, U32 timeOut)
+{
+    U32 ret;
+    void *buf = NULL;
+
+    ret = PRT_QueueLoan(queueId, size, &buf);
+    if (ret != OS_OK) {
+        return ret;
+    }
+    (void)memset_s(buf, size, fill, size);
+    ret = PRT_QueueCommit(queueId, buf, size, timeOut, OS_QUEUE_NORMAL);
+    if (ret != OS_OK) {
+        (void)PRT_QueueRelease(queueId, buf);
+    }
+    return ret;
+}
+
+static int test_zc_check(void *buf, U32 len, U32 size, U8 fill)
+{
+    U32 i;
+
+    if (len != size) {
+        return 1;
+    }
+    for (i = 0; i < len; i++) {
+        if (((U8 *)buf)[i] != fill) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_queue_zero_copy_init(void)
+{
+    U32 ret = PRT_MemPtCreate(TEST_ZC_PT, MEM_ARITH_FSC, g_testZcPtMem, TEST_ZC_PT_SIZE);
+    TEST_IF_ERR_RET(ret, "[queue_zc] create pt fail");
+    return 0;
+}
+
+static int test_queue_zero_copy_rw(void)
+{
+    U32 ret;
+    U32 i;
+    U32 len = 0;
+    U32 queueId = 0;
+    void *buf = NULL;
+    uintptr_t base = test_zc_used();
+
+    ret = PRT_QueueCreateZeroCopy(TEST_QUEUE_NODE_NUM, TEST_ZC_PT, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] create queue fail");
+
+    for (i = 0; i < TEST_QUEUE_NODE_NUM; i++) {
+        ret = test_zc_commit(queueId, TEST_MSG_SIZE + i, (U8)i, OS_QUEUE_NO_WAIT);
+        TEST_IF_ERR_RET(ret, "[queue_zc] loan/commit fail");
+    }
+
+    /* 队列满时提交失败，缓冲区仍归调用者所有 */
+    ret = PRT_QueueLoan(queueId, TEST_MSG_SIZE, &buf);
+    TEST_IF_ERR_RET(ret, "[queue_zc] loan on full queue fail");
+    ret = PRT_QueueCommit(queueId, buf, TEST_MSG_SIZE, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_zc] commit on full queue not rejected");
+    /* 提交大小超过借出大小 */
+    ret = PRT_QueueCommit(queueId, buf, TEST_MSG_SIZE + 1, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_LOAN_INVALID, "[queue_zc] oversized commit not rejected");
+    /* 用其它队列ID归还 */
+    ret = PRT_QueueRelease(queueId + 1, buf);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_LOAN_INVALID, "[queue_zc] release with wrong queue not rejected");
+    ret = PRT_QueueRelease(queueId, buf);
+    TEST_IF_ERR_RET(ret, "[queue_zc] release uncommitted buffer fail");
+
+    for (i = 0; i < TEST_QUEUE_NODE_NUM; i++) {
+        ret = PRT_QueueAcquire(queueId, &buf, &len, OS_QUEUE_NO_WAIT);
+        TEST_IF_ERR_RET(ret, "[queue_zc] acquire fail");
+        TEST_IF_ERR_RET(test_zc_check(buf, len, TEST_MSG_SIZE + i, (U8)i), "[queue_zc] acquire wrong data");
+        ret = PRT_QueueRelease(queueId, buf);
+        TEST_IF_ERR_RET(ret, "[queue_zc] release fail");
+    }
+
+    /* 已提交的缓冲区不能再次提交，也不能在被读取前归还 */
+    ret = PRT_QueueLoan(queueId, TEST_MSG_SIZE, &buf);
+    TEST_IF_ERR_RET(ret, "[queue_zc] loan fail");
+    ret = PRT_QueueCommit(queueId, buf, TEST_MSG_SIZE, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret, "[queue_zc] commit fail");
+    ret = PRT_QueueCommit(queueId, buf, TEST_MSG_SIZE, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_LOAN_COMMITTED, "[queue_zc] double commit not rejected");
+    ret = PRT_QueueRelease(queueId, buf);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_LOAN_COMMITTED, "[queue_zc] release of committed buffer not rejected");
+    ret = PRT_QueueAcquire(queueId, &buf, &len, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret, "[queue_zc] acquire fail");
+    ret = PRT_QueueRelease(queueId, buf);
+    TEST_IF_ERR_RET(ret, "[queue_zc] release fail");
+
+    ret = PRT_QueueAcquire(queueId, &buf, &len, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_zc] acquire on empty queue not rejected");
+    TEST_IF_ERR_RET(test_zc_used() != base, "[queue_zc] buffers leaked");
+
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] delete queue fail");
+    return 0;
+}
+
+static int test_queue_zero_copy_mode(void)
+{
+    U32 ret;
+    U32 len = TEST_MSG_SIZE;
+    U32 copyId = 0;
+    U32 zcId = 0;
+    void *buf = NULL;
+    U8 msg[TEST_MSG_SIZE] = {0};
+
+    ret = PRT_QueueCreate(TEST_QUEUE_NODE_NUM, TEST_MSG_SIZE, &copyId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] create copy queue fail");
+    ret = PRT_QueueCreateZeroCopy(TEST_QUEUE_NODE_NUM, TEST_ZC_PT, &zcId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] create zero copy queue fail");
+
+    /* 拷贝队列不能使用零拷贝接口 */
+    ret = PRT_QueueLoan(copyId, TEST_MSG_SIZE, &buf);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_MODE_INVALID, "[queue_zc] loan on copy queue not rejected");
+    ret = PRT_QueueAcquire(copyId, &buf, &len, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_MODE_INVALID, "[queue_zc] acquire on copy queue not rejected");
+
+    /* 零拷贝队列不能使用拷贝接口 */
+    ret = PRT_QueueWrite(zcId, msg, TEST_MSG_SIZE, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_MODE_INVALID, "[queue_zc] write on zero copy queue not rejected");
+    ret = PRT_QueueRead(zcId, msg, &len, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_MODE_INVALID, "[queue_zc] read on zero copy queue not rejected");
+
+    ret = PRT_QueueDelete(copyId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] delete copy queue fail");
+    ret = PRT_QueueDelete(zcId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] delete zero copy queue fail");
+    return 0;
+}
+
+static int test_queue_zero_copy_delete(void)
+{
+    U32 ret;
+    U32 i;
+    U32 queueId = 0;
+    uintptr_t base = test_zc_used();
+
+    ret = PRT_QueueCreateZeroCopy(TEST_QUEUE_NODE_NUM, TEST_ZC_PT, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] create queue fail");
+
+    for (i = 0; i < TEST_QUEUE_NODE_NUM - 1; i++) {
+        ret = test_zc_commit(queueId, TEST_MSG_SIZE, (U8)i, OS_QUEUE_NO_WAIT);
+        TEST_IF_ERR_RET(ret, "[queue_zc] loan/commit fail");
+    }
+    TEST_IF_ERR_RET(test_zc_used() == base, "[queue_zc] committed buffers not accounted");
+
+    /* 删除队列时队列中未读取的缓冲区一并释放 */
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] delete queue with buffers fail");
+    TEST_IF_ERR_RET(test_zc_used() != base, "[queue_zc] buffers not freed on delete");
+    return 0;
+}
+
+static void test_queue_zero_copy_reader(uintptr_t queueId, uintptr_t param2, uintptr_t param3, uintptr_t param4)
+{
+    U32 ret;
+    U32 len = 0;
+    void *buf = NULL;
+    (void)param2;
+    (void)param3;
+    (void)param4;
+
+    ret = PRT_QueueAcquire((U32)queueId, &buf, &len, OS_QUEUE_WAIT_FOREVER);
+    TEST_IF_ERR_RET_VOID(ret, "[queue_zc] blocked acquire fail");
+    TEST_IF_ERR_RET_VOID(test_zc_check(buf, len, TEST_MSG_SIZE, 0x5a), "[queue_zc] blocked acquire wrong data");
+    (void)PRT_QueueRelease((U32)queueId, buf);
+    g_testZcRecv = 1;
+}
+
+static int test_queue_zero_copy_block(void)
+{
+    U32 ret;
+    U32 queueId = 0;
+
+    ret = PRT_QueueCreateZeroCopy(TEST_QUEUE_NODE_NUM, TEST_ZC_PT, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] create queue fail");
+
+    /* 读任务优先级高，创建后立即阻塞在空队列上 */
+    g_testZcRecv = 0;
+    test_start_task_param((TskEntryFunc)test_queue_zero_copy_reader, TEST_TASK_PRIO_HIGH, OS_TSK_SCHED_FIFO,
+        (uintptr_t)queueId, 0, 0, 0);
+    TEST_IF_ERR_RET(g_testZcRecv != 0, "[queue_zc] reader not blocked");
+
+    ret = test_zc_commit(queueId, TEST_MSG_SIZE, 0x5a, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret, "[queue_zc] commit fail");
+    TEST_IF_ERR_RET(g_testZcRecv != 1, "[queue_zc] reader not woken by commit");
+
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_zc] delete queue fail");
+    return 0;
+}
+#endif
+
+#if defined(OS_OPTION_QUEUE_SPSC)
+#define TEST_SPSC_NUM 8
+#define TEST_SPSC_BLOCK_NUM 3
+
+static SpscQueHandle g_testSpscHandle;
+static volatile U32 g_testSpscRecv = 0;
+
+static int test_spsc_check(U32 *buf, U32 num, U32 start)
+{
+    U32 i;
+
+    for (i = 0; i < num; i++) {
+        if (buf[i] != start + i) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_queue_spsc_rw(void)
+{
+    U32 ret;
+    U32 i;
+    U32 num = 0;
+    U32 buf[TEST_SPSC_NUM * 2] = {0};
+    SpscQueHandle handle = 0;
+
+    ret = PRT_QueueSpscCreate(TEST_SPSC_NUM - 2, sizeof(U32), &handle);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_SPSC_NUM_INVALID, "[queue_spsc] non power of 2 num not rejected");
+    ret = PRT_QueueSpscCreate(TEST_SPSC_NUM, sizeof(U32), &handle);
+    TEST_IF_ERR_RET(ret, "[queue_spsc] create fail");
+
+    for (i = 0; i < TEST_SPSC_NUM; i++) {
+        ret = PRT_QueueSpscPut(handle, &i);
+        TEST_IF_ERR_RET(ret, "[queue_spsc] put fail");
+    }
+    ret = PRT_QueueSpscPut(handle, &i);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_spsc] put on full queue not rejected");
+
+    /* 先取走一部分，再写入使尾指针环绕 */
+    ret = PRT_QueueSpscGet(handle, buf, TEST_SPSC_NUM - 3, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret, "[queue_spsc] get fail");
+    TEST_IF_ERR_RET(num != TEST_SPSC_NUM - 3, "[queue_spsc] get wrong num");
+    TEST_IF_ERR_RET(test_spsc_check(buf, num, 0), "[queue_spsc] get wrong data");
+
+    for (i = TEST_SPSC_NUM; i < TEST_SPSC_NUM * 2 - 3; i++) {
+        ret = PRT_QueueSpscPut(handle, &i);
+        TEST_IF_ERR_RET(ret, "[queue_spsc] put after wrap fail");
+    }
+    ret = PRT_QueueSpscPut(handle, &i);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_spsc] put on wrapped full queue not rejected");
+
+    /* 跨越环尾的批量读取 */
+    ret = PRT_QueueSpscGet(handle, buf, TEST_SPSC_NUM * 2, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret, "[queue_spsc] get wrapped fail");
+    TEST_IF_ERR_RET(num != TEST_SPSC_NUM, "[queue_spsc] get wrapped wrong num");
+    TEST_IF_ERR_RET(test_spsc_check(buf, num, TEST_SPSC_NUM - 3), "[queue_spsc] get wrapped wrong data");
+
+    ret = PRT_QueueSpscGet(handle, buf, TEST_SPSC_NUM, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_spsc] get on empty queue not rejected");
+    ret = PRT_QueueSpscGet(handle, buf, TEST_SPSC_NUM, &num, 10);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_TIMEOUT, "[queue_spsc] get on empty queue not timeout");
+
+    ret = PRT_QueueSpscDelete(handle);
+    TEST_IF_ERR_RET(ret, "[queue_spsc] delete fail");
+    return 0;
+}
+
+static void test_queue_spsc_consumer(void)
+{
+    U32 ret;
+    U32 i;
+    U32 num = 0;
+    U32 val = 0;
+
+    for (i = 0; i < TEST_SPSC_BLOCK_NUM; i++) {
+        ret = PRT_QueueSpscGet(g_testSpscHandle, &val, 1, &num, OS_QUEUE_WAIT_FOREVER);
+        TEST_IF_ERR_RET_VOID(ret, "[queue_spsc] blocked get fail");
+        TEST_IF_ERR_RET_VOID(num != 1 || val != i, "[queue_spsc] blocked get wrong data");
+        g_testSpscRecv++;
+    }
+}
+
+static int test_queue_spsc_block(void)
+{
+    U32 ret;
+    U32 i;
+
+    ret = PRT_QueueSpscCreate(TEST_SPSC_NUM, sizeof(U32), &g_testSpscHandle);
+    TEST_IF_ERR_RET(ret, "[queue_spsc] create fail");
+
+    /* 消费者优先级高，每次写入都被唤醒并立即取走数据 */
+    g_testSpscRecv = 0;
+    test_start_task((TskEntryFunc)test_queue_spsc_consumer, TEST_TASK_PRIO_HIGH, OS_TSK_SCHED_FIFO);
+    TEST_IF_ERR_RET(g_testSpscRecv != 0, "[queue_spsc] consumer not blocked");
+
+    for (i = 0; i < TEST_SPSC_BLOCK_NUM; i++) {
+        ret = PRT_QueueSpscPut(g_testSpscHandle, &i);
+        TEST_IF_ERR_RET(ret, "[queue_spsc] put fail");
+        TEST_IF_ERR_RET(g_testSpscRecv != i + 1, "[queue_spsc] consumer not woken by put");
+    }
+
+    ret = PRT_QueueSpscDelete(g_testSpscHandle);
+    TEST_IF_ERR_RET(ret, "[queue_spsc] delete fail");
+    return 0;
+}
+#endif
+
+#define TEST_BATCH_READER_NUM 2
+#define TEST_BATCH_WRITE_NUM 2
+
+static volatile U32 g_testBatchRecv = 0;
+static volatile U32 g_testBatchSent = 0;
+
+static int test_queue_batch_rw(void)
+{
+    U32 ret;
+    U32 i;
+    U32 num = 0;
+    U32 queueId = 0;
+    U32 lens[TEST_QUEUE_NODE_NUM * 2] = {0};
+    U32 wbuf[TEST_QUEUE_NODE_NUM + 2] = {0};
+    U32 rbuf[TEST_QUEUE_NODE_NUM * 2][2] = {0};
+
+    ret = PRT_QueueCreate(TEST_QUEUE_NODE_NUM, TEST_MSG_SIZE, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] create queue fail");
+
+    for (i = 0; i < TEST_QUEUE_NODE_NUM + 2; i++) {
+        wbuf[i] = i;
+    }
+    ret = PRT_QueueWriteBatch(queueId, wbuf, sizeof(U32), 0, &num, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_BATCH_NUM_ZERO, "[queue_batch] zero num not rejected");
+
+    /* 空闲节点不足时只写入部分消息 */
+    ret = PRT_QueueWriteBatch(queueId, wbuf, sizeof(U32), TEST_QUEUE_NODE_NUM + 2, &num, OS_QUEUE_NO_WAIT,
+        OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret, "[queue_batch] write batch fail");
+    TEST_IF_ERR_RET(num != TEST_QUEUE_NODE_NUM, "[queue_batch] partial write wrong num");
+    ret = PRT_QueueWriteBatch(queueId, wbuf, sizeof(U32), 1, &num, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_batch] write batch on full queue not rejected");
+
+    /* 每条消息按msgSize间隔存放，lens返回实际长度 */
+    ret = PRT_QueueReadBatch(queueId, rbuf, sizeof(rbuf[0]), lens, TEST_QUEUE_NODE_NUM - 1, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret, "[queue_batch] read batch fail");
+    TEST_IF_ERR_RET(num != TEST_QUEUE_NODE_NUM - 1, "[queue_batch] read batch wrong num");
+    for (i = 0; i < num; i++) {
+        TEST_IF_ERR_RET(lens[i] != sizeof(U32) || rbuf[i][0] != i, "[queue_batch] read batch wrong data");
+    }
+
+    /* 可读消息少于maxNum时只读出部分消息 */
+    ret = PRT_QueueReadBatch(queueId, rbuf, sizeof(rbuf[0]), lens, TEST_QUEUE_NODE_NUM * 2, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret, "[queue_batch] partial read batch fail");
+    TEST_IF_ERR_RET(num != 1 || rbuf[0][0] != TEST_QUEUE_NODE_NUM - 1, "[queue_batch] partial read wrong data");
+    ret = PRT_QueueReadBatch(queueId, rbuf, sizeof(rbuf[0]), lens, 1, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_NO_SOURCE, "[queue_batch] read batch on empty queue not rejected");
+
+    /* 紧急消息整批排在普通消息之前，批内顺序不变 */
+    ret = PRT_QueueWriteBatch(queueId, &wbuf[0], sizeof(U32), 2, &num, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret || num != 2, "[queue_batch] write normal batch fail");
+    ret = PRT_QueueWriteBatch(queueId, &wbuf[2], sizeof(U32), 2, &num, OS_QUEUE_NO_WAIT, OS_QUEUE_URGENT);
+    TEST_IF_ERR_RET(ret || num != 2, "[queue_batch] write urgent batch fail");
+    ret = PRT_QueueReadBatch(queueId, rbuf, sizeof(rbuf[0]), NULL, TEST_QUEUE_NODE_NUM, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret || num != TEST_QUEUE_NODE_NUM, "[queue_batch] read mixed batch fail");
+    TEST_IF_ERR_RET(rbuf[0][0] != 2 || rbuf[1][0] != 3 || rbuf[2][0] != 0 || rbuf[3][0] != 1,
+        "[queue_batch] urgent batch wrong order");
+
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] delete queue fail");
+    return 0;
+}
+
+static void test_queue_batch_reader(uintptr_t queueId, uintptr_t param2, uintptr_t param3, uintptr_t param4)
+{
+    U32 ret;
+    U32 num = 0;
+    U32 val = 0;
+    (void)param2;
+    (void)param3;
+    (void)param4;
+
+    ret = PRT_QueueReadBatch((U32)queueId, &val, sizeof(U32), NULL, 1, &num, OS_QUEUE_WAIT_FOREVER);
+    TEST_IF_ERR_RET_VOID(ret || num != 1, "[queue_batch] blocked read batch fail");
+    g_testBatchRecv++;
+}
+
+static int test_queue_batch_wake_reader(void)
+{
+    U32 ret;
+    U32 i;
+    U32 num = 0;
+    U32 queueId = 0;
+    U32 buf[TEST_BATCH_READER_NUM + 1] = {0};
+
+    ret = PRT_QueueCreate(TEST_QUEUE_NODE_NUM, TEST_MSG_SIZE, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] create queue fail");
+
+    g_testBatchRecv = 0;
+    for (i = 0; i < TEST_BATCH_READER_NUM; i++) {
+        test_start_task_param((TskEntryFunc)test_queue_batch_reader, TEST_TASK_PRIO_HIGH, OS_TSK_SCHED_FIFO,
+            (uintptr_t)queueId, 0, 0, 0);
+    }
+    TEST_IF_ERR_RET(g_testBatchRecv != 0, "[queue_batch] readers not blocked");
+
+    /* 一次批量写唤醒全部等待的读任务，多出的消息留在队列中 */
+    ret = PRT_QueueWriteBatch(queueId, buf, sizeof(U32), TEST_BATCH_READER_NUM + 1, &num, OS_QUEUE_NO_WAIT,
+        OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret || num != TEST_BATCH_READER_NUM + 1, "[queue_batch] write batch fail");
+    TEST_IF_ERR_RET(g_testBatchRecv != TEST_BATCH_READER_NUM, "[queue_batch] readers not woken by write batch");
+
+    ret = PRT_QueueReadBatch(queueId, buf, sizeof(U32), NULL, TEST_QUEUE_NODE_NUM, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret || num != 1, "[queue_batch] remaining message wrong");
+
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] delete queue fail");
+    return 0;
+}
+
+static void test_queue_batch_writer(uintptr_t queueId, uintptr_t param2, uintptr_t param3, uintptr_t param4)
+{
+    U32 ret;
+    U32 num = 0;
+    U32 buf[TEST_BATCH_WRITE_NUM] = {0x10, 0x11};
+    (void)param2;
+    (void)param3;
+    (void)param4;
+
+    ret = PRT_QueueWriteBatch((U32)queueId, buf, sizeof(U32), TEST_BATCH_WRITE_NUM, &num, OS_QUEUE_WAIT_FOREVER,
+        OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET_VOID(ret, "[queue_batch] blocked write batch fail");
+    g_testBatchSent = num;
+}
+
+static int test_queue_batch_wake_writer(void)
+{
+    U32 ret;
+    U32 num = 0;
+    U32 queueId = 0;
+    U32 buf[TEST_QUEUE_NODE_NUM] = {0};
+
+    ret = PRT_QueueCreate(TEST_QUEUE_NODE_NUM, TEST_MSG_SIZE, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] create queue fail");
+    ret = PRT_QueueWriteBatch(queueId, buf, sizeof(U32), TEST_QUEUE_NODE_NUM, &num, OS_QUEUE_NO_WAIT,
+        OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret || num != TEST_QUEUE_NODE_NUM, "[queue_batch] fill queue fail");
+
+    g_testBatchSent = 0;
+    test_start_task_param((TskEntryFunc)test_queue_batch_writer, TEST_TASK_PRIO_HIGH, OS_TSK_SCHED_FIFO,
+        (uintptr_t)queueId, 0, 0, 0);
+    TEST_IF_ERR_RET(g_testBatchSent != 0, "[queue_batch] writer not blocked");
+
+    /* 批量读腾出节点后唤醒写任务，写任务整批写入 */
+    ret = PRT_QueueReadBatch(queueId, buf, sizeof(U32), NULL, TEST_QUEUE_NODE_NUM, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret || num != TEST_QUEUE_NODE_NUM, "[queue_batch] read batch fail");
+    TEST_IF_ERR_RET(g_testBatchSent != TEST_BATCH_WRITE_NUM, "[queue_batch] writer not woken by read batch");
+
+    ret = PRT_QueueReadBatch(queueId, buf, sizeof(U32), NULL, TEST_QUEUE_NODE_NUM, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret || num != TEST_BATCH_WRITE_NUM, "[queue_batch] read writer batch fail");
+    TEST_IF_ERR_RET(buf[0] != 0x10 || buf[1] != 0x11, "[queue_batch] writer batch wrong data");
+
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] delete queue fail");
+    return 0;
+}
+
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+static int test_queue_batch_mode(void)
+{
+    U32 ret;
+    U32 num = 0;
+    U32 queueId = 0;
+    U8 msg[TEST_MSG_SIZE] = {0};
+
+    ret = PRT_QueueCreateZeroCopy(TEST_QUEUE_NODE_NUM, TEST_ZC_PT, &queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] create zero copy queue fail");
+
+    /* 零拷贝队列不能使用批量拷贝接口 */
+    ret = PRT_QueueWriteBatch(queueId, msg, TEST_MSG_SIZE, 1, &num, OS_QUEUE_NO_WAIT, OS_QUEUE_NORMAL);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_MODE_INVALID, "[queue_batch] write batch on zero copy queue not rejected");
+    ret = PRT_QueueReadBatch(queueId, msg, TEST_MSG_SIZE, NULL, 1, &num, OS_QUEUE_NO_WAIT);
+    TEST_IF_ERR_RET(ret != OS_ERRNO_QUEUE_MODE_INVALID, "[queue_batch] read batch on zero copy queue not rejected");
+
+    ret = PRT_QueueDelete(queueId);
+    TEST_IF_ERR_RET(ret, "[queue_batch] delete zero copy queue fail");
+    return 0;
+}
+#endif
+
+test_case_t g_cases[] = {
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+    TEST_CASE_Y(test_queue_zero_copy_init),
+    TEST_CASE_Y(test_queue_zero_copy_rw),
+    TEST_CASE_Y(test_queue_zero_copy_mode),
+    TEST_CASE_Y(test_queue_zero_copy_delete),
+    TEST_CASE_Y(test_queue_zero_copy_block),
+#endif
+#if defined(OS_OPTION_QUEUE_SPSC)
+    TEST_CASE_Y(test_queue_spsc_rw),
+    TEST_CASE_Y(test_queue_spsc_block),
+#endif
+    TEST_CASE_Y(test_queue_batch_rw),
+    TEST_CASE_Y(test_queue_batch_wake_reader),
+    TEST_CASE_Y(test_queue_batch_wake_writer),
+#if defined(OS_OPTION_QUEUE_ZERO_COPY)
+    TEST_CASE_Y(test_queue_batch_mode),
+#endif
+};
+
+int g_test_case_size = sizeof(g_cases);
+
+void prt_kern_test_end()
+{
+    TEST_LOG("queue test finished\n");
+}
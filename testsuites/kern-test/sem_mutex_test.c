@@ -999,6 +999,126 @@ static int test_prior_pend_list(void) {
     return prt_sem_mutex_test_start((TskEntryFunc)test_prior_pend_list_task_C);
 }
 
+#if defined(OS_OPTION_SMP)
+#define TEST_PI_BENCH_TICKS (OS_TICK_PER_SECOND / 10)
+#define TEST_PI_BENCH_CACHE_LINE 64
+#define TEST_PI_BENCH_WAIT 0
+#define TEST_PI_BENCH_RUN 1
+#define TEST_PI_BENCH_STOP 2
+
+/* 每核计数独占一个cache line，避免计数本身引入伪共享 */
+struct test_pi_bench_cnt {
+    volatile U64 ops;
+    U8 pad[TEST_PI_BENCH_CACHE_LINE - sizeof(U64)];
+};
+
+static struct test_pi_bench_cnt g_testPiBenchCnt[OS_MAX_CORE_NUM] __attribute__((aligned(TEST_PI_BENCH_CACHE_LINE)));
+static SemHandle g_testPiBenchSem[OS_MAX_CORE_NUM];
+static volatile U32 g_testPiBenchState;
+static volatile U32 g_testPiBenchReady;
+static volatile U32 g_testPiBenchExit;
+
+/* 绑定到idx核，在独立的优先级继承互斥锁上反复加解锁，直到测试窗口结束 */
+static void test_pi_bench_task(uintptr_t idx)
+{
+    U32 ret;
+    U64 ops = 0;
+    TskHandle self;
+    SemHandle sem = g_testPiBenchSem[idx];
+
+    PRT_TaskSelf(&self);
+    (void)PRT_TaskCoreBind(self, 1U << idx);
+    __atomic_add_fetch(&g_testPiBenchReady, 1, __ATOMIC_RELEASE);
+
+    while (g_testPiBenchState == TEST_PI_BENCH_WAIT) {
+    }
+
+    while (g_testPiBenchState == TEST_PI_BENCH_RUN) {
+        ret = PRT_SemPend(sem, OS_WAIT_FOREVER);
+        ret |= PRT_SemPost(sem);
+        if (ret != OS_OK) {
+            g_testResult = (int)ret;
+            break;
+        }
+        ops++;
+    }
+
+    g_testPiBenchCnt[idx].ops = ops;
+    __atomic_add_fetch(&g_testPiBenchExit, 1, __ATOMIC_RELEASE);
+}
+
+static int test_pi_bench_round(U32 coreNum, U64 *ops)
+{
+    U32 i;
+    U32 ret;
+    TskHandle handle;
+
+    g_testPiBenchState = TEST_PI_BENCH_WAIT;
+    g_testPiBenchReady = 0;
+    g_testPiBenchExit = 0;
+    *ops = 0;
+    for (i = 0; i < coreNum; i++) {
+        ret = PRT_SemMutexCreate(&g_testPiBenchSem[i]);
+        TEST_IF_ERR_RET(ret, "[pi_bench] create mutex fail");
+        g_testPiBenchCnt[i].ops = 0;
+    }
+
+    for (i = 0; i < coreNum; i++) {
+        handle = test_start_task_param((TskEntryFunc)test_pi_bench_task, TASK_PRIOR_C, OS_TSK_SCHED_FIFO, i, 0, 0, 0);
+        TEST_IF_ERR_RET((handle == -1), "[pi_bench] create task fail");
+    }
+
+    while (g_testPiBenchReady != coreNum) {
+        PRT_TaskDelay(1);
+    }
+
+    /* 测试任务优先级高于压测任务，按tick窗口计时，窗口结束后通知压测任务退出 */
+    g_testPiBenchState = TEST_PI_BENCH_RUN;
+    PRT_TaskDelay(TEST_PI_BENCH_TICKS);
+    g_testPiBenchState = TEST_PI_BENCH_STOP;
+
+    while (g_testPiBenchExit != coreNum) {
+        PRT_TaskDelay(1);
+    }
+
+    for (i = 0; i < coreNum; i++) {
+        *ops += g_testPiBenchCnt[i].ops;
+        ret = PRT_SemDelete(g_testPiBenchSem[i]);
+        TEST_IF_ERR_RET(ret, "[pi_bench] delete mutex fail");
+    }
+    return g_testResult;
+}
+
+/**
+ * 优先级继承互斥锁多核竞争压测
+ * 1 ~ OS_MAX_CORE_NUM个任务分别绑核，各自在独立的互斥锁上反复加解锁，继承链互不相交。
+ * 统计固定窗口内的总加解锁次数及相对单核的倍数；互斥锁加解锁不经过全局锁时，吞吐随核数近似线性增长。
+*/
+static int test_pi_bench_scaling(void)
+{
+    U32 coreNum;
+    U64 ops;
+    U64 baseOps = 0;
+    int ret;
+
+    PRT_TaskDelay(OS_TICK_PER_SECOND / 10);
+    g_testFinish = 0;
+    g_testResult = 0;
+    for (coreNum = 1; coreNum <= OS_MAX_CORE_NUM; coreNum++) {
+        ret = test_pi_bench_round(coreNum, &ops);
+        if (ret != 0) {
+            return ret;
+        }
+        if (coreNum == 1) {
+            baseOps = ops;
+        }
+        TEST_LOG_FMT("[pi_bench] cores:%u ops/s:%llu scale:%llu%%", coreNum,
+            ops * OS_TICK_PER_SECOND / TEST_PI_BENCH_TICKS, (baseOps == 0) ? 0 : ops * 100 / baseOps);
+    }
+    return 0;
+}
+#endif
+
 test_case_t g_cases[] = {
     TEST_CASE_Y(test_prior_inherit),
     TEST_CASE_Y(test_prior_restore),
@@ -1006,6 +1126,9 @@ test_case_t g_cases[] = {
     TEST_CASE_Y(test_prior_propagation),
     TEST_CASE_Y(test_prior_set),
     TEST_CASE_Y(test_prior_pend_list),
+#if defined(OS_OPTION_SMP)
+    TEST_CASE_Y(test_pi_bench_scaling),
+#endif
 };
 
 int g_test_case_size = sizeof(g_cases);
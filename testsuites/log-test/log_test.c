@@ -9,6 +9,9 @@
 #include "prt_mem.h"
 #include "prt_sys.h"
 #include "prt_config.h"
+#include "prt_clk.h"
+#include "prt_hwi.h"
+#include "prt_atomic.h"
 #include "securec.h"
 
 // 后续考虑接口耗时测试(需要cycle)，最高速率测试 (不同环境最高速率不同）
@@ -360,6 +363,28 @@ int log_format_test()
     return 0;
 }
 
+int log_binary_test()
+{
+    U32 ret;
+    U32 core_id = PRT_GetCoreID();
+
+    ret = PRT_LOG_BIN(OS_LOG_NONE, OS_LOG_F1, "test %d", 1);
+    ASSERT_EQ(ret, -1);
+    ret = PRT_LOG_BIN(OS_LOG_INFO, 0, "test %d", 1);
+    ASSERT_EQ(ret, -1);
+
+    for (int i = 0; i < 3; i++) {
+        ret = PRT_LOG_BIN(OS_LOG_INFO, OS_LOG_F1, "[core:%u] binary test %d, %s, 0x%llx, %zu", core_id, i, "str",
+            0x123456789ULL, sizeof(U64));
+        ASSERT_EQ(ret, 0);
+    }
+
+    // 不支持二进制记录的格式串按文本记录
+    ret = PRT_LOG_BIN(OS_LOG_INFO, OS_LOG_F1, "[core:%u] binary fallback %*d", core_id, 4, 1);
+    ASSERT_EQ(ret, 0);
+    return 0;
+}
+
 int log_error_trigger()
 {
     U32 ret;
@@ -383,6 +408,161 @@ int log_error_trigger()
     return tmp;
 }
 
+/*
+ * 日志吞吐基准：LOG_BENCH_TASK_NUM个任务各预留LOG_BENCH_COUNT次，统计总耗时。
+ * LOG_BENCH_LOCK 为原实现的预留方式(自旋锁关中断取序号，再加锁检查并更新tail)，
+ * LOG_BENCH_ATOMIC 为原子自增取序号、cmpxchg更新tail的方式，两者都只操作本地计数，不写共享内存；
+ * LOG_BENCH_PRT_LOG 为端到端调用PRT_Log，缓冲区满时的失败单独统计。
+ */
+#define LOG_BENCH_TASK_NUM 5
+#define LOG_BENCH_COUNT 2000UL
+#define LOG_BENCH_RING_NUM 0x4000U
+
+enum LogBenchMode {
+    LOG_BENCH_LOCK,
+    LOG_BENCH_ATOMIC,
+    LOG_BENCH_PRT_LOG,
+    LOG_BENCH_MODE_NUM
+};
+
+static const char *g_logBenchName[LOG_BENCH_MODE_NUM] = {"lock", "atomic", "PRT_Log"};
+static volatile U32 g_logBenchSeq;
+static volatile U32 g_logBenchTail;
+static volatile U32 g_logBenchHead;
+static volatile U32 g_logBenchDone;
+static volatile U32 g_logBenchDrop;
+#if defined(OS_OPTION_SMP)
+static struct PrtSpinLock g_logBenchLock;
+#define LOG_BENCH_LOCK_ON() PRT_SplIrqLock(&g_logBenchLock)
+#define LOG_BENCH_LOCK_OFF(intSave) PRT_SplIrqUnlock(&g_logBenchLock, (intSave))
+#else
+#define LOG_BENCH_LOCK_ON() PRT_HwiLock()
+#define LOG_BENCH_LOCK_OFF(intSave) PRT_HwiRestore(intSave)
+#endif
+
+static void log_bench_reserve_lock(void)
+{
+    uintptr_t intSave;
+    U32 tail;
+
+    intSave = LOG_BENCH_LOCK_ON();
+    g_logBenchSeq++;
+    LOG_BENCH_LOCK_OFF(intSave);
+
+    while (1) {
+        tail = g_logBenchTail;
+        if (tail - g_logBenchHead >= LOG_BENCH_RING_NUM) {
+            g_logBenchHead = tail - LOG_BENCH_RING_NUM + 1;
+        }
+        intSave = LOG_BENCH_LOCK_ON();
+        if (tail == g_logBenchTail) {
+            g_logBenchTail = tail + 1;
+            LOG_BENCH_LOCK_OFF(intSave);
+            return;
+        }
+        LOG_BENCH_LOCK_OFF(intSave);
+    }
+}
+
+static void log_bench_reserve_atomic(void)
+{
+    U32 tail;
+
+    (void)__atomic_fetch_add(&g_logBenchSeq, 1, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&g_logBenchTail, __ATOMIC_ACQUIRE);
+    do {
+        if (tail - __atomic_load_n(&g_logBenchHead, __ATOMIC_ACQUIRE) >= LOG_BENCH_RING_NUM) {
+            g_logBenchHead = tail - LOG_BENCH_RING_NUM + 1;
+        }
+    } while (!__atomic_compare_exchange_n(&g_logBenchTail, &tail, tail + 1, false, __ATOMIC_ACQ_REL,
+                                          __ATOMIC_ACQUIRE));
+}
+
+static void log_bench_thread(uintptr_t mode)
+{
+    U32 i;
+    U32 core_id = PRT_GetCoreID();
+
+    for (i = 0; i < LOG_BENCH_COUNT; i++) {
+        if (mode == LOG_BENCH_LOCK) {
+            log_bench_reserve_lock();
+        } else if (mode == LOG_BENCH_ATOMIC) {
+            log_bench_reserve_atomic();
+        } else if (PRT_LogFormat(OS_LOG_INFO, OS_LOG_F1, "[core:%u] bench %u", core_id, i) != 0) {
+            __atomic_fetch_add(&g_logBenchDrop, 1, __ATOMIC_RELAXED);
+        }
+    }
+    __atomic_fetch_add(&g_logBenchDone, 1, __ATOMIC_RELEASE);
+}
+
+static int log_bench_round(U32 mode, U64 *cycles)
+{
+    U32 ret;
+    U64 start;
+    struct TskInitParam param = {0};
+    TskHandle testTskHandle;
+
+    g_logBenchDone = 0;
+    g_logBenchDrop = 0;
+    start = PRT_ClkGetCycleCount64();
+    for (int i = 0; i < LOG_BENCH_TASK_NUM; i++) {
+        param.stackAddr = (uintptr_t)PRT_MemAllocAlign(0, OS_MEM_DEFAULT_FSC_PT, 0x3000, MEM_ADDR_ALIGN_016);
+        param.taskEntry = (TskEntryFunc)log_bench_thread;
+        /* 同优先级，避免高优先级任务独占本核 */
+        param.taskPrio = 26;
+        param.name = "logBench";
+        param.stackSize = 0x3000;
+        param.args[0] = mode;
+
+        ret = PRT_TaskCreate(&testTskHandle, &param);
+        if (ret) {
+            printf("create task fail, %u\n", ret);
+            return -1;
+        }
+
+        ret = PRT_TaskResume(testTskHandle);
+        if (ret) {
+            printf("resume task fail, %u\n", ret);
+            return -1;
+        }
+    }
+
+    while (__atomic_load_n(&g_logBenchDone, __ATOMIC_ACQUIRE) != LOG_BENCH_TASK_NUM) {
+        PRT_TaskDelay(1);
+    }
+    *cycles = PRT_ClkGetCycleCount64() - start;
+    return 0;
+}
+
+int log_bench_test()
+{
+    U32 mode;
+    U64 cycles;
+    U64 us;
+    U64 total = LOG_BENCH_TASK_NUM * LOG_BENCH_COUNT;
+
+    while (!PRT_IsLogInit()) {
+        PRT_TaskDelay(OS_TICK_PER_SECOND / 100);
+    };
+
+#if defined(OS_OPTION_SMP)
+    if (PRT_SplLockInit(&g_logBenchLock)) {
+        return -1;
+    }
+#endif
+
+    for (mode = LOG_BENCH_LOCK; mode < LOG_BENCH_MODE_NUM; mode++) {
+        if (log_bench_round(mode, &cycles)) {
+            return -1;
+        }
+        us = PRT_ClkCycle2Us(cycles);
+        printf("[log_bench] core:%u %s: %llu ops, %llu us, %llu ops/s, drop:%u\n", PRT_GetCoreID(),
+            g_logBenchName[mode], total, us, (us == 0) ? 0 : total * 1000000 / us, g_logBenchDrop);
+        PRT_TaskDelay(OS_TICK_PER_SECOND / 10);
+    }
+    return 0;
+}
+
 typedef int (*test_fn)(int argc, char **argv);
 
 typedef struct test_case {
@@ -407,7 +587,9 @@ static test_case_t g_cases[] = {
     TEST_CASE_Y(log_switch_test),
     TEST_CASE_Y(log_format_test),
     TEST_CASE_Y(log_interface_test),
+    TEST_CASE_Y(log_binary_test),
     TEST_CASE_N(log_error_trigger),
+    TEST_CASE_N(log_bench_test),
 };
 
 static void log_test_entry()